@@ -24,6 +24,7 @@
 #include "mapmatrix.h"
 #include "OpenAip.h"
 #include "openairparser.h"
+#include "perftrace.h"
 #include "projectionbase.h"
 #include "resource.h"
 
@@ -423,8 +424,7 @@ bool AirspaceHelper::createCompiledFile( QString& fileName,
  */
 bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
 {
-  QTime t;
-  t.start();
+  PerfTrace::Scope scope( "Airspace file load" );
 
   QFile inFile(path);
 
@@ -548,8 +548,8 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
 
   QFileInfo fi( path );
 
-  qDebug( "ASH: %d airspace objects read from file %s in %dms",
-          counter, fi.fileName().toLatin1().data(), t.elapsed() );
+  qDebug( "ASH: %d airspace objects read from file %s",
+          counter, fi.fileName().toLatin1().data() );
 
   return true;
 }
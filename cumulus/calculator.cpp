@@ -35,13 +35,36 @@
 #include "mainwindow.h"
 #include "mapcalc.h"
 #include "mapmatrix.h"
+#include "navbenchmark.h"
 #include "reachablelist.h"
 #include "tpinfowidget.h"
 #include "whatsthat.h"
 #include "windanalyser.h"
 
 #define MAX_MCCREADY 10.0
-#define MAX_SAMPLECOUNT 600
+
+// Time span in seconds covered by the sample list.
+#define MAX_SAMPLETIME 600
+
+// Maximum supported fix rate in Hz of the sample list.
+#define MAX_FIXRATE 20
+
+// Time span in seconds covered by the trail history. That is the longest
+// trail drawn by the map.
+#define MAX_TRAILTIME 600
+
+// Number of samples in the trail history at the maximum fix rate.
+#define MAX_TRAILSAMPLES (MAX_TRAILTIME * MAX_FIXRATE)
+
+// Minimum duration in seconds of a circling phase, which is stored as
+// thermal.
+#define MIN_THERMAL_DURATION 30
+
+// Search radius in meters of the nearest learned thermal.
+#define THERMAL_SEARCH_RADIUS 10000.0
+
+// Climb rate in m/s of a good thermal, if no McCready value is set.
+#define GOOD_THERMAL_CLIMB 1.0
 
 Calculator *calculator = static_cast<Calculator *> (0);
 
@@ -51,7 +74,8 @@ extern MapMatrix   *_globalMapMatrix;
 
 Calculator::Calculator(QObject* parent) :
   QObject(parent),
-  samplelist( LimitedList<FlightSample>( MAX_SAMPLECOUNT ) )
+  samplelist( MAX_SAMPLETIME ),
+  trailList( MAX_TRAILSAMPLES )
 {
   setObjectName( "Calculator" );
   GeneralConfig *conf = GeneralConfig::instance();
@@ -64,6 +88,7 @@ Calculator::Calculator(QObject* parent) :
   lastGNSSAltitude = manualAltitude;
   lastAHLAltitude  = manualAltitude;
   lastAGLAltitudeError.setMeters(0);
+  lastSample = FlightSample();
 
   lastPosition.setX( conf->getCenterLat() );
   lastPosition.setY( conf->getCenterLon() );
@@ -80,6 +105,8 @@ Calculator::Calculator(QObject* parent) :
   m_calculateETA = false;
   m_calculateVario = true;
   m_calculateTas = true;
+  m_tasTime = -1;
+  m_positionIngestTime = 0;
   m_androidPressureAltitude = false;
   m_calculateWind = true;
   m_lastWind.wind = Vector(0.0, 0.0);
@@ -88,6 +115,8 @@ Calculator::Calculator(QObject* parent) :
   lastMc = GeneralConfig::instance()->getMcCready();
   lastBestSpeed.setInvalid();
   lastTas = 0.0;
+  lastNetto.setInvalid();
+  lastSpeedToFly.setInvalid();
   m_polar = 0;
   m_vario = new Vario (this);
   m_windAnalyser = new WindAnalyser(this);
@@ -104,6 +133,14 @@ Calculator::Calculator(QObject* parent) :
   m_minimumAltitude = INT_MIN;
   m_lastTpPassageState = TaskPoint::Outside;
   m_lastZoomFactor = -1.0;
+  m_hasNearestThermal = false;
+  m_thermalLat = 0;
+  m_thermalLon = 0;
+  m_thermalSamples = 0;
+
+  loadFixRates();
+
+  m_thermalStore.load( ThermalStore::defaultFileName() );
 
   m_resetAutoZoomTimer = new QTimer( this );
   m_resetAutoZoomTimer->setSingleShot( true );
@@ -152,6 +189,11 @@ Calculator::~Calculator()
   // save last position as new center position of the map
   conf->setCenterLat(lastPosition.x());
   conf->setCenterLon(lastPosition.y());
+
+  if( m_thermalStore.isModified() )
+    {
+      m_thermalStore.save( ThermalStore::defaultFileName() );
+    }
 }
 
 /** Read property of Altitude for Altimeter display */
@@ -242,13 +284,23 @@ void Calculator::slot_Speed( Speed& newSpeedValue )
 /** called if a new position-fix has been established. */
 void Calculator::slot_Position( QPoint& newPositionValue )
 {
+  NavBenchmark::Timer timer( NavBenchmark::FixProcessing );
+
   lastGPSPosition = newPositionValue;
+  m_positionIngestTime = GpsNmea::gps->getSentenceIngestTime();
 
   if( ! m_manualInFlight )
     {
       lastPosition = lastGPSPosition;
     }
 
+  if( m_fixRatePolicy.accept( FixRatePolicy::Display ) == false )
+    {
+      // High rate receiver, the position is only stored for the next sample
+      // but not distributed to the display and the navigation calculations.
+      return;
+    }
+
   lastElevation = Altitude( _globalMapContents->findElevation(lastPosition, &lastElevationError) );
   emit newPosition(lastGPSPosition, Calculator::GPS);
   calcDistance();
@@ -257,7 +309,21 @@ void Calculator::slot_Position( QPoint& newPositionValue )
   calcTas();
   calcGlidePath();
   // Calculate List of reachable items
-  m_reachablelist->calculate(false);
+  {
+    NavBenchmark::Timer reachTimer( NavBenchmark::ReachableList );
+    m_reachablelist->calculate(false);
+  }
+  calcGlideFootprint();
+
+  // The contest routes are only flown in the air.
+  if( lastFlightMode == cruising ||
+      lastFlightMode == circlingL || lastFlightMode == circlingR )
+    {
+      NavBenchmark::Timer contestTimer( NavBenchmark::Contest );
+      m_olcOptimizer.addFix( lastPosition );
+    }
+
+  calcNearestThermal();
 }
 
 /** Called if a new waypoint has been selected. If user action is
@@ -522,8 +588,12 @@ void Calculator::calcDistance( bool autoWpSwitch )
           // fetch info show time from config and compute it as milli seconds
           int showTime = GeneralConfig::instance()->getInfoDisplayTime() * 1000;
 
-          WhatsThat *box = new WhatsThat( _globalMainWindow, text,  showTime );
-          box->show();
+          // A flight replay runs without main window.
+          if( _globalMainWindow )
+            {
+              WhatsThat *box = new WhatsThat( _globalMainWindow, text,  showTime );
+              box->show();
+            }
 
           // Reset the task point index of the selected waypoint. That stops
           // the further automatic task point switch.
@@ -551,7 +621,8 @@ void Calculator::calcDistance( bool autoWpSwitch )
 	      // Here we send a notice to the user about the task point switch.
 	      emit taskInfo( tr("TP passed"), true );
 
-	      if( GeneralConfig::instance()->getReportTpSwitch() == true )
+	      if( GeneralConfig::instance()->getReportTpSwitch() == true &&
+	          _globalMainWindow )
 		{
 		  // Show a detailed switch info, if the user has configured that.
 		  TPInfoWidget *tpInfo = new TPInfoWidget( _globalMainWindow );
@@ -564,6 +635,24 @@ void Calculator::calcDistance( bool autoWpSwitch )
 	}
     }
 
+  // The distance to fly ends at the optimized touch point of the task point
+  // figure and not at its center.
+  if( targetWp->taskPointIndex >= 0 )
+    {
+      const enum TaskOptimizer::Target target =
+        GeneralConfig::instance()->getTaskMaximizeAreas() ?
+        TaskOptimizer::MaximumDistance : TaskOptimizer::MinimumDistance;
+
+      m_taskOptimizer.update( tpList, targetWp->taskPointIndex, lastPosition, target );
+
+      if( m_taskOptimizer.isValid() )
+        {
+          QPoint touchPoint = m_taskOptimizer.getTouchPoints().at( targetWp->taskPointIndex );
+
+          curDistance.setKilometers( MapCalc::dist( &lastPosition, &touchPoint ) );
+        }
+    }
+
   lastDistance = curDistance;
   emit newDistance( lastDistance );
 }
@@ -667,7 +756,7 @@ void Calculator::calcLD()
 
   const FlightSample *start = 0;
   const FlightSample *end = &samplelist.at(0);
-  int timeDiff = 0;
+  qint64 timeDiff = 0;
   double distance = 0.0;
   double newCurrentLD = -1.0;
   double newRequiredLD = -1.0;
@@ -682,19 +771,20 @@ void Calculator::calcLD()
   for ( int i = 1; i < samplelist.count(); i++ )
     {
 
-      timeDiff = (samplelist.at(i).time).msecsTo(end->time);
+      timeDiff = end->time - samplelist.at(i).time;
 
       if ( timeDiff >= ldCalcTime * 1000 )
         {
           break;
         }
 
-      // summarize single distances from speed
-      distance += samplelist[i].vector.getSpeed().getMps();
+      // summarize single distances from speed and the sample interval
+      distance += samplelist.at(i).speed *
+                  (samplelist.at(i - 1).time - samplelist.at(i).time) / 1000.0;
 
       // qDebug( "i=%d, dist=%f", i, distance );
       // store start record
-      start = &samplelist[i];
+      start = &samplelist.at(i);
     }
 
   if ( ! start )
@@ -705,7 +795,7 @@ void Calculator::calcLD()
   else
     {
       // calculate altitude difference
-      double altDiff = start->altitude.getMeters() - end->altitude.getMeters();
+      double altDiff = start->altitude - end->altitude;
 
       if ( altDiff <= 0.2 )
         {
@@ -770,7 +860,29 @@ bool Calculator::glidePath(int aLastBearing, Distance aDistance,
       return false;
     }
 
-  //  qDebug("Glider=%s", _glider->type().toLatin1().data());
+  Altitude minimalArrival( GeneralConfig::instance()->getSafetyAltitude().getMeters() );
+  Altitude givenAlt (lastAltitude - Altitude (aElevation) - minimalArrival);
+
+  // the ld is over ground
+  double ld = glideRatio( aLastBearing, bestSpeed );
+
+  arrivalAlt = (givenAlt - (aDistance / ld));
+
+  //qDebug ("ld = %f", ld);
+  //qDebug ("bestSpeed: %f", bestSpeed.getKph());
+  //  qDebug ("lastSpeed: %f", lastSpeed.getKph());
+
+  return true;
+}
+
+/** Calculates the glide ratio over ground in the passed direction */
+double Calculator::glideRatio( int aLastBearing, Speed &bestSpeed )
+{
+  if (!m_polar)
+    {
+      bestSpeed.setInvalid();
+      return 0.0;
+    }
 
   // we use the method described by Bob Hansen
   // get best speed for zero wind V0
@@ -792,23 +904,100 @@ bool Calculator::glidePath(int aLastBearing, Distance aDistance,
   Speed headwind = groundspeed.getSpeed() - airspeed.getSpeed() ;
   //qDebug ("headwind: %f", headwind.getKph());
 
-  Altitude minimalArrival( GeneralConfig::instance()->getSafetyAltitude().getMeters() );
-  Altitude givenAlt (lastAltitude - Altitude (aElevation) - minimalArrival);
-
   // improved speed for wind V1
   speed = m_polar->bestSpeed(headwind, 0.0, lastMc);
   //qDebug ("improved best speed: %f", speed.getKph());
   bestSpeed = speed;
+
   // the ld is over ground, so we take groundspeed
-  double ld =m_polar->bestLD(speed, groundspeed.getSpeed(), 0.0);
+  return m_polar->bestLD(speed, groundspeed.getSpeed(), 0.0);
+}
 
-  arrivalAlt = (givenAlt - (aDistance / ld));
+void Calculator::calcGlideFootprint()
+{
+  if( ! m_polar || ! GeneralConfig::instance()->getMapShowGlideFootprint() )
+    {
+      m_glideFootprint.clear();
+      return;
+    }
 
-  //qDebug ("ld = %f", ld);
-  //qDebug ("bestSpeed: %f", speed.getKph());
-  //  qDebug ("lastSpeed: %f", lastSpeed.getKph());
+  // Where no terrain is known, the ground below the glider is assumed.
+  double ground = lastElevation.isValid() ? lastElevation.getMeters() : 0.0;
 
-  return true;
+  m_glideFootprint.update( lastPosition,
+                           lastAltitude.getMeters(),
+                           ground,
+                           m_polar,
+                           getLastWind(),
+                           lastMc,
+                           (int) GeneralConfig::instance()->getSafetyAltitude().getMeters() );
+}
+
+void Calculator::calcNearestThermal()
+{
+  m_hasNearestThermal = false;
+
+  if( lastFlightMode != cruising ||
+      ! GeneralConfig::instance()->getMapShowThermals() )
+    {
+      return;
+    }
+
+  // A good thermal brings at least the expected climb of the McCready
+  // setting.
+  const double minClimb = lastMc.getMps() > 0.0 ? lastMc.getMps() : GOOD_THERMAL_CLIMB;
+
+  m_hasNearestThermal = m_thermalStore.nearestGoodThermal( lastPosition,
+                                                           minClimb,
+                                                           THERMAL_SEARCH_RADIUS,
+                                                           m_nearestThermal );
+}
+
+void Calculator::recordThermal( const FlightSample& sample )
+{
+  if( lastFlightMode == circlingL || lastFlightMode == circlingR )
+    {
+      m_thermalCentering.addSample( sample, getLastWind() );
+
+      if( m_thermalSamples == 0 )
+        {
+          m_thermalStart = sample;
+          m_thermalLat = 0;
+          m_thermalLon = 0;
+        }
+
+      m_thermalEnd = sample;
+      m_thermalLat += sample.lat;
+      m_thermalLon += sample.lon;
+      m_thermalSamples++;
+      return;
+    }
+
+  if( m_thermalSamples == 0 )
+    {
+      return;
+    }
+
+  // The next circling can be in another thermal.
+  m_thermalCentering.reset();
+
+  const int duration = int( (m_thermalEnd.time - m_thermalStart.time) / 1000 );
+
+  if( duration >= MIN_THERMAL_DURATION )
+    {
+      const QPoint center( int( m_thermalLat / m_thermalSamples ),
+                           int( m_thermalLon / m_thermalSamples ) );
+
+      const double climb = (m_thermalEnd.altitude - m_thermalStart.altitude) / duration;
+
+      m_thermalStore.addThermal( center,
+                                 climb,
+                                 int( m_thermalStart.altitude ),
+                                 int( m_thermalEnd.altitude ),
+                                 QDateTime::fromMSecsSinceEpoch( m_thermalEnd.time ).date().toJulianDay() );
+    }
+
+  m_thermalSamples = 0;
 }
 
 void Calculator::calcGlidePath()
@@ -1110,6 +1299,7 @@ void Calculator::slot_GpsTas(const Speed& tas)
 {
   // We get the TAS from another source. Therefore it must not be calculated by us.
   m_calculateTas = false;
+  m_tasTime = FlightClock::currentMSecsSinceEpoch();
   lastTas.setMps( tas.getMps() );
   emit newTas( lastTas );
 }
@@ -1123,6 +1313,45 @@ void Calculator::slot_Variometer(const Speed& lift)
     {
       lastVario = lift;
       emit newVario (lift);
+      calcSpeedToFly();
+    }
+}
+
+/**
+ * Calculates the netto lift and the speed to fly. The speed to fly is
+ * only provided in cruising flight, when a polar, a variometer value and
+ * a true airspeed are available.
+ */
+void Calculator::calcSpeedToFly()
+{
+  // Speeds are invalid by default.
+  Speed netto;
+  Speed stf;
+
+  if( m_polar && lastVario.isValid() && lastTas.isValid() &&
+      lastTas.getMps() > 0.0 && lastFlightMode == cruising )
+    {
+      netto = m_polar->nettoLift( lastVario, lastTas );
+      stf   = m_polar->speedToFly( netto, lastMc );
+
+      if( stf.getMps() <= 0.0 )
+        {
+          stf.setInvalid();
+        }
+    }
+
+  if( netto.isValid() != lastNetto.isValid() ||
+      ( netto.isValid() && netto != lastNetto ) )
+    {
+      lastNetto = netto;
+      emit newNetto( lastNetto );
+    }
+
+  if( stf.isValid() != lastSpeedToFly.isValid() ||
+      ( stf.isValid() && stf != lastSpeedToFly ) )
+    {
+      lastSpeedToFly = stf;
+      emit newSpeedToFly( lastSpeedToFly );
     }
 }
 
@@ -1162,6 +1391,7 @@ void Calculator::slot_GpsVariometer(const Speed& lift)
     {
       lastVario = lift;
       emit newVario (lift);
+      calcSpeedToFly();
     }
 
   m_varioDataControl->start( 5000 );
@@ -1208,6 +1438,8 @@ void Calculator::slot_settingsChanged()
 
   m_androidPressureAltitude = false;
 
+  loadFixRates();
+
   slot_CheckHomeSiteSelection();
 
   // Update the glider selected by the user.
@@ -1217,6 +1449,8 @@ void Calculator::slot_settingsChanged()
 /** This slot is called by the NMEA interpreter if a new fix has been received.  */
 void Calculator::slot_newFix( const QDateTime& newFixTime )
 {
+  NavBenchmark::Timer timer( NavBenchmark::FixProcessing );
+
   // before we start making samples, let's be sure we have all the
   // data we need for that. So, we wait for the second Fix.
   if (!m_pastFirstFix)
@@ -1225,16 +1459,28 @@ void Calculator::slot_newFix( const QDateTime& newFixTime )
       return;
     }
 
-  // create a new sample structure
-  FlightSample sample;
+  // Measure the fix rate of the receiver and adapt the sample list, that it
+  // covers always the same time span.
+  m_fixRatePolicy.newFix( newFixTime.toMSecsSinceEpoch() );
+
+  int limit = MAX_SAMPLETIME * qMin( m_fixRatePolicy.getFixRateHz(), MAX_FIXRATE );
+
+  if( samplelist.getLimit() != limit )
+    {
+      samplelist.setLimit( limit );
+    }
+
+  // create a new zero initialized sample structure
+  FlightSample sample = FlightSample();
 
   // fill it with the relevant data
-  sample.time = newFixTime;
-  sample.altitude.setMeters(lastAltitude.getMeters());
-  sample.STDAltitude.setMeters(lastSTDAltitude.getMeters());
-  sample.GNSSAltitude.setMeters(lastGNSSAltitude.getMeters());
-  sample.position=lastPosition;
-  sample.vector.setAngleAndSpeed(lastHeading, lastSpeed);
+  sample.time = newFixTime.toMSecsSinceEpoch();
+  sample.altitude = lastAltitude.getMeters();
+  sample.STDAltitude = lastSTDAltitude.getMeters();
+  sample.GNSSAltitude = lastGNSSAltitude.getMeters();
+  sample.setPosition( lastPosition );
+  sample.speed = lastSpeed.getMps();
+  sample.heading = lastHeading;
 
   //qDebug("Direction in sample: %d degrees", int(lastHeading));
   Vector groundspeed (lastHeading, lastSpeed);
@@ -1244,9 +1490,13 @@ void Calculator::slot_newFix( const QDateTime& newFixTime )
   Vector& lastWind = getLastWind();
   Vector airspeed = groundspeed + lastWind;
   // qDebug ("airspeed: %d/%f", airspeed.getAngleDeg(), airspeed.getSpeed().getKph());
-  if ( lastWind.getSpeed().getKph() != 0 )
+  if( hasMeasuredTas() )
+    {
+      sample.airspeed = lastTas.getMps();
+    }
+  else if ( lastWind.getSpeed().getKph() != 0 )
     {
-      sample.airspeed = airspeed.getSpeed();
+      sample.airspeed = airspeed.getSpeed().getMps();
     }
 
   // add to the samplelist
@@ -1257,17 +1507,21 @@ void Calculator::slot_newFix( const QDateTime& newFixTime )
   // Call variometer calculation derived from GPS altitude. Can be switched off,
   // when an external device delivers variometer information derived from a
   // baro sensor.
-  if ( m_calculateVario == true && m_androidPressureAltitude == false )
-    {
-      m_vario->newAltitude();
-    }
-
-  // Call wind analyzer calculation if required. Can be switched off,
-  // when GPS delivers wind information.
-  if ( m_calculateWind == true )
-    {
-      m_windAnalyser->slot_newSample();
-    }
+  {
+    NavBenchmark::Timer windVarioTimer( NavBenchmark::WindVario );
+
+    if ( m_calculateVario == true && m_androidPressureAltitude == false )
+      {
+        m_vario->newAltitude();
+      }
+
+    // Call wind analyzer calculation if required. Can be switched off,
+    // when GPS delivers wind information.
+    if ( m_calculateWind == true )
+      {
+        m_windAnalyser->slot_newSample();
+      }
+  }
 
   // Calculate LD
   calcLD();
@@ -1276,8 +1530,21 @@ void Calculator::slot_newFix( const QDateTime& newFixTime )
   // determine if we are standing still, cruising, circling or doing something else
   determineFlightStatus();
 
+  recordThermal( sample );
+
   // let the world know we have added a new sample to our sample list
   emit newSample();
+
+  if( m_fixRatePolicy.accept( FixRatePolicy::Trail ) )
+    {
+      // The marker is set by the flight status analysis.
+      trailList.add( samplelist.at(0) );
+    }
+
+  if( m_fixRatePolicy.accept( FixRatePolicy::Logger ) )
+    {
+      emit newLoggerSample();
+    }
 }
 
 /** Determines the status of the flight: unknown, standstill, cruising, circlingL, circlingR */
@@ -1341,13 +1608,14 @@ void Calculator::determineFlightStatus()
   FlightMode flightMode = unknown;
 
   // get headings from the last two samples
-  int lastHead = samplelist[0].vector.getAngleDeg();
-  int prevHead = samplelist[1].vector.getAngleDeg();
+  int lastHead = samplelist.at(0).heading;
+  int prevHead = samplelist.at(1).heading;
 
-  // get the time difference between these samples
-  int timediff = samplelist[1].time.secsTo(samplelist[0].time);
+  // get the time difference in seconds between these samples. High rate
+  // receivers deliver fixes in fractions of a second.
+  double timediff = (samplelist.at(0).time - samplelist.at(1).time) / 1000.0;
 
-  if (timediff == 0)
+  if (timediff <= 0.0)
     {
       // If the time difference is 0, return (just to be sure). This will only cause problems...
       return;
@@ -1358,23 +1626,26 @@ void Calculator::determineFlightStatus()
   switch (lastFlightMode)
     {
     case standstill: // we are not moving at all!
-
-      if ( (samplelist[0].position == samplelist[1].position ||
-          ( MapCalc::dist(&samplelist[0].position, &samplelist[1].position) / double(timediff) ) < 0.005) &&
-           lastSpeed.getMps() <= 0.5 )
-        {
-          // may be too ridged, GPS errors could cause problems here
-          return;
-        }
-      else
-        {
-          flightMode = unknown;
-        }
+      {
+        QPoint pos0 = samplelist.at(0).getPosition();
+        QPoint pos1 = samplelist.at(1).getPosition();
+
+        if ( (pos0 == pos1 || ( MapCalc::dist(&pos0, &pos1) / timediff ) < 0.005) &&
+             lastSpeed.getMps() <= 0.5 )
+          {
+            // may be too ridged, GPS errors could cause problems here
+            return;
+          }
+        else
+          {
+            flightMode = unknown;
+          }
+      }
       break;
 
     case cruising: // we are flying from point A to point B
       if (abs(MapCalc::angleDiff(lastHead, m_cruiseDirection)) <=  MAXCRUISEANGDIFF &&
-          samplelist[0].vector.getSpeed().getMps() > 0.5 )
+          samplelist.at(0).speed > 0.5 )
         {
           return;
         }
@@ -1419,13 +1690,11 @@ void Calculator::determineFlightStatus()
       // qDebug() << "Flight mode unknown --> Start Analysis";
 
       // we need some real analysis
-      QDateTime refTime = samplelist[0].time.addSecs(-TIMEFRAME);
-      int samples = 1;
-
-      while ((samplelist[samples].time > refTime) && ( samples < samplelist.count() - 1) )
-        {
-          samples++;
-        }
+      // Index of the first sample at or before the time frame start. The
+      // sample times are monotonic, so that a binary search can be used.
+      qint64 refTime = samplelist.at(0).time - TIMEFRAME * 1000;
+      int samples = qMin( samplelist.countSince( refTime + 1 ),
+                          samplelist.count() - 1 );
 
       if( samples < 2 )
         {
@@ -1442,9 +1711,9 @@ void Calculator::determineFlightStatus()
       int totalDirChange = 0; //total heading change. If cruising, this will be low, if turning, it will be high
       double maxSpeed = 0.0;  //maximum speed obtained in this set of samples
       int angDiff = 0;        //difference in heading between two samples
-      int totalAltChange = 0; //total change in altitude (absolute)
-      int maxAltChange = 0;   //maximum change of altitude between samples.
-      int altChange = 0;
+      double totalAltChange = 0.0; //total change in altitude (absolute)
+      double maxAltChange = 0.0;   //maximum change of altitude between samples.
+      double altChange = 0.0;
       bool break_analysis = false; //flag to indicate we can stop further analysis.
 
       // loop through the samples to get some basic data we can use to distinguish flight modes
@@ -1453,24 +1722,24 @@ void Calculator::determineFlightStatus()
           if( i < (samples - 1) )
             {
               // angDiff can be positive or negative according to the turn direction
-              angDiff = (int) rint(MapCalc::angleDiff( samplelist[i].vector.getAngleDeg(), samplelist[i+1].vector.getAngleDeg() ));
+              angDiff = (int) rint(MapCalc::angleDiff( samplelist.at(i).heading, samplelist.at(i+1).heading ));
 
-              altChange = int( samplelist[i].altitude.getMeters() - samplelist[i+1].altitude.getMeters() );
+              altChange = samplelist.at(i).altitude - samplelist.at(i+1).altitude;
               //qDebug("analysis: position=(%d, %d)", samplelist->at(i)->position.x(),samplelist->at(i)->position.y() );
             }
           else
             {
               angDiff = 0;
-              altChange = 0;
+              altChange = 0.0;
             }
 
           // That is the average value of the direction change in degree.
           // Can be positive or negation.
           totalDirChange += angDiff;
 
-          maxSpeed = qMax( maxSpeed, samplelist[i].vector.getSpeed().getMps() );
+          maxSpeed = qMax( maxSpeed, double( samplelist.at(i).speed ) );
           totalAltChange += altChange;
-          maxAltChange = qMax(abs(altChange), maxAltChange);
+          maxAltChange = qMax(fabs(altChange), maxAltChange);
 
           if ( angDiff > MINTURNANGDIFF )
             {
@@ -1484,12 +1753,12 @@ void Calculator::determineFlightStatus()
 #if 0
           qDebug("#Analysis(%d): angle1=%d, angle2=%d, angDiff=%d, speed=%f, alt1=%f, alt2=%f, altDiff=%d, tac=%d, tdc=%d, Vmax=%f",
                  i,
-                 samplelist[i].vector.getAngleDeg(),
-                 (i < samples - 1) ? samplelist[i+1].vector.getAngleDeg() : 0,
+                 samplelist.at(i).heading,
+                 (i < samples - 1) ? samplelist.at(i+1).heading : 0,
                  angDiff,
-                 samplelist[i].vector.getSpeed().getMps(),
-                 samplelist[i].altitude.getMeters(),
-                 (i < samples - 1) ? samplelist[i+1].altitude.getMeters() : 0,
+                 samplelist.at(i).speed,
+                 samplelist.at(i).altitude,
+                 (i < samples - 1) ? samplelist.at(i+1).altitude : 0,
                  altChange,
                  totalAltChange,
                  totalDirChange,
@@ -1497,6 +1766,15 @@ void Calculator::determineFlightStatus()
 #endif
         }
 
+      // Get the time difference between the first and the last sample.
+      // This might not be the 6 secs we were planning to use at all!
+      timediff = (samplelist.at(0).time - samplelist.at(samples-1).time) / 1000.0;
+
+      if( timediff <= 0.0 )
+        {
+          return;
+        }
+
       // try standstill. We are using a value > 0 because of possible GPS errors.
       /*
         The detection of stand stills may be extended further by checking if the altitude matches the terrain altitude. If not
@@ -1504,8 +1782,8 @@ void Calculator::determineFlightStatus()
       */
       if ( maxSpeed < 0.5 ) // if we get under 0.5m/s for maximum speed, we may be standing still
         {
-          // check if we had any significant altitude changes
-          if ( (abs(totalAltChange) / (samples-1)) <= MAXALTDRIFTAVG )
+          // check if we had any significant altitude changes per second
+          if ( (fabs(totalAltChange) / timediff) <= MAXALTDRIFTAVG )
             {
               flightMode = standstill;
               break_analysis = true;
@@ -1515,10 +1793,6 @@ void Calculator::determineFlightStatus()
 
       if (!break_analysis)
         {
-          // Get the time difference between the first and the last sample.
-          // This might not be the 20 secs we were planning to use at all!
-          timediff = samplelist[samples-1].time.secsTo(samplelist[0].time);
-
           // So, we are not standing still, nor are we cruising. Circling then maybe?
           if ( abs(totalDirChange) > (MINTURNANGDIFF * timediff) )
             {
@@ -1550,13 +1824,19 @@ void Calculator::determineFlightStatus()
           break_analysis = true;
 
           // save current heading for cruise check.
-          m_cruiseDirection = samplelist[0].vector.getAngleDeg();
+          m_cruiseDirection = samplelist.at(0).heading;
           // qDebug("-->Cruise direction: %d.", _cruiseDirection);
         }
     }
 
   if (flightMode != lastFlightMode)
     {
+      if( lastFlightMode == standstill )
+        {
+          // A new flight starts after a standstill.
+          m_olcOptimizer.clear();
+        }
+
       lastFlightMode = flightMode;
       samplelist[0].marker = ++m_marker;
       newFlightMode( flightMode );
@@ -1572,8 +1852,13 @@ void Calculator::slot_GpsStatus(GpsNmea::GpsStatus newState)
 
   if (flightMode != lastFlightMode)
     {
-      lastFlightMode       = flightMode;
-      samplelist[0].marker = ++m_marker;
+      lastFlightMode = flightMode;
+
+      if( ! samplelist.isEmpty() )
+        {
+          samplelist[0].marker = ++m_marker;
+        }
+
       // qDebug("new FlightMode: %d",lastFlightMode);
       newFlightMode(flightMode);
     }
@@ -1584,6 +1869,9 @@ void Calculator::slot_GpsStatus(GpsNmea::GpsStatus newState)
       emit newLD( -1.0, -1.0 );
       // reset first fix passed
       m_pastFirstFix = false;
+
+      // restart the fix rate measurement
+      m_fixRatePolicy.reset();
     }
 
   if( newState == GpsNmea::notConnected )
@@ -1604,6 +1892,9 @@ void Calculator::newFlightMode(Calculator::FlightMode fm)
     }
 
   emit flightModeChanged( fm );
+
+  // The speed to fly is only provided in cruising flight.
+  calcSpeedToFly();
 }
 
 /** Called if a new wind measurement is delivered by the GPS/Logger device */
@@ -1694,6 +1985,10 @@ void Calculator::setGlider(Glider* glider)
       m_polar  = 0;
     }
 
+  // The footprint and the final glide of the old glider are invalid.
+  m_glideFootprint.clear();
+  m_taskGlideSolver.clear();
+
   if (glider)
     {
       m_glider = glider;
@@ -1877,14 +2172,25 @@ bool Calculator::moving()
     }
 
   double speed = 0.0;
+  int cnt = 0;
+
+  qint64 lastTime = samplelist.at(0).time;
 
   // Note, that the newest samples are inserted at the list beginning.
-  for( int i = 0; i < TimeLimit && samplelist.size(); i++ )
+  // The time limit is checked, because a high rate receiver delivers
+  // more than one sample per second.
+  for( int i = 0; i < samplelist.size(); i++ )
     {
-      speed += samplelist[i].vector.getSpeed().getMps();
+      if( lastTime - samplelist.at(i).time >= TimeLimit * 1000 )
+        {
+          break;
+        }
+
+      speed += samplelist.at(i).speed;
+      cnt++;
     }
 
-  if( (speed / double(TimeLimit)) > SpeedLimit )
+  if( cnt > 0 && (speed / double(cnt)) > SpeedLimit )
     {
       return true;
     }
@@ -2008,3 +2314,12 @@ bool Calculator::restoreWaypoint()
 
   return false;
 }
+
+void Calculator::loadFixRates()
+{
+  GeneralConfig *conf = GeneralConfig::instance();
+
+  m_fixRatePolicy.setRate( FixRatePolicy::Trail, conf->getGpsTrailRate() );
+  m_fixRatePolicy.setRate( FixRatePolicy::Logger, conf->getGpsLoggerRate() );
+  m_fixRatePolicy.setRate( FixRatePolicy::Display, conf->getGpsDisplayRate() );
+}
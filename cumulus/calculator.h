@@ -27,14 +27,23 @@
 #include "altitude.h"
 #include "basemapelement.h"
 #include "distance.h"
+#include "fixratepolicy.h"
+#include "flightclock.h"
+#include "flightsample.h"
 #include "flighttask.h"
 #include "generalconfig.h"
+#include "glidefootprint.h"
+#include "olcoptimizer.h"
+#include "thermalcentering.h"
+#include "thermalstore.h"
 #include "glider.h"
 #include "gpsnmea.h"
 #include "limitedlist.h"
 #include "polar.h"
 #include "reachablelist.h"
 #include "speed.h"
+#include "taskglidesolver.h"
+#include "taskoptimizer.h"
 #include "taskpoint.h"
 #include "vario.h"
 #include "vector.h"
@@ -44,65 +53,6 @@
 class ReachableList;
 class WindAnalyser;
 
-/**
- * \class FlightSample
- *
- * \author Andrè Somers, Axel Pauli
- *
- * \brief A single sample from a flight data.
- *
- * This class represents a single sample of flight data obtained.
- *
- * \date 2002-2016
- *
- * \version 1.2
- */
-class FlightSample
-{
-
-public:
-  /**
-   * Position in KFLog format
-   */
-  QPoint position;
-
-  /**
-   * User altitude of point. May be adapted by the user.
-   */
-  Altitude altitude;
-
-  /**
-   * Pressure Altitude of point, if available. Otherwise it is derived from
-   * the GNSSAltitude.
-   */
-  Altitude STDAltitude;
-
-  /**
-   * GPS altitude of point
-   */
-  Altitude GNSSAltitude;
-
-  /**
-   * Speed and direction
-   */
-  Vector vector;
-
-  /**
-   * UTC date and time the sample was taken.
-   */
-  QDateTime time;
-
-  /**
-   * Current airspeed
-   */
-  Speed airspeed;
-
-  /**
-  * Unique marker. Can be used to reference a certain record/sample.
-  */
-  int marker;
-};
-
 /**
  * \class Calculator
  *
@@ -264,6 +214,15 @@ public:
     return lastPosition;
   };
 
+  /**
+   * \return The reception time in microseconds of the sentence, which has
+   *         delivered the last GPS position. See FixLatency.
+   */
+  qint64 getPositionIngestTime() const
+  {
+    return m_positionIngestTime;
+  };
+
   /**
    * Read property of McCready setting
    */
@@ -280,6 +239,16 @@ public:
     return lastTas;
   };
 
+  /**
+   * \return True, if the TAS is delivered by an external device and is
+   *         up to date.
+   */
+  bool hasMeasuredTas() const
+  {
+    return m_calculateTas == false && m_tasTime >= 0 &&
+           FlightClock::elapsed( m_tasTime ) < 5000;
+  };
+
   /**
    * Read property of variometer setting.
    */
@@ -288,6 +257,23 @@ public:
     return lastVario;
   };
 
+  /**
+   * Read property of the netto lift of the air mass.
+   */
+  const Speed& getlastNetto()
+  {
+    return lastNetto;
+  };
+
+  /**
+   * Read property of the speed to fly in the current air mass. It is
+   * invalid, if it cannot be calculated.
+   */
+  const Speed& getlastSpeedToFly()
+  {
+    return lastSpeedToFly;
+  };
+
   /**
    * Returns the last stored wind value.
    */
@@ -324,9 +310,24 @@ public:
   void setPosition(const QPoint& newPos);
 
   /**
-   * Contains a list of samples from the flight
+   * Contains a list of samples from the flight. All received fixes are
+   * stored in it, also these of a high rate receiver.
+   */
+  FlightSampleList samplelist;
+
+  /**
+   * Contains the long time history of the flight, decimated to the trail
+   * rate. It covers a whole flight and is used for the trail drawing.
    */
-  LimitedList<FlightSample> samplelist;
+  FlightSampleList trailList;
+
+  /**
+   * \return The decimation policy of the fix pipeline.
+   */
+  const FixRatePolicy& getFixRatePolicy() const
+  {
+    return m_fixRatePolicy;
+  };
 
   /**
    * Returns the current flight mode
@@ -363,6 +364,12 @@ public:
   bool glidePath(int aLastBearing, Distance aDistance,
                  Altitude aElevation, Altitude &arrival, Speed &BestSpeed );
 
+  /**
+   * \return the glide ratio over ground in the passed direction regarding
+   * wind and McCready or 0.0, if no glider is defined.
+   */
+  double glideRatio( int aLastBearing, Speed &bestSpeed );
+
   /**
    * \return the Glider Polar
    */
@@ -384,6 +391,64 @@ public:
       m_reachablelist->clearLists();
   };
 
+  /**
+   * \return The area, which can be reached in glide from the current position.
+   */
+  const GlideFootprint& getGlideFootprint() const
+  {
+    return m_glideFootprint;
+  };
+
+  /**
+   * \return The contest routes of the current flight.
+   */
+  const OlcOptimizer& getOlcOptimizer() const
+  {
+    return m_olcOptimizer;
+  };
+
+  /**
+   * \return The learned thermals of all flights.
+   */
+  ThermalStore& getThermalStore()
+  {
+    return m_thermalStore;
+  };
+
+  /**
+   * \return The nearest learned thermal, which is good enough for the
+   *         McCready setting. False, if there is none.
+   */
+  bool getNearestThermal( ThermalStore::Hotspot& hotspot ) const
+  {
+    hotspot = m_nearestThermal;
+    return m_hasNearestThermal;
+  };
+
+  /**
+   * \return The estimation of the thermal core during circling.
+   */
+  const ThermalCentering& getThermalCentering() const
+  {
+    return m_thermalCentering;
+  };
+
+  /**
+   * \return The final glide solver of the flight task.
+   */
+  TaskGlideSolver& getTaskGlideSolver()
+  {
+    return m_taskGlideSolver;
+  };
+
+  /**
+   * \return The optimized touch points of the flight task.
+   */
+  const TaskOptimizer& getTaskOptimizer() const
+  {
+    return m_taskOptimizer;
+  };
+
   /**
    * \return the variometer object
    */
@@ -450,9 +515,9 @@ public:
   };
 
   /**
-   * \return The time when the last sample was taken.
+   * \return The UTC time in ms when the last sample was taken.
    */
-  const QDateTime& getLastSampleTime() const
+  qint64 getLastSampleTime() const
   {
     return lastSample.time;
   };
@@ -761,6 +826,17 @@ public:
    */
   void newVario (const Speed&);
 
+  /**
+   * Sent if a new netto lift of the air mass has been calculated
+   */
+  void newNetto (const Speed&);
+
+  /**
+   * Sent if a new speed to fly has been calculated. An invalid speed
+   * is sent, if the speed to fly is no longer available.
+   */
+  void newSpeedToFly (const Speed&);
+
   /**
    * Sent if a new wind has been obtained
    */
@@ -781,6 +857,13 @@ public:
    */
   void newSample();
 
+  /**
+   * Sent if a new sample has passed the logger rate of the fix pipeline.
+   * Is used by the loggers instead of newSample to avoid load caused by
+   * high rate receivers.
+   */
+  void newLoggerSample();
+
   /**
    * Sent to inform the user about the task progress.
    */
@@ -821,6 +904,13 @@ private:
    */
   void calcBearing();
 
+  /**
+   * Calculates the netto lift of the air mass and the speed to fly
+   * from the last variometer and TAS values. The signals newNetto and
+   * newSpeedToFly are emitted, if the values have been changed.
+   */
+  void calcSpeedToFly();
+
   /**
    * Calculates the direction of heading and emits the signal
    * newHeading. This method is only called in the manually mode.
@@ -847,6 +937,22 @@ private:
    */
   void calcGlidePath();
 
+  /**
+   * Calculates the glide range footprint around the current position.
+   */
+  void calcGlideFootprint();
+
+  /**
+   * Searches the nearest good learned thermal during cruising.
+   */
+  void calcNearestThermal();
+
+  /**
+   * Collects the samples of a circling phase for the centering and stores
+   * the phase as thermal, when it is finished.
+   */
+  void recordThermal( const FlightSample& sample );
+
   /**
    * Calculates the current and required LD to the selected waypoint
    */
@@ -874,6 +980,11 @@ private:
    */
   void autoZoomInMap();
 
+  /**
+   * Loads the configured stage rates into the fix rate policy.
+   */
+  void loadFixRates();
+
 private: // Private attributes
   /** Contains the last flight sample */
   FlightSample lastSample;
@@ -897,8 +1008,17 @@ private: // Private attributes
   Speed lastTas;
   /** contains the current state of TAS calculation */
   bool m_calculateTas;
+  /** Flight clock time in ms of the last TAS of an external device */
+  qint64 m_tasTime;
+
+  /** Reception time of the sentence with the last GPS position. */
+  qint64 m_positionIngestTime;
   /** Contains the last variometer value */
   Speed lastVario;
+  /** Contains the last netto lift of the air mass */
+  Speed lastNetto;
+  /** Contains the last speed to fly */
+  Speed lastSpeedToFly;
   /** Contains the last known glide path information */
   Altitude lastGlidePath;
   /** Contains the last known altitude */
@@ -957,12 +1077,36 @@ private: // Private attributes
   WindAnalyser* m_windAnalyser;
   /** contains functions to analyze the wind */
   ReachableList* m_reachablelist;
+  /** Area, which can be reached in glide */
+  GlideFootprint m_glideFootprint;
+  /** Contest optimization of the current flight */
+  OlcOptimizer m_olcOptimizer;
+  /** Learned thermals of all flights */
+  ThermalStore m_thermalStore;
+  /** Nearest good learned thermal */
+  ThermalStore::Hotspot m_nearestThermal;
+  bool m_hasNearestThermal;
+  /** First and last sample of the current circling phase */
+  FlightSample m_thermalStart;
+  FlightSample m_thermalEnd;
+  /** Position sums and number of samples of the current circling phase */
+  qint64 m_thermalLat;
+  qint64 m_thermalLon;
+  int m_thermalSamples;
+  /** Estimation of the thermal core */
+  ThermalCentering m_thermalCentering;
+  /** Final glide calculation along the flight task */
+  TaskGlideSolver m_taskGlideSolver;
+  /** Optimized touch points of the flight task */
+  TaskOptimizer m_taskOptimizer;
   /** maintains wind measurements and returns new wind values */
   WindStore* m_windStore;
   /** Info on the selected glider. */
   Glider* m_glider;
   /** Did we already receive a complete sentence? */
   bool m_pastFirstFix;
+  /** Decimation policy of the fix pipeline for high rate receivers. */
+  FixRatePolicy m_fixRatePolicy;
   /** Direction of cruise if we are in cruising mode */
   int m_cruiseDirection;
   /** the index of the selected taskpoint in the flight task list. */
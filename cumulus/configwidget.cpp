@@ -350,6 +350,10 @@ void ConfigWidget::slotPageClicked( QTreeWidgetItem* item, int column )
       connect( page, SIGNAL(settingsChanged()),
                GpsNmea::gps, SLOT(slot_reset()) );
 
+      // The fix rates of the calculator must be updated.
+      connect( page, SIGNAL(settingsChanged()),
+               MainWindow::mainWindow(), SLOT( slotReadconfig() ) );
+
       connect( page, SIGNAL(startNmeaLog()),
                GpsNmea::gps, SLOT(slot_openNmeaLogFile()) );
 
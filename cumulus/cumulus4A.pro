@@ -142,13 +142,23 @@ HEADERS = \
     CuLabel.h \
     datatypes.h \
     distance.h \
+    elevationgrid.h \
     elevationcolorimage.h \
     filetools.h \
+    fixlatency.h \
+    fixratepolicy.h \
+    flightanalysis.h \
+    flightclock.h \
+    flightreplay.h \
+    flightsample.h \
     flighttask.h \
     fontdialog.h \
     generalconfig.h \
     gliderflightdialog.h \
     glider.h \
+    glidefootprint.h \
+    taskglidesolver.h \
+    taskoptimizer.h \
     gliderlistwidget.h \
     GliderSelectionList.h \
     gpsconandroid.h \
@@ -157,9 +167,12 @@ HEADERS = \
     helpbrowser.h \
     hwinfo.h \
     igclogger.h \
+    igcparser.h \
+    igcwriter.h \
     interfaceelements.h \
     isohypse.h \
     isolist.h \
+    latencyhistogram.h \
     jnisupport.h \
     layout.h \
     limitedlist.h \
@@ -177,13 +190,17 @@ HEADERS = \
     mapinfobox.h \
     mapmatrix.h \
     mapview.h \
+    pointindex.h \
     messagehandler.h \
     messagewidget.h \
     multilayout.h \
+    navbenchmark.h \
+    olcoptimizer.h \
     OpenAip.h \
     OpenAipLoaderThread.h \
     OpenAipPoiLoader.h \
     openairparser.h \
+    perftrace.h \
     PointListView.h \
     polardialog.h \
     polar.h \
@@ -202,9 +219,11 @@ HEADERS = \
     radiopoint.h \
     RadioPointListWidget.h \
     reachablelist.h \
+    reachtable.h \
     reachablepoint.h \
     reachpointlistview.h \
     resource.h \
+    ringbuffer.h \
     rowdelegate.h \
     runway.h \
     SinglePointListWidget.h \
@@ -235,6 +254,8 @@ HEADERS = \
     taskline.h \
     tasklistview.h \
     taskpoint.h \
+    thermalcentering.h \
+    thermalstore.h \
     taskpointeditor.h \
     taskpointtypes.h \
     time_cu.h \
@@ -251,6 +272,7 @@ HEADERS = \
     wgspoint.h \
     whatsthat.h \
     windanalyser.h \
+    windfit.h \
     windmeasurementlist.h \
     windstore.h \
     wpeditdialog.h \
@@ -277,12 +299,21 @@ SOURCES = \
     configwidget.cpp \
     CuLabel.cpp \
     distance.cpp \
+    elevationgrid.cpp \
     elevationcolorimage.cpp \
     filetools.cpp \
+    fixlatency.cpp \
+    fixratepolicy.cpp \
+    flightanalysis.cpp \
+    flightclock.cpp \
+    flightreplay.cpp \
     flighttask.cpp \
     fontdialog.cpp \
     generalconfig.cpp \
     glider.cpp \
+    glidefootprint.cpp \
+    taskglidesolver.cpp \
+    taskoptimizer.cpp \
     gliderflightdialog.cpp \
     gliderlistwidget.cpp \
     GliderSelectionList.cpp \
@@ -292,8 +323,11 @@ SOURCES = \
     helpbrowser.cpp \
     hwinfo.cpp \
     igclogger.cpp \
+    igcparser.cpp \
+    igcwriter.cpp \
     isohypse.cpp \
     isolist.cpp \
+    latencyhistogram.cpp \
     jnisupport.cpp \
     layout.cpp \
     lineelement.cpp \
@@ -310,12 +344,16 @@ SOURCES = \
     mapinfobox.cpp \
     mapmatrix.cpp \
     mapview.cpp \
+    pointindex.cpp \
     messagehandler.cpp \
     messagewidget.cpp \
+    navbenchmark.cpp \
+    olcoptimizer.cpp \
     OpenAip.cpp \
     OpenAipLoaderThread.cpp \
     OpenAipPoiLoader.cpp \
     openairparser.cpp \
+    perftrace.cpp \
     PointListView.cpp \
     polar.cpp \
     polardialog.cpp \
@@ -333,6 +371,7 @@ SOURCES = \
     radiopoint.cpp \
     RadioPointListWidget.cpp \
     reachablelist.cpp \
+    reachtable.cpp \
     reachablepoint.cpp \
     reachpointlistview.cpp \
     rowdelegate.cpp \
@@ -364,6 +403,8 @@ SOURCES = \
     taskline.cpp \
     tasklistview.cpp \
     taskpoint.cpp \
+    thermalcentering.cpp \
+    thermalstore.cpp \
     taskpointeditor.cpp \
     time_cu.cpp \
     tpinfowidget.cpp \
@@ -379,6 +420,7 @@ SOURCES = \
     wgspoint.cpp \
     whatsthat.cpp \
     windanalyser.cpp \
+    windfit.cpp \
     windmeasurementlist.cpp \
     windstore.cpp \
     wpeditdialog.cpp \
@@ -392,6 +434,7 @@ flarm {
     HEADERS += flarm.h \
                flarmaliaslist.h \
                flarmbase.h \
+               flarmcollisionpredictor.h \
                flarmbincom.h \
                flarmbincomandroid.h \
                flarmcrc.h \
@@ -399,6 +442,7 @@ flarm {
                flarmlistview.h \
                flarmlogbook.h \
                flarmradarview.h \
+               flarmtraffic.h \
                flarmwidget.h \
                preflightflarmpage.h \
 							 preflightflarmusbpage.h \
@@ -407,6 +451,7 @@ flarm {
     SOURCES += flarm.cpp \
                flarmaliaslist.cpp \
                flarmbase.cpp \
+               flarmcollisionpredictor.cpp \
                flarmbincom.cpp \
                flarmbincomandroid.cpp \
                flarmcrc.cpp \
@@ -414,6 +459,7 @@ flarm {
                flarmlistview.cpp \
                flarmlogbook.cpp \
                flarmradarview.cpp \
+               flarmtraffic.cpp \
                flarmwidget.cpp \
                preflightflarmpage.cpp \
                preflightflarmusbpage.cpp \
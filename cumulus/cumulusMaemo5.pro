@@ -64,13 +64,23 @@ HEADERS = \
     CuLabel.h \
     datatypes.h \
     distance.h \
+    elevationgrid.h \
     elevationcolorimage.h \
     filetools.h \
+    fixlatency.h \
+    fixratepolicy.h \
+    flightanalysis.h \
+    flightclock.h \
+    flightreplay.h \
+    flightsample.h \
     flighttask.h \
     fontdialog.h \
     generalconfig.h \
     gliderflightdialog.h \
     glider.h \
+    glidefootprint.h \
+    taskglidesolver.h \
+    taskoptimizer.h \
     gliderlistwidget.h \
     GliderSelectionList.h \
     gpscon.h \
@@ -79,10 +89,13 @@ HEADERS = \
     helpbrowser.h \
     hwinfo.h \
     igclogger.h \
+    igcparser.h \
+    igcwriter.h \
     interfaceelements.h \
     ipc.h \
     isohypse.h \
     isolist.h \
+    latencyhistogram.h \
     layout.h \
     limitedlist.h \
     lineelement.h \
@@ -100,13 +113,17 @@ HEADERS = \
     mapinfobox.h \
     mapmatrix.h \
     mapview.h \
+    pointindex.h \
     messagehandler.h \
     messagewidget.h \
     multilayout.h \
+    navbenchmark.h \
+    olcoptimizer.h \
     OpenAip.h \
     OpenAipLoaderThread.h \
     OpenAipPoiLoader.h \
     openairparser.h \
+    perftrace.h \
     PointListView.h \
     polardialog.h \
     polar.h \
@@ -124,9 +141,11 @@ HEADERS = \
     radiopoint.h \
     RadioPointListWidget.h \
     reachablelist.h \
+    reachtable.h \
     reachablepoint.h \
     reachpointlistview.h \
     resource.h \
+    ringbuffer.h \
     rowdelegate.h \
     runway.h \
     SinglePointListWidget.h \
@@ -159,6 +178,8 @@ HEADERS = \
     taskpointeditor.h \
     taskpointtypes.h \
     taskpoint.h \
+    thermalcentering.h \
+    thermalstore.h \
     time_cu.h \
     tpinfowidget.h \
     vario.h \
@@ -174,6 +195,7 @@ HEADERS = \
     wgspoint.h \
     whatsthat.h \
     windanalyser.h \
+    windfit.h \
     windmeasurementlist.h \
     windstore.h \
     wpeditdialog.h \
@@ -199,12 +221,21 @@ SOURCES = \
     configwidget.cpp \
     CuLabel.cpp \
     distance.cpp \
+    elevationgrid.cpp \
     elevationcolorimage.cpp \
     filetools.cpp \
+    fixlatency.cpp \
+    fixratepolicy.cpp \
+    flightanalysis.cpp \
+    flightclock.cpp \
+    flightreplay.cpp \
     flighttask.cpp \
     fontdialog.cpp \
     generalconfig.cpp \
     glider.cpp \
+    glidefootprint.cpp \
+    taskglidesolver.cpp \
+    taskoptimizer.cpp \
     gliderflightdialog.cpp \
     gliderlistwidget.cpp \
     GliderSelectionList.cpp \
@@ -214,9 +245,12 @@ SOURCES = \
     helpbrowser.cpp \
     hwinfo.cpp \
     igclogger.cpp \
+    igcparser.cpp \
+    igcwriter.cpp \
     ipc.cpp \
     isohypse.cpp \
     isolist.cpp \
+    latencyhistogram.cpp \
     layout.cpp \
     lineelement.cpp \
     listviewfilter.cpp \
@@ -233,12 +267,16 @@ SOURCES = \
     mapinfobox.cpp \
     mapmatrix.cpp \
     mapview.cpp \
+    pointindex.cpp \
     messagehandler.cpp \
     messagewidget.cpp \
+    navbenchmark.cpp \
+    olcoptimizer.cpp \
     OpenAip.cpp \
     OpenAipLoaderThread.cpp \
     OpenAipPoiLoader.cpp \
     openairparser.cpp \
+    perftrace.cpp \
     PointListView.cpp \
     polar.cpp \
     polardialog.cpp \
@@ -255,6 +293,7 @@ SOURCES = \
     radiopoint.cpp \
     RadioPointListWidget.cpp \
     reachablelist.cpp \
+    reachtable.cpp \
     reachablepoint.cpp \
     reachpointlistview.cpp \
     rowdelegate.cpp \
@@ -286,6 +325,8 @@ SOURCES = \
     taskline.cpp \
     tasklistview.cpp \
     taskpoint.cpp \
+    thermalcentering.cpp \
+    thermalstore.cpp \
     taskpointeditor.cpp \
     time_cu.cpp \
     tpinfowidget.cpp \
@@ -302,6 +343,7 @@ SOURCES = \
     wgspoint.cpp \
     whatsthat.cpp \
     windanalyser.cpp \
+    windfit.cpp \
     windmeasurementlist.cpp \
     windstore.cpp \
     wpeditdialog.cpp \
@@ -313,10 +355,12 @@ flarm {
     HEADERS += flarm.h \
                flarmaliaslist.h \
                flarmbase.h \
+               flarmcollisionpredictor.h \
                flarmdisplay.h \
                flarmlistview.h \
                flarmlogbook.h \
                flarmradarview.h \
+               flarmtraffic.h \
                flarmwidget.h \
                preflightflarmpage.h
                
@@ -324,10 +368,12 @@ flarm {
     SOURCES += flarm.cpp \
                flarmaliaslist.cpp \
                flarmbase.cpp \
+               flarmcollisionpredictor.cpp \
                flarmdisplay.cpp \
                flarmlistview.cpp \
                flarmlogbook.cpp \
                flarmradarview.cpp \
+               flarmtraffic.cpp \
                flarmwidget.cpp \
                preflightflarmpage.cpp               
                
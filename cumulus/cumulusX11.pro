@@ -113,13 +113,23 @@ HEADERS = \
     CuLabel.h \
     datatypes.h \
     distance.h \
+    elevationgrid.h \
     elevationcolorimage.h \
     filetools.h \
+    fixlatency.h \
+    fixratepolicy.h \
+    flightanalysis.h \
+    flightclock.h \
+    flightreplay.h \
+    flightsample.h \
     flighttask.h \
     fontdialog.h \
     generalconfig.h \
     gliderflightdialog.h \
     glider.h \
+    glidefootprint.h \
+    taskglidesolver.h \
+    taskoptimizer.h \
     gliderlistwidget.h \
     GliderSelectionList.h \
     gpscon.h \
@@ -128,10 +138,13 @@ HEADERS = \
     helpbrowser.h \
     hwinfo.h \
     igclogger.h \
+    igcparser.h \
+    igcwriter.h \
     interfaceelements.h \
     ipc.h \
     isohypse.h \
     isolist.h \
+    latencyhistogram.h \
     layout.h \
     limitedlist.h \
     lineelement.h \
@@ -148,13 +161,17 @@ HEADERS = \
     mapinfobox.h \
     mapmatrix.h \
     mapview.h \
+    pointindex.h \
     messagehandler.h \
     messagewidget.h \
     multilayout.h \
+    navbenchmark.h \
+    olcoptimizer.h \
     OpenAip.h \
     OpenAipPoiLoader.h \
     OpenAipLoaderThread.h \
     openairparser.h \
+    perftrace.h \
     PointListView.h \
     polardialog.h \
     polar.h \
@@ -172,9 +189,11 @@ HEADERS = \
     radiopoint.h \
     RadioPointListWidget.h \
     reachablelist.h \
+    reachtable.h \
     reachablepoint.h \
     reachpointlistview.h \
     resource.h \
+    ringbuffer.h \
     rowdelegate.h \
     runway.h \
     SinglePointListWidget.h \
@@ -206,6 +225,8 @@ HEADERS = \
     tasklistview.h \
     taskpointeditor.h \
     taskpoint.h \
+    thermalcentering.h \
+    thermalstore.h \
     taskpointtypes.h \
     time_cu.h \
     tpinfowidget.h \
@@ -221,6 +242,7 @@ HEADERS = \
     wgspoint.h \
     whatsthat.h \
     windanalyser.h \
+    windfit.h \
     windmeasurementlist.h \
     windstore.h \
     wpeditdialog.h \
@@ -246,12 +268,21 @@ SOURCES = \
     configwidget.cpp \
     CuLabel.cpp \
     distance.cpp \
+    elevationgrid.cpp \
     elevationcolorimage.cpp \
     filetools.cpp \
+    fixlatency.cpp \
+    fixratepolicy.cpp \
+    flightanalysis.cpp \
+    flightclock.cpp \
+    flightreplay.cpp \
     flighttask.cpp \
     fontdialog.cpp \
     generalconfig.cpp \
     glider.cpp \
+    glidefootprint.cpp \
+    taskglidesolver.cpp \
+    taskoptimizer.cpp \
     gliderflightdialog.cpp \
     gliderlistwidget.cpp \
     GliderSelectionList.cpp \
@@ -261,9 +292,12 @@ SOURCES = \
     helpbrowser.cpp \
     hwinfo.cpp \
     igclogger.cpp \
+    igcparser.cpp \
+    igcwriter.cpp \
     ipc.cpp \
     isohypse.cpp \
     isolist.cpp \
+    latencyhistogram.cpp \
     layout.cpp \
     lineelement.cpp \
     listviewfilter.cpp \
@@ -279,12 +313,16 @@ SOURCES = \
     mapinfobox.cpp \
     mapmatrix.cpp \
     mapview.cpp \
+    pointindex.cpp \
     messagehandler.cpp \
     messagewidget.cpp \
+    navbenchmark.cpp \
+    olcoptimizer.cpp \
     OpenAip.cpp \
     OpenAipPoiLoader.cpp \
     OpenAipLoaderThread.cpp \
     openairparser.cpp \
+    perftrace.cpp \
     PointListView.cpp \
     polar.cpp \
     polardialog.cpp \
@@ -301,6 +339,7 @@ SOURCES = \
     radiopoint.cpp \
     RadioPointListWidget.cpp \
     reachablelist.cpp \
+    reachtable.cpp \
     reachablepoint.cpp \
     reachpointlistview.cpp \
     rowdelegate.cpp \
@@ -332,6 +371,8 @@ SOURCES = \
     taskline.cpp \
     tasklistview.cpp \
     taskpoint.cpp \
+    thermalcentering.cpp \
+    thermalstore.cpp \
     taskpointeditor.cpp \
     time_cu.cpp \
     tpinfowidget.cpp \
@@ -347,6 +388,7 @@ SOURCES = \
     wgspoint.cpp \
     whatsthat.cpp \
     windanalyser.cpp \
+    windfit.cpp \
     windmeasurementlist.cpp \
     windstore.cpp \
     wpeditdialog.cpp \
@@ -360,10 +402,12 @@ flarm {
 		HEADERS += flarm.h \
 		           flarmaliaslist.h \
 		           flarmbase.h \
+		           flarmcollisionpredictor.h \
 		           flarmdisplay.h \
 		           flarmlistview.h \
 		           flarmlogbook.h \
 		           flarmradarview.h \
+		           flarmtraffic.h \
 		           flarmwidget.h \
                preflightflarmpage.h \
                preflightflarmusbpage.h \
@@ -372,10 +416,12 @@ flarm {
 		SOURCES += flarm.cpp \
 		           flarmaliaslist.cpp \
 		           flarmbase.cpp \
+		           flarmcollisionpredictor.cpp \
 		           flarmdisplay.cpp \
 		           flarmlistview.cpp \
                flarmlogbook.cpp \
 		           flarmradarview.cpp \
+		           flarmtraffic.cpp \
 		           flarmwidget.cpp \
                preflightflarmpage.cpp \
                preflightflarmusbpage.cpp \
@@ -0,0 +1,321 @@
+/***********************************************************************
+**
+**   elevationgrid.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+
+#include <QtCore>
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+
+#include "elevationgrid.h"
+#include "isohypse.h"
+#include "mapcalc.h"
+#include "mapcontents.h"
+#include "mapmatrix.h"
+#include "perftrace.h"
+
+extern MapContents *_globalMapContents;
+extern MapMatrix   *_globalMapMatrix;
+
+// Additional part of the radius, which is covered by a new built grid, so
+// that it must not be rebuilt at every position change.
+#define AREA_MARGIN 1.25
+
+ElevationGrid::ElevationGrid() :
+  m_cellSize(MinCellSize),
+  m_width(0),
+  m_height(0),
+  m_isoMapVersion(0),
+  m_version(0)
+{
+  m_levels[0] = 0;
+
+  // The real elevation is between the isohypse level and the next one,
+  // therefore the middle of the band is taken.
+  for( int i = 1; i < 256; i++ )
+    {
+      int lower = MapContents::getIsoLevel( i - 1 );
+      int upper = (i < ISO_LINE_LEVELS) ? MapContents::getIsoLevel( i ) : lower + 250;
+
+      m_levels[i] = (lower + upper) / 2;
+    }
+}
+
+ElevationGrid::~ElevationGrid()
+{
+}
+
+bool ElevationGrid::update( const QPoint& center, const double radius )
+{
+  if( ! _globalMapContents || ! _globalMapMatrix )
+    {
+      return false;
+    }
+
+  QRect needed = _globalMapMatrix->wgsToMap( MapCalc::areaBox( center, radius ) ).normalized();
+
+  if( m_isoMapVersion == _globalMapContents->getIsoMapVersion() &&
+      m_area.contains( needed ) )
+    {
+      return isValid();
+    }
+
+  PerfTrace::Scope scope( "Elevation grid build" );
+
+  build( _globalMapMatrix->wgsToMap( MapCalc::areaBox( center, radius * AREA_MARGIN ) ).normalized() );
+
+  return isValid();
+}
+
+void ElevationGrid::build( const QRect& area )
+{
+  clear();
+
+  m_area = area;
+  m_isoMapVersion = _globalMapContents->getIsoMapVersion();
+  m_version++;
+
+  int side = qMax( area.width(), area.height() );
+
+  m_cellSize = qMax( int(MinCellSize), (side + MaxCells - 1) / MaxCells );
+  m_width    = area.width() / m_cellSize + 1;
+  m_height   = area.height() / m_cellSize + 1;
+
+  QImage image( m_width, m_height, QImage::Format_RGB32 );
+  image.fill( 0 );
+
+  QPainter painter( &image );
+  painter.setPen( Qt::NoPen );
+  painter.scale( 1.0 / m_cellSize, 1.0 / m_cellSize );
+  painter.translate( -area.left(), -area.top() );
+
+  int drawn = 0;
+
+  const QMap<int, QList<Isohypse> >* isoMaps[2] =
+    { &_globalMapContents->getGroundMap(), &_globalMapContents->getTerrainMap() };
+
+  for( int i = 0; i < 2; i++ )
+    {
+      QMapIterator<int, QList<Isohypse> > it( *isoMaps[i] );
+
+      while( it.hasNext() )
+        {
+          // The isoline list of a tile is in ascending order, so that the
+          // higher levels overwrite the lower ones.
+          it.next();
+
+          const QList<Isohypse>& isoList = it.value();
+
+          for( int j = 0; j < isoList.size(); j++ )
+            {
+              const Isohypse& iso = isoList.at(j);
+
+              if( iso.getProjectedPolygon().size() < 3 ||
+                  ! iso.getProjectedBoundingBox().intersects( area ) )
+                {
+                  continue;
+                }
+
+              // The red channel contains the elevation index plus one.
+              painter.setBrush( QColor( qMin( iso.getElevationIndex() + 1, 255 ), 0, 0 ) );
+              painter.drawPolygon( iso.getProjectedPolygon() );
+              drawn++;
+            }
+        }
+    }
+
+  painter.end();
+
+  if( drawn == 0 )
+    {
+      // No terrain data available in this area.
+      m_cells.clear();
+      return;
+    }
+
+  m_cells.resize( m_width * m_height );
+
+  uchar* cells = m_cells.data();
+
+  for( int y = 0; y < m_height; y++ )
+    {
+      const QRgb* line = reinterpret_cast<const QRgb *> (image.constScanLine( y ));
+
+      for( int x = 0; x < m_width; x++ )
+        {
+          *cells++ = static_cast<uchar> (qRed( line[x] ));
+        }
+    }
+}
+
+int ElevationGrid::elevation( const QPoint& projPos ) const
+{
+  if( m_cells.isEmpty() )
+    {
+      return INT_MIN;
+    }
+
+  int x = (projPos.x() - m_area.left()) / m_cellSize;
+  int y = (projPos.y() - m_area.top()) / m_cellSize;
+
+  if( x < 0 || x >= m_width || y < 0 || y >= m_height )
+    {
+      return INT_MIN;
+    }
+
+  uchar value = m_cells.at( y * m_width + x );
+
+  return (value == 0) ? INT_MIN : m_levels[value];
+}
+
+void ElevationGrid::minClearances( const QVector<GlideLine>& lines,
+                                   QVector<int>& clearances ) const
+{
+  clearances.resize( lines.size() );
+
+  const uchar* cells = m_cells.constData();
+  const int left = m_area.left();
+  const int top  = m_area.top();
+
+  for( int i = 0; i < lines.size(); i++ )
+    {
+      const GlideLine& line = lines.at(i);
+
+      clearances[i] = NoTerrain;
+
+      if( m_cells.isEmpty() )
+        {
+          continue;
+        }
+
+      int dx = line.end.x() - line.start.x();
+      int dy = line.end.y() - line.start.y();
+
+      // One sample per passed grid cell.
+      int samples = qMax( abs( dx ), abs( dy ) ) / m_cellSize;
+
+      if( samples < 1 )
+        {
+          continue;
+        }
+
+      int checked = samples - static_cast<int> (samples * line.skip);
+
+      // Position in cell units with 16 bits fraction.
+      int fx = static_cast<int> (qint64( line.start.x() - left ) * 65536 / m_cellSize);
+      int fy = static_cast<int> (qint64( line.start.y() - top ) * 65536 / m_cellSize);
+
+      const int stepX = static_cast<int> (qint64( dx ) * 65536 / (m_cellSize * samples));
+      const int stepY = static_cast<int> (qint64( dy ) * 65536 / (m_cellSize * samples));
+
+      float alt = line.startAlt;
+      const float stepAlt = (line.endAlt - line.startAlt) / samples;
+
+      float minClearance = float(NoTerrain);
+
+      for( int k = 0; k <= checked; k++ )
+        {
+          int x = fx >> 16;
+          int y = fy >> 16;
+
+          if( x >= 0 && x < m_width && y >= 0 && y < m_height )
+            {
+              uchar value = cells[y * m_width + x];
+
+              if( value != 0 )
+                {
+                  minClearance = qMin( minClearance, alt - m_levels[value] );
+                }
+            }
+
+          fx  += stepX;
+          fy  += stepY;
+          alt += stepAlt;
+        }
+
+      if( minClearance < float(NoTerrain) )
+        {
+          clearances[i] = static_cast<int> (floor( minClearance ));
+        }
+    }
+}
+
+int ElevationGrid::profile( const QPoint& start,
+                            const QPoint& end,
+                            QVector<int>& elevations ) const
+{
+  elevations.clear();
+
+  if( m_cells.isEmpty() )
+    {
+      return 0;
+    }
+
+  int dx = end.x() - start.x();
+  int dy = end.y() - start.y();
+
+  int samples = qMax( abs( dx ), abs( dy ) ) / m_cellSize;
+
+  if( samples < 1 )
+    {
+      return 0;
+    }
+
+  elevations.resize( samples + 1 );
+
+  int* result = elevations.data();
+
+  // Position in cell units with 16 bits fraction.
+  int fx = static_cast<int> (qint64( start.x() - m_area.left() ) * 65536 / m_cellSize);
+  int fy = static_cast<int> (qint64( start.y() - m_area.top() ) * 65536 / m_cellSize);
+
+  const int stepX = static_cast<int> (qint64( dx ) * 65536 / (m_cellSize * samples));
+  const int stepY = static_cast<int> (qint64( dy ) * 65536 / (m_cellSize * samples));
+
+  for( int k = 0; k <= samples; k++ )
+    {
+      int x = fx >> 16;
+      int y = fy >> 16;
+
+      int elevation = INT_MIN;
+
+      if( x >= 0 && x < m_width && y >= 0 && y < m_height )
+        {
+          uchar value = m_cells.at( y * m_width + x );
+
+          if( value != 0 )
+            {
+              elevation = m_levels[value];
+            }
+        }
+
+      result[k] = elevation;
+
+      fx += stepX;
+      fy += stepY;
+    }
+
+  return samples;
+}
+
+void ElevationGrid::clear()
+{
+  m_cells.clear();
+  m_area = QRect();
+  m_width = 0;
+  m_height = 0;
+}
@@ -0,0 +1,182 @@
+/***********************************************************************
+**
+**   elevationgrid.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class ElevationGrid
+ *
+ * \brief Raster of the terrain elevation for fast lookups.
+ *
+ * The terrain is only available as isohypse polygons. A point in polygon
+ * test over all isohypses is much too slow to sample a lot of glide lines.
+ * Therefore the loaded isohypses are rasterized once into a grid of
+ * elevation indices around the current position. A lookup is then a simple
+ * array access. The grid is rebuilt, if the position leaves the covered area
+ * or if the loaded map data have been changed.
+ *
+ * The elevation of a cell is the middle of its isohypse band, like it is done
+ * by MapContents::findElevation().
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef ELEVATION_GRID_H
+#define ELEVATION_GRID_H
+
+#include <climits>
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+
+class ElevationGrid
+{
+ public:
+
+  /** A glide line to be checked against the terrain. */
+  struct GlideLine
+  {
+    /** Projected start point of the line. */
+    QPoint start;
+
+    /** Projected end point of the line. */
+    QPoint end;
+
+    /** Altitude MSL in meters at the start of the line. */
+    float startAlt;
+
+    /** Altitude MSL in meters at the end of the line. */
+    float endAlt;
+
+    /** Part of the line at its end in the range 0...1, which is not checked. */
+    float skip;
+  };
+
+  /** Clearance value, if no terrain is known along a line. */
+  static const int NoTerrain = INT_MAX;
+
+  ElevationGrid();
+
+  virtual ~ElevationGrid();
+
+  /**
+   * Checks, if the grid covers the passed area and if it is up to date.
+   * Otherwise the grid is rebuilt.
+   *
+   * \param center Center of the area in KFLog coordinates.
+   *
+   * \param radius Radius of the area in kilometers.
+   *
+   * \return True, if terrain data are available.
+   */
+  bool update( const QPoint& center, const double radius );
+
+  /**
+   * \return True, if the grid contains terrain data.
+   */
+  bool isValid() const
+  {
+    return ! m_cells.isEmpty();
+  };
+
+  /**
+   * \return A counter, which is incremented at every rebuild of the grid.
+   */
+  uint version() const
+  {
+    return m_version;
+  };
+
+  /**
+   * \param projPos Projected map position.
+   *
+   * \return The elevation in meters or INT_MIN, if the elevation is unknown.
+   */
+  int elevation( const QPoint& projPos ) const;
+
+  /**
+   * Calculates the minimum vertical clearance between the glide lines and the
+   * terrain. All lines are sampled in one pass with a fixed point stepping of
+   * one sample per grid cell.
+   *
+   * \param lines Glide lines to be checked.
+   *
+   * \param clearances Minimum clearance in meters of every line. Is set to
+   *                   NoTerrain, if no terrain is known along the line.
+   */
+  void minClearances( const QVector<GlideLine>& lines,
+                      QVector<int>& clearances ) const;
+
+  /**
+   * Samples the terrain along a projected line with one sample per passed
+   * grid cell, starting at the start point.
+   *
+   * \param start Projected start point of the line.
+   *
+   * \param end Projected end point of the line.
+   *
+   * \param elevations Elevations in meters of the samples. Unknown elevations
+   *                   are set to INT_MIN.
+   *
+   * \return The number of sample intervals. The elevation list contains one
+   *         value more.
+   */
+  int profile( const QPoint& start,
+               const QPoint& end,
+               QVector<int>& elevations ) const;
+
+  /**
+   * Removes the grid data.
+   */
+  void clear();
+
+ private:
+
+  /**
+   * Rasterizes the loaded isohypses of the passed projected area.
+   */
+  void build( const QRect& area );
+
+  /** Maximum number of cells per grid side. */
+  static const int MaxCells = 768;
+
+  /** Minimum cell size in projected units. */
+  static const int MinCellSize = 4;
+
+  /** Covered projected area. */
+  QRect m_area;
+
+  /** Cell size in projected units. */
+  int m_cellSize;
+
+  /** Number of cells in x- and y-direction. */
+  int m_width;
+  int m_height;
+
+  /** Elevation index plus one of every cell. 0 means unknown. */
+  QVector<uchar> m_cells;
+
+  /** Elevation in meters of a cell value. */
+  short m_levels[256];
+
+  /** Isohypse version of the map contents used for the last build. */
+  uint m_isoMapVersion;
+
+  /** Number of builds. */
+  uint m_version;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/***********************************************************************
+**
+**   fixlatency.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include "fixlatency.h"
+#include "latencyhistogram.h"
+#include "perftrace.h"
+
+// Number of latencies of the running statistics, 10 minutes at 1Hz.
+#define RUNNING_LATENCIES 600
+
+qint64 FixLatency::s_ingestTime = 0;
+
+namespace
+{
+  LatencyHistogram& histogram()
+  {
+    static LatencyHistogram latencies( RUNNING_LATENCIES );
+    return latencies;
+  }
+}
+
+qint64 FixLatency::takeIngestTime()
+{
+  qint64 time = s_ingestTime;
+
+  s_ingestTime = 0;
+
+  return time > 0 ? time : now();
+}
+
+void FixLatency::record( const qint64 ingestTime )
+{
+  if( ingestTime <= 0 )
+    {
+      return;
+    }
+
+  const qint64 latency = qMax( now() - ingestTime, Q_INT64_C(0) ) * 1000;
+
+  histogram().add( latency );
+
+  if( PerfTrace::isEnabled() )
+    {
+      PerfTrace::complete( "Fix to display", PerfTrace::now() - latency, latency );
+    }
+}
+
+const LatencyHistogram& FixLatency::statistics()
+{
+  return histogram();
+}
+
+void FixLatency::reset( const int capacity )
+{
+  histogram().setCapacity( capacity );
+}
@@ -0,0 +1,107 @@
+/***********************************************************************
+**
+**   fixlatency.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FixLatency
+ *
+ * \brief End-to-end latency from the reception of a sentence to the display.
+ *
+ * The GPS client process stamps every sentence, when it has been read from
+ * the device, with the time of the monotonic system clock. This clock is the
+ * same in all processes. The time stamp is transferred with the sentence to
+ * Cumulus and passed by GpsCon to FixLatency before the sentence is emitted.
+ * Sentences of other sources are stamped, when GpsNmea starts to process
+ * them.
+ *
+ * GpsNmea takes the time stamp of every sentence and the calculator keeps it
+ * with the last position. The map records the latency, after it has
+ * repainted the glider at this position. The running statistics cover the
+ * last latencies and are shown by the GPS status dialog and by the
+ * navigation benchmark.
+ *
+ * The header can be used without the class implementation, e.g. by the GPS
+ * client, to get the time stamp.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FIX_LATENCY_H
+#define FIX_LATENCY_H
+
+#include <ctime>
+
+#include <QtGlobal>
+
+class LatencyHistogram;
+
+class FixLatency
+{
+ public:
+
+  /**
+   * \return The time of the monotonic system clock in microseconds.
+   */
+  static qint64 now()
+  {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return qint64( ts.tv_sec ) * 1000000 + ts.tv_nsec / 1000;
+  };
+
+  /**
+   * Sets the reception time of the next sentence to be processed.
+   *
+   * \param usecs Reception time in microseconds of the monotonic clock.
+   */
+  static void setIngestTime( const qint64 usecs )
+  {
+    s_ingestTime = usecs;
+  };
+
+  /**
+   * \return The reception time of the sentence, which is processed now,
+   *         or the current time, if the sentence has no reception time.
+   *         The reception time is reset.
+   */
+  static qint64 takeIngestTime();
+
+  /**
+   * Records the latency from the reception of a sentence until now.
+   *
+   * \param ingestTime Reception time in microseconds, 0 is ignored.
+   */
+  static void record( const qint64 ingestTime );
+
+  /**
+   * \return The running statistics of the recorded latencies.
+   */
+  static const LatencyHistogram& statistics();
+
+  /**
+   * Removes all recorded latencies.
+   *
+   * \param capacity Maximum number of kept latencies, 0 means unlimited.
+   */
+  static void reset( const int capacity );
+
+ private:
+
+  static qint64 s_ingestTime;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/***********************************************************************
+**
+**   fixratepolicy.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include "fixratepolicy.h"
+
+// Fix intervals above this limit in ms are not used for the rate measurement.
+// They are caused by a fix loss or by a time jump.
+#define MAX_FIX_INTERVAL 5000
+
+FixRatePolicy::FixRatePolicy()
+{
+  for( int i = 0; i < StageCount; i++ )
+    {
+      m_rate[i] = 0.0;
+    }
+
+  reset();
+}
+
+FixRatePolicy::~FixRatePolicy()
+{
+}
+
+void FixRatePolicy::setRate( const Stage stage, const double rate )
+{
+  m_rate[stage] = rate;
+
+  // Forward the next fix to the stage to apply the new rate immediately.
+  m_counter[stage] = -1;
+}
+
+qint64 FixRatePolicy::getInterval( const Stage stage ) const
+{
+  if( m_rate[stage] <= 0.0 )
+    {
+      return 0;
+    }
+
+  return static_cast<qint64> (rint( 1000.0 / m_rate[stage] ));
+}
+
+void FixRatePolicy::newFix( const qint64 timeStamp )
+{
+  if( m_lastFixTime > 0 )
+    {
+      qint64 dt = timeStamp - m_lastFixTime;
+
+      if( dt > 0 && dt < MAX_FIX_INTERVAL )
+        {
+          // Smooth the measured rate to be robust against a jittering
+          // delivery of the receiver.
+          double interval = 1000.0 / m_fixRate;
+
+          interval = 0.8 * interval + 0.2 * double( dt );
+
+          m_fixRate = 1000.0 / interval;
+        }
+    }
+
+  m_lastFixTime = timeStamp;
+}
+
+bool FixRatePolicy::accept( const Stage stage )
+{
+  if( m_rate[stage] <= 0.0 || m_counter[stage] < 0 )
+    {
+      m_counter[stage] = 0;
+      return true;
+    }
+
+  // Decimation factor derived from the measured input fix rate.
+  int factor = qMax( 1, static_cast<int> (rint( m_fixRate / m_rate[stage] )) );
+
+  if( ++m_counter[stage] >= factor )
+    {
+      m_counter[stage] = 0;
+      return true;
+    }
+
+  return false;
+}
+
+int FixRatePolicy::getFixRateHz() const
+{
+  return qMax( 1, static_cast<int> (rint( m_fixRate )) );
+}
+
+void FixRatePolicy::reset()
+{
+  for( int i = 0; i < StageCount; i++ )
+    {
+      m_counter[i] = -1;
+    }
+
+  m_fixRate     = 1.0;
+  m_lastFixTime = 0;
+}
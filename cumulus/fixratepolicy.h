@@ -0,0 +1,124 @@
+/***********************************************************************
+**
+**   fixratepolicy.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FixRatePolicy
+ *
+ * \brief Decimation policy for high rate GNSS fixes.
+ *
+ * Modern GNSS receivers deliver 10 or 20 fixes per second. The variometer,
+ * the wind analyzer and the circling detection profit from every fix but
+ * the trail, the IGC logger and the display updates do not. This class
+ * measures the incoming fix rate and decides for every consumer stage, if
+ * a fix shall be forwarded to it or not. The rate of every stage can be
+ * configured by the user in Hz. A rate of zero or less switches off the
+ * decimation of the related stage.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FIX_RATE_POLICY_H
+#define FIX_RATE_POLICY_H
+
+#include <QtGlobal>
+
+class FixRatePolicy
+{
+ public:
+
+  /**
+   * Consumer stages of the fix pipeline, which can be decimated.
+   */
+  enum Stage { Trail=0, Logger, Display, StageCount };
+
+  FixRatePolicy();
+
+  virtual ~FixRatePolicy();
+
+  /**
+   * Sets the desired rate of a stage in Hz. A rate <= 0 disables the
+   * decimation of this stage.
+   */
+  void setRate( const Stage stage, const double rate );
+
+  /**
+   * \return The configured rate of a stage in Hz.
+   */
+  double getRate( const Stage stage ) const
+  {
+    return m_rate[stage];
+  };
+
+  /**
+   * \return The minimum time interval in ms between two fixes of the
+   *         passed stage or 0, if the stage is not decimated.
+   */
+  qint64 getInterval( const Stage stage ) const;
+
+  /**
+   * Reports a new incoming fix. Must be called once per fix before the
+   * stages are queried with accept().
+   *
+   * \param timeStamp Fix time in milliseconds.
+   */
+  void newFix( const qint64 timeStamp );
+
+  /**
+   * Checks, if the last reported fix shall be forwarded to the passed stage.
+   *
+   * \param stage The stage to be checked.
+   *
+   * \return True, if the stage shall process the fix otherwise false.
+   */
+  bool accept( const Stage stage );
+
+  /**
+   * \return The measured input fix rate in Hz. Is 1.0 as long as no rate
+   *         could be measured.
+   */
+  double getFixRate() const
+  {
+    return m_fixRate;
+  };
+
+  /**
+   * \return The measured input fix rate rounded to full Hz, minimum is 1.
+   */
+  int getFixRateHz() const;
+
+  /**
+   * Resets the rate measurement and all stage counters. Should be called,
+   * if the fix stream was interrupted.
+   */
+  void reset();
+
+ private:
+
+  /** Configured stage rates in Hz. */
+  double m_rate[StageCount];
+
+  /** Fix counters of every stage since its last accepted fix. */
+  int m_counter[StageCount];
+
+  /** Measured input fix rate in Hz. */
+  double m_fixRate;
+
+  /** Time stamp of last reported fix in ms. */
+  qint64 m_lastFixTime;
+};
+
+#endif
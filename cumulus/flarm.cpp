@@ -18,12 +18,16 @@
 #include <QtCore>
 
 #include "altitude.h"
+#include "calculator.h"
+#include "distance.h"
 #include "flarm.h"
 #include "flarmdisplay.h"
 #include "flarmaliaslist.h"
 #include "generalconfig.h"
 #include "layout.h"
 
+FlarmTraffic Flarm::m_traffic;
+
 Flarm::Flarm(QObject* parent) : QObject(parent), FlarmBase()
 {
   // Load Flarm alias data
@@ -245,26 +249,25 @@ bool Flarm::extractPflaa( const QStringList& stringList, FlarmAcft& aircraft )
       aircraft.AcftType = 0; // unknown
     }
 
-  // Check, if parsed data should be collected. In this case the data record
-  // is put or updated in the pflaaHash hash dictionary.
-  QString key = createHashKey( aircraft.IdType, aircraft.ID );
+  aircraft.Key         = FlarmTraffic::idToKey( aircraft.ID );
 
-  if( m_collectPflaa == true || key == FlarmDisplay::getSelectedObject() )
+  if( aircraft.Key == 0 )
     {
-      // first check, if record is already contained in the hash.
-      if( m_pflaaHash.contains( key ) == true )
-        {
-          // update entry
-          FlarmAcft& aircraftEntry = m_pflaaHash[key];
-          aircraftEntry = aircraft;
-        }
-      else
-        {
-          // insert new entry
-          m_pflaaHash.insert( key, aircraft );
-        }
+      qWarning() << "$PFLAA contains an invalid identifier:" << aircraft.ID;
+      return false;
     }
 
+  aircraft.Distance    = sqrt( double(aircraft.RelativeNorth) * aircraft.RelativeNorth +
+                               double(aircraft.RelativeEast) * aircraft.RelativeEast );
+  aircraft.Tcpa        = -1.0;
+  aircraft.CpaDistance = aircraft.Distance;
+  aircraft.CpaVertical = aircraft.RelativeVertical;
+  aircraft.Converging  = false;
+
+  // The data record is always put or updated in the traffic store, because
+  // the collision prediction needs the successive positions of all aircraft.
+  m_traffic.update( aircraft );
+
   return true;
 }
 
@@ -853,25 +856,21 @@ bool Flarm::getFlarmRelativeDistance( int &relativeDistance )
  */
 void Flarm::collectPflaaFinished()
 {
-  // Check the hash dictionary for expired data. This old data items have to
-  // be removed. Seems to be the best place, to do it after the end trigger as
-  // to trust that following methods will do that.
-  QMutableHashIterator<QString, Flarm::FlarmAcft> it(m_pflaaHash);
+  // Remove the expired traffic. Seems to be the best place, to do it after
+  // the end trigger as to trust that following methods will do that.
+  m_traffic.expire();
 
-  while( it.hasNext() )
-    {
-      it.next();
+  // Order the traffic once per burst for all views.
+  m_traffic.updateThreatList( calculator->getlastHeading(),
+                              calculator->getLastSpeed().getMps(),
+                              calculator->getlastVario().getMps() );
 
-      // Get next aircraft
-      Flarm::FlarmAcft& acft = it.value();
+  // Report converging traffic, before the Flarm device raises its alarm.
+  const FlarmAcft* acft = m_traffic.getNewConverging();
 
-      // Make time expire check, check time unit is in milli seconds.
-      if( acft.TimeStamp.elapsed() > 3000 )
-        {
-          // Object was longer time not updated, so we do remove it from the
-          // hash. No other way available as the time expire check.
-          it.remove();
-        }
+  if( acft != 0 && GeneralConfig::instance()->getPopupFlarmAlarms() == true )
+    {
+      createConvergingMessage( *acft );
     }
 
   // Start Flarm PFLAA data clearing supervision. There is no other way
@@ -886,10 +885,26 @@ void Flarm::collectPflaaFinished()
     }
 }
 
+/**
+ * Creates a short message about a converging aircraft and emits it.
+ */
+void Flarm::createConvergingMessage( const FlarmAcft& acft )
+{
+  int vertical = static_cast<int> (rint( acft.CpaVertical ));
+
+  QString text = tr("Traffic") + " " +
+                 FlarmAliasList::getAliasHash().value( acft.ID, acft.ID ) + " " +
+                 Distance::getText( acft.CpaDistance, true, -1 ) + " " +
+                 ((vertical > 0) ? "+" : "") + Altitude::getText( vertical, true, 0 ) + " " +
+                 tr("in") + " " + QString::number( static_cast<int> (acft.Tcpa) ) + "s";
+
+  emit flarmConvergingTraffic( text, true );
+}
+
 /** Called if timer has expired. Used for Flarm PFLAA data clearing. */
 void Flarm::slotTimeout()
 {
-  m_pflaaHash.clear();
+  m_traffic.clear();
 
   // Emit signal, if further processing in radar view is required.
   if( Flarm::getCollectPflaa() )
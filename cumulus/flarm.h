@@ -35,6 +35,7 @@
 #include <QTime>
 
 #include "flarmbase.h"
+#include "flarmtraffic.h"
 
 class QPoint;
 class QStringList;
@@ -67,6 +68,23 @@ class Flarm : public QObject, public FlarmBase
     return &instance;
   };
 
+  /**
+   * @return The store of the collected PFLAA traffic.
+   */
+  static const FlarmTraffic& getTraffic()
+  {
+    return m_traffic;
+  };
+
+  /**
+   * Resets the internal stored Flarm data and the collected traffic.
+   */
+  static void reset()
+  {
+    FlarmBase::reset();
+    m_traffic.clear();
+  };
+
   /**
    * @param relativeBearing returns the relative bearing in degree from the
    * own position as integer -180...+180.
@@ -173,6 +191,11 @@ class Flarm : public QObject, public FlarmBase
    */
   void createTrafficMessage();
 
+  /**
+   * Creates a message about a converging aircraft and emits it as signal.
+   */
+  void createConvergingMessage( const FlarmAcft& acft );
+
  signals:
 
   /**
@@ -186,6 +209,12 @@ class Flarm : public QObject, public FlarmBase
    */
   void flarmTrafficInfo( QString& info );
 
+  /**
+   * This signal is emitted, if an aircraft is predicted to converge, before
+   * the Flarm device raises its alarm level.
+   */
+  void flarmConvergingTraffic( const QString& info, const bool sound );
+
   /**
    * This signal is emitted, if no new Flarm data are received and the
    * data expecting timeout has expired.
@@ -246,6 +275,9 @@ class Flarm : public QObject, public FlarmBase
 
   /** Timer for data clearing. */
   QTimer* m_timer;
+
+  /** Store with the collected PFLAA records. */
+  static FlarmTraffic m_traffic;
 };
 
 #endif /* FLARM_H */
@@ -25,8 +25,6 @@ FlarmBase::FlarmData    FlarmBase::m_flarmData;
 FlarmBase::FlarmError   FlarmBase::m_flarmError;
 FlarmBase::ProtocolMode FlarmBase::m_protocolMode = text;
 
-QHash<QString, FlarmBase::FlarmAcft>      FlarmBase::m_pflaaHash;
-
 QMutex FlarmBase::m_mutex;
 
 FlarmBase::FlarmBase()
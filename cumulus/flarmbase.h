@@ -295,6 +295,12 @@ class FlarmBase
     double  GroundSpeed; // meters per second or INT_MIN in stealth mode
     double  ClimbRate;   // meters per second or INT_MIN in stealth mode
     short   AcftType;
+    quint32 Key;         // numeric 24-bit Flarm ID
+    double  Distance;    // horizontal distance in meters
+    double  Tcpa;        // seconds to closest approach or -1, if not approaching
+    double  CpaDistance; // predicted minimum horizontal separation in meters
+    double  CpaVertical; // predicted vertical separation at closest approach
+    bool    Converging;  // predicted to come closer than the warning limits
   };
 
   /**
@@ -423,20 +429,11 @@ class FlarmBase
     return QString(id);
   };
 
-  /**
-   * @return the m_pflaaHash to the caller.
-   */
-  static const QHash<QString, FlarmAcft>& getPflaaHash()
-  {
-    return m_pflaaHash;
-  };
-
   /**
    * Resets the internal stored Flarm data.
    */
   static void reset()
   {
-    m_pflaaHash.clear();
     m_flarmStatus.reset();
     m_flarmData.reset();
     m_flarmError.reset();
@@ -509,12 +506,6 @@ class FlarmBase
   /** Flag to switch on the collecting of PFLAA data. */
   static bool m_collectPflaa;
 
-  /**
-   * Hash map with collected PFLAA records. The key is a concatenation of
-   * the Flarm tags 'ID-Type' and 'ID'.
-   */
-  static QHash<QString, FlarmAcft> m_pflaaHash;
-
   /** Flarm protocol mode.  */
   static enum ProtocolMode m_protocolMode;
 
@@ -0,0 +1,198 @@
+/***********************************************************************
+**
+**   flarmcollisionpredictor.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <climits>
+#include <cmath>
+
+#include "flarmcollisionpredictor.h"
+
+// Time interval limits in ms between two positions, used for the velocity
+// derivation. Shorter intervals are too noisy, longer ones are outdated.
+#define MIN_INTERVAL 500
+#define MAX_INTERVAL 5000
+
+// Weight of a new velocity measurement in the low pass filter.
+#define FILTER_WEIGHT 0.5
+
+FlarmCollisionPredictor::FlarmCollisionPredictor()
+{
+}
+
+FlarmCollisionPredictor::~FlarmCollisionPredictor()
+{
+}
+
+void FlarmCollisionPredictor::addPosition( const FlarmBase::FlarmAcft& acft,
+                                           const qint64 time )
+{
+  if( acft.RelativeNorth == INT_MIN || acft.RelativeEast == INT_MIN )
+    {
+      return;
+    }
+
+  double vertical = (acft.RelativeVertical == INT_MIN) ? 0.0 : acft.RelativeVertical;
+
+  QHash<quint32, Track>::iterator it = m_tracks.find( acft.Key );
+
+  if( it == m_tracks.end() )
+    {
+      Track track;
+
+      track.time        = time;
+      track.north       = acft.RelativeNorth;
+      track.east        = acft.RelativeEast;
+      track.vertical    = vertical;
+      track.vNorth      = 0.0;
+      track.vEast       = 0.0;
+      track.vVertical   = 0.0;
+      track.hasVelocity = false;
+
+      m_tracks.insert( acft.Key, track );
+      return;
+    }
+
+  Track& track = it.value();
+
+  qint64 dt = time - track.time;
+
+  if( dt < MIN_INTERVAL )
+    {
+      // Keep the older position as reference for the next measurement.
+      return;
+    }
+
+  if( dt <= MAX_INTERVAL )
+    {
+      double sec = dt / 1000.0;
+
+      double vNorth    = (acft.RelativeNorth - track.north) / sec;
+      double vEast     = (acft.RelativeEast - track.east) / sec;
+      double vVertical = (vertical - track.vertical) / sec;
+
+      if( track.hasVelocity )
+        {
+          track.vNorth    += FILTER_WEIGHT * (vNorth - track.vNorth);
+          track.vEast     += FILTER_WEIGHT * (vEast - track.vEast);
+          track.vVertical += FILTER_WEIGHT * (vVertical - track.vVertical);
+        }
+      else
+        {
+          track.vNorth    = vNorth;
+          track.vEast     = vEast;
+          track.vVertical = vVertical;
+          track.hasVelocity = true;
+        }
+    }
+  else
+    {
+      // The aircraft was not seen for a longer time, restart the estimation.
+      track.hasVelocity = false;
+    }
+
+  track.time     = time;
+  track.north    = acft.RelativeNorth;
+  track.east     = acft.RelativeEast;
+  track.vertical = vertical;
+}
+
+void FlarmCollisionPredictor::predict( FlarmBase::FlarmAcft& acft,
+                                       const qint64 time,
+                                       const int ownTrack,
+                                       const double ownSpeed,
+                                       const double ownClimb ) const
+{
+  acft.Tcpa        = -1.0;
+  acft.CpaDistance = acft.Distance;
+  acft.CpaVertical = acft.RelativeVertical;
+  acft.Converging  = false;
+
+  if( acft.RelativeNorth == INT_MIN || acft.RelativeEast == INT_MIN )
+    {
+      return;
+    }
+
+  double north    = acft.RelativeNorth;
+  double east     = acft.RelativeEast;
+  double vertical = (acft.RelativeVertical == INT_MIN) ? 0.0 : acft.RelativeVertical;
+
+  double vNorth    = 0.0;
+  double vEast     = 0.0;
+  double vVertical = 0.0;
+
+  QHash<quint32, Track>::const_iterator it = m_tracks.constFind( acft.Key );
+
+  if( it != m_tracks.constEnd() && it.value().hasVelocity )
+    {
+      const Track& track = it.value();
+
+      vNorth    = track.vNorth;
+      vEast     = track.vEast;
+      vVertical = track.vVertical;
+
+      // Bring the last position to the current time.
+      double sec = (time - track.time) / 1000.0;
+
+      north    = track.north + vNorth * sec;
+      east     = track.east + vEast * sec;
+      vertical = track.vertical + vVertical * sec;
+    }
+  else if( acft.Track != INT_MIN && acft.GroundSpeed != INT_MIN )
+    {
+      // Velocity of the other aircraft relative to us.
+      vNorth = cos( acft.Track * M_PI / 180.0 ) * acft.GroundSpeed -
+               cos( ownTrack * M_PI / 180.0 ) * ownSpeed;
+      vEast  = sin( acft.Track * M_PI / 180.0 ) * acft.GroundSpeed -
+               sin( ownTrack * M_PI / 180.0 ) * ownSpeed;
+
+      // The relative vertical distance changes with the difference of
+      // both climb rates.
+      if( acft.ClimbRate != INT_MIN )
+        {
+          vVertical = acft.ClimbRate - ownClimb;
+        }
+    }
+  else
+    {
+      // No movement information available.
+      return;
+    }
+
+  double v2 = vNorth * vNorth + vEast * vEast;
+
+  if( v2 < 0.01 )
+    {
+      // No relative movement, the separation remains.
+      return;
+    }
+
+  double tcpa = -(north * vNorth + east * vEast) / v2;
+
+  if( tcpa < 0.0 )
+    {
+      // The aircraft are diverging.
+      return;
+    }
+
+  double cpaNorth = north + vNorth * tcpa;
+  double cpaEast  = east + vEast * tcpa;
+
+  acft.Tcpa        = tcpa;
+  acft.CpaDistance = sqrt( cpaNorth * cpaNorth + cpaEast * cpaEast );
+  acft.CpaVertical = vertical + vVertical * tcpa;
+
+  acft.Converging = tcpa <= Horizon &&
+                    acft.CpaDistance <= WarnDistance &&
+                    fabs( acft.CpaVertical ) <= WarnVertical;
+}
@@ -0,0 +1,129 @@
+/***********************************************************************
+**
+**   flarmcollisionpredictor.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FlarmCollisionPredictor
+ *
+ * \brief Closest point of approach prediction of Flarm traffic.
+ *
+ * The Flarm device reports by PFLAU only the most relevant alarm target.
+ * This class estimates the relative velocity of every Flarm aircraft from
+ * its successive PFLAA relative positions and extrapolates the relative
+ * movement linear. The result is the time to the closest point of approach,
+ * the predicted minimum horizontal separation and the vertical separation at
+ * that time. Aircraft, which will come closer than the warning limits within
+ * the prediction horizon, are marked as converging. That can be done before
+ * the Flarm device raises its own alarm level.
+ *
+ * Aircraft with only one received position are extrapolated by their
+ * reported track, ground speed and climb rate.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FLARM_COLLISION_PREDICTOR_H
+#define FLARM_COLLISION_PREDICTOR_H
+
+#include <QHash>
+
+#include "flarmbase.h"
+
+class FlarmCollisionPredictor
+{
+ public:
+
+  FlarmCollisionPredictor();
+
+  virtual ~FlarmCollisionPredictor();
+
+  /**
+   * Registers a new relative position of an aircraft.
+   *
+   * \param acft The aircraft data of the PFLAA sentence.
+   *
+   * \param time Monotonic receive time in ms.
+   */
+  void addPosition( const FlarmBase::FlarmAcft& acft, const qint64 time );
+
+  /**
+   * Calculates the closest point of approach of the passed aircraft and
+   * sets its prediction members.
+   *
+   * \param acft The aircraft to be predicted.
+   *
+   * \param time Monotonic current time in ms.
+   *
+   * \param ownTrack Own track over ground in degrees.
+   *
+   * \param ownSpeed Own speed over ground in meters per second.
+   *
+   * \param ownClimb Own climb rate in meters per second.
+   */
+  void predict( FlarmBase::FlarmAcft& acft,
+                const qint64 time,
+                const int ownTrack,
+                const double ownSpeed,
+                const double ownClimb ) const;
+
+  /**
+   * Removes the history of an aircraft.
+   */
+  void remove( const quint32 key )
+  {
+    m_tracks.remove( key );
+  };
+
+  void clear()
+  {
+    m_tracks.clear();
+  };
+
+  /** Prediction horizon in seconds. */
+  static const int Horizon = 60;
+
+  /** Horizontal separation limit in meters for a converging aircraft. */
+  static const int WarnDistance = 300;
+
+  /** Vertical separation limit in meters for a converging aircraft. */
+  static const int WarnVertical = 150;
+
+ private:
+
+  /** Relative movement history of an aircraft. */
+  struct Track
+  {
+    /** Time of last position in ms. */
+    qint64 time;
+
+    /** Last relative position in meters. */
+    double north;
+    double east;
+    double vertical;
+
+    /** Filtered relative velocity in meters per second. */
+    double vNorth;
+    double vEast;
+    double vVertical;
+
+    /** Flag, if a velocity could be derived from two positions. */
+    bool hasVelocity;
+  };
+
+  QHash<quint32, Track> m_tracks;
+};
+
+#endif
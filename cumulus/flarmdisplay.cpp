@@ -287,13 +287,14 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
   // copy background to widget
   painter.drawPixmap( rect(), background );
 
-  // Here starts the Flarm object analysis and drawing
-  QHash<QString, Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaHash();
+  // Here starts the Flarm object analysis and drawing. The traffic list is
+  // already ordered by the threat of the objects.
+  const QVector<Flarm::FlarmAcft>& flarmAcfts = Flarm::getTraffic().getThreatList();
 
   if( flarmAcfts.size() == 0 )
     {
-      // qDebug() << "FlarmDisplay::paintEvent: empty hash";
-      // hash is empty
+      // qDebug() << "FlarmDisplay::paintEvent: empty list";
+      // list is empty
       return;
     }
 
@@ -348,14 +349,13 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
 
   objectHash.clear();
 
-  QMutableHashIterator<QString, Flarm::FlarmAcft> it(flarmAcfts);
-
-  while( it.hasNext() )
+  // The most threatening object is drawn as last one, so that it is on top.
+  for( int i = flarmAcfts.size() - 1; i >= 0; i-- )
     {
-      it.next();
-
       // Get next aircraft
-      Flarm::FlarmAcft& acft = it.value();
+      const Flarm::FlarmAcft& acft = flarmAcfts.at(i);
+
+      const QString key = Flarm::createHashKey( acft.IdType, acft.ID );
 
       int north = acft.RelativeNorth;
       int east  = acft.RelativeEast;
@@ -461,11 +461,16 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
 
       QPen pen( Qt::black );
 
-      if( it.key() == selectedObject )
+      if( key == selectedObject )
         {
           // If a Flarm object is selected, we use another border color
           pen.setColor( Qt::magenta );
         }
+      else if( acft.Converging )
+        {
+          // A predicted converging object gets a blue border color
+          pen.setColor( Qt::blue );
+        }
 
       pen.setWidth( 4 * Layout::getIntScaledDensity() );
       painter.setPen( pen );
@@ -503,7 +508,7 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
           MapConfig::createSquare( object, is, color, 1.0, pen );
         }
 
-      if( it.key() == selectedObject )
+      if( key == selectedObject )
         {
           // If a Flarm object is selected, we draw some additional information
           QFont f = painter.font();
@@ -568,7 +573,7 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
                           object );
 
       // store the draw coordinates for mouse snapping
-      objectHash.insert( it.key(), QPoint(centerX + east, centerY - north) );
+      objectHash.insert( key, QPoint(centerX + east, centerY - north) );
     }
 }
 
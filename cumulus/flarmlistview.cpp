@@ -168,12 +168,13 @@ void FlarmListView::fillItemList( QString& object2Select )
 {
   list->clear();
 
-  // Here starts the Flarm object analysis and drawing
-  QHash<QString, Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaHash();
+  // Here starts the Flarm object analysis and drawing. The traffic list is
+  // already ordered by the threat of the objects.
+  const QVector<Flarm::FlarmAcft>& flarmAcfts = Flarm::getTraffic().getThreatList();
 
   if( flarmAcfts.size() == 0 )
     {
-      // hash is empty
+      // list is empty
       resizeListColumns();
       return;
     }
@@ -181,21 +182,19 @@ void FlarmListView::fillItemList( QString& object2Select )
   int iconSize = QFontMetrics(font()).height() - 4;
   list->setIconSize( QSize(iconSize, iconSize) );
 
-  QMutableHashIterator<QString, Flarm::FlarmAcft> it(flarmAcfts);
-
-  while( it.hasNext() )
+  for( int i = 0; i < flarmAcfts.size(); i++ )
     {
-      it.next();
-
       // Get next aircraft
-      Flarm::FlarmAcft& acft = it.value();
+      const Flarm::FlarmAcft& acft = flarmAcfts.at(i);
+
+      const QString key = Flarm::createHashKey( acft.IdType, acft.ID );
 
       QStringList sl;
 
       int north = acft.RelativeNorth;
       int east  = acft.RelativeEast;
 
-      double distAcft = sqrt( north*north + east*east);
+      double distAcft = acft.Distance;
 
       QString vertical = "";
 
@@ -228,7 +227,7 @@ void FlarmListView::fillItemList( QString& object2Select )
        const QHash<QString, QString> &aliasHash = FlarmAliasList::getAliasHash();
 
       // Add hash key as invisible column
-      sl << it.key()
+      sl << key
          << aliasHash.value( acft.ID, acft.ID )
          << Distance::getText( distAcft, true, -1 )
          << vertical
@@ -266,7 +265,7 @@ void FlarmListView::fillItemList( QString& object2Select )
           // correct angle because the different coordinate systems.
           int heading2Object = (360 - calculator->getlastHeading()) + (90 - alpha);
 
-          // qDebug() << "ID=" << it.key() << "Alpha" << alpha << "H2O=" << heading2Object;
+          // qDebug() << "ID=" << key << "Alpha" << alpha << "H2O=" << heading2Object;
           MapConfig::createTriangle( pixmap,
                                      iconSize,
                                      QColor(Qt::black),
@@ -281,14 +280,13 @@ void FlarmListView::fillItemList( QString& object2Select )
 
       list->addTopLevelItem( item );
 
-      if( object2Select == it.key() )
+      if( object2Select == key )
         {
           // This item is the current selected one.
           list->setCurrentItem( item );
         }
     }
 
-  list->sortByColumn ( 2, Qt::AscendingOrder );
   resizeListColumns();
 }
 
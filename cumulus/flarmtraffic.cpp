@@ -0,0 +1,263 @@
+/***********************************************************************
+**
+**   flarmtraffic.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "flarmtraffic.h"
+
+/**
+ * Threat order of two aircraft. Higher alarm levels at first, then the
+ * converging and approaching aircraft by time and predicted separation and
+ * at last the nearer ones.
+ */
+static bool threatLessThan( const FlarmBase::FlarmAcft& a,
+                            const FlarmBase::FlarmAcft& b )
+{
+  if( a.Alarm != b.Alarm )
+    {
+      return a.Alarm > b.Alarm;
+    }
+
+  if( a.Converging != b.Converging )
+    {
+      return a.Converging;
+    }
+
+  // Not approaching aircraft have a negative value.
+  bool aApproach = a.Tcpa >= 0.0;
+  bool bApproach = b.Tcpa >= 0.0;
+
+  if( aApproach != bApproach )
+    {
+      return aApproach;
+    }
+
+  if( aApproach )
+    {
+      // PFLAA positions are coarse, full seconds are accurate enough.
+      int ta = static_cast<int> (a.Tcpa);
+      int tb = static_cast<int> (b.Tcpa);
+
+      if( ta != tb )
+        {
+          return ta < tb;
+        }
+
+      if( a.CpaDistance != b.CpaDistance )
+        {
+          return a.CpaDistance < b.CpaDistance;
+        }
+    }
+
+  return a.Distance < b.Distance;
+}
+
+FlarmTraffic::FlarmTraffic() :
+  m_lastTick(-1),
+  m_newConverging(-1)
+{
+  m_clock.start();
+}
+
+FlarmTraffic::~FlarmTraffic()
+{
+}
+
+quint32 FlarmTraffic::idToKey( const QString& id )
+{
+  bool ok;
+
+  quint32 key = id.toUInt( &ok, 16 );
+
+  return ok ? (key & 0xFFFFFF) : 0;
+}
+
+void FlarmTraffic::update( const FlarmBase::FlarmAcft& aircraft )
+{
+  qint64 now  = m_clock.elapsed();
+  qint64 tick = now / SlotTime;
+
+  quint32 key = idToKey( aircraft.ID );
+
+  if( key == 0 )
+    {
+      // Aircraft without a valid identifier cannot be told apart and are
+      // not stored.
+      return;
+    }
+
+  QHash<quint32, Entry>::iterator it = m_acfts.find( key );
+
+  if( it == m_acfts.end() )
+    {
+      it = m_acfts.insert( key, Entry() );
+      it.value().tick = -1;
+      it.value().converging = false;
+    }
+
+  it.value().acft = aircraft;
+  it.value().acft.Key = key;
+
+  m_predictor.addPosition( it.value().acft, now );
+
+  if( it.value().tick != tick )
+    {
+      // Register the key only once per tick in the wheel.
+      it.value().tick = tick;
+      m_wheel[tick % WheelSlots].append( key );
+    }
+}
+
+void FlarmTraffic::expire()
+{
+  qint64 tick = m_clock.elapsed() / SlotTime;
+
+  if( m_lastTick < 0 )
+    {
+      // The first call starts the wheel at the current tick.
+      m_lastTick = tick - 1;
+    }
+
+  // Every slot has to be processed at most once.
+  qint64 t = qMax( m_lastTick + 1, tick - WheelSlots + 1 );
+
+  for( ; t <= tick; t++ )
+    {
+      // Slot containing the keys updated ExpireTicks ago. It contains
+      // also keys of newer ticks, if the catch up spans the whole wheel.
+      const qint64 expTick = t - ExpireTicks;
+      const int index = int( (expTick % WheelSlots + WheelSlots) % WheelSlots );
+
+      QVector<quint32>& slot = m_wheel[index];
+      QVector<quint32> keep;
+
+      for( int i = 0; i < slot.size(); i++ )
+        {
+          QHash<quint32, Entry>::iterator it = m_acfts.find( slot.at(i) );
+
+          if( it == m_acfts.end() )
+            {
+              continue;
+            }
+
+          if( it.value().tick <= expTick )
+            {
+              m_predictor.remove( it.key() );
+              m_acfts.erase( it );
+            }
+          else if( it.value().tick % WheelSlots == index )
+            {
+              // Not expired and registered for this slot, keep it.
+              keep.append( slot.at(i) );
+            }
+
+          // Otherwise the aircraft is registered in a newer slot.
+        }
+
+      slot = keep;
+    }
+
+  m_lastTick = tick;
+}
+
+void FlarmTraffic::updateThreatList( const int ownTrack,
+                                     const double ownSpeed,
+                                     const double ownClimb )
+{
+  m_threatList.clear();
+  m_threatList.reserve( m_acfts.size() );
+  m_newConverging = -1;
+
+  qint64 now = m_clock.elapsed();
+
+  // Keys of the aircraft, which are converging since this update.
+  QVector<quint32> newConverging;
+
+  QHash<quint32, Entry>::iterator it;
+
+  for( it = m_acfts.begin(); it != m_acfts.end(); ++it )
+    {
+      FlarmBase::FlarmAcft& acft = it.value().acft;
+
+      double north = acft.RelativeNorth;
+      double east  = acft.RelativeEast;
+
+      acft.Distance = sqrt( north * north + east * east );
+
+      m_predictor.predict( acft, now, ownTrack, ownSpeed, ownClimb );
+
+      if( acft.Converging && ! it.value().converging )
+        {
+          newConverging.append( acft.Key );
+        }
+
+      it.value().converging = acft.Converging;
+
+      m_threatList.append( acft );
+    }
+
+  std::sort( m_threatList.begin(), m_threatList.end(), threatLessThan );
+
+  if( newConverging.isEmpty() )
+    {
+      return;
+    }
+
+  // Look for the most threatening new converging aircraft, which is not
+  // already alarmed by the Flarm device.
+  for( int i = 0; i < m_threatList.size(); i++ )
+    {
+      const FlarmBase::FlarmAcft& acft = m_threatList.at(i);
+
+      if( ! acft.Converging )
+        {
+          break;
+        }
+
+      if( acft.Alarm == FlarmBase::No && newConverging.contains( acft.Key ) )
+        {
+          m_newConverging = i;
+          break;
+        }
+    }
+}
+
+const FlarmBase::FlarmAcft* FlarmTraffic::find( const QString& id ) const
+{
+  QHash<quint32, Entry>::const_iterator it = m_acfts.find( idToKey( id ) );
+
+  if( it == m_acfts.end() )
+    {
+      return static_cast<const FlarmBase::FlarmAcft *> (0);
+    }
+
+  return &it.value().acft;
+}
+
+void FlarmTraffic::clear()
+{
+  m_acfts.clear();
+  m_threatList.clear();
+  m_predictor.clear();
+  m_newConverging = -1;
+  m_lastTick = -1;
+
+  for( int i = 0; i < WheelSlots; i++ )
+    {
+      m_wheel[i].clear();
+    }
+}
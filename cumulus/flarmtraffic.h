@@ -0,0 +1,173 @@
+/***********************************************************************
+**
+**   flarmtraffic.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FlarmTraffic
+ *
+ * \brief Store of the Flarm traffic reported by PFLAA sentences.
+ *
+ * The aircraft are keyed by their numeric 24-bit Flarm identifier. Updates
+ * are registered in a timing wheel, so that the expiry check touches only
+ * the entries of the passed wheel slots and not the whole store.
+ *
+ * After each PFLAA burst a threat ordered list is built once. The closest
+ * point of approach of every aircraft is predicted by FlarmCollisionPredictor.
+ * Aircraft are ordered by alarm level, predicted convergence, time to the
+ * closest approach, predicted separation and distance. The radar view, the
+ * list view and the map read this list directly.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FLARM_TRAFFIC_H
+#define FLARM_TRAFFIC_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "flarmbase.h"
+#include "flarmcollisionpredictor.h"
+
+class FlarmTraffic
+{
+ public:
+
+  FlarmTraffic();
+
+  virtual ~FlarmTraffic();
+
+  /**
+   * Converts a hexadecimal Flarm identifier into its numeric key.
+   *
+   * \param id 6-digit hex identifier of the PFLAA sentence
+   *
+   * \return Numeric 24-bit key or 0, if the identifier is invalid. The
+   *         key 0 is never stored.
+   */
+  static quint32 idToKey( const QString& id );
+
+  /**
+   * Puts a new aircraft into the store or updates an existing one.
+   */
+  void update( const FlarmBase::FlarmAcft& aircraft );
+
+  /**
+   * Removes all aircraft, which were not updated within the expiry time.
+   */
+  void expire();
+
+  /**
+   * Builds the threat ordered list from the stored aircraft.
+   *
+   * \param ownTrack Own track over ground in degrees.
+   *
+   * \param ownSpeed Own speed over ground in meters per second.
+   *
+   * \param ownClimb Own climb rate in meters per second.
+   */
+  void updateThreatList( const int ownTrack,
+                         const double ownSpeed,
+                         const double ownClimb );
+
+  /**
+   * \return Aircraft ordered by their threat, most important at first.
+   */
+  const QVector<FlarmBase::FlarmAcft>& getThreatList() const
+  {
+    return m_threatList;
+  };
+
+  /**
+   * \return The most threatening aircraft, which is converging since the last
+   *         threat list update and not yet alarmed by Flarm, or 0.
+   */
+  const FlarmBase::FlarmAcft* getNewConverging() const
+  {
+    if( m_newConverging < 0 )
+      {
+        return static_cast<const FlarmBase::FlarmAcft *> (0);
+      }
+
+    return &m_threatList.at( m_newConverging );
+  };
+
+  /**
+   * \return The aircraft with the passed identifier or 0, if not stored.
+   */
+  const FlarmBase::FlarmAcft* find( const QString& id ) const;
+
+  /**
+   * \return The number of stored aircraft.
+   */
+  int size() const
+  {
+    return m_acfts.size();
+  };
+
+  /**
+   * Removes all stored aircraft.
+   */
+  void clear();
+
+ private:
+
+  /** Stored entry of an aircraft. */
+  struct Entry
+  {
+    FlarmBase::FlarmAcft acft;
+
+    /** Wheel tick of the last update. */
+    qint64 tick;
+
+    /** Converging state of the last threat list update. */
+    bool converging;
+  };
+
+  /** Number of slots in the timing wheel. */
+  static const int WheelSlots = 8;
+
+  /** Time span of a wheel slot in ms. */
+  static const int SlotTime = 500;
+
+  /** Number of ticks, after which a not updated aircraft is expired. */
+  static const int ExpireTicks = 6;
+
+  /** Stored aircraft, keyed by the numeric Flarm identifier. */
+  QHash<quint32, Entry> m_acfts;
+
+  /** Timing wheel, every slot contains the keys updated in its tick. */
+  QVector<quint32> m_wheel[WheelSlots];
+
+  /** Last tick, for which the expiry was processed, -1 before the first. */
+  qint64 m_lastTick;
+
+  /** Monotonic clock of the wheel. */
+  QElapsedTimer m_clock;
+
+  /** Aircraft ordered by their threat. */
+  QVector<FlarmBase::FlarmAcft> m_threatList;
+
+  /** Index of the new converging aircraft in the threat list or -1. */
+  int m_newConverging;
+
+  /** Closest point of approach prediction. */
+  FlarmCollisionPredictor m_predictor;
+};
+
+#endif
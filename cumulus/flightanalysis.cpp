@@ -0,0 +1,539 @@
+/***********************************************************************
+**
+**   flightanalysis.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+#include <cstring>
+
+#include <QtCore>
+
+#include "distance.h"
+#include "flightanalysis.h"
+#include "mapcalc.h"
+#include "olcoptimizer.h"
+#include "speed.h"
+
+// Half of the time window in seconds, in which the heading change is
+// summed up to detect circling.
+#define CIRCLING_HALF_WINDOW 10
+
+// Minimum average turn rate in degrees per second during circling.
+#define MIN_TURN_RATE 6.0
+
+// Circling phases with a shorter interruption in seconds are merged.
+#define MAX_CIRCLING_GAP 10
+
+// Minimum duration of a thermal in seconds.
+#define MIN_THERMAL_DURATION 30
+
+// Half of the time window in seconds, over which the climb rate of the
+// histogram is averaged.
+#define CLIMB_HALF_WINDOW 5
+
+// Lower limit and width of the climb rate classes in m/s.
+#define CLIMB_CLASS_MIN -2.0
+#define CLIMB_CLASS_WIDTH 0.5
+
+// Radius in meters around a task point, in which it counts as reached.
+#define TASK_POINT_RADIUS 500.0
+
+// Meters per KFLog coordinate unit, which is a 600000'st of a degree.
+#define KFLOG_TO_M (RADIUS * M_PI / (180.0 * 600000.0))
+
+namespace
+{
+  /**
+   * \return The distance in meters between two KFLog coordinates on the
+   *         sphere.
+   */
+  double distance( const QPoint& p1, const QPoint& p2 )
+  {
+    QPoint a( p1 );
+    QPoint b( p2 );
+
+    return MapCalc::dist( &a, &b ) * 1000.0;
+  }
+}
+
+FlightAnalysis::FlightAnalysis() :
+  m_flight(0),
+  m_altitude(0),
+  m_freeDistance(0.0),
+  m_faiDistance(0.0),
+  m_outAndReturnDistance(0.0),
+  m_taskPointsReached(0),
+  m_taskDistance(0.0),
+  m_taskSpeed(0.0)
+{
+  memset( m_climbHistogram, 0, sizeof(m_climbHistogram) );
+}
+
+FlightAnalysis::~FlightAnalysis()
+{
+}
+
+void FlightAnalysis::analyse( const IgcParser::Flight& flight )
+{
+  m_flight = &flight;
+  m_circling.clear();
+  m_thermals.clear();
+  m_glides.clear();
+  memset( m_climbHistogram, 0, sizeof(m_climbHistogram) );
+  m_freeDistance = 0.0;
+  m_faiDistance = 0.0;
+  m_outAndReturnDistance = 0.0;
+  m_taskPointsReached = 0;
+  m_taskDistance = 0.0;
+  m_taskSpeed = 0.0;
+
+  if( flight.size() < 2 )
+    {
+      return;
+    }
+
+  detectCircling();
+  createPhases();
+  createClimbHistogram();
+  optimizeDistances();
+  scoreTask();
+}
+
+void FlightAnalysis::detectCircling()
+{
+  const IgcParser::Flight& f = *m_flight;
+  const int n = f.size();
+
+  // The pressure altitude is preferred, if the logger has recorded it.
+  m_altitude = &f.gnssAltitude;
+
+  for( int i = 0; i < n; i++ )
+    {
+      if( f.pressureAltitude.at(i) != 0 )
+        {
+          m_altitude = &f.pressureAltitude;
+          break;
+        }
+    }
+
+  // Summed up heading change in degrees until every fix.
+  QVector<double> turn( n );
+
+  double lastBearing = 0.0;
+  bool hasBearing = false;
+
+  turn[0] = 0.0;
+
+  for( int i = 1; i < n; i++ )
+    {
+      const double dy = f.latitude.at(i) - f.latitude.at(i - 1);
+      const double dx = (f.longitude.at(i) - f.longitude.at(i - 1)) *
+                        cos( f.latitude.at(i) * M_PI / (180.0 * 600000.0) );
+
+      double change = 0.0;
+
+      if( dx != 0.0 || dy != 0.0 )
+        {
+          const double bearing = atan2( dx, dy ) * 180.0 / M_PI;
+
+          if( hasBearing )
+            {
+              change = bearing - lastBearing;
+
+              if( change > 180.0 )
+                {
+                  change -= 360.0;
+                }
+              else if( change <= -180.0 )
+                {
+                  change += 360.0;
+                }
+            }
+
+          lastBearing = bearing;
+          hasBearing = true;
+        }
+
+      turn[i] = turn[i - 1] + change;
+    }
+
+  // The net heading change in the window is large during circling and
+  // small during straight flight and S-turns.
+  m_circling.fill( false, n );
+
+  int lo = 0;
+  int hi = 0;
+
+  for( int i = 0; i < n; i++ )
+    {
+      const int t = f.time.at(i);
+
+      while( f.time.at(lo) < t - CIRCLING_HALF_WINDOW )
+        {
+          lo++;
+        }
+
+      while( hi + 1 < n && f.time.at(hi + 1) <= t + CIRCLING_HALF_WINDOW )
+        {
+          hi++;
+        }
+
+      const int dt = f.time.at(hi) - f.time.at(lo);
+
+      if( dt > 0 && fabs( turn.at(hi) - turn.at(lo) ) / dt >= MIN_TURN_RATE )
+        {
+          m_circling[i] = true;
+        }
+    }
+}
+
+void FlightAnalysis::createPhases()
+{
+  const IgcParser::Flight& f = *m_flight;
+  const QVector<int>& alt = *m_altitude;
+  const int n = f.size();
+
+  // Circling runs are collected and merged over short interruptions.
+  QVector<QPoint> runs;
+
+  for( int i = 0; i < n; i++ )
+    {
+      if( ! m_circling.at(i) )
+        {
+          continue;
+        }
+
+      int end = i;
+
+      while( end + 1 < n && m_circling.at(end + 1) )
+        {
+          end++;
+        }
+
+      if( ! runs.isEmpty() &&
+          f.time.at(i) - f.time.at(runs.last().y()) <= MAX_CIRCLING_GAP )
+        {
+          runs.last().setY( end );
+        }
+      else
+        {
+          runs.append( QPoint( i, end ) );
+        }
+
+      i = end;
+    }
+
+  for( int r = 0; r < runs.size(); r++ )
+    {
+      const int start = runs.at(r).x();
+      const int end = runs.at(r).y();
+      const int duration = f.time.at(end) - f.time.at(start);
+
+      if( duration < MIN_THERMAL_DURATION )
+        {
+          continue;
+        }
+
+      qint64 lat = 0;
+      qint64 lon = 0;
+
+      for( int i = start; i <= end; i++ )
+        {
+          lat += f.latitude.at(i);
+          lon += f.longitude.at(i);
+        }
+
+      const int count = end - start + 1;
+
+      Thermal thermal;
+      thermal.start = start;
+      thermal.end = end;
+      thermal.duration = duration;
+      thermal.gain = alt.at(end) - alt.at(start);
+      thermal.base = alt.at(start);
+      thermal.top = alt.at(end);
+      thermal.climb = double( thermal.gain ) / duration;
+      thermal.center = QPoint( int( lat / count ), int( lon / count ) );
+
+      m_thermals.append( thermal );
+    }
+
+  // The glides are the phases after every thermal until the next one or
+  // until the end of the flight. The launch is not a glide.
+  for( int k = 0; k < m_thermals.size(); k++ )
+    {
+      const int start = m_thermals.at(k).end;
+      const int end = k + 1 < m_thermals.size() ? m_thermals.at(k + 1).start : n - 1;
+
+      if( end <= start )
+        {
+          continue;
+        }
+
+      Glide glide;
+      glide.start = start;
+      glide.end = end;
+      glide.distance = 0.0;
+      glide.loss = alt.at(start) - alt.at(end);
+
+      for( int i = start + 1; i <= end; i++ )
+        {
+          const double dy = f.latitude.at(i) - f.latitude.at(i - 1);
+          const double dx = (f.longitude.at(i) - f.longitude.at(i - 1)) *
+                            cos( f.latitude.at(i) * M_PI / (180.0 * 600000.0) );
+
+          glide.distance += sqrt( dx * dx + dy * dy ) * KFLOG_TO_M;
+        }
+
+      m_glides.append( glide );
+    }
+}
+
+void FlightAnalysis::createClimbHistogram()
+{
+  const IgcParser::Flight& f = *m_flight;
+  const QVector<int>& alt = *m_altitude;
+
+  for( int k = 0; k < m_thermals.size(); k++ )
+    {
+      const Thermal& thermal = m_thermals.at(k);
+
+      int lo = thermal.start;
+      int hi = thermal.start;
+
+      for( int i = thermal.start + 1; i <= thermal.end; i++ )
+        {
+          const int t = f.time.at(i);
+
+          while( f.time.at(lo) < t - CLIMB_HALF_WINDOW )
+            {
+              lo++;
+            }
+
+          while( hi + 1 <= thermal.end && f.time.at(hi + 1) <= t + CLIMB_HALF_WINDOW )
+            {
+              hi++;
+            }
+
+          const int dt = f.time.at(hi) - f.time.at(lo);
+
+          if( dt <= 0 )
+            {
+              continue;
+            }
+
+          const double climb = double( alt.at(hi) - alt.at(lo) ) / dt;
+
+          int climbClass = int( floor( (climb - CLIMB_CLASS_MIN) / CLIMB_CLASS_WIDTH ) );
+
+          climbClass = qBound( 0, climbClass, int(ClimbClasses) - 1 );
+
+          // The histogram is weighted by the time.
+          m_climbHistogram[climbClass] += t - f.time.at(i - 1);
+        }
+    }
+}
+
+void FlightAnalysis::optimizeDistances()
+{
+  OlcOptimizer olc;
+
+  olc.addFlight( *m_flight );
+
+  m_freeDistance = olc.freeDistance().distance;
+  m_faiDistance = olc.faiTriangle().distance;
+  m_outAndReturnDistance = olc.outAndReturn().distance;
+}
+
+void FlightAnalysis::scoreTask()
+{
+  const IgcParser::Flight& f = *m_flight;
+  const QVector<QPoint>& tps = f.taskPoints;
+  const int count = tps.size();
+
+  if( count < 2 )
+    {
+      return;
+    }
+
+  QVector<double> legs( count, 0.0 );
+
+  for( int k = 1; k < count; k++ )
+    {
+      legs[k] = distance( tps.at(k - 1), tps.at(k) );
+    }
+
+  int next = 0;
+  int startTime = -1;
+  int finishTime = -1;
+  double progress = 0.0;
+
+  for( int i = 0; i < f.size() && next < count; i++ )
+    {
+      const QPoint pos = f.position( i );
+      const int t = f.time.at(i);
+
+      if( next == 1 && distance( pos, tps.at(0) ) <= TASK_POINT_RADIUS )
+        {
+          // The last start counts.
+          startTime = t;
+          continue;
+        }
+
+      const double remaining = distance( pos, tps.at(next) );
+
+      if( remaining <= TASK_POINT_RADIUS )
+        {
+          if( next == 0 )
+            {
+              startTime = t;
+            }
+
+          next++;
+          progress = 0.0;
+
+          if( next == count )
+            {
+              finishTime = t;
+            }
+
+          continue;
+        }
+
+      if( next > 0 )
+        {
+          progress = qMax( progress, legs.at(next) - remaining );
+        }
+    }
+
+  m_taskPointsReached = next;
+
+  for( int k = 1; k < next; k++ )
+    {
+      m_taskDistance += legs.at(k);
+    }
+
+  if( next > 0 && next < count )
+    {
+      m_taskDistance += progress;
+    }
+
+  if( finishTime > startTime && startTime >= 0 )
+    {
+      m_taskSpeed = m_taskDistance / (finishTime - startTime);
+    }
+}
+
+double FlightAnalysis::climbClassLimit( const int climbClass )
+{
+  return CLIMB_CLASS_MIN + climbClass * CLIMB_CLASS_WIDTH;
+}
+
+double FlightAnalysis::glideRatio() const
+{
+  double distance = 0.0;
+  int loss = 0;
+
+  for( int k = 0; k < m_glides.size(); k++ )
+    {
+      distance += m_glides.at(k).distance;
+      loss += m_glides.at(k).loss;
+    }
+
+  return loss > 0 ? distance / loss : 0.0;
+}
+
+QString FlightAnalysis::report() const
+{
+  if( m_flight == 0 || m_flight->size() < 2 )
+    {
+      return QObject::tr( "No fixes" );
+    }
+
+  const IgcParser::Flight& f = *m_flight;
+
+  const int duration = f.time.last() - f.time.first();
+
+  int thermalTime = 0;
+  int thermalGain = 0;
+
+  for( int k = 0; k < m_thermals.size(); k++ )
+    {
+      thermalTime += m_thermals.at(k).duration;
+      thermalGain += m_thermals.at(k).gain;
+    }
+
+  QString text;
+
+  text += QObject::tr( "Date" ) + ": " + f.date.toString( Qt::ISODate ) + "\n";
+
+  text += QObject::tr( "Duration" ) + ": " +
+          QString( "%1:%2" ).arg( duration / 3600 )
+                            .arg( (duration / 60) % 60, 2, 10, QChar('0') ) +
+          " (" + QString::number( f.size() ) + " " + QObject::tr( "fixes" ) + ")\n";
+
+  text += QObject::tr( "Thermals" ) + ": " + QString::number( m_thermals.size() );
+
+  if( thermalTime > 0 )
+    {
+      text += ", " + Speed( double( thermalGain ) / thermalTime ).getVerticalText() +
+              ", " + QString::number( thermalTime * 100 / qMax( 1, duration ) ) + "%";
+    }
+
+  text += "\n";
+
+  text += QObject::tr( "Glide ratio" ) + ": " +
+          QString::number( glideRatio(), 'f', 0 ) + "\n";
+
+  text += QObject::tr( "Free distance" ) + ": " +
+          Distance::getText( m_freeDistance, true, 1 ) + "\n";
+
+  text += QObject::tr( "FAI triangle" ) + ": " +
+          Distance::getText( m_faiDistance, true, 1 ) + "\n";
+
+  text += QObject::tr( "Out and return" ) + ": " +
+          Distance::getText( m_outAndReturnDistance, true, 1 ) + "\n";
+
+  if( f.taskPoints.size() >= 2 )
+    {
+      text += QObject::tr( "Task" ) + ": " +
+              QString( "%1/%2" ).arg( m_taskPointsReached ).arg( f.taskPoints.size() ) +
+              ", " + Distance::getText( m_taskDistance, true, 1 );
+
+      if( m_taskSpeed > 0.0 )
+        {
+          text += ", " + Speed( m_taskSpeed ).getHorizontalText();
+        }
+
+      text += "\n";
+    }
+
+  if( thermalTime > 0 )
+    {
+      text += QObject::tr( "Climb rates" ) + ":\n";
+
+      for( int c = ClimbClasses - 1; c >= 0; c-- )
+        {
+          if( m_climbHistogram[c] == 0 )
+            {
+              continue;
+            }
+
+          text += QString( "%1 %2%\n" )
+                  .arg( Speed( climbClassLimit( c ) ).getVerticalText(), 12 )
+                  .arg( m_climbHistogram[c] * 100 / thermalTime, 3 );
+        }
+    }
+
+  return text;
+}
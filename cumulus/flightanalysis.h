@@ -0,0 +1,232 @@
+/***********************************************************************
+**
+**   flightanalysis.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FlightAnalysis
+ *
+ * \brief Post-flight analysis of a parsed IGC file.
+ *
+ * The analysis works on the columnar fix arrays of the IgcParser and needs
+ * only a few linear passes over them:
+ *
+ * - Circling is detected by the net heading change in a time window around
+ *   every fix. Circling phases of a minimum duration are the thermals.
+ * - The climb rate histogram contains the time spent in thermals per climb
+ *   rate class.
+ * - The glides are the phases between the thermals. Their glide ratio is
+ *   the flown distance divided by the altitude loss.
+ * - The free distance over up to 5 legs, the largest FAI triangle and the
+ *   out-and-return distance are optimized by the OlcOptimizer.
+ * - A declared task is scored by the reached turn points, the achieved
+ *   distance and the task speed.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FLIGHT_ANALYSIS_H
+#define FLIGHT_ANALYSIS_H
+
+#include <QPoint>
+#include <QString>
+#include <QVector>
+
+#include "igcparser.h"
+
+class FlightAnalysis
+{
+ public:
+
+  /** A circling phase. */
+  struct Thermal
+  {
+    /** Index of the first fix. */
+    int start;
+    /** Index of the last fix. */
+    int end;
+    /** Duration in seconds. */
+    int duration;
+    /** Altitude gain in meters. */
+    int gain;
+    /** Altitude at the begin in meters. */
+    int base;
+    /** Altitude at the end in meters. */
+    int top;
+    /** Average climb rate in m/s. */
+    double climb;
+    /** Mean position of the fixes in KFLog coordinates. */
+    QPoint center;
+  };
+
+  /** A straight flight phase between two thermals. */
+  struct Glide
+  {
+    /** Index of the first fix. */
+    int start;
+    /** Index of the last fix. */
+    int end;
+    /** Flown distance in meters. */
+    double distance;
+    /** Altitude loss in meters. */
+    int loss;
+  };
+
+  /** Number of climb rate classes. */
+  enum { ClimbClasses = 20 };
+
+  FlightAnalysis();
+
+  virtual ~FlightAnalysis();
+
+  /**
+   * Analyses a parsed flight. The flight must exist, until the analysis
+   * is finished.
+   */
+  void analyse( const IgcParser::Flight& flight );
+
+  /**
+   * \return The thermals in the order of the flight.
+   */
+  const QVector<Thermal>& thermals() const
+  {
+    return m_thermals;
+  };
+
+  /**
+   * \return The glides in the order of the flight.
+   */
+  const QVector<Glide>& glides() const
+  {
+    return m_glides;
+  };
+
+  /**
+   * \return The seconds spent in thermals in the climb rate class.
+   */
+  int climbHistogram( const int climbClass ) const
+  {
+    return m_climbHistogram[climbClass];
+  };
+
+  /**
+   * \return The lower limit of the climb rate class in m/s.
+   */
+  static double climbClassLimit( const int climbClass );
+
+  /**
+   * \return The glide ratio over all glides or 0, if there was no loss.
+   */
+  double glideRatio() const;
+
+  /**
+   * \return The free distance over up to 5 legs in meters.
+   */
+  double freeDistance() const
+  {
+    return m_freeDistance;
+  };
+
+  /**
+   * \return The distance of the largest FAI triangle in meters or 0.
+   */
+  double faiTriangleDistance() const
+  {
+    return m_faiDistance;
+  };
+
+  /**
+   * \return The distance of the best out-and-return route in meters.
+   */
+  double outAndReturnDistance() const
+  {
+    return m_outAndReturnDistance;
+  };
+
+  /**
+   * \return The number of reached points of the declared task.
+   */
+  int taskPointsReached() const
+  {
+    return m_taskPointsReached;
+  };
+
+  /**
+   * \return The achieved distance of the declared task in meters.
+   */
+  double taskDistance() const
+  {
+    return m_taskDistance;
+  };
+
+  /**
+   * \return The task speed in m/s or 0, if the task was not finished.
+   */
+  double taskSpeed() const
+  {
+    return m_taskSpeed;
+  };
+
+  /**
+   * \return A text report of the analysis.
+   */
+  QString report() const;
+
+ private:
+
+  /** Selects the altitude column and detects the circling fixes. */
+  void detectCircling();
+
+  /** Creates the thermals and glides from the circling fixes. */
+  void createPhases();
+
+  /** Fills the climb rate histogram. */
+  void createClimbHistogram();
+
+  /** Optimizes the contest distances. */
+  void optimizeDistances();
+
+  /** Scores the declared task. */
+  void scoreTask();
+
+  /** The analysed flight. */
+  const IgcParser::Flight* m_flight;
+
+  /** The used altitude column. */
+  const QVector<int>* m_altitude;
+
+  /** Circling flag per fix. */
+  QVector<bool> m_circling;
+
+  QVector<Thermal> m_thermals;
+
+  QVector<Glide> m_glides;
+
+  int m_climbHistogram[ClimbClasses];
+
+  double m_freeDistance;
+
+  double m_faiDistance;
+
+  double m_outAndReturnDistance;
+
+  int m_taskPointsReached;
+
+  double m_taskDistance;
+
+  double m_taskSpeed;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/***********************************************************************
+**
+**   flightclock.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <QDateTime>
+
+#include "flightclock.h"
+
+bool   FlightClock::m_isVirtual   = false;
+qint64 FlightClock::m_virtualTime = 0;
+
+qint64 FlightClock::currentMSecsSinceEpoch()
+{
+  if( m_isVirtual )
+    {
+      return m_virtualTime;
+    }
+
+  return QDateTime::currentMSecsSinceEpoch();
+}
+
+void FlightClock::setVirtualTime( const qint64 msecs )
+{
+  if( m_isVirtual == false )
+    {
+      m_isVirtual   = true;
+      m_virtualTime = msecs;
+      return;
+    }
+
+  m_virtualTime = qMax( m_virtualTime, msecs );
+}
+
+void FlightClock::resetVirtualTime()
+{
+  m_isVirtual = false;
+}
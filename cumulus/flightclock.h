@@ -0,0 +1,83 @@
+/***********************************************************************
+**
+**   flightclock.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FlightClock
+ *
+ * \brief Time source of the navigation calculations.
+ *
+ * Normally the flight clock is the system clock. During a flight replay the
+ * clock is switched to a virtual time, which is advanced with the replayed
+ * fixes. Therefore time windows and refresh intervals of the navigation
+ * calculations behave like in a real flight, also if the replay runs much
+ * faster than real time.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FLIGHT_CLOCK_H
+#define FLIGHT_CLOCK_H
+
+#include <QtGlobal>
+
+class FlightClock
+{
+ public:
+
+  /**
+   * \return The current time in milliseconds since the epoch.
+   */
+  static qint64 currentMSecsSinceEpoch();
+
+  /**
+   * \return The milliseconds elapsed since the passed clock time.
+   */
+  static qint64 elapsed( const qint64 since )
+  {
+    return currentMSecsSinceEpoch() - since;
+  };
+
+  /**
+   * Switches to the virtual time and sets it. The virtual time is never set
+   * back.
+   *
+   * \param msecs Virtual time in milliseconds since the epoch.
+   */
+  static void setVirtualTime( const qint64 msecs );
+
+  /**
+   * Switches back to the system clock.
+   */
+  static void resetVirtualTime();
+
+  /**
+   * \return True, if the virtual time is used.
+   */
+  static bool isVirtual()
+  {
+    return m_isVirtual;
+  };
+
+ private:
+
+  FlightClock() {};
+
+  static bool   m_isVirtual;
+  static qint64 m_virtualTime;
+};
+
+#endif
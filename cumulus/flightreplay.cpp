@@ -0,0 +1,553 @@
+/***********************************************************************
+**
+**   flightreplay.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+#include <cstring>
+
+#include <QtCore>
+
+#include "airspace.h"
+#include "basemapelement.h"
+#include "fixlatency.h"
+#include "flightclock.h"
+#include "flightreplay.h"
+#include "generalconfig.h"
+#include "gliderlistwidget.h"
+#include "mapcalc.h"
+#include "mapconfig.h"
+#include "mapcontents.h"
+#include "mapmatrix.h"
+#include "navbenchmark.h"
+#include "reachablelist.h"
+#include "windanalyser.h"
+
+extern MapContents* _globalMapContents;
+extern MapMatrix*   _globalMapMatrix;
+
+// Minimum length of an IGC B record.
+#define B_RECORD_LENGTH 35
+
+namespace
+{
+  /**
+   * \return The distance of a point to a line segment in projected units.
+   */
+  double segmentDistance( const QPoint& p, const QPoint& a, const QPoint& b )
+  {
+    const double dx = b.x() - a.x();
+    const double dy = b.y() - a.y();
+    const double len2 = dx * dx + dy * dy;
+
+    double t = 0.0;
+
+    if( len2 > 0.0 )
+      {
+        t = ((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / len2;
+        t = qBound( 0.0, t, 1.0 );
+      }
+
+    const double ex = a.x() + t * dx - p.x();
+    const double ey = a.y() + t * dy - p.y();
+
+    return sqrt( ex * ex + ey * ey );
+  }
+
+  /**
+   * Converts an IGC coordinate into KFLog format.
+   *
+   * \param degrees Degrees part of the coordinate.
+   *
+   * \param minutes Minutes multiplied by 1000.
+   *
+   * \param hemisphere One of N, S, E, W.
+   */
+  int igcToKflog( const int degrees, const int minutes, const QChar hemisphere )
+  {
+    int coord = degrees * 600000 + minutes * 10;
+
+    if( hemisphere == 'S' || hemisphere == 'W' )
+      {
+        coord = -coord;
+      }
+
+    return coord;
+  }
+}
+
+FlightReplay::FlightReplay( QObject* parent ) :
+  QObject(parent),
+  m_fixPending(false),
+  m_firstFixTime(-1)
+{
+  memset( &m_statistics, 0, sizeof(m_statistics) );
+
+  GeneralConfig *conf = GeneralConfig::instance();
+
+  // The navigation stack is created like by the main window, but without
+  // any view.
+  _globalMapMatrix = new MapMatrix( this );
+  _globalMapContents = new MapContents( this, 0 );
+  _globalMapConfig = new MapConfig( this );
+
+  BaseMapElement::initMapElement( _globalMapMatrix, _globalMapConfig );
+
+  _globalMapMatrix->slotInitMatrix();
+
+  calculator = new Calculator( this );
+
+  GpsNmea::gps = new GpsNmea( this );
+  GpsNmea::gps->setReplayMode( true );
+
+  m_talker = conf->getGpsSource().left(3);
+
+  // The flight clock must be set before the calculator processes the fix.
+  connect( GpsNmea::gps, SIGNAL( newFix(const QDateTime&) ),
+           this, SLOT( slot_newFix(const QDateTime&) ) );
+
+  connect( GpsNmea::gps, SIGNAL( newVario(const Speed&) ),
+           calculator, SLOT( slot_GpsVariometer(const Speed&) ) );
+  connect( GpsNmea::gps, SIGNAL( newMc(const Speed&) ),
+           calculator, SLOT( slot_Mc(const Speed&) ) );
+  connect( GpsNmea::gps, SIGNAL( newWind(const Speed&, const short) ),
+           calculator, SLOT( slot_GpsWind(const Speed&, const short) ) );
+  connect( GpsNmea::gps, SIGNAL( newSatCount(SatInfo&) ),
+           calculator->getWindAnalyser(), SLOT( slot_newConstellation(SatInfo&) ) );
+  connect( GpsNmea::gps, SIGNAL( newSatConstellation(SatInfo&) ),
+           calculator->getWindAnalyser(), SLOT( slot_newConstellation(SatInfo&) ) );
+  connect( GpsNmea::gps, SIGNAL( statusChange( GpsNmea::GpsStatus ) ),
+           calculator->getWindAnalyser(), SLOT( slot_gpsStatusChange( GpsNmea::GpsStatus ) ) );
+  connect( GpsNmea::gps, SIGNAL( newSpeed(Speed&) ),
+           calculator, SLOT( slot_Speed(Speed&) ) );
+  connect( GpsNmea::gps, SIGNAL( newTas(const Speed&) ),
+           calculator, SLOT( slot_GpsTas(const Speed&) ) );
+  connect( GpsNmea::gps, SIGNAL( newPosition(QPoint&) ),
+           calculator, SLOT( slot_Position(QPoint&) ) );
+  connect( GpsNmea::gps, SIGNAL( newAltitude(Altitude&, Altitude&, Altitude&) ),
+           calculator, SLOT( slot_Altitude(Altitude&, Altitude&, Altitude&) ) );
+  connect( GpsNmea::gps, SIGNAL( newHeading(const double&) ),
+           calculator, SLOT( slot_Heading(const double&) ) );
+  connect( GpsNmea::gps, SIGNAL( newFix(const QDateTime&) ),
+           calculator, SLOT( slot_newFix(const QDateTime&) ) );
+  connect( GpsNmea::gps, SIGNAL( statusChange( GpsNmea::GpsStatus ) ),
+           calculator, SLOT( slot_GpsStatus( GpsNmea::GpsStatus ) ) );
+
+  connect( calculator, SIGNAL( flightModeChanged(Calculator::FlightMode) ),
+           this, SLOT( slot_flightModeChanged(Calculator::FlightMode) ) );
+  connect( calculator->getWindAnalyser(), SIGNAL( newMeasurement(const Vector&, int) ),
+           this, SLOT( slot_windMeasurement(const Vector&, int) ) );
+
+  // Load the data, which are used by the reachable list and the airspace
+  // checks, and the last selected flight task.
+  _globalMapContents->loadPointsAndAirspaces();
+
+  calculator->setGlider( GliderListWidget::getUserSelectedGlider() );
+
+  if( _globalMapContents->restoreFlightTask() )
+    {
+      calculator->slot_startTask();
+    }
+}
+
+FlightReplay::~FlightReplay()
+{
+  // The navigation stack is removed in the reverse order of its creation.
+  delete GpsNmea::gps;
+  GpsNmea::gps = 0;
+
+  delete calculator;
+  calculator = 0;
+
+  delete _globalMapConfig;
+  _globalMapConfig = 0;
+
+  delete _globalMapContents;
+  _globalMapContents = 0;
+
+  delete _globalMapMatrix;
+  _globalMapMatrix = 0;
+
+  FlightClock::resetVirtualTime();
+}
+
+bool FlightReplay::replay( const QString& fileName )
+{
+  QFile file( fileName );
+
+  if( ! file.open( QIODevice::ReadOnly ) )
+    {
+      qWarning() << "FlightReplay::replay: Cannot open file" << fileName;
+      return false;
+    }
+
+  memset( &m_statistics, 0, sizeof(m_statistics) );
+  m_firstFixTime = -1;
+  m_fixPending = false;
+  m_conflicts.clear();
+  m_track.clear();
+
+  QTextStream stream( &file );
+
+  QTime runTime;
+  runTime.start();
+
+  if( QFileInfo( fileName ).suffix().toLower() == "igc" )
+    {
+      replayIgc( stream );
+    }
+  else
+    {
+      replayNmea( stream );
+    }
+
+  m_statistics.runTime = runTime.elapsed();
+  m_statistics.reachableSites = calculator->getReachList()->getNumberSites();
+
+  file.close();
+
+  qDebug( "%s", report().toLatin1().data() );
+
+  return true;
+}
+
+QString FlightReplay::report() const
+{
+  const Statistics& s = m_statistics;
+
+  QString text;
+
+  text  = QString( "Replay: %1 sentences, %2 fixes\n" ).arg( s.sentences ).arg( s.fixes );
+  text += QString( "Flight time: %1 s, run time: %2 ms" ).arg( s.flightTime / 1000 ).arg( s.runTime );
+
+  if( s.runTime > 0 )
+    {
+      text += QString( ", speed up: %1" ).arg( double(s.flightTime) / double(s.runTime), 0, 'f', 0 );
+    }
+
+  text += "\n";
+  text += QString( "Flight mode changes: %1\n" ).arg( s.flightModeChanges );
+  text += QString( "Wind measurements: %1\n" ).arg( s.windMeasurements );
+  text += QString( "Airspace warnings: %1\n" ).arg( s.airspaceWarnings );
+  text += QString( "Reachable sites: %1" ).arg( s.reachableSites );
+
+  return text;
+}
+
+void FlightReplay::slot_newFix( const QDateTime& fixTime )
+{
+  const qint64 time = fixTime.toMSecsSinceEpoch();
+
+  FlightClock::setVirtualTime( time );
+
+  if( m_firstFixTime < 0 )
+    {
+      m_firstFixTime = time;
+    }
+
+  m_statistics.fixes++;
+  m_statistics.flightTime = time - m_firstFixTime;
+  m_fixPending = true;
+}
+
+void FlightReplay::slot_flightModeChanged( Calculator::FlightMode /* mode */ )
+{
+  m_statistics.flightModeChanges++;
+}
+
+void FlightReplay::slot_windMeasurement( const Vector& /* wind */, int /* quality */ )
+{
+  m_statistics.windMeasurements++;
+}
+
+void FlightReplay::replayNmea( QTextStream& stream )
+{
+  while( ! stream.atEnd() )
+    {
+      QString line = stream.readLine().trimmed();
+
+      if( line.startsWith( "$" ) || line.startsWith( "!" ) )
+        {
+          processSentence( line );
+        }
+    }
+}
+
+void FlightReplay::replayIgc( QTextStream& stream )
+{
+  QDate date = QDate::currentDate();
+  QTime lastTime;
+  QPoint lastPos;
+  bool hasLastPos = false;
+  double track = 0.0;
+
+  while( ! stream.atEnd() )
+    {
+      QString line = stream.readLine().trimmed();
+
+      if( line.startsWith( "HFDTE" ) )
+        {
+          // HFDTEDDMMYY or HFDTEDATE:DDMMYY,NN
+          QString ds = line.mid( 5 );
+
+          if( ds.startsWith( "DATE:" ) )
+            {
+              ds = ds.mid( 5 );
+            }
+
+          QDate d = QDate::fromString( ds.left( 6 ), "ddMMyy" );
+
+          if( d.isValid() )
+            {
+              // Two digit years are interpreted as 19xx by Qt.
+              date = d.year() < 1980 ? d.addYears( 100 ) : d;
+            }
+
+          continue;
+        }
+
+      if( ! line.startsWith( "B" ) || line.size() < B_RECORD_LENGTH )
+        {
+          continue;
+        }
+
+      QTime time = QTime::fromString( line.mid( 1, 6 ), "hhmmss" );
+
+      if( ! time.isValid() )
+        {
+          continue;
+        }
+
+      if( lastTime.isValid() )
+        {
+          if( time == lastTime )
+            {
+              continue;
+            }
+
+          if( time < lastTime )
+            {
+              // Midnight has been passed.
+              date = date.addDays( 1 );
+            }
+        }
+
+      const QString lat = line.mid( 7, 7 );
+      const QChar   latHem = line.at( 14 );
+      const QString lon = line.mid( 15, 8 );
+      const QChar   lonHem = line.at( 23 );
+
+      QPoint pos( igcToKflog( lat.left(2).toInt(), lat.mid(2).toInt(), latHem ),
+                  igcToKflog( lon.left(3).toInt(), lon.mid(3).toInt(), lonHem ) );
+
+      const int pressAlt = line.mid( 25, 5 ).toInt();
+      int gnssAlt = line.mid( 30, 5 ).toInt();
+
+      if( gnssAlt == 0 )
+        {
+          gnssAlt = pressAlt;
+        }
+
+      // Speed and track are derived from the last B record.
+      double knots = 0.0;
+
+      if( hasLastPos )
+        {
+          int dt = lastTime.secsTo( time );
+
+          if( dt <= 0 )
+            {
+              dt += 86400;
+            }
+
+          const double km = MapCalc::dist( &lastPos, &pos );
+
+          knots = km * 3600.0 / dt / 1.852;
+
+          if( km > 0.0 )
+            {
+              track = MapCalc::getBearingWgs( lastPos, pos ) * 180.0 / M_PI;
+            }
+        }
+
+      lastTime = time;
+      lastPos = pos;
+      hasLastPos = true;
+
+      const QString utc = line.mid( 1, 6 ) + ".00";
+      const QString nmeaLat = lat.left(4) + "." + lat.mid(4) + "," + latHem;
+      const QString nmeaLon = lon.left(5) + "." + lon.mid(5) + "," + lonHem;
+
+      // Altitudes are reported before RMC, which completes the fix.
+      processSentence( QString( "%1GGA,%2,%3,%4,1,08,1.0,%5,M,0.0,M,," )
+                       .arg( m_talker ).arg( utc ).arg( nmeaLat ).arg( nmeaLon )
+                       .arg( gnssAlt ) );
+
+      if( pressAlt != 0 )
+        {
+          processSentence( QString( "$PGRMZ,%1,F,2" )
+                           .arg( qRound( pressAlt / 0.3048 ) ) );
+        }
+
+      processSentence( QString( "%1RMC,%2,A,%3,%4,%5,%6,%7,,,A" )
+                       .arg( m_talker ).arg( utc ).arg( nmeaLat ).arg( nmeaLon )
+                       .arg( knots, 0, 'f', 1 )
+                       .arg( track, 0, 'f', 1 )
+                       .arg( date.toString( "ddMMyy" ) ) );
+    }
+}
+
+void FlightReplay::processSentence( const QString& sentence )
+{
+  m_statistics.sentences++;
+
+  GpsNmea::gps->slot_sentence( addChecksum( sentence ) );
+
+  if( m_fixPending )
+    {
+      m_fixPending = false;
+      m_track.append( calculator->getlastPosition() );
+      checkAirspaces();
+
+      // Without a map the fix is complete after the airspace check.
+      FixLatency::record( calculator->getPositionIngestTime() );
+    }
+}
+
+QString FlightReplay::addChecksum( const QString& sentence )
+{
+  if( sentence.contains( '*' ) || ! sentence.startsWith( "$" ) )
+    {
+      return sentence;
+    }
+
+  uchar sum = 0;
+
+  for( int i = 1; i < sentence.size(); i++ )
+    {
+      sum ^= static_cast<uchar> (sentence.at(i).toLatin1());
+    }
+
+  return sentence + QString( "*%1" ).arg( uint(sum), 2, 16, QChar('0') ).toUpper();
+}
+
+void FlightReplay::checkAirspaces()
+{
+  NavBenchmark::Timer timer( NavBenchmark::AirspaceCheck );
+
+  GeneralConfig* conf = GeneralConfig::instance();
+
+  if( conf->getAirspaceWarningEnabled() == false )
+    {
+      return;
+    }
+
+  const QPoint pos = calculator->getlastPosition();
+  const QPoint projPos = _globalMapMatrix->wgsToMap( pos );
+
+  // Length in meters of a projected unit near to the position.
+  QPoint north( pos.x() + 6000, pos.y() );
+  const QPoint projNorth = _globalMapMatrix->wgsToMap( north );
+
+  const double dx = projNorth.x() - projPos.x();
+  const double dy = projNorth.y() - projPos.y();
+  const double units = sqrt( dx * dx + dy * dy );
+
+  if( units <= 0.0 )
+    {
+      return;
+    }
+
+  QPoint p = pos;
+  const double unitLength = MapCalc::dist( &p, &north ) * 1000.0 / units;
+
+  AltitudeCollection alt = calculator->getAltitudeCollection();
+  AirspaceWarningDistance awd = conf->getAirspaceWarningDistances();
+
+  const double nearUnits = awd.horClose.getMeters() / unitLength;
+  const double veryNearUnits = awd.horVeryClose.getMeters() / unitLength;
+  const int margin = static_cast<int> (ceil( nearUnits ));
+
+  SortableAirspaceList* asl = _globalMapContents->getAirspaceList();
+
+  for( int i = 0; i < asl->size(); i++ )
+    {
+      Airspace* as = asl->at(i);
+
+      // FIRs are not included in the conflict checks, like by the map.
+      if( as->getTypeID() == BaseMapElement::AirFir ||
+          conf->getItemDrawingEnabled( as->getTypeID() ) == false )
+        {
+          continue;
+        }
+
+      Airspace::ConflictType conflict = as->conflicts( alt, awd );
+
+      if( conflict != Airspace::none )
+        {
+          Airspace::ConflictType hConflict = Airspace::none;
+
+          QRect box = as->getProjectedBoundingBox().adjusted( -margin, -margin, margin, margin );
+
+          if( box.contains( projPos ) )
+            {
+              const QPolygon& polygon = as->getProjectedPolygon();
+
+              if( polygon.containsPoint( projPos, Qt::OddEvenFill ) )
+                {
+                  hConflict = Airspace::inside;
+                }
+              else
+                {
+                  double dist = nearUnits + 1.0;
+
+                  for( int j = 0; j < polygon.size(); j++ )
+                    {
+                      dist = qMin( dist, segmentDistance( projPos,
+                                                          polygon.at(j),
+                                                          polygon.at( (j + 1) % polygon.size() ) ) );
+                    }
+
+                  if( dist <= veryNearUnits )
+                    {
+                      hConflict = Airspace::veryNear;
+                    }
+                  else if( dist <= nearUnits )
+                    {
+                      hConflict = Airspace::near;
+                    }
+                }
+            }
+
+          // the resulting conflict is always the lesser of the two
+          conflict = qMin( conflict, hConflict );
+        }
+
+      const int lastConflict = m_conflicts.value( as, Airspace::none );
+
+      if( conflict > lastConflict )
+        {
+          // The map warns about every increased conflict.
+          m_statistics.airspaceWarnings++;
+        }
+
+      if( conflict == Airspace::none )
+        {
+          m_conflicts.remove( as );
+        }
+      else
+        {
+          m_conflicts.insert( as, conflict );
+        }
+    }
+}
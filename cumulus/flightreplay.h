@@ -0,0 +1,196 @@
+/***********************************************************************
+**
+**   flightreplay.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class FlightReplay
+ *
+ * \brief Headless replay of a recorded flight through the navigation stack.
+ *
+ * The replay reads a recorded NMEA or IGC file and passes its sentences
+ * directly to GpsNmea::slot_sentence. IGC B records are converted into
+ * RMC, GGA and PGRMZ sentences before. No main window and no map widget is
+ * created, the sentences are processed as fast as the CPU allows.
+ *
+ * The flight clock is switched to a virtual time, which follows the fix times
+ * of the recorded flight. Therefore the calculator, the wind analyser, the
+ * variometer and the reachable list work like in a real flight. Instead of
+ * the map, the replay checks the loaded airspaces at every fix.
+ *
+ * The replay is started by the command line option --replay \<file\>.
+ * Under Qt5 the option -platform offscreen avoids the need of a display.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef FLIGHT_REPLAY_H
+#define FLIGHT_REPLAY_H
+
+#include <QDate>
+#include <QHash>
+#include <QObject>
+#include <QPoint>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+
+#include "calculator.h"
+#include "gpsnmea.h"
+
+class Airspace;
+class Vector;
+
+class FlightReplay : public QObject
+{
+  Q_OBJECT
+
+ private:
+
+  Q_DISABLE_COPY ( FlightReplay )
+
+ public:
+
+  /**
+   * Statistics of a replay run.
+   */
+  struct Statistics
+  {
+    /** Number of processed sentences. */
+    int sentences;
+
+    /** Number of processed fixes. */
+    int fixes;
+
+    /** Recorded flight time in ms. */
+    qint64 flightTime;
+
+    /** Run time of the replay in ms. */
+    qint64 runTime;
+
+    /** Number of flight mode changes. */
+    int flightModeChanges;
+
+    /** Number of wind measurements of the wind analyser. */
+    int windMeasurements;
+
+    /** Number of new airspace conflicts. */
+    int airspaceWarnings;
+
+    /** Number of reachable sites at the end of the flight. */
+    int reachableSites;
+  };
+
+  /**
+   * Creates the navigation stack, if it does not exist yet. The airfields,
+   * the airspaces and the last selected flight task are loaded.
+   */
+  FlightReplay( QObject* parent=0 );
+
+  virtual ~FlightReplay();
+
+  /**
+   * Replays a recorded flight. Files with the suffix igc are read as IGC
+   * file, all other files as NMEA file.
+   *
+   * \param fileName Path of the file to be replayed.
+   *
+   * \return True in case of success otherwise false.
+   */
+  bool replay( const QString& fileName );
+
+  /**
+   * \return The statistics of the last replay.
+   */
+  const Statistics& getStatistics() const
+  {
+    return m_statistics;
+  };
+
+  /**
+   * \return A text report of the last replay.
+   */
+  QString report() const;
+
+  /**
+   * \return The positions of the fixes of the last replay.
+   */
+  const QVector<QPoint>& getTrack() const
+  {
+    return m_track;
+  };
+
+ private slots:
+
+  /** Called by GpsNmea, if a new fix has been received. */
+  void slot_newFix( const QDateTime& fixTime );
+
+  /** Called by the calculator, if the flight mode has been changed. */
+  void slot_flightModeChanged( Calculator::FlightMode mode );
+
+  /** Called by the wind analyser, if a new wind has been measured. */
+  void slot_windMeasurement( const Vector& wind, int quality );
+
+ private:
+
+  /**
+   * Passes the lines of a NMEA file to GpsNmea.
+   */
+  void replayNmea( QTextStream& stream );
+
+  /**
+   * Converts the B records of an IGC file into NMEA sentences and passes
+   * them to GpsNmea.
+   */
+  void replayIgc( QTextStream& stream );
+
+  /**
+   * Passes a sentence to GpsNmea and checks the airspaces, if the sentence
+   * has completed a fix.
+   */
+  void processSentence( const QString& sentence );
+
+  /**
+   * Appends the checksum to a sentence, which starts with $ and has no
+   * checksum yet.
+   */
+  static QString addChecksum( const QString& sentence );
+
+  /**
+   * Checks the loaded airspaces at the current position and altitude,
+   * like the map does it during a real flight.
+   */
+  void checkAirspaces();
+
+  /** Statistics of the current replay. */
+  Statistics m_statistics;
+
+  /** Flag to indicate, that a new fix has to be post processed. */
+  bool m_fixPending;
+
+  /** Time of the first fix in ms. */
+  qint64 m_firstFixTime;
+
+  /** Last conflict per airspace. */
+  QHash<Airspace*, int> m_conflicts;
+
+  /** Positions of the replayed fixes. */
+  QVector<QPoint> m_track;
+
+  /** NMEA talker prefix expected by GpsNmea, e.g. $GP. */
+  QString m_talker;
+};
+
+#endif
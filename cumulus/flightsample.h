@@ -0,0 +1,204 @@
+/***********************************************************************
+**
+**   flightsample.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2002      by André Somers
+**                   2008-2016 by Axel Pauli
+**                   2026      by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef FLIGHT_SAMPLE_H
+#define FLIGHT_SAMPLE_H
+
+#include <QtGlobal>
+#include <QDateTime>
+#include <QPoint>
+
+#include "altitude.h"
+#include "ringbuffer.h"
+#include "speed.h"
+#include "vector.h"
+
+/**
+ * \class FlightSample
+ *
+ * \author André Somers, Axel Pauli
+ *
+ * \brief A single sample from a flight data.
+ *
+ * This class represents a single sample of flight data obtained. It is a
+ * plain data structure without any heap members, so that it can be stored
+ * in large preallocated histories and copied cheaply.
+ *
+ * \date 2002-2026
+ *
+ * \version 1.3
+ */
+class FlightSample
+{
+
+public:
+
+  /**
+   * UTC time in milliseconds since the epoch, when the sample was taken.
+   */
+  qint64 time;
+
+  /**
+   * Latitude in KFLog format
+   */
+  qint32 lat;
+
+  /**
+   * Longitude in KFLog format
+   */
+  qint32 lon;
+
+  /**
+   * User altitude of point in meters. May be adapted by the user.
+   */
+  float altitude;
+
+  /**
+   * Pressure Altitude of point in meters, if available. Otherwise it is
+   * derived from the GNSSAltitude.
+   */
+  float STDAltitude;
+
+  /**
+   * GPS altitude of point in meters
+   */
+  float GNSSAltitude;
+
+  /**
+   * Ground speed in meters per second
+   */
+  float speed;
+
+  /**
+   * Current airspeed in meters per second, 0 if unknown
+   */
+  float airspeed;
+
+  /**
+   * Heading in degrees
+   */
+  qint16 heading;
+
+  /**
+  * Unique marker. Can be used to reference a certain record/sample.
+  */
+  int marker;
+
+  /**
+   * @return The position in KFLog format.
+   */
+  QPoint getPosition() const
+  {
+    return QPoint( lat, lon );
+  };
+
+  void setPosition( const QPoint& pos )
+  {
+    lat = pos.x();
+    lon = pos.y();
+  };
+
+  /**
+   * @return Speed and direction over ground.
+   */
+  Vector getVector() const
+  {
+    return Vector( static_cast<int> (heading), Speed( double(speed) ) );
+  };
+
+  /**
+   * @return The UTC date and time of the sample.
+   */
+  QDateTime getDateTime() const
+  {
+    return QDateTime::fromMSecsSinceEpoch( time ).toUTC();
+  };
+};
+
+/**
+ * \class FlightSampleList
+ *
+ * \brief Ring buffer history of flight samples.
+ *
+ * Index 0 is the newest sample. The sample times are monotonic increasing,
+ * so that time window queries can be answered by a binary search.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+class FlightSampleList : public RingBuffer<FlightSample>
+{
+
+public:
+
+  FlightSampleList( int limit=10 ) :
+    RingBuffer<FlightSample>( limit )
+  {
+  };
+
+  /**
+   * @return The number of samples taken at or after the passed time in ms.
+   *         These are the samples with the indices 0...n-1.
+   */
+  int countSince( const qint64 since ) const
+  {
+    // Times are descending with the index, look for the first older sample.
+    int lo = 0;
+    int hi = count();
+
+    while( lo < hi )
+      {
+        int mid = (lo + hi) / 2;
+
+        if( at( mid ).time >= since )
+          {
+            lo = mid + 1;
+          }
+        else
+          {
+            hi = mid;
+          }
+      }
+
+    return lo;
+  };
+
+  /**
+   * @return The number of samples taken in the last seconds relative to the
+   *         newest sample.
+   */
+  int countLastSeconds( const double seconds ) const
+  {
+    if( isEmpty() )
+      {
+        return 0;
+      }
+
+    return countSince( at(0).time - static_cast<qint64> (seconds * 1000.0) );
+  };
+
+  /**
+   * @return The time span in ms between the newest and the oldest sample.
+   */
+  qint64 timeSpan() const
+  {
+    return isEmpty() ? 0 : at(0).time - last().time;
+  };
+};
+
+#endif
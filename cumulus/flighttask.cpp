@@ -868,6 +868,29 @@ void FlightTask::drawTask( QPainter* painter, QList<TaskPoint*> &drawnTp )
       }
     }
 
+  // Draw the optimized route from the current position over the touch
+  // points of the remaining task points.
+  const TaskOptimizer& optimizer = calculator->getTaskOptimizer();
+
+  if( selectedTp != 0 && optimizer.isValid() &&
+      optimizer.getTpIndex() == calculator->getTargetWp()->taskPointIndex &&
+      optimizer.getTouchPoints().size() == tpList->count() )
+    {
+      QPolygon route;
+
+      route.append( glMapMatrix->map( glMapMatrix->wgsToMap( calculator->getlastPosition() ) ) );
+
+      for( int i = optimizer.getTpIndex(); i < tpList->count(); i++ )
+        {
+          route.append( glMapMatrix->map( glMapMatrix->wgsToMap( optimizer.getTouchPoints().at(i) ) ) );
+        }
+
+      painter->setClipping( false );
+      painter->setBrush( Qt::NoBrush );
+      painter->setPen( QPen( courseLineColor, courseLineWidth, Qt::DashLine ) );
+      painter->drawPolyline( route );
+    }
+
   // Restore the previous painter state.
   painter->restore();
 }
@@ -1140,101 +1163,78 @@ FlightTask::calculateFinalGlidePath( const int taskPointIndex,
                                      Altitude &arrivalAlt,
                                      Speed &bestSpeed )
 {
-  int wpCount = tpList->count();
-
   arrivalAlt.setInvalid();
   bestSpeed.setInvalid();
 
-  if( taskPointIndex >= wpCount )
+  if( taskPointIndex >= tpList->count() )
     {
       // taskPointIndex points behind the end of the list
       return ReachablePoint::no;
     }
 
-  // fetch current altitude
-  Altitude curAlt = calculator->getlastAltitude();
-
-  // fetch minimal arrival altitude
-  Altitude minAlt( GeneralConfig::instance()->getSafetyAltitude().getMeters() );
-
-  // used altitude
-  Altitude usedAlt(0);
-  Altitude arrAlt(0);
-  Speed speed(0);
-
-  // calculate bearing from current position to the next task point from
-  // task in radian
-  int bearing = int ( rint( MapCalc::getBearingWgs( calculator->getlastPosition(),
-                                                    tpList->at( taskPointIndex )->getWGSPosition() ) ));
+  // The legs lead over the optimized touch points, if they are solved for
+  // the same next task point.
+  const TaskOptimizer& optimizer = calculator->getTaskOptimizer();
 
-  // calculate distance from current position to the next task point from
-  // task in km
-  QPoint p1 = calculator->getlastPosition();
-  QPoint p2 = tpList->at( taskPointIndex )->getWGSPosition();
-  double distance = MapCalc::dist( &p1, &p2 );
+  const QVector<QPoint>* touchPoints = 0;
 
-  bool res = calculator->glidePath( bearing, Distance(distance * 1000.0),
-                                    tpList->at( taskPointIndex )->getElevation(),
-                                    arrAlt, bestSpeed );
+  if( optimizer.isValid() && optimizer.getTpIndex() == taskPointIndex )
+    {
+      touchPoints = &optimizer.getTouchPoints();
+    }
 
-  if( ! res )
+  // The legs are integrated with the wind of the passed altitudes and are
+  // checked against the terrain.
+  const TaskGlideSolver::Result& result =
+    calculator->getTaskGlideSolver().solve( *tpList,
+                                            taskPointIndex,
+                                            calculator->getlastPosition(),
+                                            calculator->getlastAltitude(),
+                                            calculator->getPolar(),
+                                            calculator->getlastMc(),
+                                            (int) GeneralConfig::instance()->getSafetyAltitude().getMeters(),
+                                            calculator->getWindStore()->getWindMeasurementList(),
+                                            calculator->getLastWind(),
+                                            touchPoints );
+
+  if( ! result.arrivalAlt.isValid() )
     {
       return ReachablePoint::no; // glide path calculation failed, no glider selected
     }
 
 #ifdef CUMULUS_DEBUG
-  qDebug( "WP=%s, Bearing=%.1f°, Dist=%.1fkm, Ele=%.1fm, ArrAlt=%.1f",
-          tpList->at( taskPointIndex )->name.toLatin1().data(),
-          bearing*180/M_PI,
-          distance,
-          tpList->at( taskPointIndex )->elevation,
-          arrAlt.getMeters() );
+  qDebug( "FinalGlide: TP=%d, Required=%.0fm, ArrAlt=%.0fm, Clearance=%.0fm",
+          taskPointIndex,
+          result.requiredAlt.getMeters(),
+          result.arrivalAlt.getMeters(),
+          result.obstacleClearance.getMeters() );
 #endif
 
-  // Summarize single altitudes, if the taskpoint is not the last one.
-  usedAlt = curAlt-arrAlt;
+  arrivalAlt = result.arrivalAlt;
+  bestSpeed  = result.bestSpeed;
 
-  for( int i=taskPointIndex; i+1 < wpCount; i++ )
-    {
-      if( tpList->at(i)->getWGSPosition() == tpList->at(i+1)->getWGSPosition() )
-        {
-          continue; // points are equal, we ignore them
-        }
-
-      res = calculator->glidePath( (int) rint( tpList->at( i+1 )->bearing ),
-                                   Distance( tpList->at( i+1 )->distance * 1000.0),
-                                   tpList->at( i+1 )->getElevation(),
-                                   arrAlt, speed );
-#ifdef CUMULUS_DEBUG
-      qDebug( "WP=%s, Bearing=%.1f°, Dist=%.1fkm, Ele=%.1m, ArrAlt=%.1f",
-              tpList->at( i+1 )->name.toLatin1().data(),
-              tpList->at( i+1 )->bearing*180/M_PI,
-              tpList->at( i+1 )->distance,
-              tpList->at( i+1 )->elevation,
-              arrAlt.getMeters() );
-#endif
-
-      // We calculate the real altitude usage. The glidePath method
-      // delivers only an arrival altitude for one calculation. But we
-      // need the total consumed altitude. Because the minimal arrival
-      // altitude is already contained in the first done calculation,
-      // we don't need it to consider again.
-      usedAlt += curAlt - arrAlt - minAlt;
-    }
+  return result.reach;
+}
 
-  arrivalAlt = curAlt-usedAlt;
+double FlightTask::getRemainingDistance( const int taskPointIndex,
+                                         const double dist2Next ) const
+{
+  const TaskOptimizer& optimizer = calculator->getTaskOptimizer();
 
-  if( arrivalAlt >= minAlt )
+  if( optimizer.isValid() && optimizer.getTpIndex() == taskPointIndex &&
+      optimizer.getTouchPoints().size() == tpList->count() )
     {
-      return ReachablePoint::yes;
+      return optimizer.getRemainingDistance( calculator->getlastPosition() );
     }
 
-  if( arrivalAlt.getMeters() > 0.0 )
+  double distance = dist2Next;
+
+  for( int loop = taskPointIndex + 1; loop < tpList->count(); loop++ )
     {
-      return ReachablePoint::belowSafety;
+      distance += tpList->at(loop)->distance;
     }
 
-  return ReachablePoint::no;
+  return distance;
 }
 
 QString FlightTask::getTaskDistanceString( bool unit ) const
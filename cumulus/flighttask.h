@@ -359,6 +359,18 @@ class FlightTask : public BaseMapElement
                                Altitude &arrivalAlt,
                                Speed &bestSpeed );
 
+  /**
+   * Calculates the distance in km from the current position over the
+   * remaining task points to the final target. The route leads over the
+   * optimized touch points, if they are solved for the next TP.
+   *
+   * taskPointIndex: index of next TP in waypoint list
+   * dist2Next: distance in km to the center of the next TP
+   *
+   */
+  double getRemainingDistance( const int taskPointIndex,
+                               const double dist2Next ) const;
+
   virtual bool isVisible() const
     {
       return true;
@@ -118,6 +118,7 @@ void GeneralConfig::load()
   _guiMenuFont           = value("MenuFont", "").toString();
   _virtualKeyboard       = value("VirtualKeyboard", false).toBool();
   _screenSaverSpeedLimit = value("ScreenSaverSpeedLimit", 10).toDouble();
+  _performanceOverlay    = value("PerformanceOverlay", false).toBool();
   _resetConfiguration    = value("ResetConfiguration", 0).toInt();
   endGroup();
 
@@ -251,6 +252,8 @@ void GeneralConfig::load()
                                     GeneralConfig::landingTarget ).toInt();
   _qnh                    = value( "QNH", 1013 ).toInt();
   _bRecordInterval        = value( "B-RecordLoggerInterval", 3 ).toInt();
+  _bRecordCirclingInterval = value( "B-RecordCirclingLoggerInterval", 0 ).toInt();
+  _igcExtensions          = value( "IgcExtensions", IgcFxa | IgcSiu ).toInt();
   _kRecordInterval        = value( "K-RecordLoggerInterval", 0 ).toInt();
   _loggerAutostartMode    = value( "LoggerAutostartMode", true ).toBool();
   _tas                    = Speed(value( "TAS", 100.0 ).toDouble());
@@ -316,6 +319,7 @@ void GeneralConfig::load()
                                                          GeneralConfig::Touched ).toInt();
 
   _reportTaskpointSwitch = value( "ReportTaskpointSwitch", true ).toBool();
+  _taskMaximizeAreas     = value( "MaximizeAreas", false ).toBool();
   _taskDrawShape         = value( "DrawShape", true ).toBool();
   _taskFillShape         = value( "FillShape", true ).toBool();
   _taskPointAutoZoom     = value( "AutoZoom", true ).toBool();
@@ -383,6 +387,10 @@ void GeneralConfig::load()
   _mapShowWaypointLabels          = value( "ShowWaypointLabels", false ).toBool();
   _mapShowLabelsExtraInfo         = value( "ShowLabelsExtraInfo", false ).toBool();
   _mapShowRelBearingInfo          = value( "ShowRelBearingInfo", true ).toBool();
+  _mapShowGlideFootprint          = value( "ShowGlideFootprint", true ).toBool();
+  _mapShowContest                 = value( "ShowContest", false ).toBool();
+  _mapShowThermals                = value( "ShowThermals", false ).toBool();
+  _mapShowThermalCentering        = value( "ShowThermalCentering", true ).toBool();
   _mapCurrentTask                 = value( "CurrentTask", "" ).toString();
 
   _wayPointScaleBorders[Waypoint::Low]    = value( "WpScaleBorderLow", 125 ).toInt();
@@ -476,6 +484,8 @@ void GeneralConfig::load()
   _nearestSiteCalculatorSwitch   = value( "NearestSiteCalculatorOn",
                                           NEAREST_SITE_CALCULATOR_DEFAULT ).toBool();
   _maxNearestSiteCalculatorSites = value("MaxNumberOfSitesInList", 50).toInt();
+  _nearestSiteTerrainCheck       = value( "NearestSiteTerrainCheck",
+                                          NEAREST_SITE_TERRAIN_CHECK_DEFAULT ).toBool();
   endGroup();
 
   beginGroup("Information");
@@ -513,6 +523,9 @@ void GeneralConfig::load()
   _gpsHardStart       = value( "HardStart", false ).toBool();
   _gpsSyncSystemClock = value( "SyncSystemClock", false ).toBool();
   _gpsNmeaLogState    = value( "NmeaLogState", false ).toBool();
+  _gpsTrailRate       = value( "TrailRate", 1.0 ).toDouble();
+  _gpsLoggerRate      = value( "LoggerRate", 1.0 ).toDouble();
+  _gpsDisplayRate     = value( "DisplayRate", 2.0 ).toDouble();
   _gpsIpcPort         = value( "IpcPort", 0 ).toInt();
   _gpsStartClient     = value( "StartClient", true ).toBool();
   _gpsLastFixLat      = value( "LastFixLat", 0 ).toInt();
@@ -600,6 +613,7 @@ void GeneralConfig::save()
   setValue("MenuFont", _guiMenuFont);
   setValue("VirtualKeyboard", _virtualKeyboard);
   setValue("ScreenSaverSpeedLimit", _screenSaverSpeedLimit);
+  setValue("PerformanceOverlay", _performanceOverlay);
   setValue("ResetConfiguration", _resetConfiguration);
   endGroup();
 
@@ -719,6 +733,8 @@ void GeneralConfig::save()
   setValue( "ArrivalAltitudeDisplay",  _arrivalAltitudeDisplay );
   setValue( "QNH", _qnh );
   setValue( "B-RecordLoggerInterval", _bRecordInterval );
+  setValue( "B-RecordCirclingLoggerInterval", _bRecordCirclingInterval );
+  setValue( "IgcExtensions", _igcExtensions );
   setValue( "K-RecordLoggerInterval", _kRecordInterval );
   setValue( "LoggerAutostartMode", _loggerAutostartMode );
   setValue( "TAS", _tas.getMps() );
@@ -768,6 +784,7 @@ void GeneralConfig::save()
   setValue( "ActiveObserverScheme", _taskActiveObsScheme );
   setValue( "ActiveSwitchScheme", _taskActiveSwitchScheme );
   setValue( "ReportTaskpointSwitch", _reportTaskpointSwitch );
+  setValue( "MaximizeAreas", _taskMaximizeAreas );
   setValue( "DrawShape", _taskDrawShape );
   setValue( "FillShape", _taskFillShape );
   setValue( "AutoZoom", _taskPointAutoZoom );
@@ -819,6 +836,10 @@ void GeneralConfig::save()
   setValue( "ShowWaypointLabels", _mapShowWaypointLabels );
   setValue( "ShowLabelsExtraInfo", _mapShowLabelsExtraInfo );
   setValue( "ShowRelBearingInfo", _mapShowRelBearingInfo );
+  setValue( "ShowGlideFootprint", _mapShowGlideFootprint );
+  setValue( "ShowContest", _mapShowContest );
+  setValue( "ShowThermals", _mapShowThermals );
+  setValue( "ShowThermalCentering", _mapShowThermalCentering );
   setValue( "CurrentTask", _mapCurrentTask );
 
   setValue( "LoadRoads", _mapLoadRoads );
@@ -926,6 +947,7 @@ void GeneralConfig::save()
   beginGroup("NearestSitesCalc");
   setValue( "NearestSiteCalculatorOn", _nearestSiteCalculatorSwitch );
   setValue( "MaxNumberOfSitesInList", _maxNearestSiteCalculatorSites );
+  setValue( "NearestSiteTerrainCheck", _nearestSiteTerrainCheck );
   endGroup();
 
   beginGroup("Information");
@@ -953,6 +975,9 @@ void GeneralConfig::save()
   setValue( "SoftStart", _gpsSoftStart );
   setValue( "SyncSystemClock", _gpsSyncSystemClock );
   setValue( "NmeaLogState", _gpsNmeaLogState );
+  setValue( "TrailRate", _gpsTrailRate );
+  setValue( "LoggerRate", _gpsLoggerRate );
+  setValue( "DisplayRate", _gpsDisplayRate );
   setValue( "IpcPort", _gpsIpcPort );
   setValue( "StartClient", _gpsStartClient );
   setValue( "LastFixLat", _gpsLastFixLat );
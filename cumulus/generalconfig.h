@@ -62,6 +62,8 @@
 #define ALARM_SOUND_DEFAULT true
 // default for calculator of nearest sites (true = ON)
 #define NEAREST_SITE_CALCULATOR_DEFAULT true
+// default for the terrain check of the nearest sites (true = ON)
+#define NEAREST_SITE_TERRAIN_CHECK_DEFAULT true
 
 // default airspace fillings
 #define AS_FILL_NOT_NEAR   0
@@ -141,6 +143,15 @@ class GeneralConfig : protected QSettings
     inHg = 1
   };
 
+  /** Extensions of the IGC B record, which can be combined. */
+  enum IgcExtension
+  {
+    IgcFxa = 1,
+    IgcSiu = 2,
+    IgcTas = 4,
+    IgcVar = 8
+  };
+
  private:
 
   /**
@@ -1003,6 +1014,18 @@ class GeneralConfig : protected QSettings
     _screenSaverSpeedLimit = newValue;
   };
 
+  /** gets performance overlay usage */
+  bool getPerformanceOverlay() const
+  {
+    return _performanceOverlay;
+  };
+
+  /** sets performance overlay usage */
+  void setPerformanceOverlay( const bool newValue )
+  {
+    _performanceOverlay = newValue;
+  };
+
   /** gets auto logger start speed in Km/h */
   double getAutoLoggerStartSpeed() const
   {
@@ -1037,6 +1060,28 @@ class GeneralConfig : protected QSettings
     _bRecordInterval = newValue;
   };
 
+  /** gets B-Record logger interval during circling, 0 means off */
+  int getBRecordCirclingInterval() const
+  {
+    return _bRecordCirclingInterval;
+  };
+  /** sets B-Record logger interval during circling */
+  void setBRecordCirclingInterval( const int newValue )
+  {
+    _bRecordCirclingInterval = newValue;
+  };
+
+  /** gets the IGC B-Record extensions as combination of IgcExtension */
+  int getIgcExtensions() const
+  {
+    return _igcExtensions;
+  };
+  /** sets the IGC B-Record extensions */
+  void setIgcExtensions( const int newValue )
+  {
+    _igcExtensions = newValue;
+  };
+
   /** gets K-Record logger interval */
   int getKRecordInterval() const
   {
@@ -1428,6 +1473,50 @@ class GeneralConfig : protected QSettings
     _mapShowRelBearingInfo = newValue;
   };
 
+  /** gets Map ShowGlideFootprint */
+  bool getMapShowGlideFootprint() const
+  {
+    return _mapShowGlideFootprint;
+  };
+  /** sets Map ShowGlideFootprint */
+  void setMapShowGlideFootprint(const bool newValue)
+  {
+    _mapShowGlideFootprint = newValue;
+  };
+
+  /** gets Map ShowContest */
+  bool getMapShowContest() const
+  {
+    return _mapShowContest;
+  };
+  /** sets Map ShowContest */
+  void setMapShowContest(const bool newValue)
+  {
+    _mapShowContest = newValue;
+  };
+
+  /** gets Map ShowThermals */
+  bool getMapShowThermals() const
+  {
+    return _mapShowThermals;
+  };
+  /** sets Map ShowThermals */
+  void setMapShowThermals(const bool newValue)
+  {
+    _mapShowThermals = newValue;
+  };
+
+  /** gets Map ShowThermalCentering */
+  bool getMapShowThermalCentering() const
+  {
+    return _mapShowThermalCentering;
+  };
+  /** sets Map ShowThermalCentering */
+  void setMapShowThermalCentering(const bool newValue)
+  {
+    _mapShowThermalCentering = newValue;
+  };
+
   /** gets Map ShowLabelsExtraInfo */
   bool getMapShowLabelsExtraInfo() const
   {
@@ -1792,6 +1881,18 @@ class GeneralConfig : protected QSettings
     _nearestSiteCalculatorSwitch = newValue;
   };
 
+  /** gets nearest site terrain check switch */
+  bool getNearestSiteTerrainCheck() const
+  {
+    return _nearestSiteTerrainCheck;
+  };
+
+  /** sets nearest site terrain check switch */
+  void setNearestSiteTerrainCheck(const bool newValue)
+  {
+    _nearestSiteTerrainCheck = newValue;
+  };
+
   /** gets max nearest site calculator sites */
   int getMaxNearestSiteCalculatorSites() const
   {
@@ -1954,6 +2055,39 @@ class GeneralConfig : protected QSettings
     _gpsNmeaLogState = newValue;
   }
 
+  /** gets the trail fix rate in Hz, 0 means all fixes */
+  double getGpsTrailRate() const
+  {
+    return _gpsTrailRate;
+  }
+  /** sets the trail fix rate in Hz, 0 means all fixes */
+  void setGpsTrailRate(const double newValue)
+  {
+    _gpsTrailRate = newValue;
+  }
+
+  /** gets the logger fix rate in Hz, 0 means all fixes */
+  double getGpsLoggerRate() const
+  {
+    return _gpsLoggerRate;
+  }
+  /** sets the logger fix rate in Hz, 0 means all fixes */
+  void setGpsLoggerRate(const double newValue)
+  {
+    _gpsLoggerRate = newValue;
+  }
+
+  /** gets the display fix rate in Hz, 0 means all fixes */
+  double getGpsDisplayRate() const
+  {
+    return _gpsDisplayRate;
+  }
+  /** sets the display fix rate in Hz, 0 means all fixes */
+  void setGpsDisplayRate(const double newValue)
+  {
+    _gpsDisplayRate = newValue;
+  }
+
   /** gets Gps Ipc port */
   ushort getGpsIpcPort() const;
   /** sets Gps Ipc port */
@@ -2323,6 +2457,24 @@ class GeneralConfig : protected QSettings
     _reportTaskpointSwitch = value;
   };
 
+  /**
+   * Gets the flag, if the route through the task point figures shall be
+   * maximized like in an assigned area task.
+   */
+  bool getTaskMaximizeAreas() const
+  {
+    return _taskMaximizeAreas;
+  };
+
+  /**
+   * Sets the flag, if the route through the task point figures shall be
+   * maximized like in an assigned area task.
+   */
+  void setTaskMaximizeAreas( const bool value )
+  {
+    _taskMaximizeAreas = value;
+  };
+
   /** Gets task shape alpha transparency. 0 represents a fully
       transparent color, while 255 represents a fully opaque
       color. See also
@@ -3053,10 +3205,16 @@ class GeneralConfig : protected QSettings
   bool _virtualKeyboard;
   // Screen saver speed limit
   double _screenSaverSpeedLimit;
+  // Performance overlay on the map with trace data
+  bool _performanceOverlay;
   // QNH
   int _qnh;
   // B-Record logger interval
   int _bRecordInterval;
+  // B-Record logger interval during circling
+  int _bRecordCirclingInterval;
+  // IGC B-Record extensions
+  int _igcExtensions;
   // K-Record logger interval
   int _kRecordInterval;
   // auto logger start mode
@@ -3147,6 +3305,14 @@ class GeneralConfig : protected QSettings
   bool _mapShowOutLandingLabels;
   // relative bearing info
   bool _mapShowRelBearingInfo;
+  // glide range footprint
+  bool _mapShowGlideFootprint;
+  // contest routes of the flight
+  bool _mapShowContest;
+  // learned thermals
+  bool _mapShowThermals;
+  // estimated thermal core
+  bool _mapShowThermalCentering;
   // Map LoadRoads
   bool _mapLoadRoads;
   // Map LoadMotorways
@@ -3207,6 +3373,8 @@ class GeneralConfig : protected QSettings
 
   // nearest site calculator switch
   bool _nearestSiteCalculatorSwitch;
+  // check glide lines of the nearest sites against the terrain
+  bool _nearestSiteTerrainCheck;
   // maximum sites considered by nearest site calculator
   int _maxNearestSiteCalculatorSites;
 
@@ -3253,6 +3421,12 @@ class GeneralConfig : protected QSettings
   bool _gpsSyncSystemClock;
   // Gps NMEA log state
   bool _gpsNmeaLogState;
+  // Gps fix rate forwarded to the trail in Hz
+  double _gpsTrailRate;
+  // Gps fix rate forwarded to the logger in Hz
+  double _gpsLoggerRate;
+  // Gps fix rate forwarded to the display in Hz
+  double _gpsDisplayRate;
   // Gps IPC port
   ushort _gpsIpcPort;
   // Gps client start option
@@ -3335,6 +3509,9 @@ class GeneralConfig : protected QSettings
 
   bool _reportTaskpointSwitch;
 
+  // maximize the route through the task point figures
+  bool _taskMaximizeAreas;
+
   // arrival altitude display selection
   enum ArrivalAltitudeDisplay _arrivalAltitudeDisplay;
 
@@ -0,0 +1,199 @@
+/***********************************************************************
+**
+**   glidefootprint.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "glidefootprint.h"
+#include "mapcalc.h"
+#include "mapmatrix.h"
+#include "polar.h"
+
+extern MapMatrix* _globalMapMatrix;
+
+// Altitude in meters above the current one, which is covered by the
+// profiles. A climb within this margin needs no recalculation.
+#define PROFILE_MARGIN 500.0
+
+// Distance in km, after which the profiles are recalculated.
+#define REBUILD_DISTANCE 0.25
+
+// Maximum ray length in meters.
+#define MAX_RAY_LENGTH 300000.0
+
+// Number of samples per ray, if no terrain is known.
+#define DEFAULT_SAMPLES 64
+
+GlideFootprint::GlideFootprint() :
+  m_profileAltitude(0.0),
+  m_polar(0),
+  m_safetyAlt(0)
+{
+}
+
+GlideFootprint::~GlideFootprint()
+{
+}
+
+void GlideFootprint::update( const QPoint& position,
+                             const double altitude,
+                             const double ground,
+                             Polar* polar,
+                             Vector wind,
+                             const Speed& mc,
+                             const int safetyAlt )
+{
+  if( polar == 0 || _globalMapMatrix == 0 )
+    {
+      clear();
+      return;
+    }
+
+  QPoint pos = position;
+
+  // A changed projection makes the stored projected points invalid.
+  if( m_polar != polar || m_mc != mc || m_wind != wind ||
+      m_safetyAlt != safetyAlt || altitude > m_profileAltitude ||
+      MapCalc::dist( &pos, &m_position ) > REBUILD_DISTANCE ||
+      _globalMapMatrix->wgsToMap( m_position ) != m_projPosition )
+    {
+      m_position  = position;
+      m_polar     = polar;
+      m_wind      = wind;
+      m_mc        = mc;
+      m_safetyAlt = safetyAlt;
+
+      calculateProfiles( altitude, ground );
+    }
+
+  // The required altitude profiles are monotonic increasing, so that the
+  // reachable part of a ray can be found by a binary search.
+  m_polygon.resize( Rays );
+
+  for( int i = 0; i < Rays; i++ )
+    {
+      const Ray& ray = m_rays[i];
+      const QVector<float>& need = ray.need;
+
+      int count = std::upper_bound( need.constBegin(), need.constEnd(),
+                                    float(altitude) ) - need.constBegin();
+
+      double fraction = 0.0;
+
+      if( count > 1 )
+        {
+          fraction = double(count - 1) / double(need.size() - 1);
+        }
+
+      m_polygon.setPoint( i,
+                          m_projPosition.x() + qRound( (ray.end.x() - m_projPosition.x()) * fraction ),
+                          m_projPosition.y() + qRound( (ray.end.y() - m_projPosition.y()) * fraction ) );
+    }
+}
+
+void GlideFootprint::calculateProfiles( const double altitude,
+                                        const double ground )
+{
+  m_profileAltitude = altitude + PROFILE_MARGIN;
+  m_projPosition = _globalMapMatrix->wgsToMap( m_position );
+
+  // Glide ratio over ground of every ray, see Calculator::glidePath().
+  Speed speed = m_polar->bestSpeed( 0.0, 0.0, m_mc );
+
+  double maxLength = 0.0;
+
+  for( int i = 0; i < Rays; i++ )
+    {
+      Ray& ray = m_rays[i];
+
+      int bearing = static_cast<int> (rint( i * 360.0 / Rays ));
+
+      Vector groundspeed( bearing, speed );
+      Vector airspeed = groundspeed + m_wind;
+      Speed headwind = groundspeed.getSpeed() - airspeed.getSpeed();
+
+      Speed bestSpeed = m_polar->bestSpeed( headwind, 0.0, m_mc );
+
+      ray.ld = m_polar->bestLD( bestSpeed, groundspeed.getSpeed(), 0.0 );
+      ray.length = 0.0;
+
+      if( ray.ld > 0.0 )
+        {
+          // Sea level is the lowest possible ground.
+          ray.length = qMin( ray.ld * (m_profileAltitude - m_safetyAlt), MAX_RAY_LENGTH );
+          ray.length = qMax( ray.length, 0.0 );
+        }
+
+      maxLength = qMax( maxLength, ray.length );
+    }
+
+  bool hasTerrain = m_grid.update( m_position, maxLength / 1000.0 );
+
+  QVector<int> elevations;
+
+  for( int i = 0; i < Rays; i++ )
+    {
+      Ray& ray = m_rays[i];
+
+      if( ray.length < 1.0 )
+        {
+          ray.end = m_projPosition;
+          ray.need.fill( float(ground + m_safetyAlt), 1 );
+          continue;
+        }
+
+      int bearing = static_cast<int> (rint( i * 360.0 / Rays ));
+
+      ray.end = _globalMapMatrix->wgsToMap( MapCalc::getPosition( m_position, ray.length, bearing ) );
+
+      int samples = 0;
+
+      if( hasTerrain )
+        {
+          samples = m_grid.profile( m_projPosition, ray.end, elevations );
+        }
+
+      if( samples < 1 )
+        {
+          samples = DEFAULT_SAMPLES;
+          elevations.clear();
+        }
+
+      ray.need.resize( samples + 1 );
+
+      float* need = ray.need.data();
+
+      const double lossPerSample = ray.length / samples / ray.ld;
+      const int known = elevations.size();
+
+      double required = -1e9;
+
+      for( int k = 0; k <= samples; k++ )
+        {
+          double elevation = (k < known && elevations.at(k) != INT_MIN) ? elevations.at(k) : ground;
+
+          required = qMax( required, elevation + m_safetyAlt + k * lossPerSample );
+          need[k] = float(required);
+        }
+    }
+}
+
+void GlideFootprint::clear()
+{
+  m_polygon.clear();
+  m_polar = 0;
+  m_profileAltitude = 0.0;
+}
@@ -0,0 +1,145 @@
+/***********************************************************************
+**
+**   glidefootprint.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class GlideFootprint
+ *
+ * \brief Area, which can be reached in glide from the current position.
+ *
+ * Rays are cast in equally spaced bearings from the current position. The
+ * glide ratio over ground of every ray is derived from the polar, the wind
+ * and the McCready value in the same way as Calculator::glidePath() does it.
+ * Along a ray the terrain is sampled from an ElevationGrid. The ray ends,
+ * where the glide path comes closer to the terrain than the safety altitude.
+ * The ray ends form the footprint polygon.
+ *
+ * For every ray a profile of the required start altitude is stored. It is
+ * the cumulative maximum of terrain elevation, safety altitude and lost
+ * altitude up to every sample. As long as position, wind, McCready and polar
+ * are unchanged, an altitude change needs only a binary search per ray in
+ * these profiles.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef GLIDE_FOOTPRINT_H
+#define GLIDE_FOOTPRINT_H
+
+#include <QPoint>
+#include <QPolygon>
+#include <QVector>
+
+#include "elevationgrid.h"
+#include "speed.h"
+#include "vector.h"
+
+class Polar;
+
+class GlideFootprint
+{
+ public:
+
+  GlideFootprint();
+
+  virtual ~GlideFootprint();
+
+  /**
+   * Updates the footprint. The ray profiles are only recalculated, if the
+   * position, the glide conditions or the covered altitude range have been
+   * changed.
+   *
+   * \param position Current position in KFLog coordinates.
+   *
+   * \param altitude Current altitude MSL in meters.
+   *
+   * \param ground Ground elevation in meters used, where no terrain is known.
+   *
+   * \param polar Polar of the glider.
+   *
+   * \param wind Current wind vector.
+   *
+   * \param mc Current McCready value.
+   *
+   * \param safetyAlt Safety altitude above the terrain in meters.
+   */
+  void update( const QPoint& position,
+               const double altitude,
+               const double ground,
+               Polar* polar,
+               Vector wind,
+               const Speed& mc,
+               const int safetyAlt );
+
+  /**
+   * \return The footprint polygon in projected coordinates. Is empty, if no
+   *         footprint is available.
+   */
+  const QPolygon& getPolygon() const
+  {
+    return m_polygon;
+  };
+
+  /**
+   * Removes the footprint and forces a recalculation of the profiles.
+   */
+  void clear();
+
+  /** Number of rays of the footprint. */
+  static const int Rays = 64;
+
+ private:
+
+  /**
+   * Recalculates the required altitude profiles of all rays.
+   */
+  void calculateProfiles( const double altitude, const double ground );
+
+  /** Required altitude profile of a ray. */
+  struct Ray
+  {
+    /** Projected end point of the profile. */
+    QPoint end;
+
+    /** Length of the profile in meters. */
+    double length;
+
+    /** Glide ratio over ground. */
+    double ld;
+
+    /** Required start altitude in meters for every sample. */
+    QVector<float> need;
+  };
+
+  Ray m_rays[Rays];
+
+  /** Conditions of the last profile calculation. */
+  QPoint  m_position;
+  QPoint  m_projPosition;
+  double  m_profileAltitude;
+  Polar*  m_polar;
+  Vector  m_wind;
+  Speed   m_mc;
+  int     m_safetyAlt;
+
+  /** Terrain raster around the position. */
+  ElevationGrid m_grid;
+
+  /** Footprint polygon in projected coordinates. */
+  QPolygon m_polygon;
+};
+
+#endif
@@ -35,6 +35,7 @@
 #include <QMessageBox>
 #include <QInputDialog>
 
+#include "fixlatency.h"
 #include "generalconfig.h"
 #include "mapview.h"
 #include "gpsnmea.h"
@@ -72,7 +73,8 @@ GpsCon::GpsCon(QObject* parent, const char *pathIn) :
   listenNotifier(static_cast<QSocketNotifier *>(0)),
   clientNotifier(static_cast<QSocketNotifier *>(0)),
   timer(0),
-  ioSpeed(0)
+  ioSpeed(0),
+  forwardAll(false)
 {
   setObjectName( "GpsCon" );
 
@@ -832,7 +834,17 @@ void GpsCon::getDataFromClient()
           return;
         }
 
-      if( msg.startsWith( MSG_GPS_DATA ) )
+      if( msg.startsWith( MSG_GPS_DATA_TS ) )
+        {
+          // The sentence is preceded by its reception time.
+          msg = msg.right(msg.length() - strlen(MSG_GPS_DATA_TS) - 1);
+
+          int idx = msg.indexOf( ' ' );
+
+          FixLatency::setIngestTime( msg.left( idx ).toLongLong() );
+          emit newSentence( msg.mid( idx + 1 ) );
+        }
+      else if( msg.startsWith( MSG_GPS_DATA ) )
         {
           msg = msg.right(msg.length() - strlen(MSG_GPS_DATA) - 1);
           emit newSentence(msg);
@@ -995,6 +1007,13 @@ void GpsCon::sendGpsKeys()
   // Retrieve all GPS message keys from the GPS hash dictionary.
   QStringList items( gpsHash.keys() );
 
+  if( forwardAll == true )
+    {
+      // The client shall forward all sentences.
+      items.clear();
+      items << MSG_GPS_KEYS_ALL;
+    }
+
   QString msg = QString("%1 %2").arg(MSG_GPS_KEYS).arg(items.join(","));
 
   writeClientMessage( 0, msg.toLatin1().data() );
@@ -1012,6 +1031,48 @@ void GpsCon::sendGpsKeys()
     }
 }
 
+void GpsCon::setForwardAllSentences( const bool flag )
+{
+  if( forwardAll == flag )
+    {
+      return;
+    }
+
+  forwardAll = flag;
+
+  if( server.getClientSock(0) != -1 )
+    {
+      sendGpsKeys();
+    }
+}
+
+bool GpsCon::getGpsFilterStatistics( quint64& forwarded,
+                                     quint64& dropped,
+                                     quint64& droppedBytes )
+{
+  if( server.getClientSock(0) == -1 )
+    {
+      return false;
+    }
+
+  QString msg = MSG_GPS_FILTER_STATS;
+
+  writeClientMessage( 0, msg.toLatin1().data() );
+  readClientMessage( 0, msg );
+
+  QStringList args = msg.split( " " );
+
+  if( msg == MSG_NEG || args.size() != 3 )
+    {
+      return false;
+    }
+
+  forwarded    = args[0].toULongLong();
+  dropped      = args[1].toULongLong();
+  droppedBytes = args[2].toULongLong();
+  return true;
+}
+
 #ifdef FLARM
 
 bool GpsCon::getFlarmFlightList()
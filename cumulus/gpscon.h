@@ -134,10 +134,30 @@ class GpsCon : public QObject
      * Sends the well known GPS message keys to the GPS client process.
      * Only GPS sentences starting with such a key are processed and forwarded
      * to the Cumulus process. That shall avoid unneeded traffic between the
-     * two processes.
+     * two processes. If all sentences are requested, the filter of the client
+     * is switched off.
      */
     void sendGpsKeys();
 
+    /**
+     * Requests all GPS sentences from the client, e.g. for NMEA logging, or
+     * only the sentences with well known GPS message keys. The new setting is
+     * sent to the client immediately.
+     */
+    void setForwardAllSentences( const bool flag );
+
+    /**
+     * Requests the statistics of the GPS message filter from the client.
+     *
+     * \param forwarded Number of sentences forwarded to Cumulus.
+     * \param dropped Number of sentences dropped by the filter.
+     * \param droppedBytes Number of bytes dropped by the filter.
+     * \return True in case of success otherwise false.
+     */
+    bool getGpsFilterStatistics( quint64& forwarded,
+                                 quint64& dropped,
+                                 quint64& droppedBytes );
+
 #ifdef FLARM
 
     /** Requests a flight list from a Flarm device. */
@@ -292,6 +312,9 @@ class GpsCon : public QObject
     // RX/TX rate of serial device
     uint ioSpeed;
 
+    // Flag to request all GPS sentences from the client.
+    bool forwardAll;
+
     // GPS device name
     QString device;
  };
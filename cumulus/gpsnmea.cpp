@@ -46,6 +46,8 @@
 #include "mapmatrix.h"
 #include "mapcalc.h"
 #include "mapview.h"
+#include "fixlatency.h"
+#include "navbenchmark.h"
 
 #ifdef ANDROID
 #include "androidevents.h"
@@ -83,7 +85,10 @@ QMutex GpsNmea::mutex;
 
 GpsNmea::GpsNmea(QObject* parent) :
   QObject(parent),
-  flarmNmeaOutInitDone(false)
+  _allSentencesRequests(0),
+  flarmNmeaOutInitDone(false),
+  m_replayMode(false),
+  m_sentenceIngestTime(0)
 {
   if( instances > 0 )
     {
@@ -285,6 +290,9 @@ void GpsNmea::createGpsConnection()
 
   gpsObject = serial;
 
+  // Apply the sentence filter state to the new connection.
+  updateGpsFilter();
+
   connect (gpsObject, SIGNAL(newSentence(const QString&)),
            this, SLOT(slot_sentence(const QString&)) );
 
@@ -382,8 +390,24 @@ void GpsNmea::startGpsReceiver()
  * @AP 2010-08-12: The GPS sentence checksum is checked now in the receiver
  * function. Only positive verified sentences are forwarded to this slot.
  */
+void GpsNmea::setReplayMode( const bool enable )
+{
+  m_replayMode = enable;
+
+  if( enable )
+    {
+      // A recorded flight needs no device initialization.
+      flarmNmeaOutInitDone = true;
+      slot_closeNmeaLogFile();
+    }
+}
+
 void GpsNmea::slot_sentence(const QString& sentenceIn)
 {
+  NavBenchmark::Timer timer( NavBenchmark::NmeaParse );
+
+  m_sentenceIngestTime = FixLatency::takeIngestTime();
+
   // qDebug("GpsNmea::slot_sentence: %s", sentenceIn.toLatin1().data());
 
   if( flarmNmeaOutInitDone == false )
@@ -757,7 +781,7 @@ void GpsNmea::__ExtractGprmc( const QStringList& slst )
 
       if( lastUtcTime == utcTime )
         {
-          // Only every second the RMC sentence is processed.
+          // Every fix epoch of the RMC sentence is processed only once.
           return;
         }
 
@@ -781,7 +805,7 @@ void GpsNmea::__ExtractGprmc( const QStringList& slst )
 
           GeneralConfig *conf = GeneralConfig::instance();
 
-          if( updateClock && conf->getGpsSyncSystemClock() )
+          if( updateClock && m_replayMode == false && conf->getGpsSyncSystemClock() )
             {
               // @AP: we make only one update to avoid confusing of running timers
               updateClock = false;
@@ -910,7 +934,7 @@ void GpsNmea::__ExtractGpgga( const QStringList& slst )
 
       if( lastUtcTime == utcTime )
         {
-          // Only every second the GGA sentence is processed.
+          // Every fix epoch of the GGA sentence is processed only once.
           return;
         }
 
@@ -978,7 +1002,7 @@ void GpsNmea::__ExtractGngns( const QStringList& slst )
 
       if( lastUtcTime == utcTime )
         {
-          // Only every second the GNS sentence is processed.
+          // Every fix epoch of the GNS sentence is processed only once.
           return;
         }
 
@@ -1556,10 +1580,18 @@ QTime GpsNmea::__ExtractTime(const QString& timeString)
   QString mm (timeString.mid(2,2));
   QString ss (timeString.mid(4,2));
 
-  // @AP: newer CF Cards can also provide milliseconds. In this case the time
-  // format is defined as hhmmss.sss. But we will not use it to avoid problems
-  // with our fixes.
-  QTime res = QTime( hh.toInt(), mm.toInt(), ss.toInt() );
+  // Newer receivers provide also fractions of a second. In this case the time
+  // format is defined as hhmmss.sss. They are needed to distinguish the fixes
+  // of high rate receivers, which deliver 5 up to 20 fixes per second.
+  int ms = 0;
+
+  if( timeString.size() > 7 && timeString[6] == QChar('.') )
+    {
+      QString frac = timeString.mid( 7, 3 ).leftJustified( 3, QChar('0') );
+      ms = frac.toInt();
+    }
+
+  QTime res = QTime( hh.toInt(), mm.toInt(), ss.toInt(), ms );
 
   // @AP: don't overtake invalid times. They will cause invalid fixes!
   if ( ! res.isValid() )
@@ -2348,6 +2380,30 @@ bool GpsNmea::sendSentence(const QString command)
   return false;
 }
 
+bool GpsNmea::getGpsFilterStatistics( quint64& forwarded,
+                                      quint64& dropped,
+                                      quint64& droppedBytes )
+{
+  if( serial )
+    {
+      // Only a serial has a GPS client with a sentence filter.
+      return serial->getGpsFilterStatistics( forwarded, dropped, droppedBytes );
+    }
+
+  return false;
+}
+
+void GpsNmea::updateGpsFilter()
+{
+  if( serial )
+    {
+      bool all = _allSentencesRequests > 0 ||
+                 ( nmeaLogFile && nmeaLogFile->isOpen() );
+
+      serial->setForwardAllSentences( all );
+    }
+}
+
 #else
 
 bool GpsNmea::sendSentence(const QString command)
@@ -2362,6 +2418,18 @@ bool GpsNmea::sendSentence(const QString command)
   return jniGpsCmd( cmd );
 }
 
+bool GpsNmea::getGpsFilterStatistics( quint64& /* forwarded */,
+                                      quint64& /* dropped */,
+                                      quint64& /* droppedBytes */ )
+{
+  // Android delivers the sentences without a GPS client.
+  return false;
+}
+
+void GpsNmea::updateGpsFilter()
+{
+}
+
 #endif
 
 //------------------------------------------------------------------------------
@@ -2851,6 +2919,9 @@ void GpsNmea::slot_openNmeaLogFile()
           qWarning() << "Cannot open file" << fname;
         }
     }
+
+  // The log file shall contain all sentences.
+  updateGpsFilter();
 }
 
 /**
@@ -2868,6 +2939,20 @@ void GpsNmea::slot_closeNmeaLogFile()
       delete nmeaLogFile;
       nmeaLogFile = 0;
     }
+
+  updateGpsFilter();
+}
+
+void GpsNmea::requestAllSentences( const bool flag )
+{
+  _allSentencesRequests += flag ? 1 : -1;
+
+  if( _allSentencesRequests < 0 )
+    {
+      _allSentencesRequests = 0;
+    }
+
+  updateGpsFilter();
 }
 
 #ifdef ANDROID
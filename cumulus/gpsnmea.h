@@ -174,6 +174,22 @@ class GpsNmea : public QObject
      */
     void startGpsReceiver();
 
+    /**
+     * Switches the replay mode on or off. In replay mode recorded sentences
+     * are passed to slot_sentence. No device is initialized, no NMEA log is
+     * written and the system clock is not synchronized.
+     */
+    void setReplayMode( const bool enable );
+
+    /**
+     * @return The reception time in microseconds of the last sentence.
+     * See FixLatency.
+     */
+    qint64 getSentenceIngestTime() const
+      {
+        return m_sentenceIngestTime;
+      }
+
     /**
      * @return the current GPS connection status.
      */
@@ -387,6 +403,22 @@ class GpsNmea : public QObject
       */
     bool sendSentence(const QString command);
 
+    /**
+     * Requests all GPS sentences from the GPS client, also these without a
+     * handler in this class. Every true request must be released by a false
+     * request. Used by displays of the raw NMEA data.
+     */
+    void requestAllSentences( const bool flag );
+
+    /**
+     * Gets the statistics of the GPS sentence filter of the GPS client.
+     *
+     * \return true in case of success otherwise false.
+     */
+    bool getGpsFilterStatistics( quint64& forwarded,
+                                 quint64& dropped,
+                                 quint64& droppedBytes );
+
 #ifdef FLARM
 
     /** Requests a flight list from a Flarm device. */
@@ -600,6 +632,12 @@ class GpsNmea : public QObject
      *  at startup, at restart and if the GPS fix has been lost. */
     void resetDataObjects();
 
+    /**
+     * Negotiates the sentence filter with the GPS client. All sentences are
+     * requested, if they are logged or displayed raw.
+     */
+    void updateGpsFilter();
+
     /** write configuration data to allow restore of last fix */
     void writeConfig();
 
@@ -786,6 +824,9 @@ class GpsNmea : public QObject
     /** NMEA log file */
     QFile* nmeaLogFile;
 
+    /** Number of active requests for all GPS sentences. */
+    int _allSentencesRequests;
+
     /** Flag to indicate the receive of GPRMC. */
     bool _gprmcSeen;
 
@@ -795,6 +836,12 @@ class GpsNmea : public QObject
     /** Flarm NMEAOUT initialization flag. */
     bool flarmNmeaOutInitDone;
 
+    /** Flag to indicate the processing of recorded sentences. */
+    bool m_replayMode;
+
+    /** Reception time of the last sentence. */
+    qint64 m_sentenceIngestTime;
+
 #ifdef FLARM
 
     /** Flag to control begin and end of receiving PFLAA sentences. */
@@ -26,8 +26,10 @@
 #include <QtScroller>
 #endif
 
+#include "fixlatency.h"
 #include "gpsstatusdialog.h"
 #include "gpsnmea.h"
+#include "latencyhistogram.h"
 #include "layout.h"
 #include "mainwindow.h"
 
@@ -37,6 +39,7 @@ int GpsStatusDialog::noOfInstances = 0;
 GpsStatusDialog::GpsStatusDialog(QWidget * parent) :
   QWidget( parent ),
   showNmeaData( true ),
+  allSentencesRequested( false ),
   nmeaLines( 0 ),
   cntSIVSentence( 1 )
 {
@@ -118,8 +121,29 @@ GpsStatusDialog::GpsStatusDialog(QWidget * parent) :
 
   QPushButton* close = new QPushButton( tr("Close"), this );
 
+  // Shows, how many sentences were dropped by the GPS client filter.
+  filterInfo = new QLabel;
+  filterInfo->setToolTip( tr("Sentences dropped by the GPS filter") );
+  slot_updateFilterDisplay();
+
+  // Shows the latencies from the reception of a sentence to the display.
+  latencyInfo = new QLabel;
+  latencyInfo->setToolTip( tr("Fix to display latency p50/p99/max") );
+  slot_updateLatencyDisplay();
+
+  latencyTimer = new QTimer( this );
+  latencyTimer->start( 1000 );
+
+  connect( latencyTimer, SIGNAL(timeout()), this,
+           SLOT(slot_updateLatencyDisplay()) );
+
+  connect( latencyTimer, SIGNAL(timeout()), this,
+           SLOT(slot_updateFilterDisplay()) );
+
   QVBoxLayout* buttonBox = new QVBoxLayout;
   buttonBox->addWidget( satSource );
+  buttonBox->addWidget( filterInfo );
+  buttonBox->addWidget( latencyInfo );
   buttonBox->addStretch( 5 );
   buttonBox->addWidget( startStop );
   buttonBox->addSpacing( 5 );
@@ -152,6 +176,29 @@ GpsStatusDialog::GpsStatusDialog(QWidget * parent) :
 GpsStatusDialog::~GpsStatusDialog()
 {
   noOfInstances--;
+  requestAllSentences( false );
+}
+
+void GpsStatusDialog::showEvent( QShowEvent *event )
+{
+  // The raw NMEA display shall show all sentences.
+  requestAllSentences( showNmeaData );
+  QWidget::showEvent( event );
+}
+
+void GpsStatusDialog::hideEvent( QHideEvent *event )
+{
+  requestAllSentences( false );
+  QWidget::hideEvent( event );
+}
+
+void GpsStatusDialog::requestAllSentences( const bool flag )
+{
+  if( allSentencesRequested != flag )
+    {
+      allSentencesRequested = flag;
+      GpsNmea::gps->requestAllSentences( flag );
+    }
 }
 
 void GpsStatusDialog::slot_GpsSourceChanged( int /* index */ )
@@ -336,6 +383,47 @@ void GpsStatusDialog::slot_updateGpsMessageDisplay()
   nmeaBox->setText(nmeaData);
 }
 
+/**
+ * Called to update the display of the fix latencies.
+ */
+void GpsStatusDialog::slot_updateLatencyDisplay()
+{
+  const LatencyHistogram& latencies = FixLatency::statistics();
+
+  if( latencies.count() == 0 )
+    {
+      latencyInfo->setText( tr("Latency") + "\n-" );
+      return;
+    }
+
+  // The latencies are stored in nanoseconds.
+  latencyInfo->setText( tr("Latency") + "\n" +
+                        QString("%1/%2/%3 ms")
+                        .arg( latencies.percentile( 50.0 ) / 1000000 )
+                        .arg( latencies.percentile( 99.0 ) / 1000000 )
+                        .arg( latencies.maximum() / 1000000 ) );
+}
+
+/**
+ * Called to update the display of the GPS filter statistics.
+ */
+void GpsStatusDialog::slot_updateFilterDisplay()
+{
+  quint64 forwarded, dropped, droppedBytes;
+
+  if( GpsNmea::gps->getGpsFilterStatistics( forwarded, dropped, droppedBytes ) == false )
+    {
+      filterInfo->setText( tr("Dropped") + "\n-" );
+      return;
+    }
+
+  quint64 total = forwarded + dropped;
+
+  filterInfo->setText( tr("Dropped") + "\n" +
+                       QString("%1/%2").arg(dropped).arg(total) + "\n" +
+                       QString("%1 KB").arg(droppedBytes / 1024) );
+}
+
 /**
  * Called if the start/stop button is pressed to start or stop NMEA display.
  */
@@ -351,6 +439,9 @@ void GpsStatusDialog::slot_ToggleStartStop()
     {
       startStop->setText( tr("Start") );
     }
+
+  // The filter is only switched off, while the raw data are displayed.
+  requestAllSentences( showNmeaData && isVisible() );
 }
 
 /**
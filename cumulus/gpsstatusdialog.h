@@ -89,8 +89,20 @@ public:
 
   void keyReleaseEvent( QKeyEvent *event );
 
+protected:
+
+  void showEvent( QShowEvent *event );
+
+  void hideEvent( QHideEvent *event );
+
 private:
 
+  /**
+   * Switches the GPS sentence filter off, as long as the raw NMEA data are
+   * displayed.
+   */
+  void requestAllSentences( const bool flag );
+
   void ExtractSatsInView( const QString& sentence );
 
   void ExtractSatsInView( const QString& id,
@@ -136,6 +148,16 @@ private slots:
    */
   void slot_updateGpsMessageDisplay();
 
+  /**
+   * Called to update the display of the fix latencies.
+   */
+  void slot_updateLatencyDisplay();
+
+  /**
+   * Called to update the display of the GPS filter statistics.
+   */
+  void slot_updateFilterDisplay();
+
   /**
    * Called if close button is pressed.
    */
@@ -156,10 +178,15 @@ protected:
   QPushButton                *startStop;
   QPushButton                *save;
   QComboBox                  *satSource;
+  QLabel                     *filterInfo;
+  QLabel                     *latencyInfo;
 
   /** Display flag for NMEA data. */
   bool showNmeaData;
 
+  /** Flag, if all GPS sentences are requested from the GPS client. */
+  bool allSentencesRequested;
+
   /** NMEA data string displayed in nmeaBox. */
   QString nmeaData;
 
@@ -183,6 +210,9 @@ protected:
   /** GPS message display update timer. */
   QTimer *uTimer;
 
+  /** Latency display update timer. */
+  QTimer *latencyTimer;
+
   /** contains the current number of class instances */
   static int noOfInstances;
 };
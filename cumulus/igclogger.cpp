@@ -54,7 +54,7 @@ IgcLogger::IgcLogger(QObject* parent) :
   QObject(parent),
   closeTimer(0),
   _kRecordLogging(false),
-  _backtrack( LimitedList<QStringList>(60) ),
+  _backtrack( LimitedList<BacktrackEntry>(60) ),
   flightNumber(0),
   _flightMode( Calculator::unknown)
 {
@@ -71,12 +71,15 @@ IgcLogger::IgcLogger(QObject* parent) :
 
   // load user configuration items
   _bRecordInterval = GeneralConfig::instance()->getBRecordInterval();
+  _bRecordCirclingInterval = GeneralConfig::instance()->getBRecordCirclingInterval();
   _kRecordInterval = GeneralConfig::instance()->getKRecordInterval();
 
   lastLoggedBRecord = new QTime();
   lastLoggedFRecord = new QTime();
   lastLoggedKRecord = new QTime();
 
+  _writer = new IgcWriter( this );
+
   resetTimer = new QTimer( this );
   connect( resetTimer, SIGNAL(timeout()), this, SLOT(slotResetLoggingTime()) );
 
@@ -137,6 +140,7 @@ void IgcLogger::slotReadConfig()
     }
 
   _bRecordInterval = GeneralConfig::instance()->getBRecordInterval();
+  _bRecordCirclingInterval = GeneralConfig::instance()->getBRecordCirclingInterval();
   _kRecordInterval = GeneralConfig::instance()->getKRecordInterval();
 }
 
@@ -146,6 +150,7 @@ void IgcLogger::slotReadConfig()
 void IgcLogger::slotResetLoggingTime()
 {
   _bRecordInterval = GeneralConfig::instance()->getBRecordInterval();
+  _bRecordCirclingInterval = GeneralConfig::instance()->getBRecordCirclingInterval();
   _kRecordInterval = GeneralConfig::instance()->getKRecordInterval();
 }
 
@@ -161,41 +166,58 @@ void IgcLogger::slotMakeFixEntry()
     }
 
   const FlightSample &lastfix = calculator->samplelist.at(0);
+  const QTime fixTime = lastfix.getDateTime().time();
+
+  int bRecordInterval = _bRecordInterval;
+
+  if( ( _flightMode == Calculator::circlingL ||
+        _flightMode == Calculator::circlingR ) &&
+      _bRecordCirclingInterval > 0 )
+    {
+      // A higher logging rate is used in thermals.
+      bRecordInterval = qMin( bRecordInterval, _bRecordCirclingInterval );
+    }
 
   // check if we have to log a new B-Record
   if ( ! lastLoggedBRecord->isNull() &&
-         lastLoggedBRecord->addSecs( _bRecordInterval ) > lastfix.time.time() )
+         lastLoggedBRecord->addSecs( bRecordInterval ) > fixTime )
     {
       // write K-Record, if needed
-      writeKRecord( lastfix.time.time() );
+      writeKRecord( fixTime );
       return;
     }
 
-  *lastLoggedBRecord = lastfix.time.time();
+  *lastLoggedBRecord = fixTime;
 
-  QString bRecord( "B" + formatTime(lastfix.time.time()) + formatPosition(lastfix.position) + "A" +
-                   formatAltitude(lastfix.STDAltitude) + formatAltitude(lastfix.GNSSAltitude) +
-                   QString("%1").arg(GpsNmea::gps->getLastSatInfo().fixAccuracy, 3, 10, QChar('0')) +
-                   QString("%1").arg(GpsNmea::gps->getLastSatInfo().satsInUse, 2, 10, QChar('0')) );
+  // The B record is formatted by the writer thread.
+  IgcWriter::Fix bRecord;
+  bRecord.time             = QTime( 0, 0 ).secsTo( fixTime );
+  bRecord.latitude         = lastfix.getPosition().x();
+  bRecord.longitude        = lastfix.getPosition().y();
+  bRecord.pressureAltitude = (int) rint( lastfix.STDAltitude );
+  bRecord.gnssAltitude     = (int) rint( lastfix.GNSSAltitude );
+  bRecord.fixAccuracy      = GpsNmea::gps->getLastSatInfo().fixAccuracy;
+  bRecord.satsInUse        = GpsNmea::gps->getLastSatInfo().satsInUse;
+  bRecord.tas              = (int) rint( calculator->getlastTas().getKph() );
+  bRecord.vario            = (int) rint( calculator->getlastVario().getMps() * 100.0 );
 
   if ( _logMode == standby &&
        ( calculator->moving() == false ||
          _flightMode == Calculator::unknown ||
          _flightMode == Calculator::standstill ) )
     {
-      // save B and F record and time in backtrack, if we are not in move
-      QString fRecord = "F" +
-                         formatTime( lastfix.time.time() ) +
-                         GpsNmea::gps->getLastSatInfo().constellation;
-      QStringList list;
-      list << bRecord << fRecord << QTime::currentTime ().toString("hhmmss");
-      _backtrack.add( list );
+      // save B record, constellation and time in backtrack, if we are not in move
+      BacktrackEntry entry;
+      entry.fix = bRecord;
+      entry.constellation = GpsNmea::gps->getLastSatInfo().constellation;
+      entry.time = QTime::currentTime();
+      _backtrack.add( entry );
 
       // qDebug( "Backtrack add: backtrack.size=%d", _backtrack.size() );
 
       // Set last F recording time from the oldest log entry. Looks a little bit
       // tricky but should work so. ;-)
-      *lastLoggedFRecord = QTime::fromString( _backtrack.last().at(2), "hhmmss" );
+      *lastLoggedFRecord = _backtrack.last().time;
       return;
     }
 
@@ -217,21 +239,17 @@ void IgcLogger::slotMakeFixEntry()
           // If log mode was before in standby we have to write out the backtrack entries.
           if( _backtrack.size() > 0 )
             {
-              if( _backtrack.last().at( 0 ).startsWith( "B" ) )
-                {
-                  // The backtrack contains at the last position a B record but IGC log
-                  // should start with a F record. Therefore we take the corresponding
-                  // F record from the stored string list.
-                  _stream << _backtrack.last().at( 1 ) << "\r\n";
-                }
+              // The IGC log should start with a F record. Therefore we take
+              // the constellation of the oldest backtrack entry.
+              const BacktrackEntry& oldest = _backtrack.last();
+
+              _writer->writeLine( "F" +
+                                  formatTime( QTime( 0, 0 ).addSecs( oldest.fix.time ) ) +
+                                  oldest.constellation );
 
               for( int i = _backtrack.count() - 1; i >= 0; i-- )
                 {
-                  // qDebug( "backtrack %d: %s, %s", i,
-                  // _backtrack.at(i).at(0).toLatin1().data(),
-                  // _backtrack.at(i).at(1).toLatin1().data() );
-
-                  _stream << _backtrack.at(i).at(0) << "\r\n";
+                  _writer->writeFix( _backtrack.at(i).fix );
                 }
 
               _backtrack.clear(); // make sure we aren't leaving old data behind.
@@ -239,7 +257,7 @@ void IgcLogger::slotMakeFixEntry()
           else
             {
               // If backtrack contains no entries we must write out a F record at first
-              makeSatConstEntry( lastfix.time.time() );
+              makeSatConstEntry( fixTime );
             }
         }
 
@@ -254,13 +272,13 @@ void IgcLogger::slotMakeFixEntry()
         {
           // According to the IGC specification after 5 minutes a F record has
           // to be logged. So we will do now.
-          makeSatConstEntry( lastfix.time.time() );
+          makeSatConstEntry( fixTime );
         }
 
-      _stream << bRecord << "\r\n";
+      _writer->writeFix( bRecord );
 
       // write K-Record
-      writeKRecord( lastfix.time.time() );
+      writeKRecord( fixTime );
 
       emit madeEntry();
     }
@@ -271,7 +289,7 @@ void IgcLogger::slotMakeFixEntry()
  */
 void IgcLogger::writeKRecord( const QTime& timeFix )
 {
-  if( _kRecordLogging == false || ! _logfile.isOpen()  )
+  if( _kRecordLogging == false || ! _writer->isOpen()  )
     {
       // 1. K-Record logging is switched off
       // 2. IGC logfile is not open.
@@ -304,14 +322,15 @@ void IgcLogger::writeKRecord( const QTime& timeFix )
       23-29 VAT, vario speed in meters as sign +/-, 3 numbers with 3 decimal numbers
    *
    */
-  QString kRecord( "K" + formatTime(timeFix) +
-                   QString("%1").arg( (int) rint(GpsNmea::gps->getLastHeading()), 3, 10, QChar('0')) +
-                   QString("%1").arg( (int) rint(GpsNmea::gps->getLastTas().getKph()), 3, 10, QChar('0')) + "kph" +
-                   QString("%1").arg( calculator->getLastWind().getAngleDeg(), 3, 10, QChar('0')) +
-                   QString("%1").arg( (int) rint(calculator->getLastWind().getSpeed().getKph()), 3, 10, QChar('0')) +
-                   formatVario(calculator->getlastVario()) );
-
-  _stream << kRecord << "\r\n";
+  IgcWriter::Extension kRecord;
+  kRecord.time          = QTime( 0, 0 ).secsTo( timeFix );
+  kRecord.heading       = (int) rint( GpsNmea::gps->getLastHeading() );
+  kRecord.tas           = (int) rint( GpsNmea::gps->getLastTas().getKph() );
+  kRecord.windDirection = calculator->getLastWind().getAngleDeg();
+  kRecord.windSpeed     = (int) rint( calculator->getLastWind().getSpeed().getKph() );
+  kRecord.vario         = (int) rint( calculator->getlastVario().getMps() * 1000.0 );
+
+  _writer->writeExtension( kRecord );
 }
 
 /** Call this slot, if a task sector has been touched to increase
@@ -392,7 +411,7 @@ bool IgcLogger::isLogFileOpen()
 {
   // IGC Logfile is stored at User Data Directory / igc
 
-  if( _logfile.isOpen() )
+  if( _writer->isOpen() )
     {
       // Logfile is already opened
       return true;
@@ -409,9 +428,7 @@ bool IgcLogger::isLogFileOpen()
       dir.mkpath(path);
     }
 
-  _logfile.setFileName( fname );
-
-  if ( ! _logfile.open(QIODevice::WriteOnly) )
+  if ( ! _writer->open( fname, GeneralConfig::instance()->getIgcExtensions() ) )
     {
       qWarning() << "IGC-Logger: Cannot open file" << fname;
       return false;
@@ -419,7 +436,9 @@ bool IgcLogger::isLogFileOpen()
 
   // qDebug( "IGC-Logger: Created Logfile %s", fname.toLatin1().data() );
 
-  _stream.setDevice(&_logfile);
+  // The thermals of the running flight are learned directly and must not
+  // be imported from its file again.
+  calculator->getThermalStore().setImported( QFileInfo( fname ).fileName() );
 
   writeHeader();
 
@@ -432,10 +451,8 @@ bool IgcLogger::isLogFileOpen()
 /** Closes the logfile. */
 void IgcLogger::CloseFile()
 {
-  if( _logfile.isOpen() )
-    {
-      _logfile.close();
-    }
+  // All queued records are written before the file is closed.
+  _writer->close();
 
   // reset logger start time
   startLogging = QDateTime();
@@ -446,6 +463,10 @@ void IgcLogger::writeHeader()
 {
   GeneralConfig *conf = GeneralConfig::instance();
 
+  // The header is formatted here and passed line by line to the writer.
+  QString header;
+  QTextStream stream( &header );
+
   QString pilot = conf->getSurname();
   QString date  = formatDate( GpsNmea::gps->getLastDate() );
   QString time  = formatTime( GpsNmea::gps->getLastTime() );
@@ -466,10 +487,10 @@ void IgcLogger::writeHeader()
       gliderCallSign     = calculator->glider()->callSign();
     }
 
-  _stream << "AXXXCUM Cumulus soaring flight computer, Flight: " << flightNumber << "\r\n" ;
-  _stream << "HFDTE" << date << "\r\n";
-  _stream << "HFFXA500" << "\r\n";
-  _stream << "HFPLTPILOTINCHARGE: " << (pilot.isEmpty() ? "Unknown" : pilot) << "\r\n";
+  stream << "AXXXCUM Cumulus soaring flight computer, Flight: " << flightNumber << "\r\n" ;
+  stream << "HFDTE" << date << "\r\n";
+  stream << "HFFXA500" << "\r\n";
+  stream << "HFPLTPILOTINCHARGE: " << (pilot.isEmpty() ? "Unknown" : pilot) << "\r\n";
 
   if( gliderSeats == Glider::doubleSeater )
     {
@@ -478,7 +499,7 @@ void IgcLogger::writeHeader()
           coPilot = tr( "Unknown" );
         }
 
-      _stream << "HFCM2CREW2: " << coPilot << "\r\n";
+      stream << "HFCM2CREW2: " << coPilot << "\r\n";
     }
 
   QString os;
@@ -505,28 +526,33 @@ void IgcLogger::writeHeader()
         hwh.value("MODEL", "Unknown");
 #endif
 
-  _stream << "HFGTYGLIDERTYPE: " << gliderType << "\r\n";
-  _stream << "HFGIDGLIDERID: " << gliderRegistration << "\r\n";
-  _stream << "HFDTM100GPSDATUM: WSG-1984\r\n";
-  _stream << "HFRFWFIRMWAREVERION: " << QCoreApplication::applicationVersion() << "\r\n";
-  _stream << "HFRHWHARDWAREVERSION: " << hwv << "\r\n" ;
-  _stream << "HFFTYFRTYPE: Cumulus: " << QCoreApplication::applicationVersion()
-          << ", Qt: " << qVersion()
-          << ", OS: " << os
-          << "\r\n";
-  _stream << "HFGPS: Unknown\r\n";
-  _stream << "HFPRSPRESSALTSENSOR: Unknown\r\n";
-  _stream << "HSCIDCOMPETITIONID: " << gliderCallSign << "\r\n";
-
-  // GSP info lines committed for now
-  _stream << "I023638FXA3940SIU\r\n"; // Fix accuracy and sat count as add ons
+  stream << "HFGTYGLIDERTYPE: " << gliderType << "\r\n";
+  stream << "HFGIDGLIDERID: " << gliderRegistration << "\r\n";
+  stream << "HFDTM100GPSDATUM: WSG-1984\r\n";
+  stream << "HFRFWFIRMWAREVERION: " << QCoreApplication::applicationVersion() << "\r\n";
+  stream << "HFRHWHARDWAREVERSION: " << hwv << "\r\n" ;
+  stream << "HFFTYFRTYPE: Cumulus: " << QCoreApplication::applicationVersion()
+         << ", Qt: " << qVersion()
+         << ", OS: " << os
+         << "\r\n";
+  stream << "HFGPS: Unknown\r\n";
+  stream << "HFPRSPRESSALTSENSOR: Unknown\r\n";
+  stream << "HSCIDCOMPETITIONID: " << gliderCallSign << "\r\n";
+
+  // Declaration of the configured B record extensions
+  QString iRecord = IgcWriter::iRecord( conf->getIgcExtensions() );
+
+  if( ! iRecord.isEmpty() )
+    {
+      stream << iRecord << "\r\n";
+    }
 
   // Write J Record definitions, if extended logging is activated by the user.
   if( conf->getKRecordInterval() > 0 )
     {
       // Set extended logging flag used for writing of K record.
       _kRecordLogging = true;
-      _stream << "J050810HDT1116TAS1719WDI2022WSP2329VAT" << "\r\n";
+      stream << "J050810HDT1116TAS1719WDI2022WSP2329VAT" << "\r\n";
     }
   else
     {
@@ -534,6 +560,21 @@ void IgcLogger::writeHeader()
     }
 
   // Task support: C-Records
+  writeTaskDeclaration( stream );
+
+  stream.flush();
+
+  QStringList lines = header.split( "\r\n", QString::SkipEmptyParts );
+
+  for( int i = 0; i < lines.size(); i++ )
+    {
+      _writer->writeLine( lines.at(i) );
+    }
+}
+
+/** This function writes the C records of the current task into the stream. */
+void IgcLogger::writeTaskDeclaration( QTextStream& stream )
+{
   extern MapContents* _globalMapContents;
 
   FlightTask* task = _globalMapContents->getCurrentTask();
@@ -557,30 +598,30 @@ void IgcLogger::writeHeader()
   QString taskId = task->getTaskTypeString();
 
   // date, time UTC is expected at first and second position
-  _stream << "C"
-          << taskDate
-          << taskTime
-          << QDate::currentDate().toString("ddMMyy")
-          << fnr
-          << tpnr
-          << task->getTaskDistanceString() << " "
-          << taskId
-          << "\r\n";
+  stream << "C"
+         << taskDate
+         << taskTime
+         << QDate::currentDate().toString("ddMMyy")
+         << fnr
+         << tpnr
+         << task->getTaskDistanceString() << " "
+         << taskId
+         << "\r\n";
 
   // Takeoff point as dummy entry
-  _stream << "C0000000N00000000E\r\n";
+  stream << "C0000000N00000000E\r\n";
 
   for( int i=0; i < tpList.count(); i++ )
     {
       TaskPoint *tp = tpList.at(i);
 
-      _stream << "C"
-              << formatPosition( tp->getWGSPosition() )
-              << tp->getWPName() << "\r\n";
+      stream << "C"
+             << formatPosition( tp->getWGSPosition() )
+             << tp->getWPName() << "\r\n";
     }
 
   // Landing point as dummy entry
-  _stream << "C0000000N00000000E\r\n";
+  stream << "C0000000N00000000E\r\n";
 }
 
 /** This function formats a date in the correct IGC format DDMMYY */
@@ -662,7 +703,7 @@ void IgcLogger::slotToggleLogging()
  */
 void IgcLogger::slotNewTaskSelected()
 {
-  if( ! _logfile.isOpen() )
+  if( ! _writer->isOpen() )
     {
       // Logger does not run, ignore this call.
       return;
@@ -719,7 +760,7 @@ void IgcLogger::makeSatConstEntry(const QTime &time)
 
       if( isLogFileOpen() )
         {
-          _stream << entry << "\r\n";
+          _writer->writeLine( entry );
           emit madeEntry();
         }
 
@@ -735,41 +776,6 @@ QString IgcLogger::formatTime(const QTime& time)
   return result;
 }
 
-/**
- * This function formats the variometer speed value in meters with sign +/-,
- * 3 numbers with 3 decimal numbers.
- */
-QString IgcLogger::formatVario(const Speed vSpeed)
-{
-  QString result;
-
-  double mps = vSpeed.getMps();
-
-  if( mps == 0.0 )
-    {
-      result += " ";
-    }
-  else if( mps > 0.0 )
-    {
-      result += "+";
-    }
-
-  // We need a number with 6 digits and without a decimal point. Therefore
-  // the value meter per second is multiplied with 1000.
-  result += QString("%1").arg( (int) rint(mps*1000.0), 6, 10, QChar('0') );
-
-  return result;
-}
-
-/** This function formats an Altitude to the correct format for IGC files (XXXXX) */
-QString IgcLogger::formatAltitude(Altitude altitude)
-{
-  QString result;
-  result.sprintf("%05.0f",altitude.getMeters());
-  return result;
-
-}
-
 /** This function formats the position to the correct format for igc files. Latitude and Longitude are encoded as DDMMmmmADDDMMmmmO, with A=N or S and O=E or W. */
 QString IgcLogger::formatPosition(const QPoint& position)
 {
@@ -859,7 +865,7 @@ void IgcLogger::slotFlightModeChanged( Calculator::FlightMode newFlightMode )
     }
 
   if( (newFlightMode == Calculator::standstill || newFlightMode == Calculator::unknown) &&
-      _logfile.isOpen() )
+      _writer->isOpen() )
     {
       // Close an opened logfile after a certain time of still stand or unknown mode.
       closeTimer->start( TOAL * 1000);
@@ -30,7 +30,8 @@
  * \brief IGC logger
  *
  * This class provides the IGC logging facilities, using the
- * parsed data from the GPS NMEA object.
+ * parsed data from the GPS NMEA object. The records are written
+ * by the IgcWriter in a separate thread.
  *
  * \date 2002-2012
  *
@@ -55,15 +56,14 @@
 #define GPS_MAXALT UNKNOWN
 
 #include <QDateTime>
-#include <QFile>
 #include <QObject>
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
 #include <QTime>
 
-#include "altitude.h"
 #include "calculator.h"
+#include "igcwriter.h"
 #include "limitedlist.h"
 
 class QMutex;
@@ -100,6 +100,19 @@ public:
       QString gliderReg;
   };
 
+  /**
+   * Used to store a fix, which would be logged in standby mode.
+   */
+  struct BacktrackEntry
+  {
+      /** B record data of the fix. */
+      IgcWriter::Fix fix;
+      /** Satellite constellation for the F record. */
+      QString constellation;
+      /** Local time, when the fix was stored. */
+      QTime time;
+  };
+
 public:
 
   /** returns the existing singleton class */
@@ -288,15 +301,15 @@ private:
   void writeHeader();
 
   /**
-   * Makes a fix entry in the logfile.
+   * This function writes the C records of the current task into the
+   * passed stream.
    */
-  void makeSatConstEntry(const QTime &time);
+  void writeTaskDeclaration( QTextStream& stream );
 
   /**
-   * This function formats an Altitude to the correct format
-   * for IGC files (XXXXX)
+   * Makes a fix entry in the logfile.
    */
-  QString formatAltitude(Altitude altitude);
+  void makeSatConstEntry(const QTime &time);
 
   /**
    * This function formats a QTime to the correct format for igc
@@ -311,12 +324,6 @@ private:
    */
   QString formatPosition(const QPoint& position);
 
-  /**
-   * This function formats the variometer speed value in meters with sign +/-,
-   * 3 numbers with 3 decimal numbers.
-   */
-  QString formatVario(const Speed vSpeed);
-
   /**
    * Creates a new filename for the IGC file according to the IGC
    * standards (IGC GNSS FR Specification, may 2002, Section 2.5)
@@ -344,11 +351,8 @@ private:
   /** A timer for closing the logfile after a certain timeout.*/
   QTimer* closeTimer;
 
-  /** The text stream object to write our data to. */
-  QTextStream _stream;
-
-  /** This is our log file. It is being used via the _stream object. */
-  QFile _logfile;
+  /** Writes the records into the log file in a separate thread. */
+  IgcWriter* _writer;
 
   /** Contains the current active logging mode. */
   LogMode _logMode;
@@ -356,6 +360,9 @@ private:
   /** B-Record logger time interval in seconds. */
   int _bRecordInterval;
 
+  /** B-Record logger time interval in seconds during circling, 0 is off. */
+  int _bRecordCirclingInterval;
+
   /** K-Record logger time interval in seconds. */
   int _kRecordInterval;
 
@@ -375,12 +382,12 @@ private:
   QDateTime startLogging;
 
   /** List of last would-be log entries.
-    * This list is filled when in standby mode with strings that would be
+    * This list is filled when in standby mode with the fixes that would be
     * in the log were logging enabled. When a change in flight mode is detected
     * and logging is triggered, the list is used to write out some older events
     * to the log. This way, we can be sure that the complete start sequence is
     * available in the log. */
-  LimitedList<QStringList> _backtrack;
+  LimitedList<BacktrackEntry> _backtrack;
 
   /** Stores the flight number for this day */
   int flightNumber;
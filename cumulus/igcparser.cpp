@@ -0,0 +1,254 @@
+/***********************************************************************
+**
+**   igcparser.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cstring>
+
+#include <QtCore>
+
+#include "igcparser.h"
+
+// Length of a B record without extensions.
+#define B_RECORD_LENGTH 35
+
+// Length of a C record with a position.
+#define C_RECORD_LENGTH 18
+
+namespace
+{
+  /**
+   * Reads a decimal number with a fixed number of digits.
+   *
+   * \return False, if a character is not a digit.
+   */
+  bool readNumber( const char* p, const int digits, int& value )
+  {
+    value = 0;
+
+    for( int i = 0; i < digits; i++ )
+      {
+        if( p[i] < '0' || p[i] > '9' )
+          {
+            return false;
+          }
+
+        value = value * 10 + (p[i] - '0');
+      }
+
+    return true;
+  }
+
+  /** Reads an altitude of 5 characters, which can start with a minus. */
+  bool readAltitude( const char* p, int& value )
+  {
+    if( *p == '-' )
+      {
+        if( ! readNumber( p + 1, 4, value ) )
+          {
+            return false;
+          }
+
+        value = -value;
+        return true;
+      }
+
+    return readNumber( p, 5, value );
+  }
+
+  /**
+   * Reads a coordinate DDMMmmmN or DDDMMmmmE and converts it into KFLog
+   * format, which uses 10.000'st of a minute.
+   */
+  bool readCoordinate( const char* p, const int degDigits, int& value )
+  {
+    int deg, min;
+
+    if( ! readNumber( p, degDigits, deg ) ||
+        ! readNumber( p + degDigits, 5, min ) )
+      {
+        return false;
+      }
+
+    value = deg * 600000 + min * 10;
+
+    const char hemisphere = p[degDigits + 5];
+
+    if( hemisphere == 'S' || hemisphere == 'W' )
+      {
+        value = -value;
+      }
+    else if( hemisphere != 'N' && hemisphere != 'E' )
+      {
+        return false;
+      }
+
+    return true;
+  }
+}
+
+void IgcParser::Flight::clear()
+{
+  date = QDate();
+  time.clear();
+  latitude.clear();
+  longitude.clear();
+  pressureAltitude.clear();
+  gnssAltitude.clear();
+  taskPoints.clear();
+  taskNames.clear();
+}
+
+bool IgcParser::parse( const QString& fileName, Flight& flight )
+{
+  QFile file( fileName );
+
+  if( ! file.open( QIODevice::ReadOnly ) )
+    {
+      qWarning() << "IgcParser: Cannot open file" << fileName;
+      return false;
+    }
+
+  const qint64 size = file.size();
+
+  uchar* data = file.map( 0, size );
+
+  if( data != 0 )
+    {
+      parse( reinterpret_cast<const char *> (data), size, flight );
+      file.unmap( data );
+    }
+  else
+    {
+      // Not all file systems support the mapping.
+      const QByteArray ba = file.readAll();
+      parse( ba.constData(), ba.size(), flight );
+    }
+
+  file.close();
+  return true;
+}
+
+void IgcParser::parse( const char* data, const qint64 size, Flight& flight )
+{
+  flight.clear();
+
+  // The arrays are reserved for a file, which contains only B records.
+  const int estimate = size / (B_RECORD_LENGTH + 2);
+
+  flight.time.reserve( estimate );
+  flight.latitude.reserve( estimate );
+  flight.longitude.reserve( estimate );
+  flight.pressureAltitude.reserve( estimate );
+  flight.gnssAltitude.reserve( estimate );
+
+  QVector<QPoint> declaration;
+  QStringList names;
+
+  const char* end = data + size;
+  const char* line = data;
+
+  int dayOffset = 0;
+  int lastTime = -1;
+
+  while( line < end )
+    {
+      const char* eol = static_cast<const char *> (memchr( line, '\n', end - line ));
+
+      if( eol == 0 )
+        {
+          eol = end;
+        }
+
+      int length = eol - line;
+
+      if( length > 0 && line[length - 1] == '\r' )
+        {
+          length--;
+        }
+
+      if( line[0] == 'B' && length >= B_RECORD_LENGTH )
+        {
+          int hh, mm, ss, lat, lon, pressAlt, gnssAlt;
+
+          if( readNumber( line + 1, 2, hh ) &&
+              readNumber( line + 3, 2, mm ) &&
+              readNumber( line + 5, 2, ss ) &&
+              readCoordinate( line + 7, 2, lat ) &&
+              readCoordinate( line + 15, 3, lon ) &&
+              readAltitude( line + 25, pressAlt ) &&
+              readAltitude( line + 30, gnssAlt ) )
+            {
+              int time = hh * 3600 + mm * 60 + ss + dayOffset;
+
+              if( lastTime >= 0 && time < lastTime - 43200 )
+                {
+                  // Midnight has been passed.
+                  dayOffset += 86400;
+                  time += 86400;
+                }
+
+              if( time > lastTime )
+                {
+                  flight.time.append( time );
+                  flight.latitude.append( lat );
+                  flight.longitude.append( lon );
+                  flight.pressureAltitude.append( pressAlt );
+                  flight.gnssAltitude.append( gnssAlt );
+                  lastTime = time;
+                }
+            }
+        }
+      else if( line[0] == 'C' && length >= C_RECORD_LENGTH )
+        {
+          int lat, lon;
+
+          if( readCoordinate( line + 1, 2, lat ) &&
+              readCoordinate( line + 9, 3, lon ) )
+            {
+              declaration.append( QPoint( lat, lon ) );
+              names.append( QString::fromLatin1( line + C_RECORD_LENGTH,
+                                                 length - C_RECORD_LENGTH ).trimmed() );
+            }
+        }
+      else if( length >= 11 && strncmp( line, "HFDTE", 5 ) == 0 )
+        {
+          // HFDTEDDMMYY or HFDTEDATE:DDMMYY,NN
+          const char* p = line + 5;
+
+          if( length >= 16 && strncmp( p, "DATE:", 5 ) == 0 )
+            {
+              p += 5;
+            }
+
+          int dd, mo, yy;
+
+          if( readNumber( p, 2, dd ) &&
+              readNumber( p + 2, 2, mo ) &&
+              readNumber( p + 4, 2, yy ) )
+            {
+              flight.date = QDate( yy < 80 ? 2000 + yy : 1900 + yy, mo, dd );
+            }
+        }
+
+      line = eol + 1;
+    }
+
+  // The first and the last point of the declaration are takeoff and
+  // landing.
+  if( declaration.size() >= 4 )
+    {
+      flight.taskPoints = declaration.mid( 1, declaration.size() - 2 );
+      flight.taskNames = names.mid( 1, names.size() - 2 );
+    }
+}
@@ -0,0 +1,128 @@
+/***********************************************************************
+**
+**   igcparser.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class IgcParser
+ *
+ * \brief Streaming parser of IGC files.
+ *
+ * The parser maps the IGC file into the memory and scans it line by line
+ * without creating any string objects. The B records are extracted into
+ * columnar arrays, one array per value, which are reserved in advance from
+ * the file size. The flight date and the declared task of the C records
+ * are extracted too.
+ *
+ * The fix times are counted in seconds since midnight of the flight date
+ * and continue to rise after midnight. Fixes with a time not later than
+ * the previous one are skipped.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef IGC_PARSER_H
+#define IGC_PARSER_H
+
+#include <QDate>
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class IgcParser
+{
+ public:
+
+  /**
+   * \class Flight
+   *
+   * \brief The fixes and the declared task of a parsed IGC file.
+   */
+  class Flight
+  {
+   public:
+
+    /** Removes all data. */
+    void clear();
+
+    /**
+     * \return The number of fixes.
+     */
+    int size() const
+    {
+      return time.size();
+    };
+
+    /**
+     * \return The position of a fix in KFLog coordinates.
+     */
+    QPoint position( const int index ) const
+    {
+      return QPoint( latitude.at(index), longitude.at(index) );
+    };
+
+    /** Date of the flight from the header. */
+    QDate date;
+
+    /** Fix times in seconds since midnight of the flight date. */
+    QVector<int> time;
+
+    /** Latitudes in KFLog coordinates. */
+    QVector<int> latitude;
+
+    /** Longitudes in KFLog coordinates. */
+    QVector<int> longitude;
+
+    /** Pressure altitudes in meters. */
+    QVector<int> pressureAltitude;
+
+    /** GNSS altitudes in meters. */
+    QVector<int> gnssAltitude;
+
+    /**
+     * Declared task points from start to finish in KFLog coordinates. The
+     * takeoff and landing entries of the declaration are not contained.
+     */
+    QVector<QPoint> taskPoints;
+
+    /** Names of the declared task points. */
+    QStringList taskNames;
+  };
+
+  /**
+   * Parses an IGC file.
+   *
+   * \param fileName Path of the IGC file.
+   *
+   * \param flight The extracted data. Old data are removed.
+   *
+   * \return True in case of success otherwise false.
+   */
+  static bool parse( const QString& fileName, Flight& flight );
+
+  /**
+   * Parses IGC data in the memory.
+   *
+   * \param data The IGC data.
+   *
+   * \param size The number of bytes.
+   *
+   * \param flight The extracted data. Old data are removed.
+   */
+  static void parse( const char* data, const qint64 size, Flight& flight );
+};
+
+#endif
@@ -0,0 +1,461 @@
+/***********************************************************************
+**
+**   igcwriter.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <QtCore>
+
+#include "generalconfig.h"
+#include "igcwriter.h"
+
+// Number of queue slots. At a logger interval of one second that covers
+// some minutes of blocked storage.
+#define QUEUE_SIZE 512
+
+// Interval in ms, in which the queued records are written and synced.
+#define FLUSH_INTERVAL 1000
+
+// Number of records, which are written in one batch.
+#define BATCH_RECORDS 64
+
+// Length of the B record without extensions.
+#define B_RECORD_LENGTH 35
+
+const int IgcWriter::LineSize;
+
+namespace
+{
+  /**
+   * Writes a non negative number with leading zeros. Too large numbers are
+   * limited to the width.
+   */
+  char* putNumber( char* p, int value, int width )
+  {
+    int limit = 1;
+
+    for( int i = 0; i < width; i++ )
+      {
+        limit *= 10;
+      }
+
+    value = qBound( 0, value, limit - 1 );
+
+    for( int i = width - 1; i >= 0; i-- )
+      {
+        p[i] = '0' + value % 10;
+        value /= 10;
+      }
+
+    return p + width;
+  }
+
+  /** Writes a time in seconds since midnight as HHMMSS. */
+  char* putTime( char* p, int time )
+  {
+    p = putNumber( p, time / 3600, 2 );
+    p = putNumber( p, (time / 60) % 60, 2 );
+    return putNumber( p, time % 60, 2 );
+  }
+
+  /** Writes a signed number as sign followed by the digits. */
+  char* putSigned( char* p, int value, int width )
+  {
+    *p++ = value > 0 ? '+' : (value < 0 ? '-' : ' ');
+    return putNumber( p, qAbs( value ), width );
+  }
+
+  /** Writes an altitude as 5 characters, negative values as -XXXX. */
+  char* putAltitude( char* p, int altitude )
+  {
+    if( altitude < 0 )
+      {
+        *p++ = '-';
+        return putNumber( p, -altitude, 4 );
+      }
+
+    return putNumber( p, altitude, 5 );
+  }
+
+  /**
+   * Writes a KFLog coordinate as DDMMmmm or DDDMMmmm followed by the
+   * hemisphere. The KFLog format uses 10.000'st of a minute.
+   */
+  char* putCoordinate( char* p, int coord, int degWidth, char pos, char neg )
+  {
+    char mark = pos;
+
+    if( coord < 0 )
+      {
+        coord = -coord;
+        mark = neg;
+      }
+
+    const int deg = coord / 600000;
+
+    p = putNumber( p, deg, degWidth );
+    p = putNumber( p, (coord - deg * 600000) / 10, 5 );
+    *p++ = mark;
+
+    return p;
+  }
+}
+
+IgcWriter::IgcWriter( QObject *parent ) :
+  QThread( parent ),
+  m_fd(-1),
+  m_extensions(0),
+  m_head(0),
+  m_tail(0),
+  m_stop(0),
+  m_dropped(0)
+{
+  m_queue = new Record[QUEUE_SIZE];
+}
+
+IgcWriter::~IgcWriter()
+{
+  close();
+  delete [] m_queue;
+}
+
+bool IgcWriter::open( const QString& fileName, const int extensions )
+{
+  if( isOpen() )
+    {
+      close();
+    }
+
+  m_fd = ::open( QFile::encodeName( fileName ).data(),
+                 O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+  if( m_fd < 0 )
+    {
+      qWarning() << "IgcWriter: Cannot open file" << fileName
+                 << strerror(errno);
+      return false;
+    }
+
+  m_head.fetchAndStoreRelease( 0 );
+  m_tail.fetchAndStoreRelease( 0 );
+  m_stop.fetchAndStoreRelease( 0 );
+  m_dropped = 0;
+  m_extensions = extensions;
+
+  start( QThread::LowPriority );
+  return true;
+}
+
+void IgcWriter::close()
+{
+  if( ! isOpen() )
+    {
+      return;
+    }
+
+  m_mutex.lock();
+  m_stop.fetchAndStoreRelease( 1 );
+  m_wakeUp.wakeOne();
+  m_mutex.unlock();
+
+  // The writer thread writes all queued records before it finishes.
+  wait();
+
+  ::close( m_fd );
+  m_fd = -1;
+
+  if( m_dropped > 0 )
+    {
+      qWarning() << "IgcWriter:" << m_dropped << "records dropped";
+    }
+}
+
+IgcWriter::Record* IgcWriter::reserve()
+{
+  if( ! isOpen() )
+    {
+      return static_cast<Record *> (0);
+    }
+
+  const int head = m_head.fetchAndAddAcquire( 0 );
+
+  if( (head + 1) % QUEUE_SIZE == m_tail.fetchAndAddAcquire( 0 ) )
+    {
+      // The writer thread is blocked by the storage.
+      m_dropped++;
+      return static_cast<Record *> (0);
+    }
+
+  return &m_queue[head];
+}
+
+void IgcWriter::publish()
+{
+  const int head = m_head.fetchAndAddAcquire( 0 );
+
+  m_head.fetchAndStoreRelease( (head + 1) % QUEUE_SIZE );
+}
+
+bool IgcWriter::writeFix( const Fix& fix )
+{
+  Record* record = reserve();
+
+  if( record == 0 )
+    {
+      return false;
+    }
+
+  record->type = FixRecord;
+  record->data.fix = fix;
+  publish();
+  return true;
+}
+
+bool IgcWriter::writeExtension( const Extension& extension )
+{
+  Record* record = reserve();
+
+  if( record == 0 )
+    {
+      return false;
+    }
+
+  record->type = ExtensionRecord;
+  record->data.extension = extension;
+  publish();
+  return true;
+}
+
+bool IgcWriter::writeLine( const QString& line )
+{
+  Record* record = reserve();
+
+  if( record == 0 )
+    {
+      return false;
+    }
+
+  // Space is left for the line end and the terminating null.
+  const QByteArray ba = line.toLatin1().left( LineSize - 3 );
+
+  record->type = LineRecord;
+  memcpy( record->data.line, ba.constData(), ba.size() );
+  record->data.line[ba.size()] = '\0';
+  publish();
+  return true;
+}
+
+QString IgcWriter::iRecord( const int extensions )
+{
+  // Code and length of the extensions in the order of the B record.
+  const struct
+  {
+    int extension;
+    const char* code;
+    int length;
+  } fields[] =
+  {
+    { GeneralConfig::IgcFxa, "FXA", 3 },
+    { GeneralConfig::IgcSiu, "SIU", 2 },
+    { GeneralConfig::IgcTas, "TAS", 3 },
+    { GeneralConfig::IgcVar, "VAR", 4 }
+  };
+
+  QString definitions;
+  int count = 0;
+  int start = B_RECORD_LENGTH + 1;
+
+  for( uint i = 0; i < sizeof(fields) / sizeof(fields[0]); i++ )
+    {
+      if( (extensions & fields[i].extension) == 0 )
+        {
+          continue;
+        }
+
+      const int end = start + fields[i].length - 1;
+
+      definitions += QString( "%1%2%3" )
+                     .arg( start, 2, 10, QChar('0') )
+                     .arg( end, 2, 10, QChar('0') )
+                     .arg( fields[i].code );
+      start = end + 1;
+      count++;
+    }
+
+  if( count == 0 )
+    {
+      return QString();
+    }
+
+  return QString( "I%1" ).arg( count, 2, 10, QChar('0') ) + definitions;
+}
+
+int IgcWriter::format( const Record& record, char* buffer ) const
+{
+  char* p = buffer;
+
+  switch( record.type )
+    {
+      case FixRecord:
+        {
+          // BHHMMSSDDMMmmmNDDDMMmmmEAPPPPPGGGGG followed by the
+          // extensions declared in the I record.
+          const Fix& fix = record.data.fix;
+
+          *p++ = 'B';
+          p = putTime( p, fix.time );
+          p = putCoordinate( p, fix.latitude, 2, 'N', 'S' );
+          p = putCoordinate( p, fix.longitude, 3, 'E', 'W' );
+          *p++ = 'A';
+          p = putAltitude( p, fix.pressureAltitude );
+          p = putAltitude( p, fix.gnssAltitude );
+
+          if( m_extensions & GeneralConfig::IgcFxa )
+            {
+              p = putNumber( p, fix.fixAccuracy, 3 );
+            }
+
+          if( m_extensions & GeneralConfig::IgcSiu )
+            {
+              p = putNumber( p, fix.satsInUse, 2 );
+            }
+
+          if( m_extensions & GeneralConfig::IgcTas )
+            {
+              p = putNumber( p, fix.tas, 3 );
+            }
+
+          if( m_extensions & GeneralConfig::IgcVar )
+            {
+              // Vario in dm/s with sign
+              p = putSigned( p, fix.vario / 10, 3 );
+            }
+
+          break;
+        }
+
+      case ExtensionRecord:
+        {
+          // KHHMMSSHDTTASkphWDIWSP+VVVVVV
+          const Extension& ext = record.data.extension;
+
+          *p++ = 'K';
+          p = putTime( p, ext.time );
+          p = putNumber( p, ext.heading, 3 );
+          p = putNumber( p, ext.tas, 3 );
+          *p++ = 'k';
+          *p++ = 'p';
+          *p++ = 'h';
+          p = putNumber( p, ext.windDirection, 3 );
+          p = putNumber( p, ext.windSpeed, 3 );
+          p = putSigned( p, ext.vario, 6 );
+          break;
+        }
+
+      case LineRecord:
+        {
+          const int len = strlen( record.data.line );
+
+          memcpy( p, record.data.line, len );
+          p += len;
+          break;
+        }
+    }
+
+  *p++ = '\r';
+  *p++ = '\n';
+
+  return p - buffer;
+}
+
+void IgcWriter::writeBuffer( const char* buffer, int size )
+{
+  while( size > 0 )
+    {
+      const ssize_t written = ::write( m_fd, buffer, size );
+
+      if( written < 0 )
+        {
+          if( errno == EINTR )
+            {
+              continue;
+            }
+
+          qWarning() << "IgcWriter: Write error" << strerror(errno);
+          return;
+        }
+
+      buffer += written;
+      size -= written;
+    }
+}
+
+void IgcWriter::run()
+{
+  char buffer[BATCH_RECORDS * LineSize];
+
+  while( true )
+    {
+      // The stop flag is read before the queue, that all records queued
+      // before the close call are written.
+      const bool stop = m_stop.fetchAndAddAcquire( 0 ) != 0;
+
+      int tail = m_tail.fetchAndAddAcquire( 0 );
+      int used = 0;
+      bool written = false;
+
+      while( tail != m_head.fetchAndAddAcquire( 0 ) )
+        {
+          used += format( m_queue[tail], buffer + used );
+
+          tail = (tail + 1) % QUEUE_SIZE;
+          m_tail.fetchAndStoreRelease( tail );
+
+          if( used > (BATCH_RECORDS - 1) * LineSize )
+            {
+              writeBuffer( buffer, used );
+              used = 0;
+              written = true;
+            }
+        }
+
+      if( used > 0 )
+        {
+          writeBuffer( buffer, used );
+          written = true;
+        }
+
+      if( written )
+        {
+          fdatasync( m_fd );
+        }
+
+      if( stop )
+        {
+          break;
+        }
+
+      m_mutex.lock();
+
+      if( m_stop.fetchAndAddAcquire( 0 ) == 0 )
+        {
+          m_wakeUp.wait( &m_mutex, FLUSH_INTERVAL );
+        }
+
+      m_mutex.unlock();
+    }
+}
@@ -0,0 +1,248 @@
+/***********************************************************************
+**
+**   igcwriter.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class IgcWriter
+ *
+ * \brief Writes the records of an IGC file in a separate thread.
+ *
+ * The IGC logger passes the fixes and the extension data as binary records
+ * to the writer. The records are put into a lock-free queue with a single
+ * producer, the GUI thread, and a single consumer, the writer thread. Other
+ * records, like header, F and C records, are passed as preformatted lines.
+ * The B record extensions, which are declared by the I record, are selected
+ * when the file is opened.
+ *
+ * The writer thread wakes up once per flush interval, formats the queued
+ * records into fixed-width lines in a stack buffer without any heap
+ * allocation and writes them in one batch. Afterwards the data are synced
+ * to the storage. Slow flash storage does so never stall the navigation and
+ * a crash loses at most the records of one flush interval.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef IGC_WRITER_H
+#define IGC_WRITER_H
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+class IgcWriter : public QThread
+{
+  Q_OBJECT
+
+ private:
+
+  Q_DISABLE_COPY ( IgcWriter )
+
+ public:
+
+  /**
+   * Data of a B record.
+   */
+  struct Fix
+  {
+    /** UTC time of the fix in seconds since midnight. */
+    int time;
+    /** Latitude in KFLog coordinates. */
+    int latitude;
+    /** Longitude in KFLog coordinates. */
+    int longitude;
+    /** Pressure altitude in meters. */
+    int pressureAltitude;
+    /** GNSS altitude in meters. */
+    int gnssAltitude;
+    /** Fix accuracy in meters. */
+    int fixAccuracy;
+    /** Number of satellites in use. */
+    int satsInUse;
+    /** True airspeed in km/h. */
+    int tas;
+    /** Vario in cm/s. */
+    int vario;
+  };
+
+  /**
+   * Data of a K record, which contains the extension data defined by the
+   * J record of the header.
+   */
+  struct Extension
+  {
+    /** UTC time in seconds since midnight. */
+    int time;
+    /** True heading in degrees. */
+    int heading;
+    /** True airspeed in km/h. */
+    int tas;
+    /** Wind direction in degrees. */
+    int windDirection;
+    /** Wind speed in km/h. */
+    int windSpeed;
+    /** Vario in mm/s. */
+    int vario;
+  };
+
+  IgcWriter( QObject *parent = 0 );
+
+  virtual ~IgcWriter();
+
+  /**
+   * Creates the file and starts the writer thread.
+   *
+   * \param fileName Path of the IGC file.
+   *
+   * \param extensions B record extensions as combination of
+   *        GeneralConfig::IgcExtension.
+   *
+   * \return True in case of success otherwise false.
+   */
+  bool open( const QString& fileName, const int extensions );
+
+  /**
+   * Writes all queued records, syncs and closes the file. The call blocks
+   * until the writer thread has finished.
+   */
+  void close();
+
+  /**
+   * \return True, if a file is open.
+   */
+  bool isOpen() const
+  {
+    return m_fd >= 0;
+  };
+
+  /**
+   * Queues a B record.
+   *
+   * \return False, if the queue is full and the record was dropped.
+   */
+  bool writeFix( const Fix& fix );
+
+  /**
+   * Queues a K record.
+   *
+   * \return False, if the queue is full and the record was dropped.
+   */
+  bool writeExtension( const Extension& extension );
+
+  /**
+   * Queues a preformatted line, the line end is added. Too long lines are
+   * truncated.
+   *
+   * \return False, if the queue is full and the line was dropped.
+   */
+  bool writeLine( const QString& line );
+
+  /**
+   * \return The I record, which declares the passed B record extensions, or
+   *         an empty string, if no extension is selected.
+   */
+  static QString iRecord( const int extensions );
+
+  /**
+   * \return The number of records dropped since the file was opened.
+   */
+  int droppedRecords() const
+  {
+    return m_dropped;
+  };
+
+  /** Maximum length of a line with the line end. */
+  static const int LineSize = 128;
+
+ protected:
+
+  /**
+   * Writes the queued records in intervals until the file is closed.
+   */
+  void run();
+
+ private:
+
+  enum RecordType
+  {
+    FixRecord,
+    ExtensionRecord,
+    LineRecord
+  };
+
+  struct Record
+  {
+    RecordType type;
+
+    union
+    {
+      Fix       fix;
+      Extension extension;
+      char      line[LineSize];
+    } data;
+  };
+
+  /**
+   * Reserves the next free queue slot.
+   *
+   * \return The slot or 0, if the queue is full.
+   */
+  Record* reserve();
+
+  /** Publishes the slot reserved before to the writer thread. */
+  void publish();
+
+  /**
+   * Formats a record into the buffer.
+   *
+   * \return The number of written characters.
+   */
+  int format( const Record& record, char* buffer ) const;
+
+  /**
+   * Writes the buffer completely to the file.
+   */
+  void writeBuffer( const char* buffer, int size );
+
+  /** File descriptor of the IGC file, -1 if closed. */
+  int m_fd;
+
+  /** B record extensions of the open file. */
+  int m_extensions;
+
+  /** Ring of queued records. One slot is always kept free. */
+  Record* m_queue;
+
+  /** Next slot to be written by the producer. */
+  QAtomicInt m_head;
+
+  /** Next slot to be read by the writer thread. */
+  QAtomicInt m_tail;
+
+  /** Set, if the writer thread shall finish. */
+  QAtomicInt m_stop;
+
+  /** Number of dropped records. */
+  int m_dropped;
+
+  /** Used only to wait for the next flush interval. */
+  QMutex m_mutex;
+  QWaitCondition m_wakeUp;
+};
+
+#endif
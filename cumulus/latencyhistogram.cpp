@@ -0,0 +1,106 @@
+/***********************************************************************
+**
+**   latencyhistogram.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "latencyhistogram.h"
+
+LatencyHistogram::LatencyHistogram( const int capacity ) :
+  m_sortedValid(true),
+  m_capacity(capacity),
+  m_oldest(0),
+  m_total(0)
+{
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+void LatencyHistogram::add( const qint64 nsecs )
+{
+  if( m_capacity > 0 && m_samples.size() >= m_capacity )
+    {
+      // The oldest latency is replaced by the new one.
+      m_total -= m_samples.at( m_oldest );
+      m_samples[m_oldest] = nsecs;
+      m_oldest = (m_oldest + 1) % m_samples.size();
+    }
+  else
+    {
+      m_samples.append( nsecs );
+    }
+
+  m_sortedValid = false;
+  m_total += nsecs;
+}
+
+void LatencyHistogram::clear()
+{
+  m_samples.clear();
+  m_sorted.clear();
+  m_sortedValid = true;
+  m_oldest = 0;
+  m_total = 0;
+}
+
+void LatencyHistogram::setCapacity( const int capacity )
+{
+  m_capacity = capacity;
+  clear();
+}
+
+qint64 LatencyHistogram::percentile( const double percent ) const
+{
+  if( m_samples.isEmpty() )
+    {
+      return 0;
+    }
+
+  if( m_sortedValid == false )
+    {
+      m_sorted = m_samples;
+      std::sort( m_sorted.begin(), m_sorted.end() );
+      m_sortedValid = true;
+    }
+
+  // Nearest rank method
+  int rank = static_cast<int> (ceil( percent / 100.0 * m_sorted.size() ));
+
+  rank = qBound( 1, rank, m_sorted.size() );
+
+  return m_sorted.at( rank - 1 );
+}
+
+double LatencyHistogram::throughput() const
+{
+  if( m_total <= 0 )
+    {
+      return 0.0;
+    }
+
+  return double( m_samples.size() ) * 1e9 / double( m_total );
+}
+
+QString LatencyHistogram::toString() const
+{
+  return QString( "%1 %2 %3 %4 %5" )
+         .arg( count(), 8 )
+         .arg( double( percentile( 50.0 ) ) / 1000.0, 10, 'f', 1 )
+         .arg( double( percentile( 99.0 ) ) / 1000.0, 10, 'f', 1 )
+         .arg( double( maximum() ) / 1000.0, 10, 'f', 1 )
+         .arg( throughput(), 12, 'f', 0 );
+}
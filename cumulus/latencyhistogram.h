@@ -0,0 +1,131 @@
+/***********************************************************************
+**
+**   latencyhistogram.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class LatencyHistogram
+ *
+ * \brief Distribution of measured latencies.
+ *
+ * The histogram stores the single latencies in nanoseconds. Percentiles are
+ * determined by sorting the stored latencies, which is done only once after
+ * new latencies have been added.
+ *
+ * If a capacity is set, only the last latencies up to the capacity are
+ * kept, that gives running statistics of a continuous measurement.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+
+class LatencyHistogram
+{
+ public:
+
+  /**
+   * \param capacity Maximum number of kept latencies, 0 means unlimited.
+   */
+  LatencyHistogram( const int capacity=0 );
+
+  virtual ~LatencyHistogram();
+
+  /**
+   * Adds a latency.
+   *
+   * \param nsecs Latency in nanoseconds.
+   */
+  void add( const qint64 nsecs );
+
+  /** Removes all latencies. */
+  void clear();
+
+  /**
+   * Sets the maximum number of kept latencies and removes all latencies.
+   *
+   * \param capacity Maximum number of kept latencies, 0 means unlimited.
+   */
+  void setCapacity( const int capacity );
+
+  /**
+   * \return The number of latencies.
+   */
+  int count() const
+  {
+    return m_samples.size();
+  };
+
+  /**
+   * \return The sum of all latencies in nanoseconds.
+   */
+  qint64 total() const
+  {
+    return m_total;
+  };
+
+  /**
+   * \return The largest latency in nanoseconds.
+   */
+  qint64 maximum() const
+  {
+    return percentile( 100.0 );
+  };
+
+  /**
+   * \param percent Percentage of latencies, which are not longer than the
+   *        returned one, e.g. 50 for the median.
+   *
+   * \return The percentile in nanoseconds or 0, if the histogram is empty.
+   */
+  qint64 percentile( const double percent ) const;
+
+  /**
+   * \return The number of latencies per second, which the measured code
+   *         can process, or 0, if the histogram is empty.
+   */
+  double throughput() const;
+
+  /**
+   * \return One line with count, p50, p99, max in microseconds and the
+   *         throughput.
+   */
+  QString toString() const;
+
+ private:
+
+  /** The latencies in the order of their adding. */
+  QVector<qint64> m_samples;
+
+  /** The latencies sorted, valid if m_sortedValid is set. */
+  mutable QVector<qint64> m_sorted;
+
+  mutable bool m_sortedValid;
+
+  /** Maximum number of latencies, 0 means unlimited. */
+  int m_capacity;
+
+  /** Index of the oldest latency, if the capacity is reached. */
+  int m_oldest;
+
+  qint64 m_total;
+};
+
+#endif
@@ -101,6 +101,14 @@ class LineElement : public BaseMapElement
       return sbBox;
     };
 
+    /**
+     * Returns the bounding box of the projected positions.
+     */
+    const QRect& getProjectedBoundingBox() const
+    {
+      return bBox;
+    };
+
     /**
       * Returns the projected positions of the line element.
       */
@@ -25,8 +25,11 @@
 #include <QtScroller>
 #endif
 
+#include "calculator.h"
+#include "flightanalysis.h"
 #include "generalconfig.h"
 #include "igclogger.h"
+#include "igcparser.h"
 #include "logbook.h"
 #include "layout.h"
 #include "mainwindow.h"
@@ -107,6 +110,20 @@ Logbook::Logbook( QWidget *parent ) :
   m_deleteButton->setMaximumSize(buttonSize, buttonSize);
   m_deleteButton->setEnabled(false);
 
+  m_analyseButton = new QPushButton;
+  m_analyseButton->setIcon( QIcon( GeneralConfig::instance()->loadPixmap( "file-32.png" ) ) );
+  m_analyseButton->setIconSize(QSize(iconSize, iconSize));
+  m_analyseButton->setMinimumSize(buttonSize, buttonSize);
+  m_analyseButton->setMaximumSize(buttonSize, buttonSize);
+  m_analyseButton->setToolTip( tr("Flight analysis") );
+
+  m_thermalButton = new QPushButton;
+  m_thermalButton->setIcon( QIcon( GeneralConfig::instance()->loadPixmap( "thermal.xpm" ) ) );
+  m_thermalButton->setIconSize(QSize(iconSize, iconSize));
+  m_thermalButton->setMinimumSize(buttonSize, buttonSize);
+  m_thermalButton->setMaximumSize(buttonSize, buttonSize);
+  m_thermalButton->setToolTip( tr("Learn thermals") );
+
   m_okButton = new QPushButton;
   m_okButton->setIcon(QIcon(GeneralConfig::instance()->loadPixmap("ok.png")));
   m_okButton->setIconSize(QSize(iconSize, iconSize));
@@ -121,6 +138,8 @@ Logbook::Logbook( QWidget *parent ) :
 
   connect( m_deleteAllButton, SIGNAL(clicked() ), this, SLOT(slot_DeleteAllRows()) );
   connect( m_deleteButton, SIGNAL(clicked() ), this, SLOT(slot_DeleteRows()) );
+  connect( m_analyseButton, SIGNAL(clicked() ), this, SLOT(slot_Analyse()) );
+  connect( m_thermalButton, SIGNAL(clicked() ), this, SLOT(slot_LearnThermals()) );
   connect( m_okButton, SIGNAL(clicked() ), this, SLOT(slot_Ok()) );
   connect( closeButton, SIGNAL(clicked() ), this, SLOT(slot_Close()) );
 
@@ -131,6 +150,10 @@ Logbook::Logbook( QWidget *parent ) :
   vbox->addWidget( m_deleteAllButton );
   vbox->addSpacing(32);
   vbox->addWidget( m_deleteButton );
+  vbox->addSpacing(32);
+  vbox->addWidget( m_analyseButton );
+  vbox->addSpacing(32);
+  vbox->addWidget( m_thermalButton );
   vbox->addStretch(2);
   vbox->addWidget( m_okButton );
   vbox->addSpacing(32);
@@ -371,6 +394,138 @@ void Logbook::slot_DeleteAllRows()
   m_tableModified = true;
 }
 
+void Logbook::slot_Analyse()
+{
+  QDir dir( GeneralConfig::instance()->getUserDataDirectory() + "/igc" );
+
+  QStringList filters;
+  filters << "*.igc" << "*.IGC";
+
+  // The newest flight is offered at first.
+  QStringList files = dir.entryList( filters, QDir::Files, QDir::Time );
+
+  if( files.isEmpty() )
+    {
+      QMessageBox mb( QMessageBox::Information,
+                      tr( "Flight analysis" ),
+                      tr( "No IGC files found" ),
+                      QMessageBox::Ok,
+                      this );
+
+#ifdef ANDROID
+
+      mb.show();
+      QPoint pos = mapToGlobal(QPoint( width()/2 - mb.width()/2, height()/2 - mb.height()/2 ));
+      mb.move( pos );
+
+#endif
+
+      mb.exec();
+      return;
+    }
+
+  bool okay;
+
+  QString item = QInputDialog::getItem( this,
+                                        tr( "Flight analysis" ),
+                                        tr( "IGC file:" ),
+                                        files, 0, false, &okay );
+  if( ! okay || item.isEmpty() )
+    {
+      return;
+    }
+
+  QApplication::setOverrideCursor( QCursor( Qt::WaitCursor ) );
+
+  QTime t;
+  t.start();
+
+  IgcParser::Flight flight;
+  FlightAnalysis analysis;
+
+  if( IgcParser::parse( dir.absoluteFilePath( item ), flight ) )
+    {
+      analysis.analyse( flight );
+    }
+
+  QString report = analysis.report() +
+                   "\n" + tr( "Analysed in %1 ms" ).arg( t.elapsed() );
+
+  QApplication::restoreOverrideCursor();
+
+  QMessageBox mb( QMessageBox::Information,
+                  item,
+                  report,
+                  QMessageBox::Ok,
+                  this );
+
+#ifdef ANDROID
+
+  mb.show();
+  QPoint pos = mapToGlobal(QPoint( width()/2 - mb.width()/2, height()/2 - mb.height()/2 ));
+  mb.move( pos );
+
+#endif
+
+  mb.exec();
+}
+
+void Logbook::slot_LearnThermals()
+{
+  QDir dir( GeneralConfig::instance()->getUserDataDirectory() + "/igc" );
+
+  QStringList filters;
+  filters << "*.igc" << "*.IGC";
+
+  const QStringList files = dir.entryList( filters, QDir::Files );
+
+  ThermalStore& store = calculator->getThermalStore();
+
+  QApplication::setOverrideCursor( QCursor( Qt::WaitCursor ) );
+
+  int imported = 0;
+  int thermals = 0;
+
+  IgcParser::Flight flight;
+
+  for( int i = 0; i < files.size(); i++ )
+    {
+      // Every file is learned only once.
+      if( store.isImported( files.at(i) ) ||
+          ! IgcParser::parse( dir.absoluteFilePath( files.at(i) ), flight ) )
+        {
+          continue;
+        }
+
+      thermals += store.addFlight( flight, files.at(i) );
+      imported++;
+    }
+
+  if( store.isModified() )
+    {
+      store.save( ThermalStore::defaultFileName() );
+    }
+
+  QApplication::restoreOverrideCursor();
+
+  QMessageBox mb( QMessageBox::Information,
+                  tr( "Learn thermals" ),
+                  tr( "%1 thermals learned from %2 new IGC files" )
+                    .arg( thermals ).arg( imported ),
+                  QMessageBox::Ok,
+                  this );
+
+#ifdef ANDROID
+
+  mb.show();
+  QPoint pos = mapToGlobal(QPoint( width()/2 - mb.width()/2, height()/2 - mb.height()/2 ));
+  mb.move( pos );
+
+#endif
+
+  mb.exec();
+}
+
 void Logbook::slot_Ok()
 {
   if( m_tableModified )
@@ -24,7 +24,8 @@
  *
  * This widget can list all entries of a flight logbook. The user can remove
  * selected or all log entries if he wants. The content of the logbook is stored
- * in a text file in the user's data directory.
+ * in a text file in the user's data directory. A recorded IGC file can be
+ * selected for a flight analysis.
  *
  * \date 2012
  *
@@ -75,6 +76,12 @@ private slots:
   /** Removes all rows from the table. */
   void slot_DeleteAllRows();
 
+  /** Analyses a recorded IGC file, which is selected by the user. */
+  void slot_Analyse();
+
+  /** Learns the thermals of all recorded IGC files, which are new. */
+  void slot_LearnThermals();
+
   /** Ok button press is handled here. */
   void slot_Ok();
 
@@ -106,6 +113,12 @@ private:
   /** Delete all button. */
   QPushButton* m_deleteAllButton;
 
+  /** Flight analysis button. */
+  QPushButton* m_analyseButton;
+
+  /** Learn thermals button. */
+  QPushButton* m_thermalButton;
+
   /** ok button. */
   QPushButton* m_okButton;
 
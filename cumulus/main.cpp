@@ -42,15 +42,41 @@
 #include <QtGui>
 
 #include "target.h"
+#include "flightanalysis.h"
+#include "flightreplay.h"
 #include "mainwindow.h"
 #include "generalconfig.h"
+#include "igcparser.h"
 #include "messagehandler.h"
+#include "navbenchmark.h"
 #include "hwinfo.h"
 
 #ifdef ANDROID
 #include "jnisupport.h"
 #endif
 
+#ifndef ANDROID
+
+/**
+ * Returns the file, which follows the passed command line option, e.g.
+ * --replay <file>. The result is empty, if the option is not given.
+ */
+static QString getOptionFile( const QString& option )
+{
+  const QStringList args = QCoreApplication::arguments();
+
+  const int idx = args.indexOf( option );
+
+  if( idx > 0 && idx + 1 < args.size() )
+    {
+      return args.at( idx + 1 );
+    }
+
+  return QString();
+}
+
+#endif
+
 /////////////////////
 int main(int argc, char *argv[])
 {
@@ -330,6 +356,65 @@ int main(int argc, char *argv[])
   // save done configuration settings
   conf->save();
 
+#ifndef ANDROID
+
+  // A recorded flight can be replayed without user interface through the
+  // navigation calculations: cumulus --replay <file>
+  const QString replayFile = getOptionFile( "--replay" );
+
+  if( ! replayFile.isEmpty() )
+    {
+      FlightReplay *replay = new FlightReplay();
+
+      bool ok = replay->replay( replayFile );
+
+      delete replay;
+      delete GeneralConfig::instance();
+
+      return ok ? 0 : 1;
+    }
+
+  // The latencies of the navigation pipeline stages are measured by
+  // replaying a recorded flight: cumulus --benchmark <file>
+  const QString benchFile = getOptionFile( "--benchmark" );
+
+  if( ! benchFile.isEmpty() )
+    {
+      bool ok = NavBenchmark::run( benchFile );
+
+      delete GeneralConfig::instance();
+
+      return ok ? 0 : 1;
+    }
+
+  // A recorded IGC file is analysed: cumulus --analyse <file>
+  const QString analyseFile = getOptionFile( "--analyse" );
+
+  if( ! analyseFile.isEmpty() )
+    {
+      QTime t;
+      t.start();
+
+      IgcParser::Flight flight;
+      FlightAnalysis analysis;
+
+      bool ok = IgcParser::parse( analyseFile, flight );
+
+      if( ok )
+        {
+          analysis.analyse( flight );
+
+          qDebug( "%s\nAnalysed in %d ms",
+                  analysis.report().toLatin1().data(), t.elapsed() );
+        }
+
+      delete GeneralConfig::instance();
+
+      return ok ? 0 : 1;
+    }
+
+#endif
+
   // create the Cumulus application window
   MainWindow *cumulus = new MainWindow( Qt::WindowContextHelpButtonHint );
 
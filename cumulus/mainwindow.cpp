@@ -898,6 +898,9 @@ void MainWindow::slotCreateApplicationWidgets()
   connect( Flarm::instance(), SIGNAL( flarmTrafficInfo( QString& ) ),
            Map::instance, SLOT( slotShowFlarmTrafficInfo( QString& )) );
 
+  connect( Flarm::instance(), SIGNAL( flarmConvergingTraffic( const QString&, const bool ) ),
+           this, SLOT( slotNotification( const QString&, const bool ) ) );
+
   connect( Flarm::instance(), SIGNAL( flarmAlertZoneInfo( FlarmBase::FlarmAlertZone& ) ),
            _globalMapContents, SLOT( slotNewFlarmAlertZoneData( FlarmBase::FlarmAlertZone& )) );
 
@@ -941,6 +944,8 @@ void MainWindow::slotCreateApplicationWidgets()
            viewMap, SLOT( slot_GlidePath( const Altitude& ) ) );
   connect( calculator, SIGNAL( bestSpeed( const Speed& ) ),
            viewMap, SLOT( slot_bestSpeed( const Speed& ) ) );
+  connect( calculator, SIGNAL( newSpeedToFly( const Speed& ) ),
+           viewMap, SLOT( slot_speedToFly( const Speed& ) ) );
   connect( calculator, SIGNAL( newMc( const Speed& ) ),
            viewMap, SLOT( slot_Mc( const Speed& ) ) );
   connect( calculator, SIGNAL( newVario( const Speed& ) ),
@@ -957,16 +962,18 @@ void MainWindow::slotCreateApplicationWidgets()
            m_logger, SLOT( slotTaskSectorTouched() ) );
   connect( calculator, SIGNAL( taskInfo( const QString&, const bool ) ),
            this, SLOT( slotNotification( const QString&, const bool ) ) );
-  connect( calculator, SIGNAL( newSample() ),
+  connect( calculator, SIGNAL( newLoggerSample() ),
            m_logger, SLOT( slotMakeFixEntry() ) );
   connect( calculator, SIGNAL( flightModeChanged(Calculator::FlightMode) ),
            m_logger, SLOT( slotFlightModeChanged(Calculator::FlightMode) ) );
 
   connect( ( QObject* ) calculator->getReachList(), SIGNAL( newReachList() ),
            this, SLOT( slotNewReachList() ) );
+  connect( ( QObject* ) calculator->getReachList(), SIGNAL( reachSitesChanged( const QVector<int>&, bool ) ),
+           this, SLOT( slotReachSitesChanged( const QVector<int>&, bool ) ) );
 
 #ifdef INTERNET
-  connect( calculator, SIGNAL( newSample() ),
+  connect( calculator, SIGNAL( newLoggerSample() ),
            m_liveTrackLogger, SLOT( slotNewFixEntry() ) );
 #endif
 
@@ -2877,6 +2884,16 @@ void MainWindow::slotNewReachList()
   Map::instance->scheduleRedraw(Map::waypoints);
 }
 
+void MainWindow::slotReachSitesChanged( const QVector<int>& sites, bool mapChanged )
+{
+  viewRP->slot_updateSites( sites );
+
+  if( mapChanged )
+    {
+      Map::instance->scheduleRedraw(Map::waypoints);
+    }
+}
+
 void MainWindow::keyPressEvent( QKeyEvent* event )
 {
 #ifdef ANDROID
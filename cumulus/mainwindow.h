@@ -43,6 +43,7 @@
 #include <QTabWidget>
 #include <QResizeEvent>
 #include <QShortcut>
+#include <QVector>
 #include <QPointer>
 
 #include "igclogger.h"
@@ -233,6 +234,8 @@ public slots:
   void slotAlarm (const QString&, const bool sound=true);
   /** updates the list of reachable points  */
   void slotNewReachList();
+  /** updates the changed values of reachable points */
+  void slotReachSitesChanged( const QVector<int>& sites, bool mapChanged );
   /** switch on/off GPS data processing */
   void slotToggleGps(bool);
   /** used to allow or disable user keys processing during map drawing */
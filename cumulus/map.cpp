@@ -26,6 +26,7 @@
 #include "calculator.h"
 #include "mainwindow.h"
 #include "distance.h"
+#include "fixlatency.h"
 #include "generalconfig.h"
 #include "gpsnmea.h"
 #include "layout.h"
@@ -37,6 +38,7 @@
 #include "mapdefaults.h"
 #include "mapmatrix.h"
 #include "mapview.h"
+#include "perftrace.h"
 #include "radiopoint.h"
 #include "reachablelist.h"
 #include "runway.h"
@@ -89,6 +91,7 @@ Map::Map(QWidget* parent) : QWidget(parent),
   m_mode = northUp;
   m_scheduledFromLayer = baseLayer;
   m_ShowGlider = false;
+  m_fixIngestTime = 0;
   setMutex(false);
 
   //setup progressive zooming values
@@ -273,14 +276,11 @@ void Map::p_displayDetailedItemInfo(const QPoint& current)
   int delta = 0, dX = 0, dY = 0;
 
   // define lists to be used for searching
-  int searchList[] =
-    {
-      MapContents::AirfieldList,
-      MapContents::GliderfieldList,
-      MapContents::OutLandingList,
-      MapContents::RadioList,
-      MapContents::HotspotList
-    };
+  quint32 searchMask = PointIndex::listBit( MapContents::AirfieldList ) |
+                       PointIndex::listBit( MapContents::GliderfieldList ) |
+                       PointIndex::listBit( MapContents::OutLandingList ) |
+                       PointIndex::listBit( MapContents::RadioList ) |
+                       PointIndex::listBit( MapContents::HotspotList );
 
   Waypoint *w = static_cast<Waypoint *> (0);
 
@@ -340,141 +340,165 @@ void Map::p_displayDetailedItemInfo(const QPoint& current)
         }
     }
 
+  // Fetch the candidates from the spatial index. The search radius covers
+  // the snap rectangle around the touched position. The hits are ordered by
+  // their lists in the same way, as the lists were searched before.
+  QVector<PointIndex::Hit> hits;
+
   // @AP: On map scale higher as 1024 we don't evaluate anything
-  for( int l = 0; l < 5 && cs < 1024.0; l++ )
-    {
-      for(unsigned int loop = 0;
-          loop < _globalMapContents->getListLength(searchList[l]); loop++)
-        {
-          // Get specific site data from current list. We have to
-          // distinguish between AirfieldList, GilderfieldList, OutlandingList
-          // RadioList and HotspotList.
-          SinglePoint* poi;
-
-          QString siteName;
-          QString siteDescription;
-          short siteType;
-          WGSPoint siteWgsPosition;
-          QPoint sitePosition;
-          float siteElevation;
-          QPoint curPos;
-          QString siteComment;
-          QString siteCountry;
-
-          if( searchList[l] == MapContents::AirfieldList )
-            {
-              // Fetch data from the airfield list
-              poi = _globalMapContents->getAirfield(loop);
-            }
-          else if( searchList[l] == MapContents::GliderfieldList )
-            {
-              // fetch data from the gliderfield list
-              poi = _globalMapContents->getGliderfield(loop);
-            }
-          else if( searchList[l] == MapContents::OutLandingList )
-            {
-              // fetch data from the outlanding list
-              poi = _globalMapContents->getOutlanding(loop);
-            }
-          else if( searchList[l] == MapContents::RadioList )
-            {
-              // fetch data from the radio point list
-              poi = _globalMapContents->getRadioPoint(loop);
-            }
-          else if( searchList[l] == MapContents::HotspotList )
-            {
-              // fetch data from the hotspot list
-              poi = _globalMapContents->getHotspot(loop);
-            }
-          else
-            {
-              qWarning( "Map::p_displayDetailedItemInfo: ListType %d is unknown",
-                        searchList[l] );
-              break;
-            }
+  if( cs < 1024.0 )
+    {
+      double radius = 1.5 * delta * cs / 1000.0;
 
-          curPos = poi->getMapPosition();
+      _globalMapContents->getPointIndex().inRadius( _globalMapMatrix->mapToWgs( current ),
+                                                    radius,
+                                                    searchMask |
+                                                    PointIndex::listBit( MapContents::WaypointList ),
+                                                    hits );
+    }
 
-          if( ! snapRect.contains(curPos) )
-            {
-              // @AP: Point lays outside of snap rectangle, we ignore it
-              continue;
-            }
+  // List, which is not searched further, because a very near point was found.
+  int doneList = MapContents::NotSet;
+
+  for( int h = 0; h < hits.size(); h++ )
+    {
+      const int list = hits.at(h).entry.list;
+      const unsigned int loop = hits.at(h).entry.index;
+
+      if( list == doneList || (searchMask & PointIndex::listBit( list )) == 0 ||
+          loop >= _globalMapContents->getListLength( list ) )
+        {
+          continue;
+        }
+
+      // Get specific site data from current list. We have to
+      // distinguish between AirfieldList, GilderfieldList, OutlandingList
+      // RadioList and HotspotList.
+      SinglePoint* poi;
+
+      QString siteName;
+      QString siteDescription;
+      short siteType;
+      WGSPoint siteWgsPosition;
+      QPoint sitePosition;
+      float siteElevation;
+      QPoint curPos;
+      QString siteComment;
+      QString siteCountry;
+
+      if( list == MapContents::AirfieldList )
+        {
+          // Fetch data from the airfield list
+          poi = _globalMapContents->getAirfield(loop);
+        }
+      else if( list == MapContents::GliderfieldList )
+        {
+          // fetch data from the gliderfield list
+          poi = _globalMapContents->getGliderfield(loop);
+        }
+      else if( list == MapContents::OutLandingList )
+        {
+          // fetch data from the outlanding list
+          poi = _globalMapContents->getOutlanding(loop);
+        }
+      else if( list == MapContents::RadioList )
+        {
+          // fetch data from the radio point list
+          poi = _globalMapContents->getRadioPoint(loop);
+        }
+      else if( list == MapContents::HotspotList )
+        {
+          // fetch data from the hotspot list
+          poi = _globalMapContents->getHotspot(loop);
+        }
+      else
+        {
+          qWarning( "Map::p_displayDetailedItemInfo: ListType %d is unknown",
+                    list );
+          continue;
+        }
+
+      curPos = poi->getMapPosition();
+
+      if( ! snapRect.contains(curPos) )
+        {
+          // @AP: Point lays outside of snap rectangle, we ignore it
+          continue;
+        }
 
-          dX = abs(curPos.x() - current.x());
-          dY = abs(curPos.y() - current.y());
+      dX = abs(curPos.x() - current.x());
+      dY = abs(curPos.y() - current.y());
 
-          // qDebug( "pX=%d, pY=%d, cX=%d, cY=%d, delta=%d, dX=%d, dY=%d, lastDist=%d",
-          //         curPos.x(), curPos.y(), current.x(), current.y(), delta, dX, dY, lastDist );
+      // qDebug( "pX=%d, pY=%d, cX=%d, cY=%d, delta=%d, dX=%d, dY=%d, lastDist=%d",
+      //         curPos.x(), curPos.y(), current.x(), current.y(), delta, dX, dY, lastDist );
 
-          // Abstand entspricht der Icon-Groesse
-          if( dX < delta && dY < delta )
+      // Abstand entspricht der Icon-Groesse
+      if( dX < delta && dY < delta )
+        {
+          if( found && ((dX+dY) > lastDist) )
             {
-              if( found && ((dX+dY) > lastDist) )
-                {
-                  // The point we found earlier was closer but a
-                  // taskpoint can be overwritten by an better point.
-                  continue;
-                }
+              // The point we found earlier was closer but a
+              // taskpoint can be overwritten by an better point.
+              continue;
+            }
 
-            siteName = poi->getWPName();
-            siteDescription = poi->getName();
-            siteType = poi->getTypeID();
-            siteWgsPosition = poi->getWGSPosition();
-            sitePosition = poi->getPosition();
-            siteElevation = poi->getElevation();
-            siteComment = poi->getComment();
-            siteCountry = poi->getCountry();
-
-            w = &m_wp;
-            w->name = siteName;
-            w->description = siteDescription;
-            w->type = siteType;
-            w->wgsPoint = siteWgsPosition;
-            w->projPoint = sitePosition;
-            w->elevation = siteElevation;
-            w->comment = siteComment;
-            w->country = siteCountry;
-            w->icao.clear();
-            w->frequency = 0.0;
-            w->taskPointIndex = -1;
-            w->wpListMember = false;
-            w->rwyList.clear();
-
-            Airfield*   af = dynamic_cast<Airfield *>(poi);
-            RadioPoint* rp = dynamic_cast<RadioPoint *>(poi);
-
-            if( af != static_cast<Airfield *>(0) )
-              {
-                // This is an airfield object
-                w->icao = af->getICAO();
-                w->frequency = af->getFrequency();
-                w->rwyList = af->getRunwayList();
-              }
-            else if( rp != static_cast<RadioPoint *>(0) )
+        siteName = poi->getWPName();
+        siteDescription = poi->getName();
+        siteType = poi->getTypeID();
+        siteWgsPosition = poi->getWGSPosition();
+        sitePosition = poi->getPosition();
+        siteElevation = poi->getElevation();
+        siteComment = poi->getComment();
+        siteCountry = poi->getCountry();
+
+        w = &m_wp;
+        w->name = siteName;
+        w->description = siteDescription;
+        w->type = siteType;
+        w->wgsPoint = siteWgsPosition;
+        w->projPoint = sitePosition;
+        w->elevation = siteElevation;
+        w->comment = siteComment;
+        w->country = siteCountry;
+        w->icao.clear();
+        w->frequency = 0.0;
+        w->taskPointIndex = -1;
+        w->wpListMember = false;
+        w->rwyList.clear();
+
+        Airfield*   af = dynamic_cast<Airfield *>(poi);
+        RadioPoint* rp = dynamic_cast<RadioPoint *>(poi);
+
+        if( af != static_cast<Airfield *>(0) )
+          {
+            // This is an airfield object
+            w->icao = af->getICAO();
+            w->frequency = af->getFrequency();
+            w->rwyList = af->getRunwayList();
+          }
+        else if( rp != static_cast<RadioPoint *>(0) )
+          {
+            // This is a RadioPoint
+            w->icao = rp->getICAO();
+            w->frequency = rp->getFrequency();
+
+            // Workaround for declination a.s.o. These data are passed
+            // as comment.
+            if( m_wp.comment.isEmpty() == false )
               {
-                // This is a RadioPoint
-                w->icao = rp->getICAO();
-                w->frequency = rp->getFrequency();
-
-                // Workaround for declination a.s.o. These data are passed
-                // as comment.
-                if( m_wp.comment.isEmpty() == false )
-                  {
-                    m_wp.comment += ", ";
-                  }
-
-                m_wp.comment += rp->getAdditionalText();
+                m_wp.comment += ", ";
               }
 
-            found = true;
-            lastDist = dX+dY;
+            m_wp.comment += rp->getAdditionalText();
+          }
 
-            if( lastDist < (delta/3) ) //if we're very near, stop searching the list
-              {
-                break;
-              }
-            }
+        found = true;
+        lastDist = dX+dY;
+
+        if( lastDist < (delta/3) ) //if we're very near, stop searching the list
+          {
+            doneList = list;
+          }
         }
     }
 
@@ -482,8 +506,15 @@ void Map::p_displayDetailedItemInfo(const QPoint& current)
   // @AP: On map scale higher as 1024 we don't evaluate anything
   QList<Waypoint>& wpList = _globalMapContents->getWaypointList();
 
-  for( int i = 0; i < wpList.count() && cs < 1024.0; i++ )
+  for( int h = 0; h < hits.size(); h++ )
     {
+      const int i = hits.at(h).entry.index;
+
+      if( hits.at(h).entry.list != MapContents::WaypointList || i >= wpList.size() )
+        {
+          continue;
+        }
+
       Waypoint& wp = wpList[i];
 
       // consider only points, which are to drawn on the map
@@ -764,8 +795,7 @@ void Map::p_drawAirspaces( bool reset )
 
   cuAeroMapP.begin(&m_pixAeroMap);
 
-  QTime t;
-  t.start();
+  PerfTrace::Scope scope( "Airspaces" );
 
   if( reset )
     {
@@ -890,7 +920,6 @@ void Map::p_drawAirspaces( bool reset )
     }
 
   cuAeroMapP.end();
-  // qDebug("Airspace, drawTime=%d ms", t.elapsed());
 }
 
 void Map::p_drawGrid()
@@ -1027,7 +1056,7 @@ void Map::p_drawTrail()
 {
   static uint counter = 0;
 
-  // QTime t; t.start();
+  PerfTrace::Scope scope( "Trail" );
 
   int pointCnt = m_trailPoints.size();
 
@@ -1125,8 +1154,255 @@ void Map::p_drawTrail()
       p.drawPath(m_tpp);
       p.end();
     }
+}
+
+void Map::p_drawGlideFootprint()
+{
+  if( GeneralConfig::instance()->getMapShowGlideFootprint() == false )
+    {
+      return;
+    }
+
+  const QPolygon& footprint = calculator->getGlideFootprint().getPolygon();
+
+  if( footprint.size() < 3 )
+    {
+      return;
+    }
+
+  QPolygon pp = _globalMapMatrix->map( footprint );
+
+  QRect rect( QPoint(0, 0), size() );
+
+  if( ! pp.boundingRect().intersects( rect ) )
+    {
+      return;
+    }
+
+  QPainter p;
+  p.begin( &m_pixInformationMap );
+  QPen pen( QColor(0, 128, 0), 3 * Layout::getIntScaledDensity(), Qt::DashLine );
+  p.setPen( pen );
+  p.setBrush( Qt::NoBrush );
+  p.setRenderHints( QPainter::Antialiasing );
+  p.drawPolygon( pp );
+  p.end();
+}
+
+void Map::p_drawContest()
+{
+  if( GeneralConfig::instance()->getMapShowContest() == false )
+    {
+      return;
+    }
+
+  const OlcOptimizer& olc = calculator->getOlcOptimizer();
+
+  // A closed FAI triangle is preferred to the free distance.
+  const OlcOptimizer::Solution& route = olc.faiTriangle().distance > 0.0 ?
+                                        olc.faiTriangle() : olc.freeDistance();
+
+  const bool triangle = olc.faiTriangle().distance > 0.0;
+
+  if( route.points.size() < 2 && olc.hasClosingPoint() == false )
+    {
+      return;
+    }
+
+  const int isd = Layout::getIntScaledDensity();
+
+  QPainter p;
+  p.begin( &m_pixInformationMap );
+  p.setRenderHints( QPainter::Antialiasing );
+  p.setBrush( Qt::NoBrush );
+
+  if( route.points.size() >= 2 )
+    {
+      QPolygon pp( route.points.size() );
+
+      for( int i = 0; i < route.points.size(); i++ )
+        {
+          pp.setPoint( i, _globalMapMatrix->map( _globalMapMatrix->wgsToMap( route.points.at(i) ) ) );
+        }
+
+      p.setPen( QPen( QColor(160, 0, 160), 3 * isd ) );
+
+      if( triangle )
+        {
+          p.drawPolygon( pp );
+        }
+      else
+        {
+          p.drawPolyline( pp );
+        }
+    }
+
+  QString text = (triangle ? tr("FAI") : tr("Free")) + " " +
+                 Distance::getText( route.distance, true, 1 );
+
+  QPoint textPos = _globalMapMatrix->map( _globalMapMatrix->wgsToMap( calculator->getlastPosition() ) );
+
+  if( olc.hasClosingPoint() )
+    {
+      // The way back to the closing point of the open FAI triangle.
+      const QPoint cp = _globalMapMatrix->map( _globalMapMatrix->wgsToMap( olc.closingPoint() ) );
+
+      p.setPen( QPen( QColor(160, 0, 160), 2 * isd, Qt::DashLine ) );
+      p.drawLine( textPos, cp );
+      p.drawEllipse( cp, 6 * isd, 6 * isd );
+
+      text = tr("FAI") + " " +
+             Distance::getText( olc.openTriangle().distance, true, 1 ) + ", " +
+             tr("close") + " " +
+             Distance::getText( olc.closingDistance(), true, 1 );
+
+      textPos = cp;
+    }
+
+  QFont font = this->font();
+  font.setPointSize( MapFlarmLabelFontPointSize );
+  p.setFont( font );
+
+  QRect textRect = p.fontMetrics().boundingRect( text );
+  textRect.moveTo( textPos.x() + 8 * isd, textPos.y() + 8 * isd );
+
+  p.setPen( QPen( Qt::NoPen ) );
+  p.setBrush( Qt::white );
+  p.drawRect( textRect );
+
+  p.setPen( QPen( Qt::black ) );
+  p.drawText( textRect, Qt::AlignCenter, text );
+  p.end();
+}
+
+void Map::p_drawThermals( QPainter* painter )
+{
+  if( GeneralConfig::instance()->getMapShowThermals() == false )
+    {
+      return;
+    }
+
+  // Thermals with sink are not of interest.
+  const QVector<ThermalStore::Hotspot> hotspots =
+    calculator->getThermalStore().hotspots( _globalMapMatrix->getViewBorder(), 0.0 );
+
+  const int isd = Layout::getIntScaledDensity();
+
+  painter->save();
+  painter->setRenderHints( QPainter::Antialiasing );
+  painter->setPen( Qt::NoPen );
+
+  for( int i = 0; i < hotspots.size(); i++ )
+    {
+      const ThermalStore::Hotspot& hs = hotspots.at(i);
+
+      // The color changes from yellow to red up to a climb of 3 m/s, the
+      // size grows with the number of thermals.
+      const int green = 255 - qBound( 0, int( hs.climb * 85.0 ), 255 );
+      const int radius = (4 + qMin( 8, int( hs.weight ) )) * isd;
+
+      painter->setBrush( QColor( 255, green, 0, 160 ) );
+      painter->drawEllipse( _globalMapMatrix->map( _globalMapMatrix->wgsToMap( hs.position ) ),
+                            radius, radius );
+    }
 
-  // qDebug("Trail, drawTime=%d ms", t.elapsed());
+  painter->restore();
+}
+
+void Map::p_drawNearestThermal()
+{
+  ThermalStore::Hotspot hs;
+
+  if( calculator->getNearestThermal( hs ) == false )
+    {
+      return;
+    }
+
+  const int isd = Layout::getIntScaledDensity();
+
+  const QPoint pos = _globalMapMatrix->map( _globalMapMatrix->wgsToMap( calculator->getlastPosition() ) );
+  const QPoint tp = _globalMapMatrix->map( _globalMapMatrix->wgsToMap( hs.position ) );
+
+  QPainter p;
+  p.begin( &m_pixInformationMap );
+  p.setRenderHints( QPainter::Antialiasing );
+  p.setPen( QPen( QColor(255, 128, 0), 2 * isd, Qt::DashLine ) );
+  p.setBrush( Qt::NoBrush );
+  p.drawLine( pos, tp );
+  p.drawEllipse( tp, 10 * isd, 10 * isd );
+
+  QPoint p1( calculator->getlastPosition() );
+  QPoint p2( hs.position );
+
+  const QString text = Speed( hs.climb ).getVerticalText() + ", " +
+                       Distance::getText( MapCalc::dist( &p1, &p2 ) * 1000.0, true, 1 );
+
+  QFont font = this->font();
+  font.setPointSize( MapFlarmLabelFontPointSize );
+  p.setFont( font );
+
+  QRect textRect = p.fontMetrics().boundingRect( text );
+  textRect.moveTo( tp.x() + 12 * isd, tp.y() - textRect.height() / 2 );
+
+  p.setPen( QPen( Qt::NoPen ) );
+  p.setBrush( Qt::white );
+  p.drawRect( textRect );
+
+  p.setPen( QPen( Qt::black ) );
+  p.drawText( textRect, Qt::AlignCenter, text );
+  p.end();
+}
+
+void Map::p_drawThermalCenter()
+{
+  if( GeneralConfig::instance()->getMapShowThermalCentering() == false )
+    {
+      return;
+    }
+
+  const ThermalCentering& tc = calculator->getThermalCentering();
+
+  if( tc.isValid() == false )
+    {
+      return;
+    }
+
+  const int isd = Layout::getIntScaledDensity();
+
+  const QPoint pos = _globalMapMatrix->map( _globalMapMatrix->wgsToMap( calculator->getlastPosition() ) );
+  const QPoint core = _globalMapMatrix->map( _globalMapMatrix->wgsToMap( tc.getCenter() ) );
+
+  // The core is drawn with a radius of 50m but visible at all scales.
+  const double scale = _globalMapMatrix->getScale( MapMatrix::CurrentScale );
+  const int radius = qMax( 6 * isd, int( 50.0 / scale ) );
+
+  QPainter p;
+  p.begin( &m_pixInformationMap );
+  p.setRenderHints( QPainter::Antialiasing );
+  p.setPen( QPen( QColor(255, 0, 0), 2 * isd ) );
+  p.setBrush( QColor(255, 0, 0, 64) );
+  p.drawEllipse( core, radius, radius );
+  p.setPen( QPen( QColor(255, 0, 0), 2 * isd, Qt::DashLine ) );
+  p.drawLine( pos, core );
+
+  const QString text = Speed( tc.getCoreClimb() ).getVerticalText() + ", " +
+                       Distance::getText( tc.getOffsetDistance(), true, 0 ) + " " +
+                       QString::number( tc.getOffsetBearing() ) + QChar(Qt::Key_degree);
+
+  QFont font = this->font();
+  font.setPointSize( MapFlarmLabelFontPointSize );
+  p.setFont( font );
+
+  QRect textRect = p.fontMetrics().boundingRect( text );
+  textRect.moveTo( core.x() + radius + 4 * isd, core.y() - textRect.height() / 2 );
+
+  p.setPen( QPen( Qt::NoPen ) );
+  p.setBrush( Qt::white );
+  p.drawRect( textRect );
+
+  p.setPen( QPen( Qt::black ) );
+  p.drawText( textRect, Qt::AlignCenter, text );
+  p.end();
 }
 
 void Map::p_calculateTrailPoints()
@@ -1145,21 +1421,20 @@ void Map::p_calculateTrailPoints()
       return;
     }
 
-  QDateTime minTime = calculator->getLastSampleTime().addSecs(- TrailListLength );
+  // The trail history of the calculator contains the samples already
+  // decimated to the configured trail rate.
+  const FlightSampleList& trail = calculator->trailList;
 
-  int loop = 0;
-  int sampleCnt = calculator->samplelist.count();
+  // Only the samples of the trail time span in seconds are considered.
+  int sampleCnt = trail.countLastSeconds( TrailListLength );
 
-  while( loop < sampleCnt &&
-          loop < TrailListLength &&
-          calculator->samplelist.at(loop).time >= minTime )
+  for( int loop = 0; loop < sampleCnt; loop++ )
     {
       // Map WGS84 position to map projection
-      const QPoint& pos = _globalMapMatrix->map(_globalMapMatrix->wgsToMap(calculator->samplelist.at(loop).position));
+      const QPoint pos = _globalMapMatrix->map(_globalMapMatrix->wgsToMap(trail.at(loop).getPosition()));
 
       // newest positions at first, oldest at last
       m_trailPoints.append( pos );
-      loop++;
     }
 }
 
@@ -1222,6 +1497,8 @@ void Map::p_redrawMap(mapLayer fromLayer, bool queueRequest)
   // set mutex to block recursive entries and unwanted data modifications.
   setMutex(true);
 
+  PerfTrace::Scope scope( "Map redraw" );
+
   // Check, if a resize event is queued. In this case it must be
   // considered to create the right matrix size.
   if( m_isResizeEvent )
@@ -1278,9 +1555,13 @@ void Map::p_redrawMap(mapLayer fromLayer, bool queueRequest)
       p_drawNavigationLayer();
     }
 
+  // The position is displayed by the information layer.
+  const qint64 fixIngestTime = (fromLayer < topLayer) ? m_fixIngestTime : 0;
+
   if (fromLayer < topLayer)
     {
       p_drawInformationLayer();
+      m_fixIngestTime = 0;
     }
 
   // copy the new map content into the paint buffer
@@ -1310,6 +1591,9 @@ void Map::p_redrawMap(mapLayer fromLayer, bool queueRequest)
   else
     {
       repaint( m_pixPaintBuffer.rect() );
+
+      // The latency is recorded, when the new position is presented.
+      FixLatency::record( fixIngestTime );
     }
 
   // @AP: check, if a pending redraw request is active. In this case
@@ -1345,6 +1629,8 @@ void Map::p_drawBaseLayer()
       return;
     }
 
+  PerfTrace::Scope scope( "Base layer" );
+
   m_drawnCityList.clear();
   QList<BaseMapElement *> drawnElements;
 
@@ -1410,6 +1696,8 @@ void Map::p_drawBaseLayer()
  */
 void Map::p_drawAeroLayer(bool reset)
 {
+  PerfTrace::Scope scope( "Aero layer" );
+
   // first, copy the base map to the aero map
   m_pixAeroMap = m_pixBaseMap;
 
@@ -1425,6 +1713,8 @@ void Map::p_drawAeroLayer(bool reset)
  */
 void Map::p_drawNavigationLayer()
 {
+  PerfTrace::Scope scope( "Navigation layer" );
+
   m_pixNavigationMap = m_pixAeroMap;
 
   double cs = _globalMapMatrix->getScale(MapMatrix::CurrentScale);
@@ -1455,6 +1745,7 @@ void Map::p_drawNavigationLayer()
   if( _globalMapMatrix->isSwitchScale() )
     {
       _globalMapContents->drawList(&navP, MapContents::HotspotList, drawnSp );
+      p_drawThermals( &navP );
     }
 
   p_drawWaypoints(&navP, drawnWp);
@@ -1462,7 +1753,7 @@ void Map::p_drawNavigationLayer()
 
   // Now the labels of the drawn objects will be drawn, if activated via options.
   // Put all drawn labels into a set to avoid multiple drawing of them.
-  QSet<QString> labelSet;
+  QSet<quint64> labelSet;
 
   // determine icon size
   const bool useSmallIcons = _globalMapConfig->useSmallIcons();
@@ -1479,9 +1770,9 @@ void Map::p_drawNavigationLayer()
   // 1. draw all navaids, ... collected labels
   for( int i = 0; i < drawnRp.size(); i++ )
     {
-      QString corrString = WGSPoint::coordinateString( drawnRp[i]->getWGSPosition() );
+      quint64 corrKey = WGSPoint::coordinateKey( drawnRp[i]->getWGSPosition() );
 
-      if( labelSet.contains( corrString ) )
+      if( labelSet.contains( corrKey ) )
         {
           // A label with the same coordinates was already drawn.
           // We do ignore the repeated drawing.
@@ -1489,7 +1780,7 @@ void Map::p_drawNavigationLayer()
         }
 
       // store label to be drawn
-      labelSet.insert( corrString );
+      labelSet.insert( corrKey );
 
       p_drawLabel( &navP,
                    iconSize / 2 + 3,
@@ -1502,9 +1793,9 @@ void Map::p_drawNavigationLayer()
   // 2. draw all airfield, ... collected labels
   for( int i = 0; i < drawnAf.size(); i++ )
     {
-      QString corrString = WGSPoint::coordinateString( drawnAf[i]->getWGSPosition() );
+      quint64 corrKey = WGSPoint::coordinateKey( drawnAf[i]->getWGSPosition() );
 
-      if( labelSet.contains( corrString ) )
+      if( labelSet.contains( corrKey ) )
         {
           // A label with the same coordinates was already drawn.
           // We do ignore the repeated drawing.
@@ -1512,7 +1803,7 @@ void Map::p_drawNavigationLayer()
         }
 
       // store label to be drawn
-      labelSet.insert( corrString );
+      labelSet.insert( corrKey );
 
       p_drawLabel( &navP,
                    iconSize / 2 + 3,
@@ -1525,9 +1816,9 @@ void Map::p_drawNavigationLayer()
   // 3. draw all collected waypoint point labels
   for( int i = 0; i < drawnWp.size(); i++ )
     {
-      QString corrString = WGSPoint::coordinateString( drawnWp[i]->wgsPoint );
+      quint64 corrKey = WGSPoint::coordinateKey( drawnWp[i]->wgsPoint );
 
-      if( labelSet.contains( corrString ) )
+      if( labelSet.contains( corrKey ) )
         {
           // A label with the same coordinates was already drawn
           // We do ignore the repeated drawing.
@@ -1535,7 +1826,7 @@ void Map::p_drawNavigationLayer()
         }
 
       // store label to be drawn
-      labelSet.insert( corrString );
+      labelSet.insert( corrKey );
 
       bool isLandable = false;
 
@@ -1555,9 +1846,9 @@ void Map::p_drawNavigationLayer()
   // Second draw all collected task point labels
   for( int i = 0; i < drawnTp.size(); i++ )
     {
-      QString corrString = WGSPoint::coordinateString( drawnTp[i]->getWGSPosition() );
+      quint64 corrKey = WGSPoint::coordinateKey( drawnTp[i]->getWGSPosition() );
 
-      if( labelSet.contains( corrString ) )
+      if( labelSet.contains( corrKey ) )
         {
           // A label with the same coordinates was already drawn
           // We do ignore the repeated drawing.
@@ -1565,7 +1856,7 @@ void Map::p_drawNavigationLayer()
         }
 
       // store label to be drawn
-      labelSet.insert( corrString );
+      labelSet.insert( corrKey );
 
       p_drawLabel( &navP,
                    iconSize / 2 + 3,
@@ -1589,12 +1880,18 @@ void Map::p_drawNavigationLayer()
  */
 void Map::p_drawInformationLayer()
 {
+  PerfTrace::Scope scope( "Information layer" );
+
   m_pixInformationMap = m_pixNavigationMap;
 
   // Draw a glider symbol on the map if GPS has a fix and no manual mode
   // is selected by the user.
   if( m_ShowGlider && calculator->isManualInFlight() == false)
     {
+      p_drawGlideFootprint();
+      p_drawContest();
+      p_drawNearestThermal();
+      p_drawThermalCenter();
       p_drawGlider();
       p_drawTrail();
 
@@ -2272,6 +2569,8 @@ void Map::slotPosition(const QPoint& newPos, const int source)
         {
           m_curGPSPos = newPos;
 
+          m_fixIngestTime = calculator->getPositionIngestTime();
+
           if( !calculator->isManualInFlight() )
             {
               // let cross be at the GPS position so that if we switch to manual mode
@@ -2391,17 +2690,17 @@ void Map::p_drawOtherAircraft()
   // Load selected Flarm object. It is empty in case of no selection.
   QString& selectedObject = FlarmDisplay::getSelectedObject();
 
-  bool selectedObjectFound = false;
+  const Flarm::FlarmAcft* selectedAcft = static_cast<const Flarm::FlarmAcft *> (0);
 
-  if( ! selectedObject.isEmpty() && Flarm::getPflaaHash().contains(selectedObject) )
+  if( ! selectedObject.isEmpty() )
     {
-      selectedObjectFound = true;
+      selectedAcft = Flarm::getTraffic().find( selectedObject );
     }
 
   // Check, if Flarm most relevant object is identical to selected object
-  if( selectedObjectFound )
+  if( selectedAcft )
     {
-      const Flarm::FlarmAcft& flarmAcft = Flarm::getPflaaHash().value( selectedObject );
+      const Flarm::FlarmAcft& flarmAcft = *selectedAcft;
 
       if( status.ID == flarmAcft.ID )
         {
@@ -2420,6 +2719,27 @@ void Map::p_drawOtherAircraft()
       // Draw most relevant object.
       p_drawMostRelevantObject( status );
     }
+
+  // Draw the predicted converging objects, which are not yet drawn. They
+  // are at the begin of the threat ordered traffic list.
+  const QVector<Flarm::FlarmAcft>& traffic = Flarm::getTraffic().getThreatList();
+
+  for( int i = 0; i < traffic.size() && i < 3; i++ )
+    {
+      const Flarm::FlarmAcft& acft = traffic.at(i);
+
+      if( ! acft.Converging )
+        {
+          break;
+        }
+
+      if( acft.ID == status.ID || acft.ID == selectedObject )
+        {
+          continue;
+        }
+
+      p_drawSelectedFlarmObject( acft, false );
+    }
 }
 
 /**
@@ -2541,7 +2861,8 @@ void Map::p_drawMostRelevantObject( const Flarm::FlarmStatus& status )
 /**
  * Draws the user selected Flarm object.
  */
-void Map::p_drawSelectedFlarmObject( const Flarm::FlarmAcft& flarmAcft )
+void Map::p_drawSelectedFlarmObject( const Flarm::FlarmAcft& flarmAcft,
+                                     const bool selected )
 {
   QPoint other;
   double distance = 0.0;
@@ -2597,7 +2918,8 @@ void Map::p_drawSelectedFlarmObject( const Flarm::FlarmAcft& flarmAcft )
     {
       // Stealth mode is active, no additional information are available.
       // We draw only a circle.
-      painter.drawPixmap(  Rx-diameter/2, Ry-diameter/2, magentaCircle );
+      painter.drawPixmap(  Rx-diameter/2, Ry-diameter/2,
+                           selected ? magentaCircle : blueCircle );
       usedObjectSize = diameter;
     }
   else
@@ -2605,7 +2927,7 @@ void Map::p_drawSelectedFlarmObject( const Flarm::FlarmAcft& flarmAcft )
       // Additional Information are available. We draw a triangle.
       QPixmap object;
 
-      QPen pen(Qt::magenta);
+      QPen pen( selected ? Qt::magenta : Qt::blue );
       pen.setWidth( 3 * Layout::getIntScaledDensity() );
       QColor liftColor = FlarmDisplay::getLiftColor( flarmAcft.ClimbRate );
 
@@ -2688,7 +3010,12 @@ void Map::p_drawGlider()
       // Add the mapped point at the beginning of the tail point list.
       m_trailPoints.prepend( mapPos );
 
-      if( m_trailPoints.length() > TrailListLength )
+      // The trail covers a time span, the number of points depends on the
+      // trail rate.
+      const int maxPoints = qMax( TrailListLength,
+                                  calculator->trailList.countLastSeconds( TrailListLength ) );
+
+      while( m_trailPoints.length() > maxPoints )
         {
           m_trailPoints.removeLast();
         }
@@ -3076,6 +3403,8 @@ void Map::p_drawRelBearingInfo()
  */
 void Map::checkAirspace(const QPoint& pos)
 {
+  PerfTrace::Scope scope( "Airspace check" );
+
   if ( mutex() )
     {
       return;
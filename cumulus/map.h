@@ -431,6 +431,32 @@ private:
    */
   void p_drawTrail();
 
+  /**
+   * Draws the outline of the area, which can be reached in glide.
+   */
+  void p_drawGlideFootprint();
+
+  /**
+   * Draws the best contest route of the flight and the closing point of
+   * the best open FAI triangle.
+   */
+  void p_drawContest();
+
+  /**
+   * Draws the learned thermals in the map view.
+   */
+  void p_drawThermals( QPainter* painter );
+
+  /**
+   * Draws the way to the nearest good learned thermal.
+   */
+  void p_drawNearestThermal();
+
+  /**
+   * Draws the estimated thermal core during circling.
+   */
+  void p_drawThermalCenter();
+
   /**
    * Calculates the trails points to be used for trail drawing. This method must
    * be always called after a projection change.
@@ -545,9 +571,11 @@ private:
   void p_drawMostRelevantObject( const Flarm::FlarmStatus& status );
 
   /**
-   * Draws the user selected Flarm object.
+   * Draws the user selected Flarm object. A not selected object is drawn
+   * in blue, that is used for converging objects.
    */
-  void p_drawSelectedFlarmObject( const Flarm::FlarmAcft& flarmAcft );
+  void p_drawSelectedFlarmObject( const Flarm::FlarmAcft& flarmAcft,
+                                  const bool selected=true );
 
   /** Pixmaps used by Flarm for object drawing */
   QPixmap blackCircle;
@@ -711,7 +739,7 @@ protected:
   /** trail point painter path. */
   QPainterPath m_tpp;
 
-  /** maximum length of trail list */
+  /** time span in seconds of the trail */
   const int TrailListLength;
 
   /** Timer which activates the airspace status display. */
@@ -720,6 +748,9 @@ protected:
   /** Flag to ignore mouse release event. */
   bool m_ignoreMouseRelease;
 
+  /** Reception time of the sentence, which has delivered the last position. */
+  qint64 m_fixIngestTime;
+
 public:
 
   static Map *instance;
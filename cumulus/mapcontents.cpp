@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 
 #include <QtGui>
@@ -39,6 +40,8 @@
 #include "mapcontents.h"
 #include "mapmatrix.h"
 #include "mapview.h"
+#include "navbenchmark.h"
+#include "perftrace.h"
 #include "projectionbase.h"
 #include "resource.h"
 #include "taskfilemanager.h"
@@ -110,6 +113,14 @@ MapContents::MapContents(QObject* parent, WaitScreen* waitscreen) :
   _lastIsoLevel=-1;
   _isoLevelReset=true;
   _lastIsoEntry=0;
+  _isoMapVersion=0;
+  m_pointIndexDirty=true;
+  m_pointIndexVersion=0;
+
+  for( int i = 0; i < PointIndexLists; i++ )
+    {
+      m_pointIndexSizes[i] = -1;
+    }
 
   // read in waypoint list from catalog
   WaypointCatalog wpCat;
@@ -136,10 +147,14 @@ MapContents::MapContents(QObject* parent, WaitScreen* waitscreen) :
 
   currentTask = 0;
 
-  connect( this, SIGNAL(progress(int)), ws, SLOT(slot_Progress(int)) );
+  // The flight replay runs without wait screen.
+  if( ws )
+    {
+      connect( this, SIGNAL(progress(int)), ws, SLOT(slot_Progress(int)) );
 
-  connect( this, SIGNAL(loadingFile(const QString&)),
-           ws, SLOT(slot_SetText2(const QString&)) );
+      connect( this, SIGNAL(loadingFile(const QString&)),
+               ws, SLOT(slot_SetText2(const QString&)) );
+    }
 
   // qDebug("MapContents initialized");
 }
@@ -168,6 +183,66 @@ void MapContents::saveWaypointList()
     {
       wpCat.writeXml( "", wpList );
     }
+
+  invalidatePointIndex();
+}
+
+/**
+ * Returns the spatial index over the point lists. It is rebuilt on demand.
+ */
+const PointIndex& MapContents::getPointIndex()
+{
+  const int sizes[PointIndexLists] = { airfieldList.size(),
+                                       gliderfieldList.size(),
+                                       outLandingList.size(),
+                                       radioList.size(),
+                                       hotspotList.size(),
+                                       wpList.size() };
+
+  if( m_pointIndexDirty == false &&
+      memcmp( sizes, m_pointIndexSizes, sizeof(sizes) ) == 0 )
+    {
+      return m_pointIndex;
+    }
+
+  m_pointIndex.clear();
+
+  for( int i = 0; i < airfieldList.size(); i++ )
+    {
+      m_pointIndex.insert( AirfieldList, i, airfieldList.at(i).getWGSPosition() );
+    }
+
+  for( int i = 0; i < gliderfieldList.size(); i++ )
+    {
+      m_pointIndex.insert( GliderfieldList, i, gliderfieldList.at(i).getWGSPosition() );
+    }
+
+  for( int i = 0; i < outLandingList.size(); i++ )
+    {
+      m_pointIndex.insert( OutLandingList, i, outLandingList.at(i).getWGSPosition() );
+    }
+
+  for( int i = 0; i < radioList.size(); i++ )
+    {
+      m_pointIndex.insert( RadioList, i, radioList.at(i).getWGSPosition() );
+    }
+
+  for( int i = 0; i < hotspotList.size(); i++ )
+    {
+      m_pointIndex.insert( HotspotList, i, hotspotList.at(i).getWGSPosition() );
+    }
+
+  for( int i = 0; i < wpList.size(); i++ )
+    {
+      m_pointIndex.insert( WaypointList, i, wpList.at(i).wgsPoint );
+    }
+
+  m_pointIndex.finish();
+  memcpy( m_pointIndexSizes, sizes, sizeof(sizes) );
+  m_pointIndexDirty = false;
+  m_pointIndexVersion++;
+
+  return m_pointIndex;
 }
 
 /**
@@ -186,6 +261,8 @@ void MapContents::saveWaypointList()
  */
 bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
 {
+  NavBenchmark::Timer timer( NavBenchmark::TileLoad );
+
   bool kflExists, kfcExists;
   bool compiling = false;
 
@@ -678,6 +755,7 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
 
   // qDebug("loop=%d", loop);
   mapfile.close();
+  _isoMapVersion++;
 
   if ( compiling )
     {
@@ -689,6 +767,8 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
 
 bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
 {
+  NavBenchmark::Timer timer( NavBenchmark::TileLoad );
+
   bool kflExists, kfcExists;
   bool compiling = false;
 
@@ -2009,6 +2089,8 @@ void MapContents::proofeSection()
               m_hotspotLoadMutex.lock();
               poiLoader.load( hotspotList );
               m_hotspotLoadMutex.unlock();
+
+              invalidatePointIndex();
             }
           else
             {
@@ -2145,6 +2227,7 @@ void MapContents::unloadMaps(unsigned int distance)
 
   unloadMapObjects( groundMap );
   unloadMapObjects( terrainMap );
+  _isoMapVersion++;
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
@@ -2360,6 +2443,8 @@ void MapContents::clearList(const int listIndex)
       qWarning( "MapContents::clearList(): unknown list type %d!", listIndex );
       break;
     }
+
+  invalidatePointIndex();
 }
 
 
@@ -2542,9 +2627,12 @@ void MapContents::slotReloadMapData()
   hotspotList = QList<SinglePoint>();
   m_hotspotLoadMutex.unlock();
 
+  invalidatePointIndex();
+
   // all isolines are cleared
   groundMap.clear();
   terrainMap.clear();
+  _isoMapVersion++;
 
   // tile maps are cleared
   tileSectionSet.clear();
@@ -2667,6 +2755,8 @@ void MapContents::slotOpenAipAirfieldLoadFinished( int noOfLists,
   gliderfieldList = QList<Airfield>();
   outLandingList  = QList<Airfield>();
 
+  invalidatePointIndex();
+
   emit mapDataReloaded( Map::airfields );
 
   // This signal will update all list views of the main window.
@@ -2723,6 +2813,8 @@ void MapContents::slotOpenAipNavAidLoadFinished( int noOfLists,
   radioList = *radioListIn;
   delete radioListIn;
 
+  invalidatePointIndex();
+
   emit mapDataReloaded( Map::navaids );
 
   // This signal will update all list views of the main window.
@@ -2779,6 +2871,8 @@ void MapContents::slotOpenAipHotspotLoadFinished( int noOfLists,
   hotspotList = *hotspotListIn;
   delete hotspotListIn;
 
+  invalidatePointIndex();
+
   emit mapDataReloaded( Map::hotspots );
 
   // This signal will update all list views of the main window.
@@ -3262,8 +3356,7 @@ void MapContents::drawIsoList(QPainter* targetP)
 {
   // qDebug("MapContents::drawIsoList():");
 
-  QTime t;
-  t.start();
+  PerfTrace::Scope scope( "Isolines" );
 
   extern MapMatrix* _globalMapMatrix;
   _lastIsoEntry = 0;
@@ -3388,8 +3481,6 @@ void MapContents::drawIsoList(QPainter* targetP)
   pathIsoLines.sort();
   _isoLevelReset = false;
 
-  qDebug( "IsoList, drawTime=%dms", t.elapsed() );
-
 #if 0
   QString isos;
 
@@ -3549,6 +3640,33 @@ bool MapContents::restoreFlightTask()
   return true;
 }
 
+void MapContents::loadPointsAndAirspaces()
+{
+  {
+    QMutexLocker locker( &m_airfieldLoadMutex );
+
+    OpenAipPoiLoader oaipl;
+    airfieldList = QList<Airfield>();
+    oaipl.load( airfieldList );
+
+    gliderfieldList = QList<Airfield>();
+    outLandingList  = QList<Airfield>();
+
+    invalidatePointIndex();
+  }
+
+  QMutexLocker locker( &m_airspaceLoadMutex );
+
+  qDeleteAll(airspaceList);
+  airspaceList.clear();
+
+  AirspaceHelper::loadAirspaces( airspaceList );
+  airspaceList.sort();
+
+  // The first map loading has not to read the points and airspaces again.
+  isFirst = false;
+}
+
 /** Returns true if the coordinates of the waypoint in the argument
  * matches one of the waypoints in the list. */
 bool MapContents::isInWaypointList(const QPoint& wgsCoord)
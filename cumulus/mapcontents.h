@@ -50,6 +50,7 @@
 #include "flighttask.h"
 #include "isolist.h"
 #include "map.h"
+#include "pointindex.h"
 #include "radiopoint.h"
 #include "singlepoint.h"
 #include "waitscreen.h"
@@ -277,6 +278,32 @@ class MapContents : public QObject
      */
     void saveWaypointList();
 
+    /**
+     * Returns the spatial index over the airfield, gliderfield, outlanding,
+     * radio point, hotspot and waypoint lists. The index is rebuilt, if it
+     * has been invalidated or if the size of an indexed list has been changed.
+     * The list identifier of an index entry is one of the ListID values.
+     */
+    const PointIndex& getPointIndex();
+
+    /**
+     * Marks the spatial point index as outdated. Must be called after a
+     * change of an indexed list.
+     */
+    void invalidatePointIndex()
+    {
+      m_pointIndexDirty = true;
+    };
+
+    /**
+     * Returns a counter, which is incremented on every rebuild of the point
+     * index. List indices taken from an older index may be outdated.
+     */
+    uint getPointIndexVersion() const
+    {
+      return m_pointIndexVersion;
+    };
+
     /**
      * Sets the current flight task.
      */
@@ -299,6 +326,13 @@ class MapContents : public QObject
      */
     bool restoreFlightTask();
 
+    /**
+     * Loads the OpenAIP airfields and the airspaces in the calling thread
+     * without any user notification. Used by the flight replay, which runs
+     * without map view.
+     */
+    void loadPointsAndAirspaces();
+
     /**
      * @return true if the coordinates of the waypoint in the argument
      * matches one of the waypoints in the list.
@@ -344,6 +378,33 @@ class MapContents : public QObject
       return &pathIsoLines;
     };
 
+    /** Returns the loaded ground isohypses, keyed by the tile section. */
+    const QMap<int, QList<Isohypse> >& getGroundMap() const
+    {
+      return groundMap;
+    };
+
+    /** Returns the loaded terrain isohypses, keyed by the tile section. */
+    const QMap<int, QList<Isohypse> >& getTerrainMap() const
+    {
+      return terrainMap;
+    };
+
+    /**
+     * Returns a counter, which is incremented on every change of the loaded
+     * isohypses. Can be used to detect outdated derived elevation data.
+     */
+    uint getIsoMapVersion() const
+    {
+      return _isoMapVersion;
+    };
+
+    /** Returns the elevation in meters of the passed elevation index. */
+    static short getIsoLevel( const uchar index )
+    {
+      return isoLevels[qMin( int(index), ISO_LINE_LEVELS - 1 )];
+    };
+
     /** Returns the elevation index for an elevation step in meters
      */
     uchar getElevationIndex(const ushort elevation ) const;
@@ -749,6 +810,24 @@ class MapContents : public QObject
     bool _isoLevelReset;
     const IsoListEntry* _lastIsoEntry;
 
+    /** Change counter of the loaded isohypses. */
+    uint _isoMapVersion;
+
+    /** Spatial index over the point lists. */
+    PointIndex m_pointIndex;
+
+    /** Flag to signal, that the point index must be rebuilt. */
+    bool m_pointIndexDirty;
+
+    /** Rebuild counter of the point index. */
+    uint m_pointIndexVersion;
+
+    /** Number of the lists covered by the point index. */
+    enum { PointIndexLists = 6 };
+
+    /** Sizes of the indexed lists at the last index build. */
+    int m_pointIndexSizes[PointIndexLists];
+
     /**
      * Array containing the used elevation levels in meters. Is used as help
      * for reverse mapping elevation to array index.
@@ -41,6 +41,7 @@
 #include "mapinfobox.h"
 #include "mapmatrix.h"
 #include "mapview.h"
+#include "perftrace.h"
 #include "preflightwindpage.h"
 #include "speed.h"
 #include "time_cu.h"
@@ -436,6 +437,18 @@ MapView::MapView(QWidget *parent) : QWidget(parent)
 
   _theMap->setMode(Map::headUp);
 
+  // The performance overlay is placed at the upper left corner of the map.
+  m_perfOverlay = new CuLabel( _theMap );
+  m_perfOverlay->setFont( fontSB );
+  m_perfOverlay->setMargin( 3 );
+  m_perfOverlay->setAutoFillBackground( true );
+  m_perfOverlay->move( 5, 5 );
+  m_perfOverlay->setVisible( false );
+  connect( m_perfOverlay, SIGNAL(mousePress()), this, SLOT(slot_exportTrace()) );
+
+  m_perfTimer = new QTimer( this );
+  connect( m_perfTimer, SIGNAL(timeout()), this, SLOT(slot_updatePerfOverlay()) );
+
 #ifdef FLARM
 
   // Flarm widget with radar view
@@ -950,6 +963,12 @@ void MapView::slot_GlidePath (const Altitude& above)
 /** This slot is called when the best speed value has changed. */
 void MapView::slot_bestSpeed (const Speed& speed)
 {
+  if( calculator->getlastSpeedToFly().isValid() )
+    {
+      // The speed to fly of the air mass is displayed.
+      return;
+    }
+
   if( speed.isValid() )
     {
       _speed2fly->setValue(speed.getHorizontalText(false, 0));
@@ -965,6 +984,21 @@ void MapView::slot_bestSpeed (const Speed& speed)
     }
 }
 
+/** This slot is called if a new speed to fly has been calculated */
+void MapView::slot_speedToFly (const Speed& stf)
+{
+  if( stf.isValid() == false )
+    {
+      // Fall back to the best speed of the final glide.
+      slot_bestSpeed( calculator->getlastBestSpeed() );
+      return;
+    }
+
+  _speed2fly->setValue(stf.getHorizontalText(false, 0));
+  _speed2fly->setVisible( true );
+  _menuToggle->setVisible( false );
+}
+
 /** This slot is called if a new McCready value has been set */
 void MapView::slot_Mc (const Speed& mc)
 {
@@ -1110,6 +1144,29 @@ void MapView::slot_infoTimer()
   slot_info( "" );
 }
 
+void MapView::slot_updatePerfOverlay()
+{
+  // Summary of the last 5 seconds.
+  m_perfOverlay->setText( PerfTrace::summary( 5000 ) );
+  m_perfOverlay->adjustSize();
+  m_perfOverlay->raise();
+}
+
+void MapView::slot_exportTrace()
+{
+  QString fileName = GeneralConfig::instance()->getUserDataDirectory() +
+                     "/cumulus-trace.json";
+
+  if( PerfTrace::exportChromeTrace( fileName ) )
+    {
+      slot_info( tr("Trace saved") );
+    }
+  else
+    {
+      slot_info( tr("Trace not saved") );
+    }
+}
+
 /** This slot is called if the settings have been changed.
  * It refreshes all displayed data because units might have been changed.
  */
@@ -1121,12 +1178,28 @@ void MapView::slot_settingsChange()
   slot_Speed(calculator->getLastSpeed());
   slot_Distance(calculator->getlastDistance());
   slot_GlidePath(calculator->getlastGlidePath());
-  slot_bestSpeed(calculator->getlastBestSpeed());
+  slot_speedToFly(calculator->getlastSpeedToFly());
   slot_Mc(calculator->getlastMc());
   slot_Waypoint(calculator->getTargetWp());
 
   _glidepath->setPreUnit( Altitude::getUnitText() );
   _distance->setPreUnit( Distance::getUnitText() );
+
+  // The performance trace is recorded only, if the overlay is shown.
+  bool perfOverlay = GeneralConfig::instance()->getPerformanceOverlay();
+
+  PerfTrace::setEnabled( perfOverlay );
+  m_perfOverlay->setVisible( perfOverlay );
+
+  if( perfOverlay )
+    {
+      slot_updatePerfOverlay();
+      m_perfTimer->start( 1000 );
+    }
+  else
+    {
+      m_perfTimer->stop();
+    }
 }
 
 
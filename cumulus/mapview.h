@@ -238,6 +238,13 @@ class MapView : public QWidget
      */
     void slot_bestSpeed (const Speed& above);
 
+    /**
+     * This slot is called when the speed to fly in the current air mass
+     * has changed. A valid speed to fly takes precedence over the best
+     * speed of the final glide.
+     */
+    void slot_speedToFly (const Speed& stf);
+
     /**
      * This slot is called if a new McCready value has been set
      */
@@ -357,6 +364,12 @@ class MapView : public QWidget
     /** Called to show the last status info again. */
     void slot_infoTimer();
 
+    /** Called to update the performance overlay with the trace summary. */
+    void slot_updatePerfOverlay();
+
+    /** Called to export the trace, if the performance overlay is pressed. */
+    void slot_exportTrace();
+
 #ifdef QSCROLLER1
     /** Process status changes during map drag and release. */
     void slot_scrollerStateChanged(QScroller::State new_s);
@@ -487,6 +500,10 @@ signals:
     int lastPositionChangeSource;
     /** Timer to display last status info. */
     QTimer* m_infoTimer;
+    /** Overlay on the map with the summary of the performance trace. */
+    CuLabel* m_perfOverlay;
+    /** Timer to update the performance overlay. */
+    QTimer* m_perfTimer;
     /** Last reported ETA value. */
     QTime m_lastEta;
 };
@@ -0,0 +1,231 @@
+/***********************************************************************
+**
+**   navbenchmark.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <QtCore>
+#include <QPainter>
+
+#include "fixlatency.h"
+#include "flightreplay.h"
+#include "generalconfig.h"
+#include "mapcontents.h"
+#include "mapmatrix.h"
+#include "navbenchmark.h"
+
+extern MapContents* _globalMapContents;
+extern MapMatrix*   _globalMapMatrix;
+
+// Size in pixels of the offscreen map image.
+#define RENDER_WIDTH  800
+#define RENDER_HEIGHT 480
+
+// Maximum number of base layer renderings along the flight.
+#define MAX_RENDERS 200
+
+bool NavBenchmark::s_running = false;
+
+LatencyHistogram NavBenchmark::s_histograms[NavBenchmark::StageCount];
+
+namespace
+{
+  /**
+   * The innermost running timer of a thread. Timers are nested per thread,
+   * because the tile loads can run outside of the GUI thread.
+   */
+  struct TimerRef
+  {
+    TimerRef() : timer(0) {};
+
+    NavBenchmark::Timer* timer;
+  };
+
+  QThreadStorage<TimerRef> currentTimer;
+
+  /** Protects the histograms against timers of other threads. */
+  QMutex histogramMutex;
+
+  /** Names of the stages, also used as trace event names. */
+  const char* stageNames[NavBenchmark::StageCount] =
+  {
+    "NMEA parse",
+    "Fix processing",
+    "Wind and vario",
+    "Reachable list",
+    "Contest",
+    "Airspace check",
+    "Tile load",
+    "Base layer render"
+  };
+}
+
+void NavBenchmark::Timer::start()
+{
+  if( m_benchmark )
+    {
+      TimerRef& current = currentTimer.localData();
+
+      m_childTime = 0;
+      m_parent = current.timer;
+      current.timer = this;
+    }
+
+  m_start = PerfTrace::now();
+}
+
+void NavBenchmark::Timer::stop()
+{
+  const qint64 elapsed = PerfTrace::now() - m_start;
+
+  if( m_trace )
+    {
+      PerfTrace::complete( stageNames[m_stage], m_start, elapsed );
+    }
+
+  if( m_benchmark )
+    {
+      {
+        QMutexLocker locker( &histogramMutex );
+        s_histograms[m_stage].add( elapsed - m_childTime );
+      }
+
+      if( m_parent )
+        {
+          m_parent->m_childTime += elapsed;
+        }
+
+      currentTimer.localData().timer = m_parent;
+    }
+}
+
+bool NavBenchmark::run( const QString& fileName )
+{
+  for( int i = 0; i < StageCount; i++ )
+    {
+      s_histograms[i].clear();
+    }
+
+  // All fix latencies of the flight are kept.
+  FixLatency::reset( 0 );
+
+  currentTimer.localData().timer = 0;
+  s_running = true;
+
+  FlightReplay *replay = new FlightReplay();
+
+  bool ok = replay->replay( fileName );
+
+  if( ok )
+    {
+      // The map center is stored in the configuration by the map matrix
+      // and must be restored after the rendering.
+      const QPoint mapCenter = _globalMapMatrix->getMapCenter();
+
+      QImage image( RENDER_WIDTH, RENDER_HEIGHT, QImage::Format_RGB32 );
+
+      const QVector<QPoint>& track = replay->getTrack();
+      const int step = qMax( 1, track.size() / MAX_RENDERS );
+
+      for( int i = 0; i < track.size(); i += step )
+        {
+          renderBaseLayer( image, track.at(i) );
+        }
+
+      _globalMapMatrix->centerToLatLon( mapCenter );
+
+      qDebug( "%s", report().toLatin1().data() );
+    }
+
+  s_running = false;
+
+  delete replay;
+
+  return ok;
+}
+
+void NavBenchmark::renderBaseLayer( QImage& image, const QPoint& center )
+{
+  _globalMapMatrix->centerToLatLon( center );
+
+  Timer timer( BaseLayerRender );
+
+  _globalMapMatrix->createMatrix( image.size() );
+
+  image.fill( GeneralConfig::instance()->getTerrainColor(0).rgb() );
+
+  // The missing tiles are loaded by the map contents.
+  _globalMapContents->proofeSection();
+
+  const double cs = _globalMapMatrix->getScale( MapMatrix::CurrentScale );
+
+  QList<BaseMapElement *> drawnElements;
+
+  QPainter painter;
+
+  painter.begin( &image );
+
+  _globalMapContents->drawIsoList( &painter );
+
+  _globalMapContents->drawList( &painter, MapContents::TopoList, drawnElements );
+  _globalMapContents->drawList( &painter, MapContents::CityList, drawnElements );
+  _globalMapContents->drawList( &painter, MapContents::LakeList, drawnElements );
+
+  if( cs <= 200.0 )
+    {
+      _globalMapContents->drawList( &painter, MapContents::RoadList, drawnElements );
+      _globalMapContents->drawList( &painter, MapContents::RailList, drawnElements );
+      _globalMapContents->drawList( &painter, MapContents::HydroList, drawnElements );
+    }
+
+  if( cs < 1024.0 )
+    {
+      _globalMapContents->drawList( &painter, MapContents::LandmarkList, drawnElements );
+      _globalMapContents->drawList( &painter, MapContents::ObstacleList, drawnElements );
+      _globalMapContents->drawList( &painter, MapContents::ReportList, drawnElements );
+    }
+
+  _globalMapContents->drawList( &painter, MapContents::MotorwayList, drawnElements );
+
+  painter.end();
+}
+
+QString NavBenchmark::stageName( const Stage stage )
+{
+  if( stage < 0 || stage >= StageCount )
+    {
+      return "Unknown";
+    }
+
+  return stageNames[stage];
+}
+
+QString NavBenchmark::report()
+{
+  QString text = QString( "%1    count     p50/us     p99/us     max/us        ops/s" )
+                 .arg( "Stage", -18 );
+
+  for( int i = 0; i < StageCount; i++ )
+    {
+      const Stage stage = static_cast<Stage> (i);
+
+      text += QString( "\n%1 %2" )
+              .arg( stageName( stage ), -18 )
+              .arg( s_histograms[i].toString() );
+    }
+
+  text += QString( "\n%1 %2" )
+          .arg( "Fix latency", -18 )
+          .arg( FixLatency::statistics().toString() );
+
+  return text;
+}
@@ -0,0 +1,162 @@
+/***********************************************************************
+**
+**   navbenchmark.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class NavBenchmark
+ *
+ * \brief Latency benchmark of the navigation pipeline.
+ *
+ * The benchmark replays a recorded flight by the FlightReplay and measures
+ * the latencies of the single pipeline stages. Afterwards the base layer
+ * of the map is rendered into an offscreen image at positions along the
+ * flight, whereby the needed map tiles are loaded. A histogram per stage is
+ * printed with p50, p99, max and the throughput.
+ *
+ * The stages are measured by scoped timers, which are placed into the
+ * measured methods. A timer does nothing, if no benchmark is running and
+ * the PerfTrace is disabled. During a benchmark the time of a nested timer
+ * is subtracted from the enclosing one, that every stage contains only its
+ * own processing time. The timers must be used only in the main thread.
+ * If the PerfTrace is enabled, the timers record also trace events.
+ *
+ * The benchmark is started by the command line option --benchmark \<file\>.
+ * It uses the configured map, airfield and airspace data.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef NAV_BENCHMARK_H
+#define NAV_BENCHMARK_H
+
+#include <QImage>
+#include <QPoint>
+#include <QString>
+
+#include "latencyhistogram.h"
+#include "perftrace.h"
+
+class NavBenchmark
+{
+ public:
+
+  /** The measured stages of the navigation pipeline. */
+  enum Stage
+  {
+    NmeaParse = 0,
+    FixProcessing,
+    WindVario,
+    ReachableList,
+    Contest,
+    AirspaceCheck,
+    TileLoad,
+    BaseLayerRender,
+    StageCount
+  };
+
+  /**
+   * \class Timer
+   *
+   * \brief Measures the processing time of a stage in its scope.
+   */
+  class Timer
+  {
+   public:
+
+    Timer( const Stage stage ) :
+      m_stage(stage),
+      m_benchmark(NavBenchmark::s_running),
+      m_trace(PerfTrace::isEnabled())
+    {
+      if( m_benchmark || m_trace )
+        {
+          start();
+        }
+    };
+
+    ~Timer()
+    {
+      if( m_benchmark || m_trace )
+        {
+          stop();
+        }
+    };
+
+   private:
+
+    Q_DISABLE_COPY ( Timer )
+
+    void start();
+
+    void stop();
+
+    Stage  m_stage;
+    bool   m_benchmark;
+    bool   m_trace;
+    qint64 m_start;
+    qint64 m_childTime;
+    Timer* m_parent;
+  };
+
+  /**
+   * Runs the benchmark with a recorded flight and prints its report.
+   *
+   * \param fileName Path of a NMEA or IGC file.
+   *
+   * \return True in case of success otherwise false.
+   */
+  static bool run( const QString& fileName );
+
+  /**
+   * \return True, if a benchmark is running.
+   */
+  static bool isRunning()
+  {
+    return s_running;
+  };
+
+  /**
+   * \return The histogram of the passed stage.
+   */
+  static const LatencyHistogram& histogram( const Stage stage )
+  {
+    return s_histograms[stage];
+  };
+
+  /**
+   * \return The name of the passed stage.
+   */
+  static QString stageName( const Stage stage );
+
+  /**
+   * \return A text report with one line per stage.
+   */
+  static QString report();
+
+ private:
+
+  /**
+   * Renders the base layer of the map centered at the passed position into
+   * the image. The layers are drawn in the same order as by the map.
+   */
+  static void renderBaseLayer( QImage& image, const QPoint& center );
+
+  static bool s_running;
+
+  static LatencyHistogram s_histograms[StageCount];
+};
+
+#endif
@@ -0,0 +1,430 @@
+/***********************************************************************
+**
+**   olcoptimizer.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include <QtCore>
+
+#include "mapcalc.h"
+#include "olcoptimizer.h"
+
+// Minimum distance in meters between two stored points at the beginning
+// of a flight.
+#define MIN_SPACING 250.0
+
+// Maximum number of stored points. If it is exceeded, the track is thinned
+// out.
+#define MAX_POINTS 500
+
+// Number of track points used by the FAI triangle search.
+#define TRIANGLE_POINTS 120
+
+// Number of stored points between two FAI triangle searches.
+#define TRIANGLE_INTERVAL 4
+
+// Maximum distance in meters between start and finish of an out-and-return
+// route.
+#define OUT_AND_RETURN_CLOSURE 1000.0
+
+// FAI rules: every leg has at least 28% of the distance and the track is
+// closed within 20% of the distance.
+#define FAI_MIN_LEG 0.28
+#define FAI_MAX_GAP 0.2
+
+OlcOptimizer::OlcOptimizer()
+{
+  clear();
+}
+
+OlcOptimizer::~OlcOptimizer()
+{
+}
+
+void OlcOptimizer::clear()
+{
+  m_points.clear();
+  m_spacing = MIN_SPACING;
+  m_sinceTriangle = 0;
+
+  for( int l = 0; l <= FreeDistanceLegs; l++ )
+    {
+      m_best[l].clear();
+      m_from[l].clear();
+    }
+
+  m_row.clear();
+  m_freeDistance.clear();
+  m_faiTriangle.clear();
+  m_outAndReturn.clear();
+  m_openTriangle.clear();
+  m_openStart = -1;
+  m_closingPoint = QPoint();
+  m_closingDistance = 0.0;
+}
+
+OlcOptimizer::Point OlcOptimizer::makePoint( const QPoint& position )
+{
+  const double lat = position.x() * M_PI / (180.0 * 600000.0);
+  const double lon = position.y() * M_PI / (180.0 * 600000.0);
+
+  Point point;
+  point.position = position;
+  point.x = cos( lat ) * cos( lon );
+  point.y = cos( lat ) * sin( lon );
+  point.z = sin( lat );
+
+  return point;
+}
+
+double OlcOptimizer::distance( const Point& p1, const Point& p2 )
+{
+  const double dx = p1.x - p2.x;
+  const double dy = p1.y - p2.y;
+  const double dz = p1.z - p2.z;
+
+  // The chord is converted into the angle between the unit vectors, which
+  // is accurate for short distances too.
+  const double chord = sqrt( dx * dx + dy * dy + dz * dz );
+
+  return 2.0 * RADIUS * asin( qMin( 1.0, chord * 0.5 ) );
+}
+
+void OlcOptimizer::addFix( const QPoint& position )
+{
+  m_lastFix = makePoint( position );
+
+  if( m_points.isEmpty() ||
+      distance( m_points.last(), m_lastFix ) >= m_spacing )
+    {
+      appendPoint( m_lastFix );
+    }
+
+  updateClosing( m_lastFix );
+}
+
+void OlcOptimizer::addFlight( const IgcParser::Flight& flight )
+{
+  clear();
+
+  for( int i = 0; i < flight.size(); i++ )
+    {
+      addFix( flight.position(i) );
+    }
+
+  // The end of the flight has to be considered too.
+  optimizeTriangle();
+}
+
+void OlcOptimizer::appendPoint( const Point& point )
+{
+  m_points.append( point );
+
+  updateRoutes( m_points.size() - 1 );
+
+  if( m_points.size() > MAX_POINTS )
+    {
+      thinOut();
+    }
+
+  if( ++m_sinceTriangle >= TRIANGLE_INTERVAL )
+    {
+      optimizeTriangle();
+    }
+}
+
+void OlcOptimizer::updateRoutes( const int k )
+{
+  const Point& pk = m_points.at(k);
+
+  m_row.resize( k );
+
+  // Largest distance of an earlier point to the new one.
+  double reach = 0.0;
+
+  for( int i = 0; i < k; i++ )
+    {
+      m_row[i] = distance( m_points.at(i), pk );
+      reach = qMax( reach, m_row.at(i) );
+    }
+
+  // Free distance: all routes end at the new point k.
+  m_best[0].append( 0.0 );
+  m_from[0].append( -1 );
+
+  for( int l = 1; l <= FreeDistanceLegs; l++ )
+    {
+      const QVector<double>& prev = m_best[l - 1];
+
+      double value = prev.at(k);
+      int from = -1;
+
+      for( int i = 0; i < k; i++ )
+        {
+          const double d = prev.at(i) + m_row.at(i);
+
+          if( d > value )
+            {
+              value = d;
+              from = i;
+            }
+        }
+
+      m_best[l].append( value );
+      m_from[l].append( from );
+    }
+
+  if( m_best[FreeDistanceLegs].at(k) > m_freeDistance.distance )
+    {
+      m_freeDistance.distance = m_best[FreeDistanceLegs].at(k);
+      m_freeDistance.points.clear();
+
+      // Follow the previous points back to the start of the route.
+      int j = k;
+      m_freeDistance.points.prepend( m_points.at(j).position );
+
+      for( int l = FreeDistanceLegs; l > 0; l-- )
+        {
+          const int from = m_from[l].at(j);
+
+          if( from >= 0 )
+            {
+              j = from;
+              m_freeDistance.points.prepend( m_points.at(j).position );
+            }
+        }
+    }
+
+  // Out-and-return with the new point as finish. The route over a turn
+  // point t from a start s is not longer than d(s,k) + 2 * d(t,k).
+  if( OUT_AND_RETURN_CLOSURE + 2.0 * reach <= m_outAndReturn.distance )
+    {
+      return;
+    }
+
+  for( int s = 0; s < k; s++ )
+    {
+      if( m_row.at(s) > OUT_AND_RETURN_CLOSURE )
+        {
+          continue;
+        }
+
+      for( int t = s + 1; t < k; t++ )
+        {
+          if( m_row.at(s) + 2.0 * m_row.at(t) <= m_outAndReturn.distance )
+            {
+              continue;
+            }
+
+          const double d = distance( m_points.at(s), m_points.at(t) ) + m_row.at(t);
+
+          if( d > m_outAndReturn.distance )
+            {
+              m_outAndReturn.distance = d;
+              m_outAndReturn.points.clear();
+              m_outAndReturn.points << m_points.at(s).position
+                                    << m_points.at(t).position
+                                    << pk.position;
+            }
+        }
+    }
+}
+
+void OlcOptimizer::thinOut()
+{
+  QVector<Point> points;
+
+  points.reserve( m_points.size() / 2 + 1 );
+
+  for( int i = 0; i < m_points.size(); i += 2 )
+    {
+      points.append( m_points.at(i) );
+    }
+
+  // The newest point is always kept.
+  if( (m_points.size() % 2) == 0 )
+    {
+      points.append( m_points.last() );
+    }
+
+  m_points = points;
+  m_spacing *= 2.0;
+
+  // The incremental tables are rebuilt. The found solutions remain, because
+  // they are still valid routes of the flight.
+  for( int l = 0; l <= FreeDistanceLegs; l++ )
+    {
+      m_best[l].clear();
+      m_from[l].clear();
+    }
+
+  for( int k = 0; k < m_points.size(); k++ )
+    {
+      updateRoutes( k );
+    }
+
+  // The index of the open triangle is invalid now.
+  optimizeTriangle();
+}
+
+void OlcOptimizer::optimizeTriangle()
+{
+  m_sinceTriangle = 0;
+  m_openTriangle.clear();
+  m_openStart = -1;
+
+  const int n = m_points.size();
+  const int s = qMin( n, TRIANGLE_POINTS );
+
+  if( s < 3 )
+    {
+      return;
+    }
+
+  QVector<int> sub( s );
+
+  for( int k = 0; k < s; k++ )
+    {
+      sub[k] = int( qint64( k ) * (n - 1) / (s - 1) );
+    }
+
+  QVector<float> d( s * s );
+
+  for( int i = 0; i < s; i++ )
+    {
+      d[i * s + i] = 0.0;
+
+      for( int j = i + 1; j < s; j++ )
+        {
+          const float dist = distance( m_points.at( sub.at(i) ), m_points.at( sub.at(j) ) );
+          d[i * s + j] = dist;
+          d[j * s + i] = dist;
+        }
+    }
+
+  // gap[i][k] is the smallest distance between a point before i and a
+  // point after k, which closes the triangle.
+  QVector<float> gap( s * s, 0.0 );
+
+  for( int i = 0; i < s; i++ )
+    {
+      for( int k = s - 1; k >= i; k-- )
+        {
+          float g = d.at( i * s + k );
+
+          if( i > 0 )
+            {
+              g = qMin( g, gap.at( (i - 1) * s + k ) );
+            }
+
+          if( k < s - 1 )
+            {
+              g = qMin( g, gap.at( i * s + k + 1 ) );
+            }
+
+          gap[i * s + k] = g;
+        }
+    }
+
+  int open[3] = { -1, -1, -1 };
+
+  for( int i = 0; i < s; i++ )
+    {
+      for( int k = i + 2; k < s; k++ )
+        {
+          // The closing leg has at least 28% of the distance, which limits
+          // the reachable distance of all triangles over i and k.
+          const double c = d.at( i * s + k );
+
+          if( c / FAI_MIN_LEG <= m_faiTriangle.distance )
+            {
+              continue;
+            }
+
+          const bool closable = gap.at( i * s + k ) <= FAI_MAX_GAP * c / FAI_MIN_LEG;
+
+          for( int j = i + 1; j < k; j++ )
+            {
+              const double a = d.at( i * s + j );
+              const double b = d.at( j * s + k );
+              const double perimeter = a + b + c;
+
+              if( perimeter <= m_faiTriangle.distance ||
+                  qMin( a, qMin( b, c ) ) < FAI_MIN_LEG * perimeter )
+                {
+                  continue;
+                }
+
+              if( closable && gap.at( i * s + k ) <= FAI_MAX_GAP * perimeter )
+                {
+                  m_faiTriangle.distance = perimeter;
+                  m_faiTriangle.points.clear();
+                  m_faiTriangle.points << m_points.at( sub.at(i) ).position
+                                       << m_points.at( sub.at(j) ).position
+                                       << m_points.at( sub.at(k) ).position;
+                }
+              else if( perimeter > m_openTriangle.distance )
+                {
+                  m_openTriangle.distance = perimeter;
+                  open[0] = i;
+                  open[1] = j;
+                  open[2] = k;
+                }
+            }
+        }
+    }
+
+  if( m_openTriangle.distance <= m_faiTriangle.distance )
+    {
+      m_openTriangle.clear();
+      return;
+    }
+
+  for( int v = 0; v < 3; v++ )
+    {
+      m_openTriangle.points.append( m_points.at( sub.at( open[v] ) ).position );
+    }
+
+  m_openStart = sub.at( open[0] );
+  updateClosing( m_lastFix );
+}
+
+void OlcOptimizer::updateClosing( const Point& current )
+{
+  if( m_openStart < 0 )
+    {
+      return;
+    }
+
+  // The nearest point has the largest scalar product with the current
+  // position.
+  int nearest = 0;
+  double maxDot = -2.0;
+
+  for( int i = 0; i <= m_openStart; i++ )
+    {
+      const Point& p = m_points.at(i);
+      const double dot = p.x * current.x + p.y * current.y + p.z * current.z;
+
+      if( dot > maxDot )
+        {
+          maxDot = dot;
+          nearest = i;
+        }
+    }
+
+  m_closingPoint = m_points.at(nearest).position;
+  m_closingDistance = qMax( 0.0, distance( m_points.at(nearest), current ) -
+                                 FAI_MAX_GAP * m_openTriangle.distance );
+}
@@ -0,0 +1,244 @@
+/***********************************************************************
+**
+**   olcoptimizer.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class OlcOptimizer
+ *
+ * \brief Online contest optimizer over the flown track.
+ *
+ * The optimizer maintains the best free distance over up to 5 legs, the
+ * best FAI triangle and the best out-and-return route of the flight. It is
+ * fed fix by fix during the flight or with a parsed IGC file in batch mode.
+ *
+ * - A fix is stored only, if it is at least a minimum spacing away from the
+ *   last stored point. If the storage is full, every second point is
+ *   removed and the spacing is doubled. The distances are calculated exactly
+ *   on the sphere from the stored unit vectors.
+ * - The free distance is updated by an incremental dynamic programming
+ *   step for every stored point, which ends all routes at the new point.
+ * - The out-and-return route is searched with the new point as finish. The
+ *   candidates are pruned by the largest distance to the new point.
+ * - The FAI triangle is searched every few stored points over a reduced
+ *   track. Point pairs, whose distance does not allow a better triangle,
+ *   are skipped.
+ * - The best FAI triangle, which is not closed yet, is kept too. Its
+ *   closing point is the track point before the triangle, which is nearest
+ *   to the current position.
+ *
+ * All solutions only grow during the flight.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef OLC_OPTIMIZER_H
+#define OLC_OPTIMIZER_H
+
+#include <QPoint>
+#include <QVector>
+
+#include "igcparser.h"
+
+class OlcOptimizer
+{
+ public:
+
+  /** Number of legs of the free distance. */
+  enum { FreeDistanceLegs = 5 };
+
+  /** A contest route. */
+  struct Solution
+  {
+    Solution() : distance(0.0) {};
+
+    void clear()
+    {
+      distance = 0.0;
+      points.clear();
+    };
+
+    /** Distance of the route in meters. */
+    double distance;
+
+    /** Points of the route in KFLog coordinates in flight order. */
+    QVector<QPoint> points;
+  };
+
+  OlcOptimizer();
+
+  virtual ~OlcOptimizer();
+
+  /** Removes the track and all solutions. */
+  void clear();
+
+  /**
+   * Adds a new fix of the flight.
+   *
+   * \param position The position in KFLog coordinates.
+   */
+  void addFix( const QPoint& position );
+
+  /**
+   * Optimizes a whole flight. Old data are removed.
+   */
+  void addFlight( const IgcParser::Flight& flight );
+
+  /**
+   * Searches the FAI triangle over the stored track. That is done
+   * automatically every few stored points.
+   */
+  void optimizeTriangle();
+
+  /**
+   * \return The best free distance.
+   */
+  const Solution& freeDistance() const
+  {
+    return m_freeDistance;
+  };
+
+  /**
+   * \return The best closed FAI triangle.
+   */
+  const Solution& faiTriangle() const
+  {
+    return m_faiTriangle;
+  };
+
+  /**
+   * \return The best out-and-return route.
+   */
+  const Solution& outAndReturn() const
+  {
+    return m_outAndReturn;
+  };
+
+  /**
+   * \return The best FAI triangle, which is larger than the closed one but
+   *         not closed yet.
+   */
+  const Solution& openTriangle() const
+  {
+    return m_openTriangle;
+  };
+
+  /**
+   * \return True, if an open FAI triangle has a closing point.
+   */
+  bool hasClosingPoint() const
+  {
+    return m_openTriangle.distance > 0.0;
+  };
+
+  /**
+   * \return The point in KFLog coordinates, to which the open FAI
+   *         triangle is closed best.
+   */
+  const QPoint& closingPoint() const
+  {
+    return m_closingPoint;
+  };
+
+  /**
+   * \return The distance in meters, which is still missing to close the
+   *         open FAI triangle.
+   */
+  double closingDistance() const
+  {
+    return m_closingDistance;
+  };
+
+  /**
+   * \return The number of stored track points.
+   */
+  int size() const
+  {
+    return m_points.size();
+  };
+
+ private:
+
+  /** A stored track point. */
+  struct Point
+  {
+    QPoint position;
+
+    /** Unit vector of the position on the sphere. */
+    double x;
+    double y;
+    double z;
+  };
+
+  /** Creates a track point from KFLog coordinates. */
+  static Point makePoint( const QPoint& position );
+
+  /**
+   * \return The great circle distance between two points in meters.
+   */
+  static double distance( const Point& p1, const Point& p2 );
+
+  /** Stores a point and updates the incremental solutions. */
+  void appendPoint( const Point& point );
+
+  /** Updates the free distance and the out-and-return route for point k. */
+  void updateRoutes( const int k );
+
+  /** Removes every second point and recalculates the free distance. */
+  void thinOut();
+
+  /** Updates the closing point of the open FAI triangle. */
+  void updateClosing( const Point& current );
+
+  /** The stored track points. */
+  QVector<Point> m_points;
+
+  /** Minimum distance in meters between two stored points. */
+  double m_spacing;
+
+  /** Stored points since the last triangle search. */
+  int m_sinceTriangle;
+
+  /**
+   * m_best[l][k] is the longest route over up to l legs, which ends at
+   * point k. m_from[l][k] is the previous point of that route or -1, if the
+   * route has less than l legs.
+   */
+  QVector<double> m_best[FreeDistanceLegs + 1];
+  QVector<int> m_from[FreeDistanceLegs + 1];
+
+  /** Distances of all stored points to the newest one. */
+  QVector<double> m_row;
+
+  Solution m_freeDistance;
+
+  Solution m_faiTriangle;
+
+  Solution m_outAndReturn;
+
+  Solution m_openTriangle;
+
+  /** Index of the first point of the open FAI triangle. */
+  int m_openStart;
+
+  QPoint m_closingPoint;
+
+  double m_closingDistance;
+
+  /** The last fix, which must not be a stored point. */
+  Point m_lastFix;
+};
+
+#endif
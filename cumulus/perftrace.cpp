@@ -0,0 +1,366 @@
+/***********************************************************************
+**
+**   perftrace.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <QtCore>
+
+#include "perftrace.h"
+
+// Number of events in the ring buffer of a thread.
+#define BUFFER_SIZE 8192
+
+namespace
+{
+  /** A recorded event. */
+  struct Event
+  {
+    const char* name;
+
+    /** Start time in ns. */
+    qint64 time;
+
+    /** Duration in ns of a scope or value of a counter. */
+    qint64 value;
+
+    /** 'X' for a scope, 'C' for a counter. */
+    char type;
+  };
+
+  /** A slot of the ring buffer. */
+  struct Slot
+  {
+    /** Sequence counter, which is odd while the event is written. */
+    QAtomicInt sequence;
+
+    Event event;
+  };
+
+  /** Ring buffer of a thread. */
+  struct Buffer
+  {
+    Buffer( const int tid ) : tid(tid), next(0), used(1) {};
+
+    Slot slots[BUFFER_SIZE];
+
+    /** Trace thread identifier. */
+    int tid;
+
+    /** Number of written events, only used by the writer. */
+    int next;
+
+    /** Number of published events. */
+    QAtomicInt published;
+
+    /** One, while a thread writes into the buffer. */
+    QAtomicInt used;
+  };
+
+  /**
+   * Reference to the buffer of a thread. The buffer is released for the
+   * reuse by another thread, when the thread is finished.
+   */
+  struct BufferRef
+  {
+    BufferRef() : buffer(0) {};
+
+    ~BufferRef()
+    {
+      if( buffer )
+        {
+          buffer->used.fetchAndStoreRelease( 0 );
+        }
+    };
+
+    Buffer* buffer;
+  };
+
+  /** Summary of the events with the same name. */
+  struct Item
+  {
+    int count;
+    qint64 total;
+    qint64 maximum;
+    qint64 last;
+    qint64 lastTime;
+    char type;
+  };
+
+  /**
+   * Buffers of all threads, which have recorded events. The buffers of
+   * finished threads are reused, so that the list grows only up to the
+   * number of simultaneous tracing threads.
+   */
+  QList<Buffer*> buffers;
+
+  QMutex buffersMutex;
+
+  QThreadStorage<BufferRef> localBuffer;
+
+  /** Events before this time are ignored by the consumers. */
+  qint64 clearTime = 0;
+
+  QElapsedTimer startedClock()
+  {
+    QElapsedTimer clock;
+    clock.start();
+    return clock;
+  }
+
+  /**
+   * Copies the published events of all buffers, which are not older than
+   * the passed time.
+   */
+  QVector<QPair<int, Event> > collect( const qint64 since )
+  {
+    QVector<QPair<int, Event> > result;
+
+    QMutexLocker locker( &buffersMutex );
+
+    for( int i = 0; i < buffers.size(); i++ )
+      {
+        Buffer* b = buffers.at(i);
+
+        const int published = b->published.fetchAndAddAcquire( 0 );
+        const int first = qMax( 0, published - BUFFER_SIZE );
+
+        for( int j = first; j < published; j++ )
+          {
+            Slot& slot = b->slots[j % BUFFER_SIZE];
+
+            const int sequence = slot.sequence.fetchAndAddAcquire( 0 );
+
+            if( sequence & 1 )
+              {
+                // The writer overwrites the slot just now.
+                continue;
+              }
+
+            const Event e = slot.event;
+
+            if( slot.sequence.fetchAndAddOrdered( 0 ) != sequence )
+              {
+                // The slot was overwritten during the copy.
+                continue;
+              }
+
+            if( e.time >= since )
+              {
+                result.append( qMakePair( b->tid, e ) );
+              }
+          }
+      }
+
+    return result;
+  }
+
+  QString jsonString( const char* text )
+  {
+    QString s = QString::fromLatin1( text );
+    s.replace( "\\", "\\\\" );
+    s.replace( "\"", "\\\"" );
+    return "\"" + s + "\"";
+  }
+}
+
+bool PerfTrace::s_enabled = false;
+
+QElapsedTimer PerfTrace::s_clock = startedClock();
+
+void PerfTrace::setEnabled( const bool enable )
+{
+  s_enabled = enable;
+}
+
+void PerfTrace::complete( const char* name, const qint64 start, const qint64 duration )
+{
+  if( s_enabled )
+    {
+      record( name, start, duration, 'X' );
+    }
+}
+
+void PerfTrace::record( const char* name, const qint64 time,
+                        const qint64 value, const char type )
+{
+  BufferRef& ref = localBuffer.localData();
+
+  if( ref.buffer == 0 )
+    {
+      QMutexLocker locker( &buffersMutex );
+
+      // A buffer of a finished thread is reused with its events.
+      for( int i = 0; i < buffers.size(); i++ )
+        {
+          if( buffers.at(i)->used.testAndSetAcquire( 0, 1 ) )
+            {
+              ref.buffer = buffers.at(i);
+              break;
+            }
+        }
+
+      if( ref.buffer == 0 )
+        {
+          ref.buffer = new Buffer( buffers.size() + 1 );
+          buffers.append( ref.buffer );
+        }
+    }
+
+  Buffer* b = ref.buffer;
+
+  Slot& slot = b->slots[b->next % BUFFER_SIZE];
+
+  slot.sequence.fetchAndAddOrdered( 1 );
+
+  Event& e = slot.event;
+  e.name  = name;
+  e.time  = time;
+  e.value = value;
+  e.type  = type;
+
+  slot.sequence.fetchAndAddRelease( 1 );
+
+  b->next++;
+
+  // The counter is set back by a multiple of the buffer size before it can
+  // overflow, so the ring buffer index is not changed.
+  if( b->next == 0x40000000 )
+    {
+      b->next -= 0x20000000;
+    }
+
+  b->published.fetchAndStoreRelease( b->next );
+}
+
+void PerfTrace::clear()
+{
+  clearTime = now();
+}
+
+QString PerfTrace::summary( const int window )
+{
+  const qint64 end = now();
+  const qint64 since = qMax( clearTime, end - qint64( window ) * 1000000 );
+
+  const QVector<QPair<int, Event> > events = collect( since );
+
+  QMap<QByteArray, Item> items;
+
+  for( int i = 0; i < events.size(); i++ )
+    {
+      const Event& e = events.at(i).second;
+
+      QMap<QByteArray, Item>::iterator it = items.find( e.name );
+
+      if( it == items.end() )
+        {
+          Item item = { 0, 0, 0, 0, -1, e.type };
+          it = items.insert( e.name, item );
+        }
+
+      Item& item = it.value();
+
+      item.count++;
+      item.total += e.value;
+      item.maximum = qMax( item.maximum, e.value );
+
+      if( e.time > item.lastTime )
+        {
+          item.last = e.value;
+          item.lastTime = e.time;
+        }
+    }
+
+  const double seconds = qMax( double( end - since ) / 1e9, 0.001 );
+
+  QString text;
+  QMap<QByteArray, Item>::const_iterator it;
+
+  for( it = items.constBegin(); it != items.constEnd(); ++it )
+    {
+      const Item& item = it.value();
+
+      if( ! text.isEmpty() )
+        {
+          text += "\n";
+        }
+
+      if( item.type == 'C' )
+        {
+          text += QString( "%1: %2" )
+                  .arg( QString::fromLatin1( it.key() ) )
+                  .arg( item.last );
+        }
+      else
+        {
+          text += QString( "%1: %2/s %3/%4 ms" )
+                  .arg( QString::fromLatin1( it.key() ) )
+                  .arg( double( item.count ) / seconds, 0, 'f', 1 )
+                  .arg( double( item.total ) / item.count / 1e6, 0, 'f', 2 )
+                  .arg( double( item.maximum ) / 1e6, 0, 'f', 2 );
+        }
+    }
+
+  return text;
+}
+
+bool PerfTrace::exportChromeTrace( const QString& fileName )
+{
+  QFile file( fileName );
+
+  if( ! file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+      qWarning() << "PerfTrace::exportChromeTrace: Cannot open file" << fileName;
+      return false;
+    }
+
+  const QVector<QPair<int, Event> > events = collect( clearTime );
+
+  QTextStream stream( &file );
+
+  stream << "{\"traceEvents\":[";
+
+  for( int i = 0; i < events.size(); i++ )
+    {
+      const int tid  = events.at(i).first;
+      const Event& e = events.at(i).second;
+
+      if( i > 0 )
+        {
+          stream << ",";
+        }
+
+      // The time stamps of the Chrome trace format are microseconds.
+      stream << "\n{\"name\":" << jsonString( e.name )
+             << ",\"ph\":\"" << e.type << "\""
+             << ",\"ts\":" << QString::number( double( e.time ) / 1000.0, 'f', 3 )
+             << ",\"pid\":1,\"tid\":" << tid;
+
+      if( e.type == 'X' )
+        {
+          stream << ",\"dur\":" << QString::number( double( e.value ) / 1000.0, 'f', 3 );
+        }
+      else
+        {
+          stream << ",\"args\":{\"value\":" << e.value << "}";
+        }
+
+      stream << "}";
+    }
+
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  file.close();
+
+  return stream.status() == QTextStream::Ok;
+}
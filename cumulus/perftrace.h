@@ -0,0 +1,163 @@
+/***********************************************************************
+**
+**   perftrace.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class PerfTrace
+ *
+ * \brief Lightweight tracing of the hot paths.
+ *
+ * The trace records scoped timings and counter values as events. Every
+ * thread writes its events into an own ring buffer. The buffer has only one
+ * writer, therefore no lock is needed. The number of written events is
+ * published by an atomic counter, which is read by the consumers. Every
+ * slot has a sequence counter, so that the consumers skip slots, which are
+ * overwritten during the copy. A mutex is only used, when a thread records
+ * its first event and when the events are collected.
+ *
+ * The buffer of a finished thread is reused by the next new thread.
+ *
+ * If the trace is disabled, a scope or a counter checks only a static flag.
+ *
+ * The collected events can be summarized for the performance overlay of the
+ * map view or exported as Chrome trace JSON, which can be loaded into
+ * chrome://tracing or Perfetto.
+ *
+ * Event names must be string literals, because only their pointers are
+ * stored.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef PERF_TRACE_H
+#define PERF_TRACE_H
+
+#include <QElapsedTimer>
+#include <QString>
+
+class PerfTrace
+{
+ public:
+
+  /**
+   * \class Scope
+   *
+   * \brief Records the processing time of its scope as trace event.
+   */
+  class Scope
+  {
+   public:
+
+    Scope( const char* name ) :
+      m_name( PerfTrace::s_enabled ? name : 0 ),
+      m_start( m_name ? PerfTrace::now() : 0 )
+    {
+    };
+
+    ~Scope()
+    {
+      if( m_name )
+        {
+          PerfTrace::complete( m_name, m_start, PerfTrace::now() - m_start );
+        }
+    };
+
+   private:
+
+    Q_DISABLE_COPY ( Scope )
+
+    const char* m_name;
+    qint64      m_start;
+  };
+
+  /**
+   * \return True, if the trace is enabled.
+   */
+  static bool isEnabled()
+  {
+    return s_enabled;
+  };
+
+  /**
+   * Enables or disables the trace. The recorded events are kept.
+   */
+  static void setEnabled( const bool enable );
+
+  /**
+   * \return The trace time in nanoseconds. The time is monotonic and the
+   *         same for all threads.
+   */
+  static qint64 now()
+  {
+    return s_clock.nsecsElapsed();
+  };
+
+  /**
+   * Records a timing, which has been measured outside of a scope.
+   *
+   * \param name Name of the timed action.
+   *
+   * \param start Start time in nanoseconds.
+   *
+   * \param duration Duration in nanoseconds.
+   */
+  static void complete( const char* name, const qint64 start, const qint64 duration );
+
+  /**
+   * Records the value of a counter.
+   */
+  static void counter( const char* name, const qint64 value )
+  {
+    if( s_enabled )
+      {
+        record( name, now(), value, 'C' );
+      }
+  };
+
+  /**
+   * Forgets all events recorded until now.
+   */
+  static void clear();
+
+  /**
+   * \param window Time window in ms of the summarized events.
+   *
+   * \return One line per event name with the rate, the mean and the maximum
+   *         duration of the scopes or the last value of the counters.
+   */
+  static QString summary( const int window );
+
+  /**
+   * Writes the recorded events as Chrome trace JSON.
+   *
+   * \param fileName Path of the file to be written.
+   *
+   * \return True in case of success otherwise false.
+   */
+  static bool exportChromeTrace( const QString& fileName );
+
+ private:
+
+  /** Appends an event to the buffer of the calling thread. */
+  static void record( const char* name, const qint64 time,
+                      const qint64 value, const char type );
+
+  static bool s_enabled;
+
+  static QElapsedTimer s_clock;
+};
+
+#endif
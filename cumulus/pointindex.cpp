@@ -0,0 +1,228 @@
+/***********************************************************************
+**
+**   pointindex.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <algorithm>
+
+#include <QRect>
+
+#include "mapcalc.h"
+#include "pointindex.h"
+
+// Number of cells in longitude direction, used for the cell key.
+#define LON_CELLS 4096
+
+// Start radius in km of the nearest search.
+#define NEAREST_START_RADIUS 10.0
+
+/** Orders hits like the point lists. */
+static bool listLessThan( const PointIndex::Hit& a, const PointIndex::Hit& b )
+{
+  if( a.entry.list != b.entry.list )
+    {
+      return a.entry.list < b.entry.list;
+    }
+
+  return a.entry.index < b.entry.index;
+}
+
+/** Orders hits by their distance. */
+static bool distanceLessThan( const PointIndex::Hit& a, const PointIndex::Hit& b )
+{
+  return a.distance < b.distance;
+}
+
+PointIndex::PointIndex()
+{
+}
+
+PointIndex::~PointIndex()
+{
+}
+
+quint32 PointIndex::cellKey( const int lat, const int lon )
+{
+  // Shift the coordinates into the positive range.
+  int latCell = (lat + 90 * 600000) / CellSize;
+  int lonCell = (lon + 180 * 600000) / CellSize;
+
+  return static_cast<quint32> (latCell * LON_CELLS + lonCell);
+}
+
+void PointIndex::clear()
+{
+  m_entries.clear();
+  m_cells.clear();
+}
+
+void PointIndex::insert( const int list, const int index, const QPoint& wgsPos )
+{
+  Entry entry;
+
+  entry.lat   = wgsPos.x();
+  entry.lon   = wgsPos.y();
+  entry.list  = static_cast<qint16> (list);
+  entry.index = index;
+
+  m_entries.append( entry );
+}
+
+void PointIndex::finish()
+{
+  m_cells.clear();
+
+  if( m_entries.isEmpty() )
+    {
+      return;
+    }
+
+  // Sort by the cell key, so that the entries of a cell are adjacent.
+  QVector<QPair<quint32, int> > keys( m_entries.size() );
+
+  for( int i = 0; i < m_entries.size(); i++ )
+    {
+      keys[i] = qMakePair( cellKey( m_entries.at(i).lat, m_entries.at(i).lon ), i );
+    }
+
+  std::sort( keys.begin(), keys.end() );
+
+  QVector<Entry> sorted( m_entries.size() );
+
+  for( int i = 0; i < keys.size(); i++ )
+    {
+      sorted[i] = m_entries.at( keys.at(i).second );
+
+      QHash<quint32, QPair<int, int> >::iterator it = m_cells.find( keys.at(i).first );
+
+      if( it == m_cells.end() )
+        {
+          m_cells.insert( keys.at(i).first, qMakePair( i, 1 ) );
+        }
+      else
+        {
+          it.value().second++;
+        }
+    }
+
+  m_entries = sorted;
+}
+
+void PointIndex::inRadius( const QPoint& center,
+                           const double radius,
+                           const quint32 listMask,
+                           QVector<Hit>& hits ) const
+{
+  hits.clear();
+
+  if( m_entries.isEmpty() )
+    {
+      return;
+    }
+
+  // The bounding box uses the latitude as x-axis and the longitude as y-axis.
+  QRect box = MapCalc::areaBox( center, radius );
+
+  int latMin = qMax( box.left(), -90 * 600000 );
+  int latMax = qMin( box.left() + box.width(), 90 * 600000 - 1 );
+  int lonMin = qMax( box.top(), -180 * 600000 );
+  int lonMax = qMin( box.top() + box.height(), 180 * 600000 - 1 );
+
+  quint32 first = cellKey( latMin, lonMin );
+  quint32 last  = cellKey( latMax, lonMax );
+
+  int lonCells = (last % LON_CELLS) - (first % LON_CELLS);
+
+  QPoint c = center;
+
+  for( quint32 row = first; row <= last; row += LON_CELLS )
+    {
+      for( quint32 key = row; key <= row + lonCells; key++ )
+        {
+          QHash<quint32, QPair<int, int> >::const_iterator it = m_cells.constFind( key );
+
+          if( it == m_cells.constEnd() )
+            {
+              continue;
+            }
+
+          int end = it.value().first + it.value().second;
+
+          for( int i = it.value().first; i < end; i++ )
+            {
+              const Entry& entry = m_entries.at(i);
+
+              if( (listMask & listBit( entry.list )) == 0 ||
+                  entry.lat < latMin || entry.lat > latMax ||
+                  entry.lon < lonMin || entry.lon > lonMax )
+                {
+                  continue;
+                }
+
+              QPoint pos( entry.lat, entry.lon );
+
+              double distance = MapCalc::dist( &c, &pos );
+
+              if( distance > radius )
+                {
+                  continue;
+                }
+
+              Hit hit;
+              hit.entry = entry;
+              hit.distance = distance;
+
+              hits.append( hit );
+            }
+        }
+    }
+
+  std::sort( hits.begin(), hits.end(), listLessThan );
+}
+
+void PointIndex::nearest( const QPoint& center,
+                          const int k,
+                          const double maxRadius,
+                          const quint32 listMask,
+                          QVector<Hit>& hits ) const
+{
+  hits.clear();
+
+  if( k < 1 )
+    {
+      return;
+    }
+
+  // Double the search radius, until enough points are found. All points
+  // outside of the radius are farther away than the found ones.
+  double radius = qMin( NEAREST_START_RADIUS, maxRadius );
+
+  while( true )
+    {
+      inRadius( center, radius, listMask, hits );
+
+      if( hits.size() >= k || radius >= maxRadius )
+        {
+          break;
+        }
+
+      radius = qMin( radius * 2.0, maxRadius );
+    }
+
+  std::sort( hits.begin(), hits.end(), distanceLessThan );
+
+  if( hits.size() > k )
+    {
+      hits.resize( k );
+    }
+}
@@ -0,0 +1,164 @@
+/***********************************************************************
+**
+**   pointindex.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class PointIndex
+ *
+ * \brief Spatial index over the WGS84 positions of point objects.
+ *
+ * The index is a uniform grid of 0.1 degree cells. The entries are stored
+ * sorted by their cells in one vector and a hash points to the entry range
+ * of every occupied cell. An entry references a point object by its list
+ * identifier and its index in that list, so that the index is independent
+ * of the stored point classes.
+ *
+ * Queries touch only the cells overlapping the search area. The radius
+ * query returns all points within a distance, the nearest query the k
+ * nearest points.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef POINT_INDEX_H
+#define POINT_INDEX_H
+
+#include <QHash>
+#include <QPair>
+#include <QPoint>
+#include <QVector>
+
+class PointIndex
+{
+ public:
+
+  /** Reference to an indexed point object. */
+  struct Entry
+  {
+    /** WGS84 position in KFLog format. */
+    qint32 lat;
+    qint32 lon;
+
+    /** Identifier of the list containing the point. */
+    qint16 list;
+
+    /** Index of the point in its list. */
+    qint32 index;
+  };
+
+  /** Result entry of a query. */
+  struct Hit
+  {
+    Entry entry;
+
+    /** Distance to the query center in km. */
+    double distance;
+  };
+
+  PointIndex();
+
+  virtual ~PointIndex();
+
+  /**
+   * Removes all entries.
+   */
+  void clear();
+
+  /**
+   * Adds a point to the index. After all points are added, finish() must be
+   * called before the index can be queried.
+   *
+   * \param list Identifier of the list containing the point.
+   *
+   * \param index Index of the point in its list.
+   *
+   * \param wgsPos WGS84 position of the point in KFLog format.
+   */
+  void insert( const int list, const int index, const QPoint& wgsPos );
+
+  /**
+   * Sorts the added entries by their cells and builds the cell table.
+   */
+  void finish();
+
+  /**
+   * \return The number of indexed points.
+   */
+  int size() const
+  {
+    return m_entries.size();
+  };
+
+  /**
+   * Looks for all points within a radius. The hits are ordered by list and
+   * index, that is the order of the point lists.
+   *
+   * \param center Center of the search in KFLog format.
+   *
+   * \param radius Search radius in km.
+   *
+   * \param listMask Bit mask of the list identifiers to be considered.
+   *
+   * \param hits Found points.
+   */
+  void inRadius( const QPoint& center,
+                 const double radius,
+                 const quint32 listMask,
+                 QVector<Hit>& hits ) const;
+
+  /**
+   * Looks for the k nearest points. The hits are ordered by distance.
+   *
+   * \param center Center of the search in KFLog format.
+   *
+   * \param k Maximum number of points to be returned.
+   *
+   * \param maxRadius Maximum search radius in km.
+   *
+   * \param listMask Bit mask of the list identifiers to be considered.
+   *
+   * \param hits Found points.
+   */
+  void nearest( const QPoint& center,
+                const int k,
+                const double maxRadius,
+                const quint32 listMask,
+                QVector<Hit>& hits ) const;
+
+  /**
+   * \return The bit of a list identifier in a list mask.
+   */
+  static quint32 listBit( const int list )
+  {
+    return 1U << list;
+  };
+
+ private:
+
+  /** Cell size in KFLog units, 0.1 degree. */
+  static const int CellSize = 60000;
+
+  /** Returns the cell key of a KFLog position. */
+  static quint32 cellKey( const int lat, const int lon );
+
+  /** Entries ordered by their cells. */
+  QVector<Entry> m_entries;
+
+  /** Start index and number of entries of every occupied cell. */
+  QHash<quint32, QPair<int, int> > m_cells;
+};
+
+#endif
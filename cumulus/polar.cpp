@@ -25,6 +25,17 @@
 #include "layout.h"
 #include "polar.h"
 
+// Range and step width in m/s of the headwind axis of the speed table.
+#define TABLE_WIND_MIN  -30.0
+#define TABLE_WIND_STEP 1.0
+#define TABLE_WIND_SIZE 61
+
+// Range and step width in m/s of the effective McCready axis of the speed
+// table. The effective McCready value is the McCready value minus the lift.
+#define TABLE_MC_MIN  -10.0
+#define TABLE_MC_STEP 0.25
+#define TABLE_MC_SIZE 81
+
 Polar::Polar() :
   _name(""),
   _v1(0),
@@ -132,7 +143,8 @@ Polar::Polar (const Polar& polar) :
   _addLoad (polar._addLoad),
   _wingArea(polar._wingArea),
   _seats (polar._seats),
-  _maxWater (polar._maxWater)
+  _maxWater (polar._maxWater),
+  _speedTable (polar._speedTable)
 {}
 
 Polar::~Polar()
@@ -171,6 +183,9 @@ void Polar::recalculatePolarData()
 
   _c = _cc = W3 - _aa*V3*V3 - _bb*V3;
 
+  // The speed table must be rebuilt.
+  _speedTable.clear();
+
   if( _addLoad > 0 || _water > 0 || _bugs > 0 )
     {
       setLoad( _addLoad, _water, _bugs );
@@ -204,6 +219,9 @@ void Polar::setLoad( int addLoad, int water, int bugs )
   _b = _bb / B;      // positive
   _c = _cc * A * B;  // negative
   // we just increase the #sinking rate; this is not quite correct but gives reasonable results
+
+  // The speed table must be rebuilt.
+  _speedTable.clear();
 }
 
 /**
@@ -225,10 +243,47 @@ Speed Polar::bestSpeed (const Speed& wind, const Speed& lift, const Speed& mc) c
   // qDebug ("Polar::bestSpeed(%s)", _name.latin1());
   // qDebug ("bestSpeed: wind = %s, lift = %s", wind.getTextHorizontal().latin1(), lift.getTextVertical().latin1());
 
+  // Lift and McCready value are only used as difference in the polar equation.
+  double w = wind.getMps();
+  double m = mc.getMps() - lift.getMps();
+
+  double x = (w - TABLE_WIND_MIN) / TABLE_WIND_STEP;
+  double y = (m - TABLE_MC_MIN) / TABLE_MC_STEP;
+
+  if( x >= 0.0 && x < TABLE_WIND_SIZE - 1 && y >= 0.0 && y < TABLE_MC_SIZE - 1 )
+    {
+      if( _speedTable.isEmpty() )
+        {
+          buildSpeedTable();
+        }
+
+      int ix = int( x );
+      int iy = int( y );
+      double fx = x - ix;
+      double fy = y - iy;
+
+      const float* row0 = _speedTable.constData() + ix * TABLE_MC_SIZE + iy;
+      const float* row1 = row0 + TABLE_MC_SIZE;
+
+      // Near invalid solutions the analytic result is used.
+      if( row0[0] >= 0.0 && row0[1] >= 0.0 && row1[0] >= 0.0 && row1[1] >= 0.0 )
+        {
+          double s0 = row0[0] + (row0[1] - row0[0]) * fy;
+          double s1 = row1[0] + (row1[1] - row1[0]) * fy;
+
+          return Speed( s0 + (s1 - s0) * fx );
+        }
+    }
+
+  return Speed( solveBestSpeed( w, m ) );
+}
+
+double Polar::solveBestSpeed (double wind, double mc) const
+{
   // this is the polar equation transformed into a speed/lift coordinate system
   // the Reichmann equation V on Page 183 does not include wind. Mistake ?
-  Speed speed;
-  double temp = (wind * wind * _a - wind * _b + _c + lift - mc) / _a;
+  double speed;
+  double temp = (wind * wind * _a - wind * _b + _c - mc) / _a;
 
   if( temp >= 0.0 )
     {
@@ -241,10 +296,38 @@ Speed Polar::bestSpeed (const Speed& wind, const Speed& lift, const Speed& mc) c
       // is this a reasonable approach ?
       speed = -wind;
     }
-  // qDebug ("best speed: %s", speed.getTextHorizontal().latin1());
+  // qDebug ("best speed: %f", speed);
   return speed;
 }
 
+void Polar::buildSpeedTable() const
+{
+  _speedTable.resize( TABLE_WIND_SIZE * TABLE_MC_SIZE );
+
+  float* table = _speedTable.data();
+
+  for( int i = 0; i < TABLE_WIND_SIZE; i++ )
+    {
+      double wind = TABLE_WIND_MIN + i * TABLE_WIND_STEP;
+
+      for( int j = 0; j < TABLE_MC_SIZE; j++ )
+        {
+          double mc = TABLE_MC_MIN + j * TABLE_MC_STEP;
+          double temp = (wind * wind * _a - wind * _b + _c - mc) / _a;
+
+          // Marks points without a solution of the polar equation.
+          if( _a == 0.0 || temp < 0.0 || sqrt( temp ) - wind < 0.0 )
+            {
+              table[i * TABLE_MC_SIZE + j] = -1.0;
+            }
+          else
+            {
+              table[i * TABLE_MC_SIZE + j] = sqrt( temp ) - wind;
+            }
+        }
+    }
+}
+
 /**
   * calculate best glide ratio for given wind and lift;
   */
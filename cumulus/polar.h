@@ -36,6 +36,7 @@
 
 #include <QWidget>
 #include <QString>
+#include <QVector>
 
 #include "speed.h"
 
@@ -74,9 +75,28 @@ class Polar
 
   /**
    * calculate best airspeed for given wind, lift and McCready value;
+   * the value is interpolated from the speed to fly table, if possible.
    */
   Speed bestSpeed (const Speed& wind, const Speed& lift, const Speed& mc) const;
 
+  /**
+   * calculate the speed to fly in still air for the given netto lift
+   * of the air mass and McCready value.
+   */
+  Speed speedToFly (const Speed& netto, const Speed& mc) const
+  {
+    return bestSpeed( Speed(0.0), netto, mc );
+  };
+
+  /**
+   * calculate the netto lift of the air mass from the measured vario
+   * value and the true airspeed.
+   */
+  Speed nettoLift (const Speed& vario, const Speed& tas) const
+  {
+    return Speed( vario.getMps() + getSink( tas ).getMps() );
+  };
+
   /**
    * calculate best glide ratio
    */
@@ -244,6 +264,17 @@ class Polar
 
  private:
 
+  /**
+   * solves the polar equation for the best airspeed for given wind and
+   * effective McCready value, that is McCready minus lift.
+   */
+  double solveBestSpeed (double wind, double mc) const;
+
+  /**
+   * fills the speed to fly table from the current polar parameters.
+   */
+  void buildSpeedTable() const;
+
   /** Glider type */
   QString _name;
 
@@ -266,6 +297,13 @@ class Polar
   double _wingArea;
   int    _seats;
   int    _maxWater;
+
+  /**
+   * Best airspeeds in m/s indexed by headwind and effective McCready value.
+   * The table is built on its first use and dropped, when the polar
+   * parameters are changed. Invalid solutions are marked negative.
+   */
+  mutable QVector<float> _speedTable;
 };
 
 #endif
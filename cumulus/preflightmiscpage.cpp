@@ -198,6 +198,47 @@ PreFlightMiscPage::PreFlightMiscPage(QWidget *parent) :
   topLayout->addWidget(m_bRecordInterval, row, 1);
   row++;
 
+  lbl = new QLabel(tr("B-Record Circling:"));
+  topLayout->addWidget(lbl, row, 0);
+
+  m_bRecordCirclingInterval = new NumberEditor;
+  m_bRecordCirclingInterval->setDecimalVisible( false );
+  m_bRecordCirclingInterval->setPmVisible( false );
+  m_bRecordCirclingInterval->setRange( 0, 60);
+  m_bRecordCirclingInterval->setTip("0...60 s");
+  m_bRecordCirclingInterval->setMaxLength(2);
+  m_bRecordCirclingInterval->setSuffix(" s");
+  m_bRecordCirclingInterval->setSpecialValueText(tr("Off"));
+
+  eValidator = new QRegExpValidator( QRegExp( "([0-9]{1,2})" ), this );
+  m_bRecordCirclingInterval->setValidator( eValidator );
+  m_bRecordCirclingInterval->setMinimumWidth( mbrw );
+
+  topLayout->addWidget(m_bRecordCirclingInterval, row, 1);
+  row++;
+
+  lbl = new QLabel(tr("B-Record Extensions:"));
+  topLayout->addWidget(lbl, row, 0);
+
+  m_chkFxa = new QCheckBox("FXA");
+  m_chkFxa->setToolTip(tr("Fix accuracy"));
+  m_chkSiu = new QCheckBox("SIU");
+  m_chkSiu->setToolTip(tr("Satellites in use"));
+  m_chkTas = new QCheckBox("TAS");
+  m_chkTas->setToolTip(tr("True airspeed"));
+  m_chkVar = new QCheckBox("VAR");
+  m_chkVar->setToolTip(tr("Vario"));
+
+  QHBoxLayout *extBox = new QHBoxLayout;
+  extBox->addWidget(m_chkFxa);
+  extBox->addWidget(m_chkSiu);
+  extBox->addWidget(m_chkTas);
+  extBox->addWidget(m_chkVar);
+  extBox->addStretch(10);
+
+  topLayout->addLayout(extBox, row, 1, 1, 2);
+  row++;
+
   lbl = new QLabel(tr("K-Record Interval:"));
   topLayout->addWidget(lbl, row, 0);
 
@@ -287,6 +328,14 @@ void PreFlightMiscPage::load()
   m_edtQNH->setValue( conf->getQNH() );
   m_edtLDTime->setValue( conf->getLDCalculationTime() );
   m_bRecordInterval->setValue( conf->getBRecordInterval() );
+  m_bRecordCirclingInterval->setValue( conf->getBRecordCirclingInterval() );
+
+  const int extensions = conf->getIgcExtensions();
+
+  m_chkFxa->setChecked( extensions & GeneralConfig::IgcFxa );
+  m_chkSiu->setChecked( extensions & GeneralConfig::IgcSiu );
+  m_chkTas->setChecked( extensions & GeneralConfig::IgcTas );
+  m_chkVar->setChecked( extensions & GeneralConfig::IgcVar );
   m_kRecordInterval->setValue( conf->getKRecordInterval() );
   m_chkLogAutoStart->setChecked( conf->getLoggerAutostartMode() );
 
@@ -339,6 +388,31 @@ void PreFlightMiscPage::save()
   conf->setQNH(m_edtQNH->value());
   conf->setLDCalculationTime(m_edtLDTime->value());
   conf->setBRecordInterval(m_bRecordInterval->value());
+  conf->setBRecordCirclingInterval(m_bRecordCirclingInterval->value());
+
+  int extensions = 0;
+
+  if( m_chkFxa->isChecked() )
+    {
+      extensions |= GeneralConfig::IgcFxa;
+    }
+
+  if( m_chkSiu->isChecked() )
+    {
+      extensions |= GeneralConfig::IgcSiu;
+    }
+
+  if( m_chkTas->isChecked() )
+    {
+      extensions |= GeneralConfig::IgcTas;
+    }
+
+  if( m_chkVar->isChecked() )
+    {
+      extensions |= GeneralConfig::IgcVar;
+    }
+
+  conf->setIgcExtensions( extensions );
   conf->setKRecordInterval(m_kRecordInterval->value());
 
   if( m_loadedSpeed != m_logAutoStartSpeed->value() )
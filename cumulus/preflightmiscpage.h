@@ -95,6 +95,11 @@ class PreFlightMiscPage : public QWidget
   QCheckBox*          m_chkLogAutoStart;
   QComboBox*          m_edtArrivalAltitude;
   NumberEditor*       m_bRecordInterval; // B-Record logging interval in seconds
+  NumberEditor*       m_bRecordCirclingInterval; // B-Record logging interval in thermals
+  QCheckBox*          m_chkFxa; // B-Record extension fix accuracy
+  QCheckBox*          m_chkSiu; // B-Record extension satellites in use
+  QCheckBox*          m_chkTas; // B-Record extension true airspeed
+  QCheckBox*          m_chkVar; // B-Record extension vario
   NumberEditor*       m_kRecordInterval; // K-Record logging interval in seconds
   DoubleNumberEditor* m_logAutoStartSpeed;
   NumberEditor*       m_edtMinimalArrival;
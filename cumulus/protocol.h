@@ -29,7 +29,7 @@
 
 //------- Used by Command/Response channel -------//
 
-#define MSG_PROTOCOL   "Cumulus-GPS_Client_IPC_V1.5_Axel@kflog.org"
+#define MSG_PROTOCOL   "Cumulus-GPS_Client_IPC_V1.7_Axel@kflog.org"
 
 #define MSG_MAGIC      "\\Magic\\"
 
@@ -55,9 +55,16 @@
 // shutdown request
 #define MSG_SHD	"\\Shutdown\\"
 
-// GPS message keys to be processed.
+// GPS message keys to be processed. All other sentences are dropped by the
+// client. The single key MSG_GPS_KEYS_ALL switches off the filter.
 #define MSG_GPS_KEYS   "\\Gps_Msg_Keys\\"
 
+#define MSG_GPS_KEYS_ALL "*"
+
+// GPS message filter statistics are requested. Answer is
+// "<forwarded> <dropped> <dropped bytes>"
+#define MSG_GPS_FILTER_STATS   "\\Gps_Filter_Stats\\"
+
 // Flarm Flight list is requested
 #define MSG_FLARM_FLIGHT_LIST_REQ   "\\Flarm_Flight_List\\"
 
@@ -72,6 +79,10 @@
 // GPS data message
 #define MSG_GPS_DATA  "#Gps_Data#"
 
+// GPS data message with the reception time of the sentence in microseconds
+// of the monotonic clock: <usecs> <sentence>
+#define MSG_GPS_DATA_TS  "#Gps_Data_Ts#"
+
 // Flarm flight list response
 #define MSG_FLARM_FLIGHT_LIST_RES  "#FFLR#"
 
@@ -28,6 +28,7 @@
  ***********************************************************************/
 
 #include <algorithm>
+#include <climits>
 #include <math.h>
 
 #include <QtCore>
@@ -44,13 +45,28 @@ extern MapContents *_globalMapContents;
 
 // Initialize static members
 int  ReachableList::safetyAlt = 0;
-QMap<QString, int> ReachableList::arrivalAltMap;
-QMap<QString, Distance> ReachableList::distanceMap;
+ReachTable ReachableList::reachTable;
 bool ReachableList::modeAltitude = false;
 
 // Radius of reachables to be taken into account in kilometers
 #define RANGE_RADIUS 100.0;
 
+// Final part of a glide line in meters, which is not checked against the
+// terrain. The site itself is located there.
+#define FINAL_APPROACH 1000.0
+
+// Movement in kilometers, after which the candidate window is moved.
+#define WINDOW_STEP 1.0
+
+// Bearing change in degrees, after which the glide ratio of a site is
+// recalculated.
+#define GLIDE_RATIO_BEARING_STEP 2
+
+// Movement in kilometers and altitude change in meters, after which the
+// glide lines are checked again against the terrain.
+#define TERRAIN_STEP 0.25
+#define TERRAIN_ALTITUDE_STEP 10.0
+
 // number of created class instances
 short ReachableList::instances = 0;
 
@@ -71,7 +87,11 @@ ReachableList::ReachableList(QObject *parent) : QObject(parent)
 
   lastAltitude = 0.0;
   _maxReach = RANGE_RADIUS;
-  tick = 0;
+  lastPolar = 0;
+  lastWater = 0;
+  lastBugs = 0;
+  lastTerrainAltitude = 0.0;
+  poolVersion = 0;
   modeAltitude = false;
   initValuesOK = false;
   calcMode = ReachableList::distance;
@@ -96,63 +116,80 @@ void ReachableList::calculate(bool always)
       return;
     }
 
-  tick++;
-
   QPoint currentPosition = calculator->getlastPosition();
 
-  // Calculate distance to position of last full computed list.
+  // Calculate distance to position of last candidate window.
   // The result has the unit kilometers.
   double dist2Last = MapCalc::dist(&currentPosition, &lastCalculationPosition);
 
-  // qDebug("tick %d %d",tick, always );
-  // The whole list is new computed, if the distance has become
-  // greater than 5km to the last computing point.
-  if ( dist2Last > 5.0 || always )
+  // The candidate window is moved, if the distance has become
+  // greater than the window step to the last window position.
+  if ( dist2Last > WINDOW_STEP || always )
     {
-      // save position where new calculation has been done
+      // save position where the window has been moved
       lastCalculationPosition = currentPosition;
-      calculateNewList();
+      slideWindow( always );
       return;
     }
 
-  if ( (tick %10) == 0 )
-    {
-      // Only update last computed list after 10 ticks,
-      // normally after 10s in GPS mode.
-      calculateDataInList();
-    }
+  // Otherwise only the values of the sites are updated.
+  updateDataInList();
 }
 
-void ReachableList::addItemsToList(enum MapContents::ListID item)
+void ReachableList::addItemsToList( enum MapContents::ListID item,
+                                    const PointIndex& index,
+                                    QHash<qint64, ReachablePoint>& pool )
 {
   Distance distance;
-  QRect bbox = MapCalc::areaBox(lastPosition, _maxReach);
-  int r=0, a=0;
-  //qDebug("bounding box: (%d, %d), (%d, %d) (%d x %d km)", bbox.left(),bbox.top(),bbox.right(),bbox.bottom(),0,0);
 
-  if( item == MapContents::WaypointList )
+  // Ask the spatial index for all points of the list within the maximum
+  // reach.
+  QVector<PointIndex::Hit> hits;
+
+  if ( calcMode == ReachableList::distance && item != MapContents::WaypointList )
     {
-      // Waypoints have different structure treat them here
-      QList<Waypoint> &wpList = _globalMapContents->getWaypointList();
-      // qDebug("Nr of Waypoints: %d", wpList.count() );
+      // Without glider only the nearest sites are listed. All sites of these
+      // lists are candidates, so more sites than the list can take are not
+      // needed.
+      index.nearest( lastPosition, getMaxNrOfSites(), _maxReach,
+                     PointIndex::listBit( item ), hits );
+    }
+  else
+    {
+      index.inRadius( lastPosition, _maxReach, PointIndex::listBit( item ), hits );
+    }
+
+  // The bearing is calculated later for the selected sites only.
+  short bearing = 0;
+  Altitude altitude(0);
+
+  for ( int h=0; h < hits.size(); h++ )
+    {
+      int i = hits.at(h).entry.index;
+      qint64 key = (qint64( item ) << 32) | i;
+
+      distance.setKilometers(hits.at(h).distance);
+
+      // Sites, which are already in the window, are taken over.
+      QHash<qint64, ReachablePoint>::const_iterator it = candidatePool.constFind( key );
+
+      if ( it != candidatePool.constEnd() )
+        {
+          ReachablePoint rp = it.value();
+          rp.setDistance( distance );
+          pool.insert( key, rp );
+          continue;
+        }
 
-      for ( int i=0; i < wpList.count(); i++ )
+      if( item == MapContents::WaypointList )
         {
-          WGSPoint pt = wpList.at(i).wgsPoint;
+          // Waypoints have different structure treat them here
+          QList<Waypoint> &wpList = _globalMapContents->getWaypointList();
 
-          if (! bbox.contains(pt))
+          if( i >= wpList.size() )
             {
-              //qDebug("Not in bounding box, so ignore! (distance: %d, (%d, %d), %s)", (int)distance.getKilometers(), pt.x(),pt.y(), wpList.at(i)->name.latin1());
-              r++;
               continue;
             }
-          else
-            {
-              a++;
-              //qDebug("In bounding box, so accept! (distance: %d, %s)", (int)distance.getKilometers(), wpList.at(i)->name.latin1());
-            }
-
-          distance.setKilometers(MapCalc::dist(&lastPosition, &pt));
 
           bool isLandable = false;
 
@@ -161,154 +198,108 @@ void ReachableList::addItemsToList(enum MapContents::ListID item)
               isLandable = wpList.at(i).rwyList.at(0).m_isOpen;
             }
 
-
           // check if point is a potential reachable candidate at best LD
-          if ( (distance.getKilometers() > _maxReach ) ||
-               ! (isLandable ||
+          if ( ! (isLandable ||
                  (wpList.at(i).type == BaseMapElement::Outlanding) )  )
             {
               continue;
             }
 
-          // calculate bearing
-          double result = MapCalc::getBearing(lastPosition, pt);
-          int bearing = int(rint(result * 180./M_PI));
-          Altitude altitude(0);
-
           ReachablePoint rp( wpList[i],
                              false,
                              distance,
                              bearing,
                              altitude );
 
-          append(rp);
+          pool.insert( key, rp );
+          continue;
         }
-    }
-  else
-    {
-      // get number of elements in the list
-      int nr = _globalMapContents->getListLength(item);
 
-      // qDebug("No of sites: %d type %d", nr, item );
-      for (int i=0; i<nr; i++ )
+      if( i >= (int) _globalMapContents->getListLength(item) )
         {
-          // Get specific site data from current list. We have to distinguish
-          // between AirfieldList, GilderSiteList and OutlandingList.
-          Airfield* site;
-
-          if( item == MapContents::AirfieldList )
-            {
-              // Fetch data from airport list
-              site = _globalMapContents->getAirfield(i);
-            }
-          else if( item == MapContents::GliderfieldList )
-            {
-              // fetch data from glider site list
-              site = _globalMapContents->getGliderfield(i);
-            }
-          else if( item == MapContents::OutLandingList )
-            {
-              // fetch data from glider site list
-              site = _globalMapContents->getOutlanding(i);
-            }
-          else
-            {
-              qWarning( "ReachableList::addItemsToList: ListType %d is unknown",
-                        item );
-              break;
-            }
-
-          QString siteName = site->getWPName();
-          QString siteIcao = site->getICAO();
-          QString siteDescription = site->getName();
-          QString siteCountry = site->getCountry();
-          short siteType = site->getTypeID();
-          float siteFrequency = site->getFrequency();
-          WGSPoint siteWgsPosition = site->getWGSPosition();
-          QPoint sitePosition = site->getPosition();
-          float siteElevation = site->getElevation();
-          QString siteComment = site->getComment();
-          QList<Runway> siteRwyList = site->getRunwayList();
-
-          if (! bbox.contains(siteWgsPosition) )
-            {
-              //qDebug("Not in bounding box, so ignore! (distance: %d, (%d, %d), %s)", (int)distance.getKilometers(), pt.x(),pt.y(), site->getName().latin1());
-              r++;
-              continue;
-            }
-          else
-            {
-              a++;
-              //qDebug("In bounding box, so accept! (distance: %d, %s)", (int)distance.getKilometers(), site->getName().latin1());
-            }
-          distance.setKilometers(MapCalc::dist(&lastPosition,&siteWgsPosition));
-          // qDebug("%d  %f %f", i, (float)distance.getKilometers(),_maxReach );
-          // check if point is a potential reachable candidate at best LD
-          if ( distance.getKilometers() > _maxReach )
-            {
-              continue;
-            }
-
-          // calculate bearing
-          double result = MapCalc::getBearing(lastPosition, siteWgsPosition);
-          short bearing = short(rint(result * 180./M_PI));
-          Altitude altitude(0);
-
-          // add all potential reachable points to the list, altitude is calculated later
-          ReachablePoint rp( siteName,
-                             siteIcao,
-                             siteDescription,
-                             siteCountry,
-                             true,
-                             siteType,
-                             siteFrequency,
-                             siteWgsPosition,
-                             sitePosition,
-                             siteElevation,
-                             siteComment,
-                             distance,
-                             bearing,
-                             altitude,
-                             siteRwyList );
-          append(rp);
-
-          // qDebug("%s(%d) %f %d° %d", rp.getName().toLatin1().data(), rp.getElevation(),  rp.getDistance().getKilometers(), rp.getBearing(), (int)rp->getArrivalAlt().getMeters() );
-
+          continue;
         }
-    }
-  // qDebug("accepted: %d, rejected: %d. Percent reject: %f",a,r,(100.0*r)/(a+r));
-}
 
-QColor ReachableList::getReachColor( const QPoint& position )
-{
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+      // Get specific site data from current list. We have to distinguish
+      // between AirfieldList, GilderSiteList and OutlandingList.
+      Airfield* site;
 
-  if ( arrivalAltMap.contains( ReachableList::coordinateString( position ) ) )
-    {
-      if ( arrivalAltMap[ ReachableList::coordinateString ( position ) ] > safetyAlt )
+      if( item == MapContents::AirfieldList )
         {
-          return( Qt::green );
+          // Fetch data from airport list
+          site = _globalMapContents->getAirfield(i);
         }
-      else if ( arrivalAltMap[ ReachableList::coordinateString ( position ) ] > 0 )
+      else if( item == MapContents::GliderfieldList )
         {
-          return( Qt::magenta );
+          // fetch data from glider site list
+          site = _globalMapContents->getGliderfield(i);
+        }
+      else if( item == MapContents::OutLandingList )
+        {
+          // fetch data from glider site list
+          site = _globalMapContents->getOutlanding(i);
         }
       else
         {
-          return( Qt::red );
+          qWarning( "ReachableList::addItemsToList: ListType %d is unknown",
+                    item );
+          break;
         }
+
+      QString siteName = site->getWPName();
+      QString siteIcao = site->getICAO();
+      QString siteDescription = site->getName();
+      QString siteCountry = site->getCountry();
+      short siteType = site->getTypeID();
+      float siteFrequency = site->getFrequency();
+      WGSPoint siteWgsPosition = site->getWGSPosition();
+      QPoint sitePosition = site->getPosition();
+      float siteElevation = site->getElevation();
+      QString siteComment = site->getComment();
+      QList<Runway> siteRwyList = site->getRunwayList();
+
+      // add all potential reachable points to the pool, altitude is calculated later
+      ReachablePoint rp( siteName,
+                         siteIcao,
+                         siteDescription,
+                         siteCountry,
+                         true,
+                         siteType,
+                         siteFrequency,
+                         siteWgsPosition,
+                         sitePosition,
+                         siteElevation,
+                         siteComment,
+                         distance,
+                         bearing,
+                         altitude,
+                         siteRwyList );
+
+      pool.insert( key, rp );
+    }
+}
+
+QColor ReachableList::getReachColor( const QPoint& position )
+{
+  switch( reachability( reachTable.find( position ) ) )
+    {
+      case ReachablePoint::yes:
+        return( Qt::green );
+      case ReachablePoint::belowSafety:
+        return( Qt::magenta );
+      default:
+        return( Qt::red );
     }
-  return( Qt::red );
 }
 
 
 int ReachableList::getArrivalAlt( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  const ReachTable::Entry* entry = reachTable.find( position );
 
-  if ( arrivalAltMap.contains( coordinateString ( position ) ) )
+  if ( entry != 0 && entry->arrivalAlt != ReachTable::Unset )
     {
-      return( arrivalAltMap[ coordinateString ( position ) ] - safetyAlt );
+      return( entry->arrivalAlt - safetyAlt );
     }
 
   return( -9999 );
@@ -316,11 +307,11 @@ int ReachableList::getArrivalAlt( const QPoint& position )
 
 Altitude ReachableList::getArrivalAltitude( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  const ReachTable::Entry* entry = reachTable.find( position );
 
-  if ( arrivalAltMap.contains( coordinateString ( position ) ) )
+  if ( entry != 0 && entry->arrivalAlt != ReachTable::Unset )
     {
-      return (Altitude( arrivalAltMap[ coordinateString ( position ) ]) - safetyAlt) ;
+      return (Altitude( entry->arrivalAlt ) - safetyAlt) ;
     }
 
   return Altitude(); //return an invalid altitude
@@ -328,11 +319,11 @@ Altitude ReachableList::getArrivalAltitude( const QPoint& position )
 
 Distance ReachableList::getDistance( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  const ReachTable::Entry* entry = reachTable.find( position );
 
-  if ( distanceMap.contains( coordinateString ( position ) ) )
+  if ( entry != 0 )
     {
-      return( distanceMap[ coordinateString ( position ) ] );
+      return( Distance( entry->distance ) );
     }
 
   return Distance();    //return an invalid distance
@@ -340,19 +331,46 @@ Distance ReachableList::getDistance( const QPoint& position )
 
 ReachablePoint::reachable ReachableList::getReachable( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  return reachability( reachTable.find( position ) );
+}
 
-  if ( arrivalAltMap.contains( coordinateString ( position ) ) )
+ReachablePoint::reachable ReachableList::reachability( const ReachTable::Entry* entry )
+{
+  if ( entry == 0 || entry->arrivalAlt == ReachTable::Unset || entry->arrivalAlt <= 0 )
     {
-      if ( arrivalAltMap[ coordinateString ( position ) ] > safetyAlt )
-        return ReachablePoint::yes;
-      else if ( arrivalAltMap[ coordinateString ( position ) ] > 0 )
-        return ReachablePoint::belowSafety;
-      else
-        return ReachablePoint::no;
+      return ReachablePoint::no;
     }
 
-  return ReachablePoint::no;
+  ReachablePoint::reachable result =
+      (entry->arrivalAlt > safetyAlt) ? ReachablePoint::yes : ReachablePoint::belowSafety;
+
+  // The glide line can be blocked by terrain on the way to the site.
+  if ( entry->clearance != ReachTable::Unset )
+    {
+      if ( entry->clearance < 0 )
+        {
+          return ReachablePoint::no;
+        }
+
+      if ( entry->clearance < safetyAlt )
+        {
+          return ReachablePoint::belowSafety;
+        }
+    }
+
+  return result;
+}
+
+Altitude ReachableList::getTerrainClearance( const QPoint& position )
+{
+  const ReachTable::Entry* entry = reachTable.find( position );
+
+  if ( entry != 0 && entry->clearance != ReachTable::Unset )
+    {
+      return Altitude( entry->clearance );
+    }
+
+  return Altitude(); //return an invalid altitude
 }
 
 /**
@@ -365,75 +383,310 @@ void ReachableList::calculateDataInList()
 {
   // QTime t;
   // t.start();
-  int counter = 0;
   setInitValues();
-  arrivalAltMap.clear();
-  distanceMap.clear();
+
+  bool recalc = updateConditions();
 
   for (int i = 0; i < count(); i++)
     {
-      // recalculate Distance
       ReachablePoint& p = (*this)[i];
-      WGSPoint pt = p.getWaypoint()->wgsPoint;
-      Altitude arrivalAlt;
-      Distance distance;
-      Speed bestSpeed;
 
-      distance.setKilometers( MapCalc::dist(&lastPosition, &pt) );
+      p.setTerrainClearance( Altitude() );
+      updateSite( p, recalc );
+    }
+
+  if ( calcMode == ReachableList::altitude &&
+       GeneralConfig::instance()->getNearestSiteTerrainCheck() )
+    {
+      checkTerrainClearance();
+    }
+
+  updateReachTable();
 
-      if ( lastPosition == pt || distance.getMeters() <= 100.0 )
+  // sorting of items depends on the glider selection
+  if ( calculator->glider() )
+    {
+      modeAltitude = true; // glider is known, sort by arrival altitudes
+    }
+  else
+    {
+      modeAltitude = false; // glider is unknown, sort by distances
+    }
+
+  std::stable_sort( begin(), end() );
+  // qDebug("Time for glide path calculation: %d msec", t.restart() );
+  emit newReachList();
+}
+
+void ReachableList::updateDataInList()
+{
+  setInitValues();
+
+  // A changed glider selection changes the sort order of the list.
+  if ( modeAltitude != (calculator->glider() != 0) )
+    {
+      calculateDataInList();
+      return;
+    }
+
+  bool recalc = updateConditions();
+
+  // Save the displayed values, to detect the changed sites.
+  const int n = count();
+
+  QVector<quint64> order( n );
+  QVector<int> reach( n );
+  QVector<int> arrival( n );
+  QVector<int> distance( n );
+  QVector<short> bearing( n );
+
+  for (int i = 0; i < n; i++)
+    {
+      const ReachablePoint& p = at(i);
+
+      order[i]    = WGSPoint::coordinateKey( p.getWaypoint()->wgsPoint );
+      reach[i]    = p.getReachable();
+      arrival[i]  = p.getArrivalAlt().isValid() ? qRound( p.getArrivalAlt().getMeters() ) : INT_MIN;
+      distance[i] = qRound( p.getDistance().getMeters() );
+      bearing[i]  = p.getBearing();
+
+      updateSite( (*this)[i], recalc );
+    }
+
+  if ( calcMode == ReachableList::altitude &&
+       GeneralConfig::instance()->getNearestSiteTerrainCheck() )
+    {
+      // The clearances are kept for small changes of position and altitude.
+      if ( recalc ||
+           MapCalc::dist( &lastPosition, &lastTerrainPosition ) > TERRAIN_STEP ||
+           fabs( lastAltitude - lastTerrainAltitude ) >= TERRAIN_ALTITUDE_STEP )
         {
-          // @AP: there is nearly no difference between the two points,
-          // therefore we have no distance and no bearing
-          distance.setMeters(0.0);
-          p.setDistance( distance );
-          p.setBearing( 0 );
-          p.setArrivalAlt( calculator->getAltitudeCollection().gpsAltitude  );
+          checkTerrainClearance();
         }
-      else
+    }
+  else
+    {
+      for (int i = 0; i < n; i++)
         {
-          p.setDistance( distance );
+          (*this)[i].setTerrainClearance( Altitude() );
+        }
+    }
 
-          // recalculate Bearing
-          p.setBearing( short (rint(MapCalc::getBearingWgs(lastPosition, pt) * 180/M_PI)) );
+  updateReachTable();
 
-          // Calculate glide path. Returns false, if no glider is known.
-          calculator->glidePath( p.getBearing(), p.getDistance(),
-                                 Altitude(p.getElevation()),
-                                 arrivalAlt, bestSpeed );
+  std::stable_sort( begin(), end() );
 
-          // Save arrival altitude. Is set to invalid, if no glider is defined in calculator.
-          p.setArrivalAlt( arrivalAlt );
+  for (int i = 0; i < n; i++)
+    {
+      if ( order.at(i) != WGSPoint::coordinateKey( at(i).getWaypoint()->wgsPoint ) )
+        {
+          // The order has been changed, the list must be refilled.
+          emit newReachList();
+          return;
         }
+    }
+
+  // The map labels show the distance in kilometers and the arrival altitude.
+  // To avoid a redraw at every fix, the altitude is considered in steps.
+  const bool labelInfo = GeneralConfig::instance()->getMapShowLabelsExtraInfo();
+
+  QVector<int> changed;
+  bool mapChanged = false;
+
+  for (int i = 0; i < n; i++)
+    {
+      const ReachablePoint& p = at(i);
+
+      int newArrival  = p.getArrivalAlt().isValid() ? qRound( p.getArrivalAlt().getMeters() ) : INT_MIN;
+      int newDistance = qRound( p.getDistance().getMeters() );
 
-      if ( arrivalAlt.isValid() )
+      // The list view shows the distance with 100m resolution.
+      if ( newArrival == arrival.at(i) &&
+           newDistance / 100 == distance.at(i) / 100 &&
+           p.getBearing() == bearing.at(i) &&
+           p.getReachable() == reach.at(i) )
         {
-          // add only valid altitudes to the map
-          arrivalAltMap[ coordinateString ( pt ) ] = (int) arrivalAlt.getMeters() + safetyAlt;
+          continue;
         }
 
-      distanceMap[ coordinateString ( pt ) ] = distance;
+      changed.append( i );
 
-      if ( arrivalAlt.getMeters() > 0 )
+      if ( p.getReachable() != reach.at(i) )
         {
-          counter++;
+          mapChanged = true;
+        }
+      else if ( labelInfo &&
+                ( newDistance / 1000 != distance.at(i) / 1000 ||
+                  newArrival / 10 != arrival.at(i) / 10 ) )
+        {
+          mapChanged = true;
         }
     }
 
-  // sorting of items depends on the glider selection
-  if ( calculator->glider() )
+  if ( changed.size() > 0 )
     {
-      modeAltitude = true; // glider is known, sort by arrival altitudes
+      emit reachSitesChanged( changed, mapChanged );
     }
-  else
+}
+
+void ReachableList::updateSite( ReachablePoint& p, const bool recalcGlideRatio )
+{
+  WGSPoint pt = p.getWaypoint()->wgsPoint;
+  Distance distance;
+
+  distance.setKilometers( MapCalc::dist(&lastPosition, &pt) );
+
+  if ( lastPosition == pt || distance.getMeters() <= 100.0 )
     {
-      modeAltitude = false; // glider is unknown, sort by distances
+      // @AP: there is nearly no difference between the two points,
+      // therefore we have no distance and no bearing
+      distance.setMeters(0.0);
+      p.setDistance( distance );
+      p.setBearing( 0 );
+      p.setArrivalAlt( calculator->getAltitudeCollection().gpsAltitude  );
+      return;
     }
 
-  std::sort( begin(), end() );
-  // qDebug("Number of reachable sites (arriv >0): %d", counter );
-  // qDebug("Time for glide path calculation: %d msec", t.restart() );
-  emit newReachList();
+  p.setDistance( distance );
+
+  // recalculate Bearing
+  short bearing = short (rint(MapCalc::getBearingWgs(lastPosition, pt) * 180/M_PI));
+  p.setBearing( bearing );
+
+  // The glide ratio over ground depends only on the bearing, as long as
+  // polar, McCready and wind are unchanged.
+  int diff = abs( bearing - p.getGlideRatioBearing() ) % 360;
+
+  if ( recalcGlideRatio || p.getGlideRatio() <= 0.0 ||
+       qMin( diff, 360 - diff ) >= GLIDE_RATIO_BEARING_STEP )
+    {
+      Speed bestSpeed;
+
+      p.setGlideRatio( calculator->glideRatio( bearing, bestSpeed ), bearing );
+    }
+
+  if ( p.getGlideRatio() <= 0.0 )
+    {
+      // No glider is defined in calculator.
+      p.setArrivalAlt( Altitude() );
+      return;
+    }
+
+  // Same calculation as in Calculator::glidePath().
+  p.setArrivalAlt( Altitude( lastAltitude - p.getElevation() - safetyAlt -
+                             distance.getMeters() / p.getGlideRatio() ) );
+}
+
+bool ReachableList::updateConditions()
+{
+  Polar* polar = calculator->getPolar();
+  int water = polar ? polar->water() : 0;
+  int bugs = polar ? polar->bugs() : 0;
+  Speed mc = calculator->getlastMc();
+  Vector wind = calculator->getLastWind();
+
+  bool changed = ( polar != lastPolar || water != lastWater ||
+                   bugs != lastBugs || mc != lastMc || wind != lastWind );
+
+  lastPolar = polar;
+  lastWater = water;
+  lastBugs = bugs;
+  lastMc = mc;
+  lastWind = wind;
+
+  return changed;
+}
+
+void ReachableList::updateReachTable()
+{
+  reachTable.clear();
+  reachTable.reserve( count() );
+
+  for (int i = 0; i < count(); i++)
+    {
+      const ReachablePoint& p = at(i);
+
+      ReachTable::Entry& entry = reachTable.insert( p.getWaypoint()->wgsPoint );
+
+      if ( p.getArrivalAlt().isValid() )
+        {
+          // add only valid altitudes to the table
+          entry.arrivalAlt = (int) p.getArrivalAlt().getMeters() + safetyAlt;
+        }
+
+      if ( p.getTerrainClearance().isValid() )
+        {
+          entry.clearance = (int) p.getTerrainClearance().getMeters();
+        }
+
+      entry.distance = p.getDistance().getMeters();
+    }
+}
+
+void ReachableList::checkTerrainClearance()
+{
+  lastTerrainPosition = lastPosition;
+  lastTerrainAltitude = lastAltitude;
+
+  for (int i = 0; i < count(); i++)
+    {
+      (*this)[i].setTerrainClearance( Altitude() );
+    }
+
+  if ( ! elevationGrid.update( lastPosition, _maxReach ) )
+    {
+      // No terrain data available.
+      return;
+    }
+
+  extern MapMatrix* _globalMapMatrix;
+
+  QPoint start = _globalMapMatrix->wgsToMap( lastPosition );
+
+  // Collect the glide lines of all sites in one batch.
+  QVector<ElevationGrid::GlideLine> lines;
+  QVector<int> indices;
+  QVector<int> clearances;
+
+  lines.reserve( count() );
+  indices.reserve( count() );
+
+  for (int i = 0; i < count(); i++)
+    {
+      const ReachablePoint& p = at(i);
+
+      double dist = p.getDistance().getMeters();
+
+      if ( ! p.getArrivalAlt().isValid() || dist <= FINAL_APPROACH )
+        {
+          continue;
+        }
+
+      ElevationGrid::GlideLine line;
+
+      line.start    = start;
+      line.end      = p.getWaypoint()->projPoint;
+      line.startAlt = lastAltitude;
+
+      // The arrival altitude is reduced by the safety altitude.
+      line.endAlt   = p.getElevation() + safetyAlt + p.getArrivalAlt().getMeters();
+      line.skip     = FINAL_APPROACH / dist;
+
+      lines.append( line );
+      indices.append( i );
+    }
+
+  elevationGrid.minClearances( lines, clearances );
+
+  for (int i = 0; i < indices.size(); i++)
+    {
+      if ( clearances.at(i) == ElevationGrid::NoTerrain )
+        {
+          continue;
+        }
+
+      (*this)[indices.at(i)].setTerrainClearance( Altitude( clearances.at(i) ) );
+    }
 }
 
 void ReachableList::setInitValues()
@@ -441,6 +694,7 @@ void ReachableList::setInitValues()
   // This info we do need from the calculator
   lastPosition = calculator->getlastPosition();
   lastAltitude = calculator->getlastAltitude().getMeters();
+  safetyAlt = (int) GeneralConfig::instance()->getSafetyAltitude().getMeters();
   _maxReach = RANGE_RADIUS; // default range radius
   Polar* polar = calculator->getPolar();
   calcMode = ReachableList::altitude;
@@ -474,36 +728,115 @@ void ReachableList::calculateNewList()
       return;
     }
 
+  // All sites are created newly.
+  candidatePool.clear();
+  lastCalculationPosition = calculator->getlastPosition();
+  slideWindow( true );
+}
+
+/** Orders the sites by descending distance like the distance mode does. */
+static bool farthestFirst( const ReachablePoint& a, const ReachablePoint& b )
+{
+  return a.getDistance().getMeters() > b.getDistance().getMeters();
+}
+
+void ReachableList::slideWindow( const bool force )
+{
   // QTime t; // timer for performance measurement
   // t.start();
 
   setInitValues();
-  clearLists();  // clear all lists
 
-  // Now add items of different type to the list
-  addItemsToList(MapContents::AirfieldList);
-  addItemsToList(MapContents::GliderfieldList);
-  addItemsToList(MapContents::OutLandingList);
-  addItemsToList(MapContents::WaypointList);
-  modeAltitude = false;
-  //qDebug("Number of potential reachable sites: %d", count() );
+  const PointIndex& index = _globalMapContents->getPointIndex();
 
-  // sort list according to distances
-  std::sort(begin(), end() );
-  removeDoubles();
-  // qDebug("Number of potential reachable sites (after pruning): %d", count() );
+  // The pool keys are list indices, which are only valid for one index build.
+  if ( poolVersion != _globalMapContents->getPointIndexVersion() )
+    {
+      candidatePool.clear();
+      poolVersion = _globalMapContents->getPointIndexVersion();
+    }
+
+  // Now add items of different type to the new window. Sites leaving the
+  // window are dropped with the old pool.
+  QHash<qint64, ReachablePoint> pool;
+
+  addItemsToList( MapContents::AirfieldList, index, pool );
+  addItemsToList( MapContents::GliderfieldList, index, pool );
+  addItemsToList( MapContents::OutLandingList, index, pool );
+  addItemsToList( MapContents::WaypointList, index, pool );
+  candidatePool = pool;
+  //qDebug("Number of potential reachable sites: %d", candidatePool.size() );
+
+  // sort sites according to distances
+  QList<ReachablePoint> sites = candidatePool.values();
+  std::sort( sites.begin(), sites.end(), farthestFirst );
+  removeDoubles( sites );
 
   // Remove all elements over the maximum. That are the far away elements.
   int nr = getMaxNrOfSites();
 
-  while ( nr < size() )
+  while ( nr < sites.size() )
+    {
+      sites.removeFirst();
+    }
+
+  // Check, if the nearest sites are the same as before.
+  bool changed = force || sites.size() != size();
+
+  if ( ! changed )
+    {
+      QSet<quint64> keys;
+
+      for (int i = 0; i < count(); i++)
+        {
+          keys.insert( WGSPoint::coordinateKey( at(i).getWaypoint()->wgsPoint ) );
+        }
+
+      for (int i = 0; i < sites.size(); i++)
+        {
+          if ( ! keys.contains( WGSPoint::coordinateKey( sites.at(i).getWaypoint()->wgsPoint ) ) )
+            {
+              changed = true;
+              break;
+            }
+        }
+    }
+
+  if ( ! changed )
     {
-      removeFirst();
+      updateDataInList();
+      return;
     }
 
+  // Take over the glide ratios of the sites, which stay in the list.
+  QHash<quint64, QPair<double, short> > ratios;
+
+  for (int i = 0; i < count(); i++)
+    {
+      const ReachablePoint& p = at(i);
+
+      ratios.insert( WGSPoint::coordinateKey( p.getWaypoint()->wgsPoint ),
+                     qMakePair( p.getGlideRatio(), p.getGlideRatioBearing() ) );
+    }
+
+  for (int i = 0; i < sites.size(); i++)
+    {
+      ReachablePoint& p = sites[i];
+
+      QHash<quint64, QPair<double, short> >::const_iterator it =
+          ratios.constFind( WGSPoint::coordinateKey( p.getWaypoint()->wgsPoint ) );
+
+      if ( it != ratios.constEnd() )
+        {
+          p.setGlideRatio( it.value().first, it.value().second );
+        }
+    }
+
+  QList<ReachablePoint>::operator=( sites );
+
   // qDebug("Limited Number of potential reachable sites: %d", count() );
   calculateDataInList();
-  //qDebug("Time for full calculation: %d msec", t.restart() );
+  //qDebug("Time for window calculation: %d msec", t.restart() );
 }
 
 // prints list to qDebug interface
@@ -522,106 +855,81 @@ void ReachableList::show()
     }
 }
 
+/**
+ * Returns true, if the later one of two sites at the same position shall be
+ * removed, otherwise the earlier one.
+ */
+bool ReachableList::isLaterDouble( const ReachablePoint& p2,
+                                   const ReachablePoint& p1 )
+{
+  if ( p2.getWaypoint()->priority != p1.getWaypoint()->priority )
+    {
+      // the waypoint with the lower priority will be removed
+      return ( p2.getWaypoint()->priority > p1.getWaypoint()->priority );
+    }
+
+  if ( p2.getWaypoint()->name == p1.getWaypoint()->name )
+    {
+      // both name are identical. remove the one which has not set
+      // the airfield origin flag. If both origin flags are set, the
+      // earlier one is removed.
+      return ( ! p1.isOrignAfl() );
+    }
+
+  if ( p2.getWaypoint()->name.length() == p1.getWaypoint()->name.length() )
+    {
+      // the lengths of the names are the same
+      // remove the one with the lowest alphabetical value
+      // (remember that A<a)
+      return ( p2.getWaypoint()->name > p1.getWaypoint()->name );
+    }
+
+  // if the names are not of equal length, remove the shortest.
+  return ( p2.getWaypoint()->name.length() > p1.getWaypoint()->name.length() );
+}
+
 /**
  * Removes double entries from the list. Double entries can occur
  * when a point is a waypoint as well as an airfield. In this case,
  * the one with the higher severity or longer name is preferred.
- * This function ASSUMES THE LIST IS SORTED!
  */
-void ReachableList::removeDoubles()
+void ReachableList::removeDoubles( QList<ReachablePoint>& list )
 {
-  QList<int> removeList;
+  // The sites are looked up by their positions, the kept site of every
+  // position is stored.
+  QHash<quint64, int> kept;
+  QVector<bool> remove( list.size(), false );
 
-  for (int i=count()-1; i>=1; i--)
+  for (int i = 0; i < list.size(); i++)
     {
-      const ReachablePoint& p1 = at(i);
+      quint64 key = WGSPoint::coordinateKey( list.at(i).getWaypoint()->wgsPoint );
 
-      for (int j=0; j<i; j++)
-        {
-          const ReachablePoint& p2 = at(j);
+      QHash<quint64, int>::iterator it = kept.find( key );
 
-          //qDebug("i=%d j=%d, P1=%s, P2=%s,", i, j, p1.getWaypoint()->name.toLatin1().data(), p2.getWaypoint()->name.toLatin1().data());
-
-          if ( p2.getWaypoint()->wgsPoint == p1.getWaypoint()->wgsPoint )
-            {
-              //qDebug("  points are the same");
-              // ok, the points are the same. Now we choose which one to remove
-
-              if ( p2.getWaypoint()->priority != p1.getWaypoint()->priority )
-                {
-                  // the waypoint with the lower priority will be removed
-                  if ( p2.getWaypoint()->priority > p1.getWaypoint()->priority )
-                    {
-                      removeList.append(i);
-                    }
-                  else
-                    {
-                      removeList.append(j);
-                    }
-                  continue;
-                }
-
-              if ( p2.getWaypoint()->name == p1.getWaypoint()->name )
-                {
-                  // both name are identical. remove the one which has not set
-                  // the airfield origin flag.
-                  if( ! p1.isOrignAfl() )
-                     {
-                       removeList.append(i);
-                       continue;
-                     }
-
-                  if( ! p2.isOrignAfl() )
-                     {
-                       removeList.append(j);
-                       continue;
-                     }
-
-                  // both origin flags are set, remove one of the objects
-                  removeList.append(j);
-                  continue;
-                }
-
-              if ( p2.getWaypoint()->name.length() == p1.getWaypoint()->name.length() )
-                {
-                  // the lengths of the names are the same
-                  // remove the one with the lowest alphabetical value
-                  // (remember that A<a)
-                  if (p2.getWaypoint()->name > p1.getWaypoint()->name)
-                    {
-                      removeList.append(i);
-                    }
-                  else
-                    {
-                      removeList.append(j);
-                    }
-                  continue;
-                }
-
-              // if the names are not of equal length, remove the shortest.
-              if ( p2.getWaypoint()->name.length() > p1.getWaypoint()->name.length() )
-                {
-                  removeList.append(i);
-                }
-              else
-                {
-                  removeList.append(j);
-                }
-              continue;
-            }
-
-          // qDebug("  points are NOT the same: (%d, %d) vs (%d, %d)",p1.getWaypoint()->origP.x(),p1.getWaypoint()->origP.y(),p2.getWaypoint()->origP.x(),p2.getWaypoint()->origP.y());
-        } // End of for j
-    } // End of for i
+      if ( it == kept.end() )
+        {
+          kept.insert( key, i );
+          continue;
+        }
 
-  // sort remove list
-  std::sort( removeList.begin(), removeList.end(), qLess<int>() );
+      if ( isLaterDouble( list.at( it.value() ), list.at(i) ) )
+        {
+          remove[i] = true;
+        }
+      else
+        {
+          remove[it.value()] = true;
+          it.value() = i;
+        }
+    }
 
   // Start remove at the end of the list so that access index is always valid.
-  for (int i = removeList.count()-1; i >= 0; i--)
+  for (int i = list.size() - 1; i >= 0; i--)
     {
-      // qDebug("Removing point %d (%s)", removeList.at(i), at(removeList.at(i)).getWaypoint()->name.toLatin1().data());
-      // remove doubles from global list
-      removeAt( removeList.at(i) );
+      if ( remove.at(i) )
+        {
+          // qDebug("Removing point %d (%s)", i, list.at(i).getWaypoint()->name.toLatin1().data());
+          list.removeAt( i );
+        }
     }
 }
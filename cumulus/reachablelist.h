@@ -41,7 +41,9 @@
 #include <QObject>
 #include <QPoint>
 #include <QList>
+#include <QHash>
 #include <QMap>
+#include <QVector>
 
 #include "generalconfig.h"
 #include "mapmatrix.h"
@@ -51,6 +53,10 @@
 #include "vector.h"
 #include "speed.h"
 #include "reachablepoint.h"
+#include "elevationgrid.h"
+#include "reachtable.h"
+
+class Polar;
 
 class ReachableList : public QObject, QList<ReachablePoint>
 {
@@ -73,8 +79,21 @@ class ReachableList : public QObject, QList<ReachablePoint>
 
  signals:
 
+  /**
+   * Emitted, if the sites of the list or their order have been changed.
+   */
   void newReachList();
 
+  /**
+   * Emitted, if only the values of some sites have been changed. The sites
+   * and their order in the list are unchanged.
+   *
+   * \param sites List indices of the changed sites.
+   *
+   * \param mapChanged True, if a change is visible on the map.
+   */
+  void reachSitesChanged( const QVector<int>& sites, bool mapChanged );
+
  public:
 
   /**
@@ -87,7 +106,9 @@ class ReachableList : public QObject, QList<ReachablePoint>
   };
 
   /**
-   * calculates scheduled glide path and full list
+   * Updates the list after a position change. The candidate window is moved
+   * after some distance, otherwise only the changed values are updated.
+   * If always is set, a full update is made.
    */
   void calculate(bool always);
 
@@ -143,8 +164,7 @@ class ReachableList : public QObject, QList<ReachablePoint>
   void clearLists()
   {
     clear();
-    arrivalAltMap.clear();
-    distanceMap.clear();
+    reachTable.clear();
   };
 
   /**
@@ -177,6 +197,13 @@ class ReachableList : public QObject, QList<ReachablePoint>
    */
   static Distance getDistance( const QPoint& position );
 
+  /**
+   * @returns an Altitude object with the minimum clearance of the glide line
+   * above the terrain. If the point is not found or the terrain was not
+   * checked, an invalid Altitude is returned
+   */
+  static Altitude getTerrainClearance( const QPoint& position );
+
   /**
    * @returns The safety altitude in meters
    */
@@ -203,15 +230,61 @@ class ReachableList : public QObject, QList<ReachablePoint>
     */
   void calculateDataInList();
 
+  /**
+   * Updates the elements of the list after a position or altitude change.
+   * The glide ratios are only recalculated, if the bearing of a site or the
+   * glide conditions have been changed.
+   */
+  void updateDataInList();
+
+  /**
+   * Updates distance, bearing and arrival altitude of a site. The stored
+   * glide ratio of the site is used, if it is still valid.
+   */
+  void updateSite( ReachablePoint& p, const bool recalcGlideRatio );
+
+  /**
+   * Stores the current glide conditions. Returns true, if McCready, wind,
+   * polar, water or bugs have been changed since the last call.
+   */
+  bool updateConditions();
+
+  /**
+   * Fills the reach table from the list elements.
+   */
+  void updateReachTable();
+
+  /**
+   * Moves the candidate window to the current position. Only sites, which
+   * have entered the window, are created newly. If the nearest sites are
+   * the same as before, only the values are updated.
+   */
+  void slideWindow( const bool force );
+
+  /**
+   * Checks the glide lines to all sites with a valid arrival altitude
+   * against the terrain and stores the minimum clearances.
+   */
+  void checkTerrainClearance();
+
+  /**
+   * Returns the reachability of the passed site results, derived from the
+   * arrival altitude and the terrain clearance.
+   */
+  static ReachablePoint::reachable reachability( const ReachTable::Entry* entry );
+
   /**
    * Sets the initial values needed for the calculation.
    */
   void setInitValues();
 
   /**
-   * adds glider, airport or waypoint site (if not out of reach) to the list
+   * adds glider, airport or waypoint site (if not out of reach) to the
+   * passed candidate pool. Sites of the current pool are taken over.
    */
-  void addItemsToList(enum MapContents::ListID item);
+  void addItemsToList( enum MapContents::ListID item,
+                       const PointIndex& index,
+                       QHash<qint64, ReachablePoint>& pool );
 
   /**
    * print list via qDebug interface
@@ -222,14 +295,15 @@ class ReachableList : public QObject, QList<ReachablePoint>
    * Removes double entries from the list. Double entries can occur
    * when a point is a waypoint as well as an airfield. In this case,
    * the one with the higher severity or longer name is preferred.
-   * This function ASSUMES THE LIST IS SORTED!
    */
-  void removeDoubles();
+  static void removeDoubles( QList<ReachablePoint>& list );
 
-  static QString coordinateString(const QPoint& position)
-  {
-    return QString("%1.%2").arg(position.x()).arg(position.y());
-  };
+  /**
+   * Returns true, if the later one of two sites at the same position
+   * shall be removed, otherwise the earlier one.
+   */
+  static bool isLaterDouble( const ReachablePoint& earlier,
+                             const ReachablePoint& later );
 
   QPoint      lastCalculationPosition; // position at last calculation
   QPoint      lastPosition;
@@ -237,17 +311,34 @@ class ReachableList : public QObject, QList<ReachablePoint>
   Vector      lastWind;
   Speed       lastMc;
   double      _maxReach;
-  int         tick;
   bool        initValuesOK;
 
+  // Glide conditions of the last calculation
+  Polar*      lastPolar;
+  int         lastWater;
+  int         lastBugs;
+
+  // Position and altitude of the last terrain check
+  QPoint      lastTerrainPosition;
+  double      lastTerrainAltitude;
+
+  // All sites in the candidate window, keyed by list identifier and index
+  QHash<qint64, ReachablePoint> candidatePool;
+
+  // Version of the point index used for the candidate pool
+  uint        poolVersion;
+
   // Used mode for calculation of list. Can be altitude or distance.
   enum ReachableList::CalculationMode calcMode;
 
   static bool modeAltitude;
   static int safetyAlt;
 
-  static QMap<QString, int> arrivalAltMap;
-  static QMap<QString, Distance> distanceMap;
+  // Reach results of all sites in the list, keyed by their positions
+  static ReachTable reachTable;
+
+  // Terrain raster used for the clearance check of the glide lines
+  ElevationGrid elevationGrid;
 
   // number of created class instances
   static short instances;
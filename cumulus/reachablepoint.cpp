@@ -53,6 +53,9 @@ ReachablePoint::ReachablePoint( QString name,
   _distance   = distance;
   _arrivalAlt = arrivAlt;
   _bearing    = bearing;
+
+  _glideRatio        = 0.0;
+  _glideRatioBearing = 0;
 };
 
 // Construction from another WP
@@ -67,32 +70,62 @@ ReachablePoint::ReachablePoint(Waypoint& wp,
   _distance   = distance;
   _arrivalAlt = arrivAlt;
   _bearing    = bearing;
+
+  _glideRatio        = 0.0;
+  _glideRatioBearing = 0;
 };
 
 ReachablePoint::~ReachablePoint()
 {
 }
 
-ReachablePoint::reachable ReachablePoint::getReachable()
+ReachablePoint::reachable ReachablePoint::getReachable() const
 {
+  ReachablePoint::reachable result;
+
   if ( _arrivalAlt.isValid() && _arrivalAlt.getMeters() > 0 )
     {
-      return ReachablePoint::yes;
+      result = ReachablePoint::yes;
     }
   else if ( _arrivalAlt.isValid() && _arrivalAlt.getMeters() > -ReachableList::getSafetyAltititude() )
     {
-      return ReachablePoint::belowSafety;
+      result = ReachablePoint::belowSafety;
     }
   else
     {
       return ReachablePoint::no;
     }
+
+  // The glide line can be blocked by terrain on the way to the site.
+  if ( _terrainClearance.isValid() )
+    {
+      if ( _terrainClearance.getMeters() < 0 )
+        {
+          return ReachablePoint::no;
+        }
+
+      if ( _terrainClearance.getMeters() < ReachableList::getSafetyAltititude() )
+        {
+          return ReachablePoint::belowSafety;
+        }
+    }
+
+  return result;
 }
 
 bool ReachablePoint::operator < (const ReachablePoint& other) const
 {
   if ( ReachableList::getModeAltitude() )
     {
+      reachable r1 = getReachable();
+      reachable r2 = other.getReachable();
+
+      // Sites blocked by terrain are ranked below the unblocked ones.
+      if ( r1 != r2 )
+        {
+          return r1 < r2;
+        }
+
       return (_arrivalAlt.getMeters() < other._arrivalAlt.getMeters());
     }
   else
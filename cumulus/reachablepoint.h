@@ -174,7 +174,48 @@ class ReachablePoint
     _arrivalAlt = alt;
   };
 
-  reachable getReachable();
+  /**
+   * Returns the minimum clearance of the glide line above the terrain. Is
+   * invalid, if the terrain was not checked.
+   */
+  Altitude getTerrainClearance() const
+  {
+    return _terrainClearance;
+  };
+
+  void setTerrainClearance( const Altitude& clearance )
+  {
+    _terrainClearance = clearance;
+  };
+
+  /**
+   * Returns the glide ratio over ground used for the arrival altitude. Is
+   * 0.0, if no glide ratio was calculated.
+   */
+  double getGlideRatio() const
+  {
+    return _glideRatio;
+  };
+
+  /**
+   * Returns the bearing, for which the glide ratio was calculated.
+   */
+  short getGlideRatioBearing() const
+  {
+    return _glideRatioBearing;
+  };
+
+  void setGlideRatio( const double ld, const short bearing )
+  {
+    _glideRatio = ld;
+    _glideRatioBearing = bearing;
+  };
+
+  /**
+   * Returns the reachability derived from the arrival altitude and the
+   * terrain clearance of the glide line.
+   */
+  reachable getReachable() const;
 
   /**
    * compares two entries to sort list either by distance or arrival altitude
@@ -188,6 +229,9 @@ class ReachablePoint
   Distance     _distance;
   short        _bearing;
   Altitude     _arrivalAlt;
+  Altitude     _terrainClearance;
+  double       _glideRatio;
+  short        _glideRatioBearing;
 };
 
 #endif /* REACHABLE_POINT_H */
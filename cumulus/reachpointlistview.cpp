@@ -187,8 +187,6 @@ void ReachpointListView::fillRpList()
       return;
     }
 
-  int safetyAlt = (int) GeneralConfig::instance()->getSafetyAltitude().getMeters();
-
   // Save the vertical scrollbar position. It returns the number of hidden rows.
   int vvalue = list->verticalScrollBar()->value();
 
@@ -226,6 +224,7 @@ void ReachpointListView::fillRpList()
 
   list->setUpdatesEnabled(false);
   list->clear();
+  m_siteItems.clear();
 
   // Create a pointer to the list of nearest sites
   QList<ReachablePoint> *pl = calculator->getReachList()->getList();
@@ -245,39 +244,6 @@ void ReachpointListView::fillRpList()
           continue;
         }
 
-      // Setup string for bearing
-      QString bearing = QString("%1%2").arg( rp.getBearing() ).arg( QString(Qt::Key_degree) );
-
-      // Calculate relative bearing too, very cool feature
-      int relbearing = rp.getBearing() - calculator->getlastHeading();
-
-      while (relbearing < 0)
-        {
-          relbearing += 360;
-        }
-
-      // Show arrival altitude or estimated time of arrival. It depends on
-      // the glider selection.
-      QString arrival = "---";
-
-      if ( rp.getArrivalAlt().isValid() )
-        {
-          // there is a valid altitude defined
-          arrival = rp.getArrivalAlt().getText( true, 0);
-        }
-      else if ( calculator->getLastSpeed().getMps() > 0.5 )
-        {
-          // Check, if we are moving. In this case the ETA to the target is displayed.
-          // Moving is required to avoid division by zero!
-          int eta = (int) rint(rp.getDistance().getMeters() / calculator->getLastSpeed().getMps());
-
-          if ( eta < 100*3600 )
-            {
-              // display only eta if less than 100 hours
-              arrival = QString("%1:%2").arg( eta/3600 ).arg( (eta%3600)/60, 2, 10, QChar('0') );
-            }
-        }
-
       // calculate sunset
       QString sr, ss, tz;
       QDate date = QDate::currentDate();
@@ -308,9 +274,9 @@ void ReachpointListView::fillRpList()
       QStringList sl;
       sl << rp.getName()
          << frequency
-         << rp.getDistance().getText(false,1)
-         << bearing
-         << arrival
+         << ""
+         << ""
+         << ""
          << rLen
          <<  " " + ss + " " + tz
          << key;
@@ -325,79 +291,16 @@ void ReachpointListView::fillRpList()
       li->setTextAlignment( 6, Qt::AlignLeft|Qt::AlignVCenter );
 
       list->addTopLevelItem( li );
+      m_siteItems.insert( i, li );
 
-      QColor iconColor;
-
-      if ( rp.getReachable() == ReachablePoint::yes )
-        {
-          iconColor = QColor(0, 255, 0);
-        }
-      else if ( rp.getReachable() == ReachablePoint::belowSafety )
-        {
-          iconColor = QColor(255, 0, 255);
-        }
-      else
-        {
-          iconColor = Qt::transparent;
-        }
-
-      // create landing site type icon
-      QPixmap sitePm = _globalMapConfig->getPixmap(rp.getType(), false);
-      QPixmap icon( sitePm.size() + QSize(1, 1) );
-      icon.fill( iconColor );
-
-      QPainter painter;
-      painter.begin(&icon);
-      painter.drawPixmap( 1, 1, sitePm );
-      painter.end();
-
-      QIcon qi;
-      qi.addPixmap( icon );
-      li->setIcon( 0, qi );
-
-      QPixmap directionPm;
-
-      QPen pen(Qt::black);
-      pen.setWidth(0);
-
-      // Draw a triangle pointing into direction of landing site
-      MapConfig::createTriangle( directionPm,
-                                 iconSize,
-                                 Qt::black,
-                                 relbearing,
-                                 1.0,
-                                 Qt::transparent,
-                                 pen );
-
-      li->setIcon( 3, directionPm );
+      // set the values, which change with the position
+      setItemValues( li, rp );
 
       // store name of last selected to avoid jump to first element on each fill
       if ( rp.getName() == sname )
         {
           selectedItem = li;
         }
-
-      QColor c;
-      // list safely reachable sites in green
-      if ( rp.getArrivalAlt().isValid() && rp.getArrivalAlt().getMeters() > 0 )
-        {
-          c = QColor(Qt::darkGreen);
-        }
-      // list narrowly reachable sites in magenta
-      else if (rp.getArrivalAlt().isValid() && rp.getArrivalAlt().getMeters() > -safetyAlt)
-        {
-          c = QColor(Qt::darkMagenta);
-        }
-      // list other near sites in black
-      else
-        {
-          c = QColor(Qt::black);
-        }
-
-      for (int i=0; i < li->columnCount(); i++)
-        {
-          li->setForeground(i, QBrush(c));
-        }
     }
 
   // sort list
@@ -438,6 +341,116 @@ void ReachpointListView::fillRpList()
   list->setUpdatesEnabled(true);
 }
 
+/** Sets the values of an item, which change with the position. */
+void ReachpointListView::setItemValues( QTreeWidgetItem* li, const ReachablePoint& rp )
+{
+  int iconSize = list->iconSize().width();
+
+  // Setup string for bearing
+  QString bearing = QString("%1%2").arg( rp.getBearing() ).arg( QString(Qt::Key_degree) );
+
+  // Calculate relative bearing too, very cool feature
+  int relbearing = rp.getBearing() - calculator->getlastHeading();
+
+  while (relbearing < 0)
+    {
+      relbearing += 360;
+    }
+
+  // Show arrival altitude or estimated time of arrival. It depends on
+  // the glider selection.
+  QString arrival = "---";
+
+  if ( rp.getArrivalAlt().isValid() )
+    {
+      // there is a valid altitude defined
+      arrival = rp.getArrivalAlt().getText( true, 0);
+    }
+  else if ( calculator->getLastSpeed().getMps() > 0.5 )
+    {
+      // Check, if we are moving. In this case the ETA to the target is displayed.
+      // Moving is required to avoid division by zero!
+      int eta = (int) rint(rp.getDistance().getMeters() / calculator->getLastSpeed().getMps());
+
+      if ( eta < 100*3600 )
+        {
+          // display only eta if less than 100 hours
+          arrival = QString("%1:%2").arg( eta/3600 ).arg( (eta%3600)/60, 2, 10, QChar('0') );
+        }
+    }
+
+  li->setText( 2, rp.getDistance().getText(false,1) );
+  li->setText( 3, bearing );
+  li->setText( 4, arrival );
+
+  QColor iconColor;
+
+  if ( rp.getReachable() == ReachablePoint::yes )
+    {
+      iconColor = QColor(0, 255, 0);
+    }
+  else if ( rp.getReachable() == ReachablePoint::belowSafety )
+    {
+      iconColor = QColor(255, 0, 255);
+    }
+  else
+    {
+      iconColor = Qt::transparent;
+    }
+
+  // create landing site type icon
+  QPixmap sitePm = _globalMapConfig->getPixmap(rp.getType(), false);
+  QPixmap icon( sitePm.size() + QSize(1, 1) );
+  icon.fill( iconColor );
+
+  QPainter painter;
+  painter.begin(&icon);
+  painter.drawPixmap( 1, 1, sitePm );
+  painter.end();
+
+  QIcon qi;
+  qi.addPixmap( icon );
+  li->setIcon( 0, qi );
+
+  QPixmap directionPm;
+
+  QPen pen(Qt::black);
+  pen.setWidth(0);
+
+  // Draw a triangle pointing into direction of landing site
+  MapConfig::createTriangle( directionPm,
+                             iconSize,
+                             Qt::black,
+                             relbearing,
+                             1.0,
+                             Qt::transparent,
+                             pen );
+
+  li->setIcon( 3, directionPm );
+
+  QColor c;
+  // list safely reachable sites in green
+  if ( rp.getReachable() == ReachablePoint::yes )
+    {
+      c = QColor(Qt::darkGreen);
+    }
+  // list narrowly reachable sites in magenta
+  else if ( rp.getReachable() == ReachablePoint::belowSafety )
+    {
+      c = QColor(Qt::darkMagenta);
+    }
+  // list other near sites in black
+  else
+    {
+      c = QColor(Qt::black);
+    }
+
+  for (int i=0; i < li->columnCount(); i++)
+    {
+      li->setForeground(i, QBrush(c));
+    }
+}
+
 void ReachpointListView::showEvent(QShowEvent *)
 {
   // clear an old selection
@@ -601,6 +614,40 @@ void ReachpointListView::slot_newList()
     }
 }
 
+void ReachpointListView::slot_updateSites( const QVector<int>& sites )
+{
+  if ( ! this->isVisible() || _newList )
+    {
+      // The list is filled completely, when it is shown the next time.
+      _newList = true;
+      return;
+    }
+
+  if ( calculator == static_cast<Calculator *>(0) )
+    {
+      return;
+    }
+
+  QList<ReachablePoint> *pl = calculator->getReachList()->getList();
+
+  list->setUpdatesEnabled(false);
+
+  for (int i = 0; i < sites.size(); i++)
+    {
+      QTreeWidgetItem* li = m_siteItems.value( sites.at(i), 0 );
+
+      // Hidden sites have no item.
+      if ( li != 0 && sites.at(i) < pl->size() )
+        {
+          setItemValues( li, pl->at( sites.at(i) ) );
+        }
+    }
+
+  list->resizeColumnToContents(2);
+  list->resizeColumnToContents(4);
+  list->setUpdatesEnabled(true);
+}
+
 /** Called to set a new home position. The change of the home position can trigger
  *  a reload of many map data, if option projection follows home is active.
  */
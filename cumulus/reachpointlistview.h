@@ -33,6 +33,8 @@
 
 #include <QWidget>
 #include <QTreeWidget>
+#include <QHash>
+#include <QVector>
 #include <QPixmap>
 #include <QBoxLayout>
 #include <QPushButton>
@@ -43,6 +45,7 @@
 
 class MainWindow;
 class QCheckBox;
+class ReachablePoint;
 
 class ReachpointListView : public QWidget
 {
@@ -115,6 +118,14 @@ public slots:
    */
   void slot_newList ();
 
+  /**
+   * This slot is called when only the values of some reachable points have
+   * been changed. The rows of these points are updated in place.
+   *
+   * \param sites Indices of the changed points in the reachable list.
+   */
+  void slot_updateSites( const QVector<int>& sites );
+
 private slots:
 
   /**
@@ -167,8 +178,16 @@ signals:
 
 private:
 
+  /**
+   * Sets the values of a list item, which change with the position.
+   */
+  void setItemValues( QTreeWidgetItem* li, const ReachablePoint& rp );
+
   QTreeWidget* list;
 
+  /** List items of the reachable points, keyed by their list indices. */
+  QHash<int, QTreeWidgetItem*> m_siteItems;
+
   /** that stores a home position change */
   bool _homeChanged;
   bool _newList;
@@ -0,0 +1,151 @@
+/***********************************************************************
+**
+**   reachtable.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include "reachtable.h"
+#include "wgspoint.h"
+
+// Minimum number of slots.
+#define MIN_CAPACITY 64
+
+ReachTable::ReachTable() :
+  m_size(0)
+{
+}
+
+ReachTable::~ReachTable()
+{
+}
+
+void ReachTable::clear()
+{
+  m_used.fill( false );
+  m_size = 0;
+}
+
+void ReachTable::reserve( const int size )
+{
+  // The load factor is kept at or below one half.
+  int capacity = MIN_CAPACITY;
+
+  while( capacity < 2 * size )
+    {
+      capacity *= 2;
+    }
+
+  if( capacity > m_keys.size() )
+    {
+      rehash( capacity );
+    }
+}
+
+int ReachTable::slot( const quint64 key ) const
+{
+  // Mix the bits of latitude and longitude, to spread adjacent positions.
+  quint64 hash = key * Q_UINT64_C(0x9E3779B97F4A7C15);
+
+  return static_cast<int> (hash >> 32) & (m_keys.size() - 1);
+}
+
+void ReachTable::rehash( const int capacity )
+{
+  QVector<quint64> keys = m_keys;
+  QVector<Entry> values = m_values;
+  QVector<bool> used = m_used;
+
+  m_keys.fill( 0, capacity );
+  m_values.resize( capacity );
+  m_used.fill( false, capacity );
+
+  const int mask = capacity - 1;
+
+  for( int i = 0; i < used.size(); i++ )
+    {
+      if( used.at(i) == false )
+        {
+          continue;
+        }
+
+      int s = slot( keys.at(i) );
+
+      while( m_used.at(s) )
+        {
+          s = (s + 1) & mask;
+        }
+
+      m_keys[s] = keys.at(i);
+      m_values[s] = values.at(i);
+      m_used[s] = true;
+    }
+}
+
+ReachTable::Entry& ReachTable::insert( const QPoint& position )
+{
+  if( 2 * (m_size + 1) > m_keys.size() )
+    {
+      reserve( m_size + 1 );
+    }
+
+  const quint64 key = WGSPoint::coordinateKey( position );
+  const int mask = m_keys.size() - 1;
+
+  int s = slot( key );
+
+  while( m_used.at(s) )
+    {
+      if( m_keys.at(s) == key )
+        {
+          return m_values[s];
+        }
+
+      s = (s + 1) & mask;
+    }
+
+  m_keys[s] = key;
+  m_used[s] = true;
+  m_size++;
+
+  Entry& entry = m_values[s];
+
+  entry.arrivalAlt = Unset;
+  entry.clearance  = Unset;
+  entry.distance   = 0.0;
+
+  return entry;
+}
+
+const ReachTable::Entry* ReachTable::find( const QPoint& position ) const
+{
+  if( m_size == 0 )
+    {
+      return static_cast<const Entry *> (0);
+    }
+
+  const quint64 key = WGSPoint::coordinateKey( position );
+  const int mask = m_keys.size() - 1;
+
+  int s = slot( key );
+
+  while( m_used.at(s) )
+    {
+      if( m_keys.at(s) == key )
+        {
+          return &m_values.at(s);
+        }
+
+      s = (s + 1) & mask;
+    }
+
+  return static_cast<const Entry *> (0);
+}
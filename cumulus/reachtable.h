@@ -0,0 +1,119 @@
+/***********************************************************************
+**
+**   reachtable.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class ReachTable
+ *
+ * \brief Hash table with the reach results of the sites.
+ *
+ * The map drawing asks for the reach results of every drawn site. Therefore
+ * the lookup must be cheap. The table is keyed by the packed WGS84 position
+ * of a site and uses open addressing with linear probing in a power of two
+ * sized array. A lookup needs no memory allocation and no string work.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef REACH_TABLE_H
+#define REACH_TABLE_H
+
+#include <climits>
+
+#include <QPoint>
+#include <QVector>
+
+class ReachTable
+{
+ public:
+
+  /** Reach results of a site. */
+  struct Entry
+  {
+    /** Arrival altitude in meters including the safety altitude. */
+    int arrivalAlt;
+
+    /** Minimum clearance of the glide line above the terrain in meters. */
+    int clearance;
+
+    /** Distance to the site in meters. */
+    double distance;
+  };
+
+  /** Value of an unset altitude or clearance. */
+  static const int Unset = INT_MIN;
+
+  ReachTable();
+
+  virtual ~ReachTable();
+
+  /**
+   * Removes all entries. The allocated memory is kept for the next use.
+   */
+  void clear();
+
+  /**
+   * Prepares the table for the passed number of entries.
+   */
+  void reserve( const int size );
+
+  /**
+   * Returns the entry of a position. A missing entry is created with unset
+   * values.
+   *
+   * \param position WGS84 position in KFLog format.
+   */
+  Entry& insert( const QPoint& position );
+
+  /**
+   * Looks for the entry of a position.
+   *
+   * \param position WGS84 position in KFLog format.
+   *
+   * \return The entry or null, if the position is unknown.
+   */
+  const Entry* find( const QPoint& position ) const;
+
+  /**
+   * \return The number of stored entries.
+   */
+  int size() const
+  {
+    return m_size;
+  };
+
+ private:
+
+  /** Returns the slot index of the key. */
+  int slot( const quint64 key ) const;
+
+  /** Reallocates the slots for the passed capacity and reinserts all entries. */
+  void rehash( const int capacity );
+
+  /** Keys of the slots. */
+  QVector<quint64> m_keys;
+
+  /** Values of the slots. */
+  QVector<Entry> m_values;
+
+  /** Flag per slot, if it is used. */
+  QVector<bool> m_used;
+
+  /** Number of stored entries. */
+  int m_size;
+};
+
+#endif
@@ -0,0 +1,222 @@
+/***********************************************************************
+**
+**   ringbuffer.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <QVector>
+
+/**
+ * \class RingBuffer
+ *
+ * \brief Template for a fixed capacity history of value items.
+ *
+ * The RingBuffer template class stores up to limit items in a preallocated
+ * QVector. Adding an item overwrites the oldest one, when the buffer is full.
+ * No memory is allocated or moved during adding, which makes the class
+ * suitable for long histories filled with a high rate.
+ *
+ * The access order is the same as of the LimitedList: index 0 is the
+ * newest item, index count()-1 the oldest one.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+template <class type>
+class RingBuffer
+{
+
+public:
+
+  /**
+   * Constructor
+   * @param limit the maximum number of elements in this buffer.
+   */
+  RingBuffer( int limit=10 );
+
+  virtual ~RingBuffer()
+  {
+  };
+
+  /**
+   * Adds a new item as newest item to the buffer. If the buffer is full, the
+   * oldest item is overwritten.
+   *
+   * @param d Item to be added to the buffer.
+   */
+  void add( const type &d );
+
+  /**
+   * Sets the new limit for the number of items in the buffer. The newest
+   * items are kept, if the new limit is smaller than the current item count.
+   *
+   * @param limit The new limit of the buffer.
+   */
+  void setLimit( const int limit );
+
+  /**
+   * @return The set limit of the buffer.
+   */
+  int getLimit() const
+  {
+    return m_data.size();
+  };
+
+  /**
+   * @return The number of stored items.
+   */
+  int count() const
+  {
+    return m_count;
+  };
+
+  int size() const
+  {
+    return m_count;
+  };
+
+  bool isEmpty() const
+  {
+    return m_count == 0;
+  };
+
+  /**
+   * Removes all items. The allocated storage is kept.
+   */
+  void clear()
+  {
+    m_count = 0;
+    m_head  = -1;
+  };
+
+  /**
+   * @return The item at index i, where 0 is the newest item.
+   */
+  const type& at( const int i ) const
+  {
+    return m_data.at( pos( i ) );
+  };
+
+  const type& operator[]( const int i ) const
+  {
+    return m_data.at( pos( i ) );
+  };
+
+  type& operator[]( const int i )
+  {
+    return m_data[pos( i )];
+  };
+
+  /**
+   * @return The newest item.
+   */
+  const type& first() const
+  {
+    return at( 0 );
+  };
+
+  /**
+   * @return The oldest item.
+   */
+  const type& last() const
+  {
+    return at( m_count - 1 );
+  };
+
+ private:
+
+  /** Maps a logical index to a storage index. */
+  int pos( const int i ) const
+  {
+    int p = m_head - i;
+
+    return (p < 0) ? p + m_data.size() : p;
+  };
+
+  /** Preallocated item storage. */
+  QVector<type> m_data;
+
+  /** Storage index of the newest item. */
+  int m_head;
+
+  /** Number of stored items. */
+  int m_count;
+};
+
+
+/**
+ * IMPLEMENTATION
+ * ====================================================================
+ *
+ * The implementation is stored in the header file because that's the
+ * only way it will compile without linker errors. This has to do with
+ * the fact that it's a template.
+ */
+
+template <class type>
+RingBuffer<type>::RingBuffer( int limit ) :
+  m_data( limit ),
+  m_head( -1 ),
+  m_count( 0 )
+{
+}
+
+template <class type>
+void RingBuffer<type>::add( const type &elem )
+{
+  if( m_data.size() == 0 )
+    {
+      return;
+    }
+
+  if( ++m_head >= m_data.size() )
+    {
+      m_head = 0;
+    }
+
+  m_data[m_head] = elem;
+
+  if( m_count < m_data.size() )
+    {
+      m_count++;
+    }
+}
+
+template <class type>
+void RingBuffer<type>::setLimit( const int limit )
+{
+  if( limit == m_data.size() )
+    {
+      return;
+    }
+
+  // Copy the newest items in the new storage, oldest at first.
+  int keep = qMin( m_count, qMax( 0, limit ) );
+
+  QVector<type> data( qMax( 0, limit ) );
+
+  for( int i = 0; i < keep; i++ )
+    {
+      data[i] = at( keep - 1 - i );
+    }
+
+  m_data  = data;
+  m_count = keep;
+  m_head  = keep - 1;
+}
+
+#endif
@@ -128,6 +128,20 @@ SettingsPageGPS::SettingsPageGPS(QWidget *parent) : QWidget(parent)
   GpsAltitude->addItem(tr("GPS"));
   GpsAltitude->addItem(tr("Pressure"));
 
+  // Fix rates forwarded to the different consumers, if a high rate
+  // receiver is connected.
+  topLayout->addWidget(new QLabel(tr("Trail Rate:"), this),row,0);
+  TrailRate = createRateBox();
+  topLayout->addWidget(TrailRate,row++,1);
+
+  topLayout->addWidget(new QLabel(tr("Logger Rate:"), this),row,0);
+  LoggerRate = createRateBox();
+  topLayout->addWidget(LoggerRate,row++,1);
+
+  topLayout->addWidget(new QLabel(tr("Display Rate:"), this),row,0);
+  DisplayRate = createRateBox();
+  topLayout->addWidget(DisplayRate,row++,1);
+
 #ifndef MAEMO
   topLayout->setRowMinimumHeight( row++, 10);
 
@@ -264,6 +278,10 @@ void SettingsPageGPS::load()
 #endif
 
   saveNmeaData->setChecked( conf->getGpsNmeaLogState() );
+
+  setRateBox( TrailRate, conf->getGpsTrailRate() );
+  setRateBox( LoggerRate, conf->getGpsLoggerRate() );
+  setRateBox( DisplayRate, conf->getGpsDisplayRate() );
 }
 
 /** Called to initiate saving to the configuration file. */
@@ -284,6 +302,10 @@ void SettingsPageGPS::save()
 
   conf->setGpsNmeaLogState( saveNmeaData->isChecked() );
 
+  conf->setGpsTrailRate( TrailRate->itemData( TrailRate->currentIndex() ).toDouble() );
+  conf->setGpsLoggerRate( LoggerRate->itemData( LoggerRate->currentIndex() ).toDouble() );
+  conf->setGpsDisplayRate( DisplayRate->itemData( DisplayRate->currentIndex() ).toDouble() );
+
   if( oldNmeaLogState != saveNmeaData->isChecked() )
     {
       if( saveNmeaData->isChecked() )
@@ -327,3 +349,32 @@ void SettingsPageGPS::slot_gpsDeviceChanged( const QString& text )
 
   GpsSpeed->setEnabled( true );
 }
+
+QComboBox* SettingsPageGPS::createRateBox()
+{
+  QComboBox* box = new QComboBox(this);
+  box->setEditable(false);
+
+  // The item data contains the rate in Hz, 0 means all received fixes.
+  box->addItem( tr("All Fixes"), 0.0 );
+  box->addItem( "0.5 Hz", 0.5 );
+  box->addItem( "1 Hz", 1.0 );
+  box->addItem( "2 Hz", 2.0 );
+  box->addItem( "5 Hz", 5.0 );
+  box->addItem( "10 Hz", 10.0 );
+
+  return box;
+}
+
+void SettingsPageGPS::setRateBox( QComboBox* box, const double rate )
+{
+  int index = box->findData( rate );
+
+  if( index == -1 )
+    {
+      // Unknown rate in the configuration, use all fixes.
+      index = 0;
+    }
+
+  box->setCurrentIndex( index );
+}
@@ -88,10 +88,19 @@ class SettingsPageGPS : public QWidget
   /** Called to save the configuration file data.*/
   void save();
 
+  /** Creates a combo box with the selectable fix rates. */
+  QComboBox* createRateBox();
+
+  /** Selects the passed fix rate in the combo box. */
+  void setRateBox( QComboBox* box, const double rate );
+
   QComboBox*   GpsSource;
   QComboBox*   GpsDev;
   QComboBox*   GpsSpeed;
   QComboBox*   GpsAltitude;
+  QComboBox*   TrailRate;
+  QComboBox*   LoggerRate;
+  QComboBox*   DisplayRate;
   QCheckBox*   checkSyncSystemClock;
   QCheckBox*   saveNmeaData;
 };
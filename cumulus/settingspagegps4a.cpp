@@ -87,6 +87,23 @@ SettingsPageGPS4A::SettingsPageGPS4A(QWidget *parent) : QWidget(parent)
   topLayout->addWidget(GpsAltitude, row, 1);
   row++;
 
+  // Fix rates forwarded to the different consumers, if a high rate
+  // receiver is connected.
+  topLayout->addWidget(new QLabel(tr("Trail Rate:")), row, 0);
+  TrailRate = createRateBox();
+  topLayout->addWidget(TrailRate, row, 1);
+  row++;
+
+  topLayout->addWidget(new QLabel(tr("Logger Rate:")), row, 0);
+  LoggerRate = createRateBox();
+  topLayout->addWidget(LoggerRate, row, 1);
+  row++;
+
+  topLayout->addWidget(new QLabel(tr("Display Rate:")), row, 0);
+  DisplayRate = createRateBox();
+  topLayout->addWidget(DisplayRate, row, 1);
+  row++;
+
   topLayout->setRowMinimumHeight( row++, 10);
 
   saveNmeaData = new QCheckBox (tr("Save NMEA Data to file"));
@@ -151,6 +168,10 @@ void SettingsPageGPS4A::load()
   GpsSource->setCurrentIndex( index );
   GpsAltitude->setCurrentIndex( conf->getGpsAltitude() );
   saveNmeaData->setChecked( conf->getGpsNmeaLogState() );
+
+  setRateBox( TrailRate, conf->getGpsTrailRate() );
+  setRateBox( LoggerRate, conf->getGpsLoggerRate() );
+  setRateBox( DisplayRate, conf->getGpsDisplayRate() );
 }
 
 void SettingsPageGPS4A::save()
@@ -164,6 +185,10 @@ void SettingsPageGPS4A::save()
 
   conf->setGpsNmeaLogState( saveNmeaData->isChecked() );
 
+  conf->setGpsTrailRate( TrailRate->itemData( TrailRate->currentIndex() ).toDouble() );
+  conf->setGpsLoggerRate( LoggerRate->itemData( LoggerRate->currentIndex() ).toDouble() );
+  conf->setGpsDisplayRate( DisplayRate->itemData( DisplayRate->currentIndex() ).toDouble() );
+
   if( oldNmeaLogState != saveNmeaData->isChecked() )
     {
       if( saveNmeaData->isChecked() )
@@ -176,3 +201,32 @@ void SettingsPageGPS4A::save()
         }
     }
 }
+
+QComboBox* SettingsPageGPS4A::createRateBox()
+{
+  QComboBox* box = new QComboBox(this);
+  box->setEditable(false);
+
+  // The item data contains the rate in Hz, 0 means all received fixes.
+  box->addItem( tr("All Fixes"), 0.0 );
+  box->addItem( "0.5 Hz", 0.5 );
+  box->addItem( "1 Hz", 1.0 );
+  box->addItem( "2 Hz", 2.0 );
+  box->addItem( "5 Hz", 5.0 );
+  box->addItem( "10 Hz", 10.0 );
+
+  return box;
+}
+
+void SettingsPageGPS4A::setRateBox( QComboBox* box, const double rate )
+{
+  int index = box->findData( rate );
+
+  if( index == -1 )
+    {
+      // Unknown rate in the configuration, use all fixes.
+      index = 0;
+    }
+
+  box->setCurrentIndex( index );
+}
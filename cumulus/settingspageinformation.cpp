@@ -178,6 +178,12 @@ SettingsPageInformation::SettingsPageInformation( QWidget *parent ) :
   topLayout->addWidget( inverseInfoDisplay, row, 1, 1, 2 );
   row++;
 
+  checkNearestTerrain = new QCheckBox(tr("Terrain Check"), this);
+  checkNearestTerrain->setObjectName("checkNearestTerrain");
+  checkNearestTerrain->setChecked(true);
+  topLayout->addWidget( checkNearestTerrain, row, 0 );
+  row++;
+
   topLayout->setRowStretch ( row, 10 );
   topLayout->setColumnStretch( 2, 10 );
 
@@ -267,6 +273,7 @@ void SettingsPageInformation::load()
   checkAlarmSound->setChecked( conf->getAlarmSoundOn() );
   checkFlarmAlarms->setChecked( conf->getPopupFlarmAlarms() );
   calculateNearestSites->setChecked( conf->getNearestSiteCalculatorSwitch() );
+  checkNearestTerrain->setChecked( conf->getNearestSiteTerrainCheck() );
   inverseInfoDisplay->setChecked( conf->getBlackBgInfoDisplay() );
 }
 
@@ -287,6 +294,7 @@ void SettingsPageInformation::save()
   conf->setAlarmSoundOn( checkAlarmSound->isChecked() );
   conf->setPopupFlarmAlarms( checkFlarmAlarms->isChecked() );
   conf->setNearestSiteCalculatorSwitch( calculateNearestSites->isChecked() );
+  conf->setNearestSiteTerrainCheck( checkNearestTerrain->isChecked() );
   conf->setBlackBgInfoDisplay( inverseInfoDisplay->isChecked() );
 }
 
@@ -306,6 +314,7 @@ void SettingsPageInformation::slot_setFactoryDefault()
   checkFlarmAlarms->setChecked( true );
   inverseInfoDisplay->setChecked( false );
   calculateNearestSites->setChecked(NEAREST_SITE_CALCULATOR_DEFAULT);
+  checkNearestTerrain->setChecked(NEAREST_SITE_TERRAIN_CHECK_DEFAULT);
 }
 
 #ifndef ANDROID
@@ -114,6 +114,7 @@ class SettingsPageInformation : public QWidget
   QCheckBox*   checkAlarmSound;
   QCheckBox*   checkFlarmAlarms;
   QCheckBox*   calculateNearestSites;
+  QCheckBox*   checkNearestTerrain;
   QCheckBox*   inverseInfoDisplay;
 
   QPushButton* buttonReset;
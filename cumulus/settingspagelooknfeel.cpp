@@ -161,6 +161,10 @@ SettingsPageLookNFeel::SettingsPageLookNFeel(QWidget *parent) :
   topLayout->addWidget( m_screenSaverSpeedLimit, row, 1 );
   row++;
 
+  m_performanceOverlay = new QCheckBox( tr("Performance overlay"), this );
+  topLayout->addWidget( m_performanceOverlay, row, 0, 1, 2 );
+  row++;
+
   topLayout->setRowStretch( row, 10 );
   topLayout->setColumnStretch( 2, 10 );
 
@@ -237,6 +241,8 @@ void SettingsPageLookNFeel::load()
   m_screenSaverSpeedLimit->setValue( speed.getValueInUnit( m_unit ) );
   // save loaded value for change control
   m_loadedSpeed = m_screenSaverSpeedLimit->value();
+
+  m_performanceOverlay->setChecked( conf->getPerformanceOverlay() );
 }
 
 void SettingsPageLookNFeel::save()
@@ -280,6 +286,12 @@ void SettingsPageLookNFeel::save()
       changes++;
    }
 
+  if( conf->getPerformanceOverlay() != m_performanceOverlay->isChecked() )
+    {
+      conf->setPerformanceOverlay( m_performanceOverlay->isChecked() );
+      changes++;
+    }
+
   if( changes )
     {
       conf->save();
@@ -303,6 +315,7 @@ bool SettingsPageLookNFeel::checkChanges()
   changed |= conf->getGuiMenuFont() != m_currentMenuFont;
   changed |= conf->getGuiStyle() != m_styleBox->currentText();
   changed |= conf->getMapFrameColor() != m_currentMapFrameColor;
+  changed |= conf->getPerformanceOverlay() != m_performanceOverlay->isChecked();
   changed |= m_loadedSpeed != m_screenSaverSpeedLimit->value() ;
 
   return changed;
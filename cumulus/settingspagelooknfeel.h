@@ -108,6 +108,7 @@ private:
   QPushButton    *m_menuFontDialog;
   QPushButton    *m_editMapFrameColor;
   QCheckBox      *m_virtualKeybord;
+  QCheckBox      *m_performanceOverlay;
 
   DoubleNumberEditor *m_screenSaverSpeedLimit;
 
@@ -140,8 +140,8 @@ SettingsPageMapObjects::SettingsPageMapObjects(QWidget *parent) :
   //hBox->addStretch( 10 );
 
   //---------------------------------------------------------------------------
-  // table with 8 rows and 2 columns
-  loadOptions = new QTableWidget(8, 2, this);
+  // table with 9 rows and 2 columns
+  loadOptions = new QTableWidget(10, 2, this);
 
   loadOptions->setVerticalScrollMode( QAbstractItemView::ScrollPerPixel );
   loadOptions->setHorizontalScrollMode( QAbstractItemView::ScrollPerPixel );
@@ -302,6 +302,10 @@ void SettingsPageMapObjects::load()
   liOlLabels->setCheckState( conf->getMapShowOutLandingLabels() ? Qt::Checked : Qt::Unchecked );
   liRelBearingInfo->setCheckState( conf->getMapShowRelBearingInfo() ? Qt::Checked : Qt::Unchecked );
   liFlightTrail->setCheckState( conf->getMapDrawTrail() ? Qt::Checked : Qt::Unchecked );
+  liGlideFootprint->setCheckState( conf->getMapShowGlideFootprint() ? Qt::Checked : Qt::Unchecked );
+  liContest->setCheckState( conf->getMapShowContest() ? Qt::Checked : Qt::Unchecked );
+  liThermals->setCheckState( conf->getMapShowThermals() ? Qt::Checked : Qt::Unchecked );
+  liThermalCentering->setCheckState( conf->getMapShowThermalCentering() ? Qt::Checked : Qt::Unchecked );
   // Load scale values for spin boxes. Note! The load order is important because a value change
   // of the spin box will generate a signal.
   m_wpHighScaleLimit->setValue( conf->getWaypointScaleBorder( Waypoint::High ));
@@ -338,6 +342,10 @@ void SettingsPageMapObjects::save()
   conf->setMapShowLabelsExtraInfo(liLabelsInfo->checkState() == Qt::Checked ? true : false);
   conf->setMapShowRelBearingInfo(liRelBearingInfo->checkState() == Qt::Checked ? true : false);
   conf->setMapDrawTrail(liFlightTrail->checkState() == Qt::Checked ? true : false);
+  conf->setMapShowGlideFootprint(liGlideFootprint->checkState() == Qt::Checked ? true : false);
+  conf->setMapShowContest(liContest->checkState() == Qt::Checked ? true : false);
+  conf->setMapShowThermals(liThermals->checkState() == Qt::Checked ? true : false);
+  conf->setMapShowThermalCentering(liThermalCentering->checkState() == Qt::Checked ? true : false);
 
   conf->setWaypointScaleBorder( Waypoint::Low, m_wpLowScaleLimit->value() );
   conf->setWaypointScaleBorder( Waypoint::Normal, m_wpNormalScaleLimit->value() );
@@ -356,6 +364,10 @@ void SettingsPageMapObjects::fillLoadOptionList()
   liCities->setFlags( Qt::ItemIsEnabled );
   loadOptions->setItem( row++, col, liCities );
 
+  liContest = new QTableWidgetItem( tr("Contest routes") );
+  liContest->setFlags( Qt::ItemIsEnabled );
+  loadOptions->setItem( row++, col, liContest );
+
   liForests = new QTableWidgetItem( tr("Forests") );
   liForests->setFlags( Qt::ItemIsEnabled );
   loadOptions->setItem( row++, col, liForests );
@@ -384,6 +396,10 @@ void SettingsPageMapObjects::fillLoadOptionList()
   liWaterways->setFlags( Qt::ItemIsEnabled );
   loadOptions->setItem( row++, col, liWaterways );
 
+  liThermals = new QTableWidgetItem( tr("Thermal map") );
+  liThermals->setFlags( Qt::ItemIsEnabled );
+  loadOptions->setItem( row++, col, liThermals );
+
   // next column is one
   row = 0;
   col = 1;
@@ -420,6 +436,14 @@ void SettingsPageMapObjects::fillLoadOptionList()
   liFlightTrail->setFlags( Qt::ItemIsEnabled );
   loadOptions->setItem( row++, col, liFlightTrail );
 
+  liGlideFootprint = new QTableWidgetItem( tr("Glide footprint") );
+  liGlideFootprint->setFlags( Qt::ItemIsEnabled );
+  loadOptions->setItem( row++, col, liGlideFootprint );
+
+  liThermalCentering = new QTableWidgetItem( tr("Thermal centering") );
+  liThermalCentering->setFlags( Qt::ItemIsEnabled );
+  loadOptions->setItem( row++, col, liThermalCentering );
+
 #if 0
   // Set a dummy into the unused cells
   QTableWidgetItem *liDummy = new QTableWidgetItem;
@@ -449,6 +473,13 @@ void SettingsPageMapObjects::slot_toggleCheckBox( int row, int column )
     }
 
   QTableWidgetItem *item = loadOptions->item( row, column );
+
+  if( item == 0 || item->flags() == Qt::NoItemFlags )
+    {
+      // Dummy cell was clicked
+      return;
+    }
+
   item->setCheckState( item->checkState() == Qt::Checked ? Qt::Unchecked : Qt::Checked );
 }
 
@@ -473,6 +504,10 @@ bool SettingsPageMapObjects::checkChanges()
   changed |= ( conf->getMapShowOutLandingLabels() ? Qt::Checked : Qt::Unchecked ) != liOlLabels->checkState();
   changed |= ( conf->getMapShowRelBearingInfo() ? Qt::Checked : Qt::Unchecked ) != liRelBearingInfo->checkState();
   changed |= ( conf->getMapDrawTrail() ? Qt::Checked : Qt::Unchecked ) != liFlightTrail->checkState();
+  changed |= ( conf->getMapShowGlideFootprint() ? Qt::Checked : Qt::Unchecked ) != liGlideFootprint->checkState();
+  changed |= ( conf->getMapShowContest() ? Qt::Checked : Qt::Unchecked ) != liContest->checkState();
+  changed |= ( conf->getMapShowThermals() ? Qt::Checked : Qt::Unchecked ) != liThermals->checkState();
+  changed |= ( conf->getMapShowThermalCentering() ? Qt::Checked : Qt::Unchecked ) != liThermalCentering->checkState();
 
   changed |= ( conf->getWaypointScaleBorder( Waypoint::Low )    != m_wpLowScaleLimit->value() );
   changed |= ( conf->getWaypointScaleBorder( Waypoint::Normal ) != m_wpNormalScaleLimit->value() );
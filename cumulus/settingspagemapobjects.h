@@ -133,6 +133,10 @@ private:
   QTableWidgetItem *liLabelsInfo;
   QTableWidgetItem *liRelBearingInfo;
   QTableWidgetItem *liFlightTrail;
+  QTableWidgetItem *liGlideFootprint;
+  QTableWidgetItem *liContest;
+  QTableWidgetItem *liThermals;
+  QTableWidgetItem *liThermalCentering;
 
   NumberEditor *m_wpLowScaleLimit;
   NumberEditor *m_wpNormalScaleLimit;
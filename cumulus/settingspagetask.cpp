@@ -114,11 +114,13 @@ SettingsPageTask::SettingsPageTask( QWidget *parent) :
   ntScheme->addButton( touched, 1 );
 
   m_reportSwitch = new QCheckBox( tr("Report"), this );
+  m_maximizeAreas = new QCheckBox( tr("Max. areas"), this );
 
   QVBoxLayout* vbox = new QVBoxLayout;
   vbox->addWidget( nearest );
   vbox->addWidget( touched );
   vbox->addWidget( m_reportSwitch );
+  vbox->addWidget( m_maximizeAreas );
   vbox->addStretch(1);
   ssBox->setLayout(vbox);
 
@@ -617,6 +619,7 @@ void SettingsPageTask::load()
     }
 
   m_reportSwitch->setChecked( conf->getReportTpSwitch() );
+  m_maximizeAreas->setChecked( conf->getTaskMaximizeAreas() );
   m_drawShape->setChecked( conf->getTaskDrawShape() );
   m_fillShape->setChecked( conf->getTaskFillShape() );
   m_transShape->setValue( conf->getTaskShapeAlpha() );
@@ -721,6 +724,7 @@ void SettingsPageTask::save()
 
   conf->setActiveTaskSwitchScheme( (GeneralConfig::ActiveTaskSwitchScheme) m_selectedSwitchScheme );
   conf->setReportTpSwitch( m_reportSwitch->isChecked() );
+  conf->setTaskMaximizeAreas( m_maximizeAreas->isChecked() );
   conf->setTaskDrawShape( m_drawShape->isChecked() );
   conf->setTaskFillShape( m_fillShape->isChecked() );
   conf->setTaskShapeAlpha(m_transShape->value() );
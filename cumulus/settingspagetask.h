@@ -144,6 +144,9 @@ private:
   // report switch option
   QCheckBox* m_reportSwitch;
 
+  // maximize the route through the task point figures
+  QCheckBox* m_maximizeAreas;
+
   QButtonGroup* ntScheme;       // nearest-touch schema
   QButtonGroup* startScheme;    // circle-sector scheme
   QButtonGroup* finishScheme;   // circle-sector scheme
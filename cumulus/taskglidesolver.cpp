@@ -0,0 +1,477 @@
+/***********************************************************************
+**
+**   taskglidesolver.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include "flightclock.h"
+#include "generalconfig.h"
+#include "mapcalc.h"
+#include "mapmatrix.h"
+#include "polar.h"
+#include "taskglidesolver.h"
+#include "taskpoint.h"
+#include "windmeasurementlist.h"
+
+extern MapMatrix* _globalMapMatrix;
+
+// Length in meters of an integration step along a leg.
+#define STEP_LENGTH 500.0
+
+// Height in meters of an altitude band of the wind profile.
+#define WIND_BAND 250.0
+
+// Number of altitude bands of the wind profile.
+#define WIND_BANDS 64
+
+// Time window in seconds and altitude range in meters of the wind search.
+#define WIND_TIME_WINDOW 1800
+#define WIND_ALT_RANGE 400
+
+// Age in seconds, after which the wind profile is recalculated.
+#define WIND_REFRESH 60
+
+// Wind difference in m/s, which is considered as a change of the profile.
+#define WIND_TOLERANCE 0.1
+
+// Part of the final leg in meters before the final task point, which is not
+// checked against the terrain. The final task point itself is terrain.
+#define FINAL_APPROACH 1000.0
+
+TaskGlideSolver::TaskGlideSolver() :
+  m_polar(0),
+  m_water(0),
+  m_bugs(0),
+  m_safetyAlt(0),
+  m_conditions(1),
+  m_windList(0),
+  m_manualWind(false),
+  m_windVersion(0),
+  m_windTime(-1)
+{
+  m_result.reach = ReachablePoint::no;
+  m_result.hasObstacle = false;
+
+  m_firstLeg.conditions = 0;
+  m_firstLeg.startAlt = Unreachable;
+}
+
+TaskGlideSolver::~TaskGlideSolver()
+{
+}
+
+void TaskGlideSolver::clear()
+{
+  m_legs.clear();
+  m_bandWinds.clear();
+  m_bandSet.clear();
+
+  m_polar = 0;
+  m_windTime = -1;
+
+  // All legs cached before are invalid now.
+  m_conditions++;
+}
+
+const TaskGlideSolver::Result& TaskGlideSolver::solve( const QList<TaskPoint *>& tpList,
+                                                       const int tpIndex,
+                                                       const QPoint& position,
+                                                       const Altitude& altitude,
+                                                       Polar* polar,
+                                                       const Speed& mc,
+                                                       const int safetyAlt,
+                                                       WindMeasurementList& windList,
+                                                       const Vector& wind,
+                                                       const QVector<QPoint>* touchPoints )
+{
+  m_result.requiredAlt.setInvalid();
+  m_result.arrivalAlt.setInvalid();
+  m_result.bestSpeed.setInvalid();
+  m_result.obstacleClearance.setInvalid();
+  m_result.reach = ReachablePoint::no;
+  m_result.hasObstacle = false;
+
+  const int wpCount = tpList.count();
+
+  if( polar == 0 || _globalMapMatrix == 0 || tpIndex < 0 || tpIndex >= wpCount )
+    {
+      return m_result;
+    }
+
+  updateConditions( polar, mc, safetyAlt, windList, wind );
+
+  // The legs lead over the touch points or over the task point centers.
+  QVector<QPoint> points( wpCount );
+
+  for( int i = 0; i < wpCount; i++ )
+    {
+      points[i] = ( touchPoints != 0 && touchPoints->size() == wpCount ) ?
+                  touchPoints->at(i) : tpList.at(i)->getWGSPosition();
+    }
+
+  if( m_legs.size() != wpCount )
+    {
+      m_legs.resize( wpCount );
+
+      for( int i = 0; i < wpCount; i++ )
+        {
+          m_legs[i].conditions = m_conditions - 1;
+        }
+    }
+
+  // The terrain raster must cover the whole remaining route.
+  int latMin = position.x();
+  int latMax = position.x();
+  int lonMin = position.y();
+  int lonMax = position.y();
+
+  for( int i = tpIndex; i < wpCount; i++ )
+    {
+      const QPoint& p = points.at(i);
+
+      latMin = qMin( latMin, p.x() );
+      latMax = qMax( latMax, p.x() );
+      lonMin = qMin( lonMin, p.y() );
+      lonMax = qMax( lonMax, p.y() );
+    }
+
+  QPoint center( (latMin + latMax) / 2, (lonMin + lonMax) / 2 );
+  QPoint corner( latMax, lonMax );
+
+  m_grid.update( center, MapCalc::dist( &center, &corner ) + 1.0 );
+
+  // The legs are solved backwards from the final task point.
+  const TaskPoint* finalTp = tpList.at( wpCount - 1 );
+
+  int requiredAlt = qRound( finalTp->getElevation() ) + safetyAlt;
+  int clearance = ElevationGrid::NoTerrain;
+  QPoint obstacle;
+
+  for( int i = wpCount - 2; i >= tpIndex && requiredAlt != Unreachable; i-- )
+    {
+      const QPoint& start = points.at(i);
+      const QPoint& end = points.at(i + 1);
+
+      if( start == end )
+        {
+          continue; // points are equal, we ignore them
+        }
+
+      const Leg& leg = solveLeg( m_legs[i + 1], start, end, requiredAlt, i + 2 == wpCount );
+
+      requiredAlt = leg.startAlt;
+
+      if( leg.clearance < clearance )
+        {
+          clearance = leg.clearance;
+          obstacle  = leg.obstacle;
+        }
+    }
+
+  if( requiredAlt == Unreachable )
+    {
+      return m_result;
+    }
+
+  const Leg& first = solveLeg( m_firstLeg,
+                               position,
+                               points.at( tpIndex ),
+                               requiredAlt,
+                               tpIndex + 1 == wpCount );
+
+  if( first.startAlt == Unreachable )
+    {
+      return m_result;
+    }
+
+  if( first.clearance < clearance )
+    {
+      clearance = first.clearance;
+      obstacle  = first.obstacle;
+    }
+
+  m_result.requiredAlt = Altitude( first.startAlt );
+  m_result.arrivalAlt  = Altitude( altitude.getMeters() - first.startAlt );
+  m_result.bestSpeed   = first.bestSpeed;
+
+  if( clearance != ElevationGrid::NoTerrain )
+    {
+      m_result.hasObstacle = true;
+      m_result.obstacle = obstacle;
+      m_result.obstacleClearance = Altitude( clearance );
+    }
+
+  // The arrival altitude is counted above the safety altitude.
+  if( m_result.arrivalAlt.getMeters() >= 0.0 )
+    {
+      m_result.reach = ReachablePoint::yes;
+    }
+  else if( m_result.arrivalAlt.getMeters() > -safetyAlt )
+    {
+      m_result.reach = ReachablePoint::belowSafety;
+    }
+
+  return m_result;
+}
+
+void TaskGlideSolver::updateConditions( Polar* polar,
+                                        const Speed& mc,
+                                        const int safetyAlt,
+                                        WindMeasurementList& windList,
+                                        const Vector& wind )
+{
+  bool changed = false;
+
+  if( m_polar != polar || m_water != polar->water() || m_bugs != polar->bugs() ||
+      m_mc != mc || m_safetyAlt != safetyAlt )
+    {
+      m_polar     = polar;
+      m_water     = polar->water();
+      m_bugs      = polar->bugs();
+      m_mc        = mc;
+      m_safetyAlt = safetyAlt;
+      changed     = true;
+    }
+
+  m_windList = &windList;
+
+  Vector newWind = wind;
+  const bool manual = GeneralConfig::instance()->isManualWindEnabled();
+
+  if( m_bandWinds.isEmpty() )
+    {
+      m_bandWinds.resize( WIND_BANDS );
+      m_bandSet.fill( false, WIND_BANDS );
+    }
+
+  // The wind profile is recalculated, if new measurements are available or
+  // if it becomes too old, because the older measurements lose their weight.
+  if( m_manualWind != manual || m_wind != newWind ||
+      m_windVersion != windList.version() ||
+      m_windTime < 0 || FlightClock::elapsed( m_windTime ) > WIND_REFRESH * 1000 )
+    {
+      m_manualWind = manual;
+      m_wind       = newWind;
+      m_windVersion = windList.version();
+      m_windTime = FlightClock::currentMSecsSinceEpoch();
+
+      for( int i = 0; i < WIND_BANDS; i++ )
+        {
+          if( m_bandSet.at(i) == false )
+            {
+              continue;
+            }
+
+          Vector oldWind = m_bandWinds.at(i);
+          Vector bandValue = bandWind( i );
+
+          if( fabs( oldWind.getXMps() - bandValue.getXMps() ) > WIND_TOLERANCE ||
+              fabs( oldWind.getYMps() - bandValue.getYMps() ) > WIND_TOLERANCE )
+            {
+              m_bandWinds[i] = bandValue;
+              changed = true;
+            }
+        }
+    }
+
+  if( changed )
+    {
+      m_conditions++;
+    }
+}
+
+Vector TaskGlideSolver::windAt( const double altitude )
+{
+  int band = qBound( 0, int( altitude / WIND_BAND ), WIND_BANDS - 1 );
+
+  if( m_bandSet.at(band) == false )
+    {
+      m_bandWinds[band] = bandWind( band );
+      m_bandSet[band] = true;
+    }
+
+  return m_bandWinds.at(band);
+}
+
+Vector TaskGlideSolver::bandWind( const int band )
+{
+  if( m_manualWind || m_windList == 0 )
+    {
+      return m_wind;
+    }
+
+  Vector wind = m_windList->getWind( Altitude( (band + 0.5) * WIND_BAND ),
+                                     WIND_TIME_WINDOW,
+                                     WIND_ALT_RANGE );
+
+  if( wind.isValid() == false )
+    {
+      return m_wind;
+    }
+
+  return wind;
+}
+
+double TaskGlideSolver::glideRatio( const double bearing, Vector wind, Speed& bestSpeed ) const
+{
+  // we use the method described by Bob Hansen, see Calculator::glideRatio()
+  Speed speed = m_polar->bestSpeed( 0.0, 0.0, m_mc );
+
+  // assume we are heading for the task point
+  Vector groundspeed( bearing, speed );
+
+  // we add wind because of the negative direction
+  Vector airspeed = groundspeed + wind;
+
+  Speed headwind = groundspeed.getSpeed() - airspeed.getSpeed();
+
+  bestSpeed = m_polar->bestSpeed( headwind, 0.0, m_mc );
+
+  // the ld is over ground, so we take groundspeed
+  return m_polar->bestLD( bestSpeed, groundspeed.getSpeed(), 0.0 );
+}
+
+const TaskGlideSolver::Leg& TaskGlideSolver::solveLeg( Leg& leg,
+                                                       const QPoint& start,
+                                                       const QPoint& end,
+                                                       const int endAlt,
+                                                       const bool finalLeg )
+{
+  if( leg.conditions == m_conditions &&
+      leg.gridVersion == m_grid.version() &&
+      leg.start == start && leg.end == end &&
+      leg.endAlt == endAlt && leg.finalLeg == finalLeg )
+    {
+      return leg;
+    }
+
+  leg.start       = start;
+  leg.end         = end;
+  leg.endAlt      = endAlt;
+  leg.finalLeg    = finalLeg;
+  leg.conditions  = m_conditions;
+  leg.gridVersion = m_grid.version();
+  leg.clearance   = ElevationGrid::NoTerrain;
+  leg.obstacle    = end;
+
+  QPoint p1 = start;
+  QPoint p2 = end;
+
+  const double distance = MapCalc::dist( &p1, &p2 ) * 1000.0;
+
+  if( distance < 1.0 )
+    {
+      leg.startAlt = endAlt;
+      glideRatio( 0.0, windAt( endAlt ), leg.bestSpeed );
+      return leg;
+    }
+
+  const double bearing = MapCalc::getBearingWgs( p1, p2 );
+  const int steps = qMax( 1, int( ceil( distance / STEP_LENGTH ) ) );
+  const double stepLength = distance / steps;
+
+  // Required altitude at every step, integrated from the leg end backwards.
+  QVector<double> profile( steps + 1 );
+
+  double altitude = endAlt;
+  int lastBand = -1;
+  double ld = 0.0;
+
+  profile[steps] = altitude;
+
+  for( int k = steps - 1; k >= 0; k-- )
+    {
+      int band = qBound( 0, int( altitude / WIND_BAND ), WIND_BANDS - 1 );
+
+      // The glide ratio changes only with the wind band.
+      if( band != lastBand )
+        {
+          lastBand = band;
+          ld = glideRatio( bearing, windAt( altitude ), leg.bestSpeed );
+        }
+
+      if( ld <= 0.0 )
+        {
+          // The wind is too strong for a glide on this course.
+          leg.startAlt = Unreachable;
+          return leg;
+        }
+
+      altitude += stepLength / ld;
+      profile[k] = altitude;
+    }
+
+  leg.startAlt = qRound( altitude );
+
+  if( ! m_grid.isValid() )
+    {
+      return leg;
+    }
+
+  QVector<int> elevations;
+
+  const int samples = m_grid.profile( _globalMapMatrix->wgsToMap( start ),
+                                      _globalMapMatrix->wgsToMap( end ),
+                                      elevations );
+
+  // At the end of the final leg the glide path meets the terrain.
+  const double checked = finalLeg ? 1.0 - FINAL_APPROACH / distance : 1.0;
+
+  double obstacleFraction = 1.0;
+
+  for( int j = 0; j <= samples && samples > 0; j++ )
+    {
+      const double fraction = double( j ) / samples;
+
+      if( fraction > checked )
+        {
+          break;
+        }
+
+      if( elevations.at(j) == INT_MIN )
+        {
+          continue;
+        }
+
+      // The glide path is linear between the integration steps.
+      const double pos = fraction * steps;
+      const int k = qMin( int( pos ), steps - 1 );
+      const double pathAlt = profile.at(k) + (profile.at(k + 1) - profile.at(k)) * (pos - k);
+
+      const int clearance = int( pathAlt ) - elevations.at(j);
+
+      if( clearance < leg.clearance )
+        {
+          leg.clearance = clearance;
+          obstacleFraction = fraction;
+        }
+    }
+
+  if( leg.clearance == ElevationGrid::NoTerrain )
+    {
+      return leg;
+    }
+
+  leg.obstacle = QPoint( start.x() + qRound( (end.x() - start.x()) * obstacleFraction ),
+                         start.y() + qRound( (end.y() - start.y()) * obstacleFraction ) );
+
+  // The glide path before the obstacle must be raised by the missing
+  // clearance.
+  if( leg.clearance < m_safetyAlt )
+    {
+      leg.startAlt += m_safetyAlt - leg.clearance;
+    }
+
+  return leg;
+}
@@ -0,0 +1,252 @@
+/***********************************************************************
+**
+**   taskglidesolver.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class TaskGlideSolver
+ *
+ * \brief Final glide calculation along the remaining legs of a flight task.
+ *
+ * The route from the current position over the remaining task points to the
+ * final task point is solved backwards, starting with the safety altitude
+ * above the final task point. Every leg is integrated in short steps. At
+ * every step the wind of the reached altitude band is taken from the wind
+ * measurements and the glide ratio over ground is derived from it in the
+ * same way as Calculator::glidePath() does it.
+ *
+ * The glide path of every leg is checked against the terrain. If the path
+ * comes closer to the terrain than the safety altitude, the required
+ * altitude at the start of the leg is raised by the missing clearance. The
+ * point of the smallest clearance along the route is the critical obstacle.
+ *
+ * The results are cached per leg together with their inputs, that are the
+ * leg points, the required altitude at the leg end, the glide conditions
+ * and the terrain raster. As long as wind, polar and McCready are unchanged,
+ * only the leg from the current position to the next task point must be
+ * recalculated at a new fix.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef TASK_GLIDE_SOLVER_H
+#define TASK_GLIDE_SOLVER_H
+
+#include <climits>
+
+#include <QList>
+#include <QPoint>
+#include <QVector>
+
+#include "altitude.h"
+#include "elevationgrid.h"
+#include "reachablepoint.h"
+#include "speed.h"
+#include "vector.h"
+
+class Polar;
+class TaskPoint;
+class WindMeasurementList;
+
+class TaskGlideSolver
+{
+ public:
+
+  /** Result of a final glide calculation. */
+  struct Result
+  {
+    /** Altitude MSL, which is required at the current position. */
+    Altitude requiredAlt;
+
+    /** Arrival altitude above the safety altitude of the final task point. */
+    Altitude arrivalAlt;
+
+    /** Best speed at the current position. */
+    Speed bestSpeed;
+
+    /** Reachability of the final task point. */
+    ReachablePoint::reachable reach;
+
+    /** True, if terrain was known along the route. */
+    bool hasObstacle;
+
+    /** Position of the smallest terrain clearance in KFLog coordinates. */
+    QPoint obstacle;
+
+    /** Clearance of the glide path above the critical obstacle. */
+    Altitude obstacleClearance;
+  };
+
+  TaskGlideSolver();
+
+  virtual ~TaskGlideSolver();
+
+  /**
+   * Calculates the final glide from the current position over the task
+   * points starting at the passed index. Only the legs, whose inputs have
+   * been changed, are recalculated.
+   *
+   * \param tpList Task points of the flight task.
+   *
+   * \param tpIndex Index of the next task point.
+   *
+   * \param position Current position in KFLog coordinates.
+   *
+   * \param altitude Current altitude MSL.
+   *
+   * \param polar Polar of the glider.
+   *
+   * \param mc Current McCready value.
+   *
+   * \param safetyAlt Safety altitude in meters.
+   *
+   * \param windList Wind measurements, from which the wind profile is taken.
+   *
+   * \param wind Wind used for altitudes without wind measurements.
+   *
+   * \param touchPoints Optimized touch points of the task points in KFLog
+   *        coordinates or null. The legs end at the task point centers, if
+   *        no touch points are passed.
+   *
+   * \return The result of the calculation. The altitudes are invalid, if the
+   *         calculation was not possible.
+   */
+  const Result& solve( const QList<TaskPoint *>& tpList,
+                       const int tpIndex,
+                       const QPoint& position,
+                       const Altitude& altitude,
+                       Polar* polar,
+                       const Speed& mc,
+                       const int safetyAlt,
+                       WindMeasurementList& windList,
+                       const Vector& wind,
+                       const QVector<QPoint>* touchPoints=0 );
+
+  /**
+   * \return The result of the last calculation.
+   */
+  const Result& getResult() const
+  {
+    return m_result;
+  };
+
+  /**
+   * Removes all cached legs.
+   */
+  void clear();
+
+ private:
+
+  /** Cached calculation of a single leg. */
+  struct Leg
+  {
+    /** Inputs of the calculation. */
+    QPoint start;
+    QPoint end;
+    int    endAlt;
+    bool   finalLeg;
+    uint   conditions;
+    uint   gridVersion;
+
+    /** Required altitude MSL at the leg start or Unreachable. */
+    int startAlt;
+
+    /** Best speed at the leg start. */
+    Speed bestSpeed;
+
+    /** Smallest clearance of the glide path or ElevationGrid::NoTerrain. */
+    int clearance;
+
+    /** Position of the smallest clearance in KFLog coordinates. */
+    QPoint obstacle;
+  };
+
+  /** Required altitude of a leg, which cannot be flown against the wind. */
+  static const int Unreachable = INT_MAX;
+
+  /**
+   * Checks the glide conditions and the wind profile. If one of them has
+   * been changed, all cached legs become invalid.
+   */
+  void updateConditions( Polar* polar,
+                         const Speed& mc,
+                         const int safetyAlt,
+                         WindMeasurementList& windList,
+                         const Vector& wind );
+
+  /**
+   * \return The wind in the altitude band of the passed altitude.
+   */
+  Vector windAt( const double altitude );
+
+  /**
+   * Calculates the wind of an altitude band from the wind measurements.
+   */
+  Vector bandWind( const int band );
+
+  /**
+   * Calculates the glide ratio over ground for the passed course and wind.
+   */
+  double glideRatio( const double bearing, Vector wind, Speed& bestSpeed ) const;
+
+  /**
+   * Returns the cached leg or recalculates it, if its inputs have been
+   * changed.
+   */
+  const Leg& solveLeg( Leg& leg,
+                       const QPoint& start,
+                       const QPoint& end,
+                       const int endAlt,
+                       const bool finalLeg );
+
+  /** Result of the last calculation. */
+  Result m_result;
+
+  /** Legs between the task points, indexed by the task point of the leg end. */
+  QVector<Leg> m_legs;
+
+  /** Leg from the current position to the next task point. */
+  Leg m_firstLeg;
+
+  /** Glide conditions of the cached legs. */
+  Polar* m_polar;
+  int    m_water;
+  int    m_bugs;
+  Speed  m_mc;
+  int    m_safetyAlt;
+
+  /** Counter, which is incremented at every change of the conditions. */
+  uint m_conditions;
+
+  /** Wind per altitude band and the flag, if it was already calculated. */
+  QVector<Vector> m_bandWinds;
+  QVector<bool>   m_bandSet;
+
+  /** Wind measurements used by the last calculation. */
+  WindMeasurementList* m_windList;
+
+  /** Wind for altitudes without measurements and manual wind. */
+  Vector m_wind;
+  bool   m_manualWind;
+
+  /** Version of the wind measurements and age of the last wind profile. */
+  uint   m_windVersion;
+  qint64 m_windTime;
+
+  /** Terrain raster covering the route. */
+  ElevationGrid m_grid;
+};
+
+#endif
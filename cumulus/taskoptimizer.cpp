@@ -0,0 +1,495 @@
+/***********************************************************************
+**
+**   taskoptimizer.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include <QPointF>
+
+#include "flightclock.h"
+#include "generalconfig.h"
+#include "mapcalc.h"
+#include "taskoptimizer.h"
+#include "taskpoint.h"
+
+// Interval in seconds, after which the touch points are solved again.
+#define SOLVE_INTERVAL 5
+
+// Maximum number of passes over all touch points.
+#define MAX_PASSES 8
+
+// Movement in meters of all touch points, which ends the passes.
+#define CONVERGENCE 5.0
+
+// Number of samples per boundary piece of a figure.
+#define BOUNDARY_SAMPLES 48
+
+// Number of samples along the line between the neighbour points.
+#define LINE_SAMPLES 32
+
+// Number of iterations of the golden section search.
+#define GOLDEN_ITERATIONS 20
+
+// Meters per degree of latitude.
+#define METERS_PER_DEGREE 111194.93
+
+// KFLog coordinate units per degree.
+#define KFLOG_PER_DEGREE 600000.0
+
+namespace
+{
+  /**
+   * Plane coordinates in meters around a task point center. The x-axis points
+   * to the east, the y-axis to the north.
+   */
+  class LocalFrame
+  {
+  public:
+
+    LocalFrame( const QPoint& center ) :
+      m_center( center ),
+      m_cosLat( cos( center.x() / KFLOG_PER_DEGREE * M_PI / 180.0 ) )
+    {
+    }
+
+    QPointF toLocal( const QPoint& wgs ) const
+    {
+      return QPointF( (wgs.y() - m_center.y()) / KFLOG_PER_DEGREE * METERS_PER_DEGREE * m_cosLat,
+                      (wgs.x() - m_center.x()) / KFLOG_PER_DEGREE * METERS_PER_DEGREE );
+    }
+
+    QPoint toWgs( const QPointF& local ) const
+    {
+      return QPoint( m_center.x() + qRound( local.y() / METERS_PER_DEGREE * KFLOG_PER_DEGREE ),
+                     m_center.y() + qRound( local.x() / (METERS_PER_DEGREE * m_cosLat) * KFLOG_PER_DEGREE ) );
+    }
+
+  private:
+
+    QPoint m_center;
+    double m_cosLat;
+  };
+
+  /** An arc or a straight edge of a figure boundary. */
+  struct Piece
+  {
+    bool    arc;
+    double  radius;
+    double  startAngle;
+    double  angleSpan;
+    QPointF start;
+    QPointF end;
+
+    QPointF at( const double t ) const
+    {
+      if( arc )
+        {
+          // Angles are bearings counted clockwise from north.
+          const double a = startAngle + t * angleSpan;
+          return QPointF( radius * sin( a ), radius * cos( a ) );
+        }
+
+      return start + (end - start) * t;
+    }
+  };
+
+  /** Task point figure in the local frame of its center. */
+  class Figure
+  {
+  public:
+
+    Figure( const TaskPoint* tp ) :
+      m_scheme( tp->getActiveTaskPointFigureScheme() ),
+      m_inner( 0.0 ),
+      m_outer( 0.0 ),
+      m_minAngle( tp->minAngle ),
+      m_span( 2.0 * M_PI )
+    {
+      if( m_scheme == GeneralConfig::Circle )
+        {
+          m_outer = tp->getTaskCircleRadius().getMeters();
+          addArc( m_outer, 0.0, 2.0 * M_PI );
+          return;
+        }
+
+      m_inner = tp->getTaskSectorInnerRadius().getMeters();
+      m_outer = tp->getTaskSectorOuterRadius().getMeters();
+
+      if( tp->getTaskSectorAngle() < 360 )
+        {
+          m_span = MapCalc::normalize( tp->maxAngle - tp->minAngle );
+        }
+
+      const double maxAngle = m_minAngle + m_span;
+
+      addArc( m_outer, m_minAngle, m_span );
+
+      if( m_span >= 2.0 * M_PI )
+        {
+          if( m_inner > 0.0 )
+            {
+              addArc( m_inner, 0.0, 2.0 * M_PI );
+            }
+
+          return;
+        }
+
+      // A keyhole includes the inner circle outside of the sector.
+      const double innerSpan = (m_scheme == GeneralConfig::Keyhole) ? 2.0 * M_PI - m_span : -m_span;
+
+      addEdge( polar( m_outer, maxAngle ), polar( m_inner, maxAngle ) );
+      addArc( m_inner, maxAngle, innerSpan );
+      addEdge( polar( m_inner, m_minAngle ), polar( m_outer, m_minAngle ) );
+    }
+
+    bool contains( const QPointF& p ) const
+    {
+      const double d = sqrt( p.x() * p.x() + p.y() * p.y() );
+
+      if( m_scheme == GeneralConfig::Circle )
+        {
+          return d <= m_outer;
+        }
+
+      if( m_scheme == GeneralConfig::Keyhole && d <= m_inner )
+        {
+          return true;
+        }
+
+      if( d > m_outer || d < m_inner )
+        {
+          return false;
+        }
+
+      const double rel = MapCalc::normalize( atan2( p.x(), p.y() ) - m_minAngle );
+
+      return m_span >= 2.0 * M_PI || rel <= m_span;
+    }
+
+    const QVector<Piece>& pieces() const
+    {
+      return m_pieces;
+    }
+
+  private:
+
+    static QPointF polar( const double radius, const double angle )
+    {
+      return QPointF( radius * sin( angle ), radius * cos( angle ) );
+    }
+
+    void addArc( const double radius, const double startAngle, const double angleSpan )
+    {
+      Piece piece;
+      piece.arc        = true;
+      piece.radius     = radius;
+      piece.startAngle = startAngle;
+      piece.angleSpan  = angleSpan;
+      m_pieces.append( piece );
+    }
+
+    void addEdge( const QPointF& start, const QPointF& end )
+    {
+      Piece piece;
+      piece.arc        = false;
+      piece.radius     = 0.0;
+      piece.startAngle = 0.0;
+      piece.angleSpan  = 0.0;
+      piece.start      = start;
+      piece.end        = end;
+      m_pieces.append( piece );
+    }
+
+    enum GeneralConfig::ActiveTaskFigureScheme m_scheme;
+    double m_inner;
+    double m_outer;
+    double m_minAngle;
+    double m_span;
+    QVector<Piece> m_pieces;
+  };
+
+  double length( const QPointF& p )
+  {
+    return sqrt( p.x() * p.x() + p.y() * p.y() );
+  }
+
+  /** Route length over the point, the next point is optional. */
+  double routeLength( const QPointF& p, const QPointF& previous, const QPointF* next )
+  {
+    double result = length( p - previous );
+
+    if( next != 0 )
+      {
+        result += length( *next - p );
+      }
+
+    return result;
+  }
+}
+
+TaskOptimizer::TaskOptimizer() :
+  m_tpIndex(-1),
+  m_target(MinimumDistance),
+  m_remainingDistance(0.0),
+  m_solveTime(-1)
+{
+}
+
+TaskOptimizer::~TaskOptimizer()
+{
+}
+
+void TaskOptimizer::clear()
+{
+  m_centers.clear();
+  m_touchPoints.clear();
+  m_tpIndex = -1;
+  m_remainingDistance = 0.0;
+}
+
+bool TaskOptimizer::update( const QList<TaskPoint *>& tpList,
+                            const int tpIndex,
+                            const QPoint& position,
+                            const enum Target target )
+{
+  if( tpIndex < 0 || tpIndex >= tpList.size() )
+    {
+      clear();
+      return false;
+    }
+
+  bool changed = ( m_tpIndex != tpIndex || m_target != target ||
+                   m_centers.size() != tpList.size() ||
+                   m_solveTime < 0 ||
+                   FlightClock::elapsed( m_solveTime ) >= SOLVE_INTERVAL * 1000 );
+
+  for( int i = 0; i < tpList.size() && ! changed; i++ )
+    {
+      changed = ( m_centers.at(i) != tpList.at(i)->getWGSPosition() );
+    }
+
+  if( ! changed )
+    {
+      return false;
+    }
+
+  m_tpIndex = tpIndex;
+  m_target  = target;
+  m_solveTime = FlightClock::currentMSecsSinceEpoch();
+
+  m_centers.resize( tpList.size() );
+
+  for( int i = 0; i < tpList.size(); i++ )
+    {
+      m_centers[i] = tpList.at(i)->getWGSPosition();
+    }
+
+  solve( tpList, position );
+  return true;
+}
+
+void TaskOptimizer::solve( const QList<TaskPoint *>& tpList, const QPoint& position )
+{
+  const int count = tpList.size();
+
+  // The last solution is the start of the iteration, if it fits to the task.
+  if( m_touchPoints.size() != count )
+    {
+      m_touchPoints = m_centers;
+    }
+
+  for( int i = 0; i < m_tpIndex; i++ )
+    {
+      m_touchPoints[i] = m_centers.at(i);
+    }
+
+  for( int pass = 0; pass < MAX_PASSES; pass++ )
+    {
+      double moved = 0.0;
+
+      for( int i = m_tpIndex; i < count; i++ )
+        {
+          const TaskPoint* tp = tpList.at(i);
+
+          const enum GeneralConfig::ActiveTaskFigureScheme scheme =
+            tp->getActiveTaskPointFigureScheme();
+
+          if( tp->getTaskPointType() == TaskPointTypes::Start ||
+              scheme == GeneralConfig::Line || scheme == GeneralConfig::Undefined )
+            {
+              m_touchPoints[i] = m_centers.at(i);
+              continue;
+            }
+
+          const QPoint previous = (i == m_tpIndex) ? position : m_touchPoints.at(i - 1);
+
+          QPoint nextPoint;
+          const QPoint* next = 0;
+
+          if( i + 1 < count )
+            {
+              nextPoint = m_touchPoints.at(i + 1);
+              next = &nextPoint;
+            }
+
+          // A finish point is always reached on the shortest way.
+          const bool maximize = ( m_target == MaximumDistance &&
+                                  tp->getTaskPointType() == TaskPointTypes::Turn );
+
+          QPoint point = optimizePoint( tp, previous, next, maximize );
+
+          QPoint oldPoint = m_touchPoints.at(i);
+          moved = qMax( moved, MapCalc::dist( &oldPoint, &point ) * 1000.0 );
+
+          m_touchPoints[i] = point;
+        }
+
+      if( moved < CONVERGENCE )
+        {
+          break;
+        }
+    }
+
+  // The leg to the next touch point changes with every position and is
+  // added at the query.
+  QPoint p1 = m_touchPoints.at( m_tpIndex );
+  m_remainingDistance = 0.0;
+
+  for( int i = m_tpIndex + 1; i < count; i++ )
+    {
+      QPoint p2 = m_touchPoints.at(i);
+      m_remainingDistance += MapCalc::dist( &p1, &p2 );
+      p1 = p2;
+    }
+}
+
+double TaskOptimizer::getRemainingDistance( const QPoint& position ) const
+{
+  if( ! isValid() )
+    {
+      return 0.0;
+    }
+
+  QPoint p1 = position;
+  QPoint p2 = m_touchPoints.at( m_tpIndex );
+
+  return MapCalc::dist( &p1, &p2 ) + m_remainingDistance;
+}
+
+QPoint TaskOptimizer::optimizePoint( const TaskPoint* tp,
+                                     const QPoint& previous,
+                                     const QPoint* next,
+                                     const bool maximize ) const
+{
+  const LocalFrame frame( tp->getWGSPosition() );
+  const Figure figure( tp );
+
+  const QPointF a = frame.toLocal( previous );
+  const QPointF b = next ? frame.toLocal( *next ) : a;
+  const QPointF* pb = next ? &b : 0;
+
+  if( ! maximize )
+    {
+      // If the line between the neighbours crosses the figure, its points in
+      // the figure are optimal. The one nearest to the center is taken.
+      QPointF best;
+      double bestDist = -1.0;
+
+      for( int i = 0; i <= LINE_SAMPLES; i++ )
+        {
+          const QPointF p = a + (b - a) * (double( i ) / LINE_SAMPLES);
+
+          if( figure.contains( p ) && ( bestDist < 0.0 || length( p ) < bestDist ) )
+            {
+              best = p;
+              bestDist = length( p );
+            }
+        }
+
+      if( bestDist >= 0.0 )
+        {
+          return frame.toWgs( best );
+        }
+    }
+
+  // Otherwise the optimum is on the boundary of the figure.
+  const double sign = maximize ? -1.0 : 1.0;
+  const QVector<Piece>& pieces = figure.pieces();
+
+  int bestPiece = -1;
+  double bestT = 0.0;
+  double bestValue = 0.0;
+
+  for( int j = 0; j < pieces.size(); j++ )
+    {
+      for( int i = 0; i <= BOUNDARY_SAMPLES; i++ )
+        {
+          const double t = double( i ) / BOUNDARY_SAMPLES;
+          const double value = sign * routeLength( pieces.at(j).at( t ), a, pb );
+
+          if( bestPiece < 0 || value < bestValue )
+            {
+              bestPiece = j;
+              bestT = t;
+              bestValue = value;
+            }
+        }
+    }
+
+  if( bestPiece < 0 )
+    {
+      return tp->getWGSPosition();
+    }
+
+  // Refine the best sample between its neighbour samples.
+  const Piece& piece = pieces.at( bestPiece );
+  const double ratio = (sqrt( 5.0 ) - 1.0) / 2.0;
+
+  double lo = qMax( 0.0, bestT - 1.0 / BOUNDARY_SAMPLES );
+  double hi = qMin( 1.0, bestT + 1.0 / BOUNDARY_SAMPLES );
+
+  double t1 = hi - ratio * (hi - lo);
+  double t2 = lo + ratio * (hi - lo);
+  double v1 = sign * routeLength( piece.at( t1 ), a, pb );
+  double v2 = sign * routeLength( piece.at( t2 ), a, pb );
+
+  for( int i = 0; i < GOLDEN_ITERATIONS; i++ )
+    {
+      if( v1 < v2 )
+        {
+          hi = t2;
+          t2 = t1;
+          v2 = v1;
+          t1 = hi - ratio * (hi - lo);
+          v1 = sign * routeLength( piece.at( t1 ), a, pb );
+        }
+      else
+        {
+          lo = t1;
+          t1 = t2;
+          v1 = v2;
+          t2 = lo + ratio * (hi - lo);
+          v2 = sign * routeLength( piece.at( t2 ), a, pb );
+        }
+    }
+
+  const double t = (lo + hi) / 2.0;
+
+  if( sign * routeLength( piece.at( t ), a, pb ) < bestValue )
+    {
+      return frame.toWgs( piece.at( t ) );
+    }
+
+  return frame.toWgs( piece.at( bestT ) );
+}
@@ -0,0 +1,164 @@
+/***********************************************************************
+**
+**   taskoptimizer.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class TaskOptimizer
+ *
+ * \brief Optimal touch points inside the task point figures.
+ *
+ * A task point is passed, when its circle, sector or keyhole figure is
+ * touched. Therefore the route over the remaining task points need not to
+ * lead over the task point centers. The optimizer determines a touch point
+ * inside every figure, so that the remaining route becomes as short as
+ * possible. For assigned areas the route can be made as long as possible
+ * instead.
+ *
+ * The touch points are solved iteratively. In every pass each touch point is
+ * moved to the optimum of its figure between the touch points of the
+ * previous and the next task point. If the straight line between both
+ * neighbours crosses the figure, any crossing point is optimal. Otherwise
+ * the optimum is on the figure boundary, which is sampled and refined by a
+ * golden section search. The passes are repeated, until no touch point
+ * moves any more.
+ *
+ * Start points and line figures are always passed at their centers.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef TASK_OPTIMIZER_H
+#define TASK_OPTIMIZER_H
+
+#include <QList>
+#include <QPoint>
+#include <QVector>
+
+class TaskPoint;
+
+class TaskOptimizer
+{
+ public:
+
+  /** Objective of the optimization. */
+  enum Target
+  {
+    /** Shortest route, that is the fastest route of a racing task. */
+    MinimumDistance,
+
+    /** Longest route through assigned areas. */
+    MaximumDistance
+  };
+
+  TaskOptimizer();
+
+  virtual ~TaskOptimizer();
+
+  /**
+   * Solves the touch points again, if the task or the next task point have
+   * been changed or if the last solution is older than the solve interval.
+   *
+   * \param tpList Task points of the flight task.
+   *
+   * \param tpIndex Index of the next task point.
+   *
+   * \param position Current position in KFLog coordinates.
+   *
+   * \param target Objective of the optimization.
+   *
+   * \return True, if the touch points have been solved again.
+   */
+  bool update( const QList<TaskPoint *>& tpList,
+               const int tpIndex,
+               const QPoint& position,
+               const enum Target target=MinimumDistance );
+
+  /**
+   * Removes the solution.
+   */
+  void clear();
+
+  /**
+   * \return True, if a solution is available.
+   */
+  bool isValid() const
+  {
+    return ! m_touchPoints.isEmpty();
+  };
+
+  /**
+   * \return The index of the next task point of the solution.
+   */
+  int getTpIndex() const
+  {
+    return m_tpIndex;
+  };
+
+  /**
+   * \return The touch points in KFLog coordinates, indexed like the task
+   *         point list. Task points before the next one keep their centers.
+   */
+  const QVector<QPoint>& getTouchPoints() const
+  {
+    return m_touchPoints;
+  };
+
+  /**
+   * \param position Current position in KFLog coordinates.
+   *
+   * \return The remaining distance in km from the position over all touch
+   *         points of the solution.
+   */
+  double getRemainingDistance( const QPoint& position ) const;
+
+ private:
+
+  /**
+   * Calculates the touch points.
+   */
+  void solve( const QList<TaskPoint *>& tpList, const QPoint& position );
+
+  /**
+   * Moves the touch point of a task point to the optimum between the
+   * previous and the next point.
+   *
+   * \return The new touch point in KFLog coordinates.
+   */
+  QPoint optimizePoint( const TaskPoint* tp,
+                        const QPoint& previous,
+                        const QPoint* next,
+                        const bool maximize ) const;
+
+  /** Centers of the task points, used to detect task changes. */
+  QVector<QPoint> m_centers;
+
+  /** Touch points of the last solution. */
+  QVector<QPoint> m_touchPoints;
+
+  /** Index of the next task point. */
+  int m_tpIndex;
+
+  /** Objective of the last solution. */
+  enum Target m_target;
+
+  /** Distance in km from the next touch point to the end of the task. */
+  double m_remainingDistance;
+
+  /** Flight clock time in ms of the last solution, -1 if none. */
+  qint64 m_solveTime;
+};
+
+#endif
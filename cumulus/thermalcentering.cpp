@@ -0,0 +1,214 @@
+/***********************************************************************
+**
+**   thermalcentering.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include <QtCore>
+
+#include "mapcalc.h"
+#include "thermalcentering.h"
+
+// Time span in seconds, over which the climb rate is derived.
+#define CLIMB_WINDOW 2.0
+
+// Time constant in seconds of the decay, which is about one circle.
+#define DECAY_TIME 25.0
+
+// Circling time in seconds, before an estimate is provided.
+#define MIN_CIRCLING_TIME 20.0
+
+// Estimates with a larger offset in meters are rejected.
+#define MAX_OFFSET 500.0
+
+// Gravity in m/s^2 for the total energy height.
+#define GRAVITY 9.81
+
+// Meters per KFLog coordinate unit of the latitude.
+#define KFLOG_TO_M (RADIUS * M_PI / (180.0 * 600000.0))
+
+ThermalCentering::ThermalCentering()
+{
+  reset();
+}
+
+ThermalCentering::~ThermalCentering()
+{
+}
+
+void ThermalCentering::reset()
+{
+  m_first = 0;
+  m_count = 0;
+  m_startTime = -1;
+  m_origin = QPoint();
+  m_cosLat = 1.0;
+  m_sumOne = 0.0;
+  m_sumClimb = 0.0;
+  m_sumWeight = 0.0;
+  m_sumWeightX = 0.0;
+  m_sumWeightY = 0.0;
+  m_sumWeightTime = 0.0;
+  m_sumWeightClimb = 0.0;
+  m_firstTime = 0.0;
+  m_lastTime = -1.0;
+  m_driftX = 0.0;
+  m_driftY = 0.0;
+}
+
+void ThermalCentering::addSample( const FlightSample& sample, Vector& wind )
+{
+  if( m_startTime < 0 )
+    {
+      m_startTime = sample.time;
+      m_origin = sample.getPosition();
+      m_cosLat = cos( m_origin.x() * M_PI / (180.0 * 600000.0) );
+    }
+
+  Point p;
+  p.time = (sample.time - m_startTime) / 1000.0;
+  p.y = (sample.lat - m_origin.x()) * KFLOG_TO_M;
+  p.x = (sample.lon - m_origin.y()) * KFLOG_TO_M * m_cosLat;
+
+  // The total energy removes the climb of a pull up.
+  p.energy = sample.STDAltitude;
+
+  if( sample.airspeed > 0.0 )
+    {
+      p.energy += sample.airspeed * sample.airspeed / (2.0 * GRAVITY);
+    }
+
+  if( m_count == WindowSize )
+    {
+      m_first = (m_first + 1) % WindowSize;
+      m_count--;
+    }
+
+  m_window[(m_first + m_count) % WindowSize] = p;
+  m_count++;
+
+  while( m_count > 2 && p.time - m_window[m_first].time > CLIMB_WINDOW )
+    {
+      m_first = (m_first + 1) % WindowSize;
+      m_count--;
+    }
+
+  // The wind vector points to the direction, from which the wind blows.
+  m_driftX = -wind.getYMps();
+  m_driftY = -wind.getXMps();
+
+  const Point& oldest = m_window[m_first];
+  const double dt = p.time - oldest.time;
+
+  if( m_count < 2 || dt < CLIMB_WINDOW * 0.5 )
+    {
+      return;
+    }
+
+  const double climb = (p.energy - oldest.energy) / dt;
+
+  // The climb is valid for the middle of the window.
+  const Point& mid = m_window[(m_first + m_count / 2) % WindowSize];
+
+  if( m_lastTime >= 0.0 )
+    {
+      const double decay = exp( -(mid.time - m_lastTime) / DECAY_TIME );
+
+      m_sumOne *= decay;
+      m_sumClimb *= decay;
+      m_sumWeight *= decay;
+      m_sumWeightX *= decay;
+      m_sumWeightY *= decay;
+      m_sumWeightTime *= decay;
+      m_sumWeightClimb *= decay;
+    }
+  else
+    {
+      m_firstTime = mid.time;
+    }
+
+  m_sumOne += 1.0;
+  m_sumClimb += climb;
+
+  // Only the climb above the mean attracts the core.
+  const double weight = qMax( 0.0, climb - m_sumClimb / m_sumOne );
+
+  m_sumWeight += weight;
+  m_sumWeightX += weight * mid.x;
+  m_sumWeightY += weight * mid.y;
+  m_sumWeightTime += weight * mid.time;
+  m_sumWeightClimb += weight * climb;
+
+  m_lastTime = mid.time;
+}
+
+void ThermalCentering::center( double& x, double& y ) const
+{
+  // The samples have drifted with the air mass until the last sample.
+  const double now = m_window[(m_first + m_count - 1) % WindowSize].time;
+  const double drift = now * m_sumWeight - m_sumWeightTime;
+
+  x = (m_sumWeightX + m_driftX * drift) / m_sumWeight;
+  y = (m_sumWeightY + m_driftY * drift) / m_sumWeight;
+}
+
+bool ThermalCentering::isValid() const
+{
+  if( m_count == 0 || m_lastTime - m_firstTime < MIN_CIRCLING_TIME ||
+      m_sumWeight <= 0.0 )
+    {
+      return false;
+    }
+
+  return getOffsetDistance() <= MAX_OFFSET;
+}
+
+QPoint ThermalCentering::getCenter() const
+{
+  double x, y;
+
+  center( x, y );
+
+  return QPoint( m_origin.x() + int( y / KFLOG_TO_M ),
+                 m_origin.y() + int( x / (KFLOG_TO_M * m_cosLat) ) );
+}
+
+double ThermalCentering::getOffsetDistance() const
+{
+  double x, y;
+
+  center( x, y );
+
+  const Point& last = m_window[(m_first + m_count - 1) % WindowSize];
+
+  return hypot( x - last.x, y - last.y );
+}
+
+int ThermalCentering::getOffsetBearing() const
+{
+  double x, y;
+
+  center( x, y );
+
+  const Point& last = m_window[(m_first + m_count - 1) % WindowSize];
+
+  int bearing = int( rint( atan2( x - last.x, y - last.y ) * 180.0 / M_PI ) );
+
+  return bearing < 0 ? bearing + 360 : bearing;
+}
+
+double ThermalCentering::getCoreClimb() const
+{
+  return m_sumWeight > 0.0 ? m_sumWeightClimb / m_sumWeight : 0.0;
+}
@@ -0,0 +1,151 @@
+/***********************************************************************
+**
+**   thermalcentering.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class ThermalCentering
+ *
+ * \brief Estimates the thermal core during circling.
+ *
+ * The climb rate is derived from the change of the total energy height
+ * over a short window of the flight samples and is assigned to the
+ * position in the middle of the window. That avoids the delay of the
+ * averaged variometer value.
+ *
+ * The core is the centroid of all positions, weighted by the climb above
+ * the mean climb. The positions are converted into meters around the point,
+ * where the circling started. All sums decay exponentially with a time
+ * constant of about one circle, so that the estimate follows the thermal.
+ *
+ * The thermal drifts with the wind. A sample taken at time t lies at
+ * position p + drift * (T - t) in the air mass at the current time T. Due
+ * to that linearity, the drift correction is applied to the sums at the
+ * query and every sample costs only a constant time.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef THERMAL_CENTERING_H
+#define THERMAL_CENTERING_H
+
+#include <QPoint>
+
+#include "flightsample.h"
+#include "vector.h"
+
+class ThermalCentering
+{
+ public:
+
+  ThermalCentering();
+
+  virtual ~ThermalCentering();
+
+  /** Removes all samples. Called, when the circling ends. */
+  void reset();
+
+  /**
+   * Adds a flight sample of the circling.
+   *
+   * \param sample The new flight sample.
+   *
+   * \param wind The current wind.
+   */
+  void addSample( const FlightSample& sample, Vector& wind );
+
+  /**
+   * \return True, if enough samples around a circle are collected.
+   */
+  bool isValid() const;
+
+  /**
+   * \return The estimated core in KFLog coordinates at the time of the
+   *         last sample.
+   */
+  QPoint getCenter() const;
+
+  /**
+   * \return The distance in meters from the last position to the core.
+   */
+  double getOffsetDistance() const;
+
+  /**
+   * \return The direction in degrees from the last position to the core.
+   */
+  int getOffsetBearing() const;
+
+  /**
+   * \return The mean climb in m/s at the core.
+   */
+  double getCoreClimb() const;
+
+ private:
+
+  /** A sample of the climb window in local coordinates. */
+  struct Point
+  {
+    /** Time in seconds since the begin of the circling. */
+    double time;
+
+    /** East and north offset in meters. */
+    double x;
+    double y;
+
+    /** Total energy height in meters. */
+    double energy;
+  };
+
+  /** Calculates the drift corrected core in local coordinates. */
+  void center( double& x, double& y ) const;
+
+  /** Number of slots of the climb window. */
+  enum { WindowSize = 64 };
+
+  /** The recent samples, which form the climb window. */
+  Point m_window[WindowSize];
+
+  /** Index of the oldest and the number of samples in the window. */
+  int m_first;
+  int m_count;
+
+  /** Start of the circling in ms since the epoch. */
+  qint64 m_startTime;
+
+  /** Reference position of the local coordinates. */
+  QPoint m_origin;
+  double m_cosLat;
+
+  /** Decayed sums of the climb and its count. */
+  double m_sumOne;
+  double m_sumClimb;
+
+  /** Decayed sums of the weights, the weighted positions and times. */
+  double m_sumWeight;
+  double m_sumWeightX;
+  double m_sumWeightY;
+  double m_sumWeightTime;
+  double m_sumWeightClimb;
+
+  /** Time in seconds of the first and the last added climb. */
+  double m_firstTime;
+  double m_lastTime;
+
+  /** Drift of the air mass in m/s to east and north. */
+  double m_driftX;
+  double m_driftY;
+};
+
+#endif
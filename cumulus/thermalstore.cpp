@@ -0,0 +1,420 @@
+/***********************************************************************
+**
+**   thermalstore.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include <QtCore>
+
+#include "flightanalysis.h"
+#include "generalconfig.h"
+#include "mapcalc.h"
+#include "resource.h"
+#include "thermalstore.h"
+
+// Size of a grid cell in KFLog coordinates, which is 0.01 degree.
+#define CELL_SIZE 6000
+
+// Half life of a thermal weight in days.
+#define HALF_LIFE 365.0
+
+// Cells with a smaller decayed weight are not reported.
+#define MIN_WEIGHT 0.25
+
+// Meters per KFLog coordinate unit of the latitude.
+#define KFLOG_TO_M (RADIUS * M_PI / (180.0 * 600000.0))
+
+// Type and version of the store file.
+#define FILE_TYPE_THERMALS "Cumulus-Thermals"
+#define FILE_VERSION_THERMALS 1
+
+namespace
+{
+  /** \return The factor, to which a weight has decayed after the days. */
+  double decay( const int days )
+  {
+    return days <= 0 ? 1.0 : pow( 0.5, days / HALF_LIFE );
+  }
+}
+
+ThermalStore::ThermalStore() :
+  m_today( QDate::currentDate().toJulianDay() ),
+  m_modified(false)
+{
+}
+
+ThermalStore::~ThermalStore()
+{
+}
+
+void ThermalStore::clear()
+{
+  m_cells.clear();
+  m_imported.clear();
+  m_modified = true;
+}
+
+int ThermalStore::cellIndex( const int coordinate )
+{
+  // Rounds down for negative coordinates too.
+  return coordinate >= 0 ? coordinate / CELL_SIZE :
+                           -((-coordinate - 1) / CELL_SIZE) - 1;
+}
+
+void ThermalStore::addThermal( const QPoint& center,
+                               const double climb,
+                               const int base,
+                               const int top,
+                               const int day )
+{
+  const int latCell = cellIndex( center.x() );
+  const int lonCell = cellIndex( center.y() );
+
+  QHash<qint64, Cell>::iterator it = m_cells.find( cellKey( latCell, lonCell ) );
+
+  if( it == m_cells.end() )
+    {
+      Cell cell;
+      cell.day = day;
+      cell.weight = 0.0;
+      cell.climb = 0.0;
+      cell.lat = 0.0;
+      cell.lon = 0.0;
+      cell.base = 0.0;
+      cell.top = 0.0;
+
+      it = m_cells.insert( cellKey( latCell, lonCell ), cell );
+    }
+
+  Cell& cell = it.value();
+
+  // The older part is aged to the newer day.
+  double weight = 1.0;
+
+  if( day > cell.day )
+    {
+      const float factor = decay( day - cell.day );
+
+      cell.weight *= factor;
+      cell.climb *= factor;
+      cell.lat *= factor;
+      cell.lon *= factor;
+      cell.base *= factor;
+      cell.top *= factor;
+      cell.day = day;
+    }
+  else
+    {
+      weight = decay( cell.day - day );
+    }
+
+  cell.weight += weight;
+  cell.climb += weight * climb;
+  cell.lat += weight * (center.x() - latCell * CELL_SIZE);
+  cell.lon += weight * (center.y() - lonCell * CELL_SIZE);
+  cell.base += weight * base;
+  cell.top += weight * top;
+
+  m_today = qMax( m_today, day );
+  m_modified = true;
+}
+
+int ThermalStore::addFlight( const IgcParser::Flight& flight, const QString& name )
+{
+  if( m_imported.contains( name ) )
+    {
+      return 0;
+    }
+
+  FlightAnalysis analysis;
+  analysis.analyse( flight );
+
+  const QVector<FlightAnalysis::Thermal>& thermals = analysis.thermals();
+
+  const int day = flight.date.isValid() ? flight.date.toJulianDay() : m_today;
+
+  for( int i = 0; i < thermals.size(); i++ )
+    {
+      const FlightAnalysis::Thermal& t = thermals.at(i);
+
+      addThermal( t.center, t.climb, t.base, t.top, day );
+    }
+
+  m_imported.insert( name );
+  m_modified = true;
+
+  return thermals.size();
+}
+
+bool ThermalStore::makeHotspot( const qint64 key, const Cell& cell, Hotspot& hotspot ) const
+{
+  const double weight = cell.weight * decay( m_today - cell.day );
+
+  if( weight < MIN_WEIGHT )
+    {
+      return false;
+    }
+
+  const int latCell = qint32( quint64( key ) >> 32 );
+  const int lonCell = qint32( key & 0xffffffff );
+
+  // The means of the sums are not changed by the decay.
+  hotspot.position = QPoint( latCell * CELL_SIZE + int( cell.lat / cell.weight ),
+                             lonCell * CELL_SIZE + int( cell.lon / cell.weight ) );
+  hotspot.climb = cell.climb / cell.weight;
+  hotspot.base = int( cell.base / cell.weight );
+  hotspot.top = int( cell.top / cell.weight );
+  hotspot.weight = weight;
+
+  return true;
+}
+
+bool ThermalStore::hotspot( const QPoint& position, Hotspot& hotspot ) const
+{
+  const qint64 key = cellKey( cellIndex( position.x() ), cellIndex( position.y() ) );
+
+  QHash<qint64, Cell>::const_iterator it = m_cells.constFind( key );
+
+  if( it == m_cells.constEnd() )
+    {
+      return false;
+    }
+
+  return makeHotspot( key, it.value(), hotspot );
+}
+
+QVector<ThermalStore::Hotspot> ThermalStore::hotspots( const QRect& area,
+                                                       const double minClimb ) const
+{
+  QVector<Hotspot> result;
+
+  const QRect r = area.normalized();
+
+  const int lat1 = cellIndex( r.top() );
+  const int lat2 = cellIndex( r.bottom() );
+  const int lon1 = cellIndex( r.left() );
+  const int lon2 = cellIndex( r.right() );
+
+  const qint64 areaCells = qint64( lat2 - lat1 + 1 ) * (lon2 - lon1 + 1);
+
+  Hotspot spot;
+
+  if( areaCells > m_cells.size() )
+    {
+      // A large area is checked by all occupied cells.
+      QHash<qint64, Cell>::const_iterator it;
+
+      for( it = m_cells.constBegin(); it != m_cells.constEnd(); ++it )
+        {
+          if( makeHotspot( it.key(), it.value(), spot ) &&
+              spot.climb >= minClimb &&
+              r.contains( spot.position.y(), spot.position.x() ) )
+            {
+              result.append( spot );
+            }
+        }
+
+      return result;
+    }
+
+  for( int lat = lat1; lat <= lat2; lat++ )
+    {
+      for( int lon = lon1; lon <= lon2; lon++ )
+        {
+          const qint64 key = cellKey( lat, lon );
+
+          QHash<qint64, Cell>::const_iterator it = m_cells.constFind( key );
+
+          if( it != m_cells.constEnd() &&
+              makeHotspot( key, it.value(), spot ) &&
+              spot.climb >= minClimb )
+            {
+              result.append( spot );
+            }
+        }
+    }
+
+  return result;
+}
+
+bool ThermalStore::nearestGoodThermal( const QPoint& position,
+                                       const double minClimb,
+                                       const double maxDistance,
+                                       Hotspot& hotspot ) const
+{
+  if( m_cells.isEmpty() )
+    {
+      return false;
+    }
+
+  const int latCell = cellIndex( position.x() );
+  const int lonCell = cellIndex( position.y() );
+
+  // The smaller side of a cell limits the distance of a ring of cells.
+  const double cosLat = qMax( 0.01, cos( position.x() * M_PI / (180.0 * 600000.0) ) );
+  const double cellSide = CELL_SIZE * KFLOG_TO_M * cosLat;
+
+  const int maxRing = int( ceil( maxDistance / cellSide ) ) + 1;
+
+  double bestDistance = maxDistance;
+  bool found = false;
+
+  Hotspot candidate;
+
+  for( int ring = 0; ring <= maxRing; ring++ )
+    {
+      // All cells of the ring are at least that far away.
+      if( (ring - 1) * cellSide > bestDistance )
+        {
+          break;
+        }
+
+      for( int dlat = -ring; dlat <= ring; dlat++ )
+        {
+          // Only the border cells of the square belong to the ring.
+          const int step = (dlat == -ring || dlat == ring) ? 1 : 2 * ring;
+
+          for( int dlon = -ring; dlon <= ring; dlon += qMax( 1, step ) )
+            {
+              const qint64 key = cellKey( latCell + dlat, lonCell + dlon );
+
+              QHash<qint64, Cell>::const_iterator it = m_cells.constFind( key );
+
+              if( it == m_cells.constEnd() ||
+                  ! makeHotspot( key, it.value(), candidate ) ||
+                  candidate.climb < minClimb )
+                {
+                  continue;
+                }
+
+              QPoint p1( position );
+              QPoint p2( candidate.position );
+
+              const double distance = MapCalc::dist( &p1, &p2 ) * 1000.0;
+
+              if( distance <= bestDistance )
+                {
+                  bestDistance = distance;
+                  hotspot = candidate;
+                  found = true;
+                }
+            }
+        }
+    }
+
+  return found;
+}
+
+QString ThermalStore::defaultFileName()
+{
+  return GeneralConfig::instance()->getUserDataDirectory() + "/thermals.dat";
+}
+
+bool ThermalStore::load( const QString& fileName )
+{
+  m_cells.clear();
+  m_imported.clear();
+  m_modified = false;
+
+  QFile file( fileName );
+
+  if( ! file.exists() )
+    {
+      return true;
+    }
+
+  if( ! file.open( QIODevice::ReadOnly ) )
+    {
+      qWarning() << "ThermalStore: Cannot open file" << fileName;
+      return false;
+    }
+
+  QDataStream in( &file );
+  in.setVersion( QDataStream::Qt_4_7 );
+
+  quint32 magic;
+  QByteArray type;
+  quint8 version;
+  quint32 count;
+
+  in >> magic >> type >> version;
+
+  if( magic != KFLOG_FILE_MAGIC || type != FILE_TYPE_THERMALS ||
+      version != FILE_VERSION_THERMALS )
+    {
+      qWarning() << "ThermalStore: Wrong file format" << fileName;
+      return false;
+    }
+
+  in >> count;
+
+  m_cells.reserve( count );
+
+  for( quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++ )
+    {
+      qint64 key;
+      Cell cell;
+
+      in >> key >> cell.day >> cell.weight >> cell.climb
+         >> cell.lat >> cell.lon >> cell.base >> cell.top;
+
+      m_cells.insert( key, cell );
+    }
+
+  in >> m_imported;
+
+  if( in.status() != QDataStream::Ok )
+    {
+      qWarning() << "ThermalStore: Read error" << fileName;
+      m_cells.clear();
+      m_imported.clear();
+      return false;
+    }
+
+  return true;
+}
+
+bool ThermalStore::save( const QString& fileName )
+{
+  QFile file( fileName );
+
+  if( ! file.open( QIODevice::WriteOnly ) )
+    {
+      qWarning() << "ThermalStore: Cannot open file" << fileName;
+      return false;
+    }
+
+  QDataStream out( &file );
+  out.setVersion( QDataStream::Qt_4_7 );
+
+  out << quint32( KFLOG_FILE_MAGIC );
+  out << QByteArray( FILE_TYPE_THERMALS );
+  out << quint8( FILE_VERSION_THERMALS );
+  out << quint32( m_cells.size() );
+
+  QHash<qint64, Cell>::const_iterator it;
+
+  for( it = m_cells.constBegin(); it != m_cells.constEnd(); ++it )
+    {
+      const Cell& cell = it.value();
+
+      out << it.key() << cell.day << cell.weight << cell.climb
+          << cell.lat << cell.lon << cell.base << cell.top;
+    }
+
+  out << m_imported;
+
+  m_modified = false;
+  return out.status() == QDataStream::Ok;
+}
@@ -0,0 +1,245 @@
+/***********************************************************************
+**
+**   thermalstore.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+/**
+ * \class ThermalStore
+ *
+ * \brief Learned thermal map from the own circling phases.
+ *
+ * Every circling phase of a flight is recorded with its center, its climb
+ * rate and its altitude band. The phases are collected from the running
+ * flight or imported from IGC files.
+ *
+ * The store is a uniform grid of 0.01 degree cells. Every occupied cell
+ * holds only the weighted sums of its thermals, so that a lookup costs
+ * the same, how many flights were recorded. A hash maps the cell
+ * coordinates to the cell.
+ *
+ * The weights decay with a half life of a year. The sums of a cell are
+ * aged, when a thermal is added, and the remaining decay is applied at
+ * the query.
+ *
+ * The store is saved in the user data directory.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+
+#ifndef THERMAL_STORE_H
+#define THERMAL_STORE_H
+
+#include <QHash>
+#include <QPoint>
+#include <QRect>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "igcparser.h"
+
+class ThermalStore
+{
+ public:
+
+  /** A learned thermal of a cell. */
+  struct Hotspot
+  {
+    /** Mean center in KFLog coordinates. */
+    QPoint position;
+
+    /** Mean climb rate in m/s. */
+    double climb;
+
+    /** Mean altitude in meters, at which the thermals were entered. */
+    int base;
+
+    /** Mean altitude in meters, at which the thermals were left. */
+    int top;
+
+    /** Decayed number of thermals. */
+    double weight;
+  };
+
+  ThermalStore();
+
+  virtual ~ThermalStore();
+
+  /** Removes all thermals. */
+  void clear();
+
+  /**
+   * Adds a circling phase.
+   *
+   * \param center Center of the circles in KFLog coordinates.
+   *
+   * \param climb Climb rate in m/s.
+   *
+   * \param base Altitude in meters at the begin.
+   *
+   * \param top Altitude in meters at the end.
+   *
+   * \param day Julian day of the flight.
+   */
+  void addThermal( const QPoint& center,
+                   const double climb,
+                   const int base,
+                   const int top,
+                   const int day );
+
+  /**
+   * Adds the circling phases of a parsed IGC file. A file is imported only
+   * once.
+   *
+   * \param flight The parsed flight.
+   *
+   * \param name The name of the IGC file.
+   *
+   * \return The number of added thermals.
+   */
+  int addFlight( const IgcParser::Flight& flight, const QString& name );
+
+  /**
+   * \return True, if the IGC file has been imported already.
+   */
+  bool isImported( const QString& name ) const
+  {
+    return m_imported.contains( name );
+  };
+
+  /**
+   * Marks an IGC file as imported. That is used for the file of the running
+   * flight, whose thermals are recorded directly.
+   */
+  void setImported( const QString& name )
+  {
+    m_imported.insert( name );
+    m_modified = true;
+  };
+
+  /**
+   * Looks up the cell, which contains the position.
+   *
+   * \return True, if the cell contains a thermal.
+   */
+  bool hotspot( const QPoint& position, Hotspot& hotspot ) const;
+
+  /**
+   * \return All thermals in the area, which have at least the climb rate
+   *         in m/s. The area uses the x-axis for the longitude and the
+   *         y-axis for the latitude like MapMatrix::getViewBorder().
+   */
+  QVector<Hotspot> hotspots( const QRect& area, const double minClimb ) const;
+
+  /**
+   * Searches the nearest thermal with at least the climb rate.
+   *
+   * \param position The search center in KFLog coordinates.
+   *
+   * \param minClimb The minimum climb rate in m/s.
+   *
+   * \param maxDistance The search radius in meters.
+   *
+   * \param hotspot The found thermal.
+   *
+   * \return True, if a thermal was found.
+   */
+  bool nearestGoodThermal( const QPoint& position,
+                           const double minClimb,
+                           const double maxDistance,
+                           Hotspot& hotspot ) const;
+
+  /**
+   * \return The number of occupied cells.
+   */
+  int size() const
+  {
+    return m_cells.size();
+  };
+
+  /**
+   * \return True, if the store was changed since the last load or save.
+   */
+  bool isModified() const
+  {
+    return m_modified;
+  };
+
+  /**
+   * Loads the store from a file. Old data are removed.
+   *
+   * \return True in case of success otherwise false.
+   */
+  bool load( const QString& fileName );
+
+  /**
+   * Saves the store into a file.
+   *
+   * \return True in case of success otherwise false.
+   */
+  bool save( const QString& fileName );
+
+  /**
+   * \return The default file of the store in the user data directory.
+   */
+  static QString defaultFileName();
+
+ private:
+
+  /** Weighted sums of the thermals of a cell. */
+  struct Cell
+  {
+    /** Julian day, to which the sums are aged. */
+    qint32 day;
+
+    float weight;
+    float climb;
+
+    /** Center offsets to the cell origin in KFLog coordinates. */
+    float lat;
+    float lon;
+
+    float base;
+    float top;
+  };
+
+  /** \return The key of the cell with the given cell coordinates. */
+  static qint64 cellKey( const int latCell, const int lonCell )
+  {
+    return qint64( (quint64( quint32( latCell ) ) << 32) | quint32( lonCell ) );
+  };
+
+  /** \return The cell coordinate of a KFLog coordinate. */
+  static int cellIndex( const int coordinate );
+
+  /**
+   * Creates the thermal of a cell.
+   *
+   * \return False, if the cell has no weight left.
+   */
+  bool makeHotspot( const qint64 key, const Cell& cell, Hotspot& hotspot ) const;
+
+  QHash<qint64, Cell> m_cells;
+
+  /** Names of the imported IGC files. */
+  QSet<QString> m_imported;
+
+  /** Julian day, to which the weights are decayed at the queries. */
+  int m_today;
+
+  bool m_modified;
+};
+
+#endif
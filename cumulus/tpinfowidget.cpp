@@ -381,13 +381,7 @@ void TPInfoWidget::prepareSwitchText( const int currentTpIndex,
 	"</th></tr>";
 
       // distance in km to final target must be calculated
-      double finalDistance = dist2Next;
-
-      for( int loop=currentTpIndex+2; loop <= tpList.count() - 1; loop++ )
-	  {
-	    // qDebug("distance: %f", tpList.at(loop)->distance);
-	    finalDistance += tpList.at(loop)->distance;
-	  }
+      double finalDistance = task->getRemainingDistance( currentTpIndex + 1, dist2Next );
 
       // to avoid wraping in the table we have to code spaces as forced
       // spaces in html
@@ -673,13 +667,7 @@ void TPInfoWidget::prepareArrivalInfoText( Waypoint *wp )
     "</td></tr>";
 
   // distance in km to final target must be calculated
-  double finalDistance = distance2Target.getKilometers();
-
-  for( int loop=tpIdx+1; loop <= tpList.count() - 1; loop++ )
-    {
-      // qDebug("distance: %f", tpList.at(loop)->distance);
-      finalDistance += tpList.at(loop)->distance;
-    }
+  double finalDistance = task->getRemainingDistance( tpIdx, distance2Target.getKilometers() );
 
   // to avoid wrapping in the table we have to code spaces as forced
   // spaces in html
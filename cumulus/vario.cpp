@@ -21,6 +21,7 @@
 #include "vario.h"
 #include "altitude.h"
 #include "calculator.h"
+#include "flightclock.h"
 #include "generalconfig.h"
 
 Vario::Vario(QObject* parent) :
@@ -68,7 +69,7 @@ void Vario::newAltitude()
 
   // Step through the list. Note, the list is inverse ordered, last sample at
   // first position.
-  QDateTime startTime = calculator->samplelist.at( 0 ).time;
+  qint64 startTime = calculator->samplelist.at( 0 ).time;
 
   while( i < max )
     {
@@ -80,8 +81,8 @@ void Vario::newAltitude()
       // calculate energy altitude for both samples
       if( m_TEKOn )
         {
-          double speed1 = sample1->airspeed.getMps();
-          double speed2 = sample2->airspeed.getMps();
+          double speed1 = sample1->airspeed;
+          double speed2 = sample2->airspeed;
 
           if( (calculator->currentFlightMode() != Calculator::circlingL &&
                calculator->currentFlightMode() != Calculator::circlingR) ||
@@ -89,10 +90,8 @@ void Vario::newAltitude()
             {
               // If we do not circling or the calculated airspeed is zero
               // we do take the ground speed as basis.
-              Vector v1 = sample1->vector;
-              Vector v2 = sample1->vector;
-              speed1 = v1.getSpeed().getMps();
-              speed2 = v2.getSpeed().getMps();
+              speed1 = sample1->speed;
+              speed2 = sample2->speed;
             }
 
           energyAlt1  = (speed1 * speed1) / (2 * 9.81);
@@ -102,7 +101,7 @@ void Vario::newAltitude()
       // if( i == 2 )
       // qDebug("Airspeed %f, EnergyAltitude %f, TekAdj %f",sample1->airspeed.getKph(), energyAlt1, _TekAdjust );
 
-      int timeDist = sample2->time.msecsTo( startTime );
+      qint64 timeDist = startTime - sample2->time;
 
       if( timeDist > m_intTime )
         {
@@ -112,10 +111,10 @@ void Vario::newAltitude()
 
       i++;
 
-      double diff = (sample1->altitude.getMeters() + energyAlt1 * m_TekAdjust) -
-                    (sample2->altitude.getMeters() + energyAlt2 * m_TekAdjust);
+      double diff = (sample1->altitude + energyAlt1 * m_TekAdjust) -
+                    (sample2->altitude + energyAlt2 * m_TekAdjust);
 
-      int elapsed = sample2->time.msecsTo( sample1->time );
+      qint64 elapsed = sample1->time - sample2->time;
 
       sum += (1000.0 * diff / (double) elapsed);
 
@@ -155,7 +154,7 @@ void Vario::newPressureAltitude( const Altitude& altitude, const Speed& tas )
 
   sample.altitude  = altitude.getMeters();
   sample.tas       = tas.getMps();
-  sample.timeStamp = QDateTime::currentMSecsSinceEpoch();
+  sample.timeStamp = FlightClock::currentMSecsSinceEpoch();
 
   // Add the new sample to the list.
   m_sampleList.add( sample );
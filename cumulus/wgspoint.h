@@ -174,6 +174,16 @@ public:
       return QString("%1.%2").arg(position.x()).arg(position.y());
     };
 
+    /**
+     * Returns the position packed into an integer to be used as key for
+     * checks a.s.o. It is unique like the coordinate string, but needs no
+     * string formatting.
+     */
+    static quint64 coordinateKey(const QPoint& position)
+    {
+      return (quint64( quint32( position.x() ) ) << 32) | quint32( position.y() );
+    };
+
     /**
      * Calculates the other position and distance in relation to the own position.
      *
@@ -25,32 +25,44 @@
 /*
   About Wind analysis
 
-  Currently, the wind is analyzed by finding the minimum and the maximum
-  ground speeds measured while flying a circle. The direction of the wind is taken
-  to be the direction in which the speed reaches it's maximum value, the speed
-  is half the difference between the maximum and the minimum speeds measured.
-  A quality parameter, based on the number of circles already flown (the first
-  circles are taken to be less accurate) and the angle between the headings at
-  minimum and maximum speeds, is calculated in order to be able to weigh the
-  resulting measurement. This method do not more work for wind speeds < 5Km/h.
-
-  There are other options for determining the wind speed. You could for instance
-  add all the vectors in a circle, and take the resulting vector as the wind speed.
-  This is a more complex method, but because it is based on more heading/speed
-  measurements by the GPS, it is probably more accurate. If equipped with
-  instruments that pass along airspeed, the calculations can be compensated for
-  changes in airspeed, resulting in better measurements. We are now assuming
-  the pilot flies in perfect circles with constant airspeed, which is of course
-  not a safe assumption.
-  The quality indication we are calculation can also be approached differently,
-  by calculating how constant the speed in the circle would be if corrected for
-  the wind speed we just derived. The more constant, the better. This is again
-  more CPU intensive, but may produce better results.
+  While circling with constant airspeed, the ground velocity vectors measured
+  by the GPS lie on a circle. The center of that circle is the drift of the air
+  mass and its radius is the airspeed. Every ground velocity sample is added to
+  a streaming least squares circle fit, which stores only some sums. Therefore
+  all samples of a circle contribute to the result and not only the two with
+  the minimum and maximum ground speed.
+
+  The fit is evaluated after every half circle over the last two half circles,
+  so that a new measurement is available twice per circle. The quality of the
+  measurement is derived from the deviation of the samples from the fitted
+  circle. The more constant the airspeed was flown, the better. The first
+  circles in a thermal are considered to be of lesser quality.
+
+  If an external device delivers the true airspeed, the wind is estimated in
+  straight flight too. A Kalman filter refines the drift with every sample, so
+  that the airspeed derived from ground velocity and drift matches the
+  measured one. The course changes of normal cruising make the drift fully
+  observable.
 
   Some of the errors made here will be averaged-out by the WindStore, which keeps
   a number of wind measurements and calculates a weighted average based on quality.
 */
 
+// Minimum number of samples of a circle fit.
+#define MIN_CIRCLE_SAMPLES 8
+
+// Minimum radius of the fitted circle in m/s, that is the airspeed.
+#define MIN_CIRCLE_RADIUS 8.0
+
+// Interval in ms, in which the straight flight wind is reported.
+#define FILTER_REPORT_INTERVAL 30000
+
+// Maximum standard deviation in m/s of a reported straight flight wind.
+#define FILTER_MAX_SIGMA 1.5
+
+// Maximum time gap in ms between two samples processed by the filter.
+#define FILTER_MAX_GAP 5000
+
 WindAnalyser::WindAnalyser(QObject* parent) :
   QObject(parent),
   active(false),
@@ -62,7 +74,12 @@ WindAnalyser::WindAnalyser(QObject* parent) :
   satCnt(0),
   minSatCnt(4),
   ciclingMode(false),
-  gpsStatus(GpsNmea::notConnected)
+  cruisingMode(false),
+  gpsStatus(GpsNmea::notConnected),
+  hasLastHalfCircle(false),
+  filterStarted(false),
+  filterSampleTime(0),
+  filterReportTime(0)
 {
   // Initialization
   minSatCnt = GeneralConfig::instance()->getWindMinSatCount();
@@ -74,69 +91,56 @@ WindAnalyser::~WindAnalyser()
 /** Called if a new sample is available in the sample list. */
 void WindAnalyser::slot_newSample()
 {
+  const FlightSample& sample = calculator->samplelist.at(0);
+
+  if( cruisingMode )
+    {
+      _filterSample( sample );
+      return;
+    }
+
   if( ! active )
     {
       return; // do only work if we are in active mode
     }
 
-  Vector &curVec = calculator->samplelist[0].vector;
+  Vector curVec = sample.getVector();
 
   // circle detection
   if( lastHeading != -1 )
     {
-      int diff = abs( curVec.getAngleDeg() - lastHeading );
-
-      if( diff > 180 )
-        {
-          // Correct difference, if current angle has 360 degree passed.
-          // In such a case it starts with smaller values again.
-          diff = abs(diff - 360 );
-        }
-
-      circleDegrees += diff;
+      // The signed heading difference is summed up. Heading noise of a high
+      // rate receiver cancels out then and does not close the circle early.
+      circleDegrees += MapCalc::angleDiff( lastHeading, curVec.getAngleDeg() );
       circleSectors++;
     }
-  else
-    {
-      minVector = curVec;
-      maxVector = curVec;
-    }
 
   lastHeading = curVec.getAngleDeg();
 
-  if( curVec.getSpeed().getMps() < minVector.getSpeed().getMps() )
-    {
-      // New minimum speed detected
-      minVector = curVec;
-    }
+  halfCircle.add( curVec.getXMps(), curVec.getYMps() );
 
-  if( curVec.getSpeed().getMps() > maxVector.getSpeed().getMps() )
+  if( abs( circleDegrees ) >= 180 )
     {
-      // New maximum speed detected
-      maxVector = curVec;
-    }
+      // half circle made!
+      if( hasLastHalfCircle )
+        {
+          // Increase the number of circles flown (used to determine the
+          // quality) and calculate the wind over the last full circle.
+          circleCount++;
 
-  /*
-  qDebug( "curVec: %.3f/%dGrad, minVec: %.3f/%dGrad, maxVec: %.3f/%dGrad",
-         curVec.getSpeed().getKph(), curVec.getAngleDeg(),
-         minVector.getSpeed().getKph(), minVector.getAngleDeg(),
-         maxVector.getSpeed().getKph(), maxVector.getAngleDeg() );
-  */
+          WindCircleFit fullCircle = lastHalfCircle;
+          fullCircle += halfCircle;
 
-  if( circleDegrees > 360 )
-    {
-      // full circle made!
-      // increase the number of circles flown (used to determine the quality)
-      circleCount++;
+          _calcWind( fullCircle );
+        }
 
-      // calculate the wind for this circle
-      _calcWind();
+      lastHalfCircle = halfCircle;
+      hasLastHalfCircle = true;
+      halfCircle.clear();
 
-      circleDegrees = 0;
+      // Keep the overshoot for the next half circle.
+      circleDegrees -= (circleDegrees > 0) ? 180 : -180;
       circleSectors = 0;
-
-      minVector = curVec;
-      maxVector = curVec;
     }
 }
 
@@ -150,9 +154,17 @@ void WindAnalyser::slot_newFlightMode( Calculator::FlightMode newFlightMode )
   circleSectors = 0;
   lastHeading   = -1;
 
+  halfCircle.clear();
+  lastHalfCircle.clear();
+  hasLastHalfCircle = false;
+
   // We are inactive as default.
   active = false;
 
+  // The straight flight wind filter is restarted with the next sample.
+  cruisingMode  = (newFlightMode == Calculator::cruising);
+  filterStarted = false;
+
   if( newFlightMode == Calculator::circlingL )
     {
       circleLeft = true;
@@ -189,22 +201,54 @@ void WindAnalyser::slot_newFlightMode( Calculator::FlightMode newFlightMode )
   active = true;
 }
 
-void WindAnalyser::_calcWind()
+void WindAnalyser::_calcWind( const WindCircleFit& fit )
 {
-  // int degreePerStep = circleDegrees / circleSectors;
+  double north, east, radius, rms;
+
+  if( fit.count() < MIN_CIRCLE_SAMPLES ||
+      fit.solve( north, east, radius, rms ) == false )
+    {
+      return;
+    }
 
-  int aDiff = rint(MapCalc::angleDiff( minVector.getAngleDeg(), maxVector.getAngleDeg() ));
+  // The circle radius is the airspeed. A too small radius or a drift near to
+  // the airspeed is not plausible.
+  const double drift = sqrt( north * north + east * east );
+
+  if( radius < MIN_CIRCLE_RADIUS || drift > 0.8 * radius )
+    {
+      return;
+    }
 
   /*
     Determine quality.
 
-    Currently, we are using the question how well the min and the max vectors
-    are on opposing sides of the circle to determine the quality. 140 degrees is
-    the minimum separation, 180 is ideal.
+    The root mean square deviation of the samples from the fitted circle
+    measures, how constant the airspeed was flown.
     Furthermore, the first two circles are considered to be of lesser quality.
   */
+  int quality;
 
-  int quality = 5 - ((180 - abs( aDiff )) / 8);
+  if( rms < 0.5 )
+    {
+      quality = 5;
+    }
+  else if( rms < 1.0 )
+    {
+      quality = 4;
+    }
+  else if( rms < 1.5 )
+    {
+      quality = 3;
+    }
+  else if( rms < 2.5 )
+    {
+      quality = 2;
+    }
+  else
+    {
+      quality = 1;
+    }
 
   if( circleCount < 2 )
     {
@@ -216,7 +260,7 @@ void WindAnalyser::_calcWind()
       quality--;
     }
 
-  // qDebug() << "WindQuality=" << quality;
+  // qDebug() << "WindQuality=" << quality << "rms=" << rms;
 
   if( quality < 1 )
     {
@@ -226,29 +270,64 @@ void WindAnalyser::_calcWind()
   // 5 is maximum quality, make sure we honor that.
   quality = qMin( quality, 5 );
 
-  // Invert maxVector angle
-  maxVector.setAngle( MapCalc::normalize( maxVector.getAngleDeg() + 180 ) );
+  // The wind comes from the opposite direction of the drift.
+  Vector result( -north, -east );
 
-  // take both directions for min and max vector into account
-  /*
-  qDebug( "maxAngle=%d/%.0f minAngle=%d/%.0f",
-           maxVector.getAngleDeg(), maxVector.getSpeed().getKph(),
-           minVector.getAngleDeg(), minVector.getSpeed().getKph() );
-  */
+  // Let the world know about our measurement!
+  // qDebug("### ComputedWind: %dGrad/%.0fKm/h", result.getAngleDeg(), result.getSpeed().getKph());
 
-  // create a vector object for the resulting wind
-  Vector result;
+  emit newMeasurement( result, quality );
+}
 
-  // the direction of the wind is the direction where the greatest speed occurred
-  result.setAngle( ( maxVector.getAngleDeg() + minVector.getAngleDeg() ) / 2);
+void WindAnalyser::_filterSample( const FlightSample& sample )
+{
+  // The filter needs the airspeed of an external device. A calculated
+  // airspeed is derived from the wind itself.
+  if( calculator->hasMeasuredTas() == false ||
+      gpsStatus != GpsNmea::validFix || satCnt < minSatCnt )
+    {
+      filterStarted = false;
+      return;
+    }
 
-  // The speed of the wind is half the difference between the minimum and the maximum speeds.
-  result.setSpeed( (maxVector.getSpeed().getMps() - minVector.getSpeed().getMps()) / 2.0 );
+  Vector curVec = sample.getVector();
 
-  // Let the world know about our measurement!
-  // qDebug("### ComputedWind: %dGrad/%.0fKm/h", result.getAngleDeg(), result.getSpeed().getKph());
+  if( filterStarted == false ||
+      sample.time - filterSampleTime > FILTER_MAX_GAP ||
+      sample.time <= filterSampleTime )
+    {
+      // Start with the current wind as drift.
+      Vector& wind = calculator->getLastWind();
 
-  emit newMeasurement( result, quality );
+      filter.reset( -wind.getXMps(), -wind.getYMps() );
+      filterStarted    = true;
+      filterSampleTime = sample.time;
+      filterReportTime = sample.time;
+      return;
+    }
+
+  const double dt = (sample.time - filterSampleTime) / 1000.0;
+  filterSampleTime = sample.time;
+
+  filter.update( curVec.getXMps(), curVec.getYMps(), calculator->getlastTas().getMps(), dt );
+
+  if( sample.time - filterReportTime < FILTER_REPORT_INTERVAL )
+    {
+      return;
+    }
+
+  filterReportTime = sample.time;
+
+  const double sigma = filter.sigma();
+
+  if( sigma > FILTER_MAX_SIGMA )
+    {
+      return; // The drift is not yet observed well enough.
+    }
+
+  Vector result( -filter.north(), -filter.east() );
+
+  emit newMeasurement( result, sigma < FILTER_MAX_SIGMA / 2.0 ? 3 : 2 );
 }
 
 void WindAnalyser::slot_newConstellation( SatInfo& newConstellation )
@@ -271,6 +350,9 @@ void WindAnalyser::slot_newConstellation( SatInfo& newConstellation )
       circleDegrees = 0;
       circleSectors = 0;
       lastHeading   = -1;
+
+      halfCircle.clear();
+      hasLastHalfCircle = false;
     }
 }
 
@@ -294,5 +376,8 @@ void WindAnalyser::slot_gpsStatusChange( GpsNmea::GpsStatus newStatus )
       circleDegrees = 0;
       circleSectors = 0;
       lastHeading   = -1;
+
+      halfCircle.clear();
+      hasLastHalfCircle = false;
     }
 }
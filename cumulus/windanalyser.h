@@ -37,6 +37,7 @@
 #include "vector.h"
 #include "calculator.h"
 #include "gpsnmea.h"
+#include "windfit.h"
 
 class WindAnalyser : public QObject
 {
@@ -83,7 +84,15 @@ public slots:
 
 private:
 
-  void _calcWind();
+  /**
+   * Calculates the wind from the circle fitted to the ground velocities.
+   */
+  void _calcWind( const WindCircleFit& fit );
+
+  /**
+   * Feeds the wind filter with a sample of straight flight.
+   */
+  void _filterSample( const FlightSample& sample );
 
   /** active is set to true or false by the slot_newFlightMode slot. */
   bool active;
@@ -95,9 +104,19 @@ private:
   int satCnt;
   int minSatCnt;
   bool ciclingMode;
+  bool cruisingMode;
   GpsNmea::GpsStatus gpsStatus;
-  Vector minVector;
-  Vector maxVector;
+
+  /** Ground velocities of the current and the last half circle. */
+  WindCircleFit halfCircle;
+  WindCircleFit lastHalfCircle;
+  bool hasLastHalfCircle;
+
+  /** Wind estimation from the measured airspeed in straight flight. */
+  WindFilter filter;
+  bool filterStarted;
+  qint64 filterSampleTime;
+  qint64 filterReportTime;
 };
 
 #endif
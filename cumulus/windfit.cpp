@@ -0,0 +1,192 @@
+/***********************************************************************
+**
+**   windfit.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <cmath>
+
+#include <QtGlobal>
+
+#include "windfit.h"
+
+// Initial variance of the filtered drift in (m/s)^2.
+#define FILTER_INITIAL_VARIANCE 16.0
+
+// Variance of the airspeed measurement in (m/s)^2.
+#define FILTER_TAS_VARIANCE 1.0
+
+// Change of the wind per second as variance in (m/s)^2.
+#define FILTER_DRIFT_VARIANCE 0.002
+
+// Minimum length of the air velocity in m/s, which is processed.
+#define FILTER_MIN_AIRSPEED 5.0
+
+WindCircleFit::WindCircleFit()
+{
+  clear();
+}
+
+void WindCircleFit::clear()
+{
+  n = sx = sy = sxx = syy = sxy = sz = sxz = syz = szz = 0.0;
+}
+
+void WindCircleFit::add( const double north, const double east )
+{
+  const double z = north * north + east * east;
+
+  n   += 1.0;
+  sx  += north;
+  sy  += east;
+  sxx += north * north;
+  syy += east * east;
+  sxy += north * east;
+  sz  += z;
+  sxz += north * z;
+  syz += east * z;
+  szz += z * z;
+}
+
+WindCircleFit& WindCircleFit::operator += ( const WindCircleFit& other )
+{
+  n   += other.n;
+  sx  += other.sx;
+  sy  += other.sy;
+  sxx += other.sxx;
+  syy += other.syy;
+  sxy += other.sxy;
+  sz  += other.sz;
+  sxz += other.sxz;
+  syz += other.syz;
+  szz += other.szz;
+
+  return *this;
+}
+
+bool WindCircleFit::solve( double& north, double& east, double& radius, double& rms ) const
+{
+  if( n < 3.0 )
+    {
+      return false;
+    }
+
+  // The circle x^2 + y^2 + D*x + E*y + F = 0 is fitted by the normal
+  // equations of the algebraic distances, which are solved by Cramer's rule.
+  const double a11 = sxx, a12 = sxy, a13 = sx;
+  const double a22 = syy, a23 = sy,  a33 = n;
+  const double b1 = -sxz, b2 = -syz, b3 = -sz;
+
+  const double det = a11 * (a22 * a33 - a23 * a23) -
+                     a12 * (a12 * a33 - a23 * a13) +
+                     a13 * (a12 * a23 - a22 * a13);
+
+  // The samples are on a line or in a point.
+  if( fabs( det ) < 1e-9 * n * n * n )
+    {
+      return false;
+    }
+
+  const double D = ( b1 * (a22 * a33 - a23 * a23) -
+                     a12 * (b2 * a33 - a23 * b3) +
+                     a13 * (b2 * a23 - a22 * b3) ) / det;
+
+  const double E = ( a11 * (b2 * a33 - a23 * b3) -
+                     b1 * (a12 * a33 - a23 * a13) +
+                     a13 * (a12 * b3 - b2 * a13) ) / det;
+
+  const double F = ( a11 * (a22 * b3 - b2 * a23) -
+                     a12 * (a12 * b3 - b2 * a13) +
+                     b1 * (a12 * a23 - a22 * a13) ) / det;
+
+  const double r2 = (D * D + E * E) / 4.0 - F;
+
+  if( r2 <= 0.0 )
+    {
+      return false;
+    }
+
+  north  = -D / 2.0;
+  east   = -E / 2.0;
+  radius = sqrt( r2 );
+
+  // The sum of the squared algebraic distances is expanded from the sums.
+  // An algebraic distance is about 2 * radius times the geometric one.
+  const double residual = szz + D * D * sxx + E * E * syy + F * F * n +
+                          2.0 * (D * sxz + E * syz + F * sz +
+                                 D * E * sxy + D * F * sx + E * F * sy);
+
+  rms = sqrt( qMax( residual, 0.0 ) / n ) / (2.0 * radius);
+
+  return true;
+}
+
+WindFilter::WindFilter()
+{
+  reset( 0.0, 0.0 );
+}
+
+void WindFilter::reset( const double north, const double east )
+{
+  m_north = north;
+  m_east  = east;
+  m_p11   = FILTER_INITIAL_VARIANCE;
+  m_p12   = 0.0;
+  m_p22   = FILTER_INITIAL_VARIANCE;
+}
+
+void WindFilter::update( const double north, const double east, const double tas, const double dt )
+{
+  // The wind may change in the meantime.
+  m_p11 += FILTER_DRIFT_VARIANCE * dt;
+  m_p22 += FILTER_DRIFT_VARIANCE * dt;
+
+  // Air velocity, which results from the estimated drift.
+  const double ax = north - m_north;
+  const double ay = east - m_east;
+  const double airspeed = sqrt( ax * ax + ay * ay );
+
+  if( airspeed < FILTER_MIN_AIRSPEED )
+    {
+      return;
+    }
+
+  // Derivation of the airspeed after the drift components.
+  const double h1 = -ax / airspeed;
+  const double h2 = -ay / airspeed;
+
+  const double ph1 = m_p11 * h1 + m_p12 * h2;
+  const double ph2 = m_p12 * h1 + m_p22 * h2;
+
+  const double s = h1 * ph1 + h2 * ph2 + FILTER_TAS_VARIANCE;
+
+  const double k1 = ph1 / s;
+  const double k2 = ph2 / s;
+
+  const double innovation = tas - airspeed;
+
+  m_north += k1 * innovation;
+  m_east  += k2 * innovation;
+
+  m_p11 -= k1 * ph1;
+  m_p12 -= k1 * ph2;
+  m_p22 -= k2 * ph2;
+}
+
+double WindFilter::sigma() const
+{
+  // Largest eigenvalue of the covariance matrix.
+  const double mean = (m_p11 + m_p22) / 2.0;
+  const double diff = (m_p11 - m_p22) / 2.0;
+
+  return sqrt( mean + sqrt( diff * diff + m_p12 * m_p12 ) );
+}
@@ -0,0 +1,164 @@
+/***********************************************************************
+**
+**   windfit.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c): 2026 by the Cumulus team
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef WIND_FIT_H
+#define WIND_FIT_H
+
+/**
+ * \class WindCircleFit
+ *
+ * \brief Streaming least squares circle fit of ground velocities.
+ *
+ * While circling with constant airspeed, the ground velocity vectors lie on
+ * a circle. Its center is the drift of the air mass and its radius is the
+ * airspeed. The fit minimizes the algebraic distance of the samples to the
+ * circle (Kasa fit). Only the sums of the samples are stored, so that a
+ * sample is added in constant time and two fits can be merged.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+class WindCircleFit
+{
+ public:
+
+  WindCircleFit();
+
+  /**
+   * Removes all samples.
+   */
+  void clear();
+
+  /**
+   * Adds a ground velocity sample.
+   *
+   * \param north Velocity component to the north in m/s.
+   *
+   * \param east Velocity component to the east in m/s.
+   */
+  void add( const double north, const double east );
+
+  /**
+   * Adds the samples of another fit.
+   */
+  WindCircleFit& operator += ( const WindCircleFit& other );
+
+  /**
+   * \return The number of samples.
+   */
+  int count() const
+  {
+    return static_cast<int> (n);
+  };
+
+  /**
+   * Fits the circle to the samples.
+   *
+   * \param north North component of the circle center in m/s.
+   *
+   * \param east East component of the circle center in m/s.
+   *
+   * \param radius Circle radius in m/s.
+   *
+   * \param rms Root mean square deviation of the samples from the circle
+   *            in m/s.
+   *
+   * \return True, if a circle could be fitted.
+   */
+  bool solve( double& north, double& east, double& radius, double& rms ) const;
+
+ private:
+
+  /** Sums of the samples, z is the squared length of a sample. */
+  double n, sx, sy, sxx, syy, sxy, sz, sxz, syz, szz;
+};
+
+/**
+ * \class WindFilter
+ *
+ * \brief Wind estimation from true airspeed and ground velocity.
+ *
+ * If the true airspeed is measured by an external device, the length of the
+ * difference between ground velocity and air mass drift must be equal to it.
+ * An extended Kalman filter refines the drift with every sample by this
+ * condition. In straight flight mainly the component along the track is
+ * observed. Course changes make the other component observable, so that
+ * the filter converges within some minutes of normal cruising.
+ *
+ * \date 2026
+ *
+ * \version 1.0
+ */
+class WindFilter
+{
+ public:
+
+  WindFilter();
+
+  /**
+   * Restarts the filter with an initial drift of the air mass.
+   *
+   * \param north North component of the drift in m/s.
+   *
+   * \param east East component of the drift in m/s.
+   */
+  void reset( const double north, const double east );
+
+  /**
+   * Processes a sample.
+   *
+   * \param north North component of the ground velocity in m/s.
+   *
+   * \param east East component of the ground velocity in m/s.
+   *
+   * \param tas True airspeed in m/s.
+   *
+   * \param dt Time since the last sample in seconds.
+   */
+  void update( const double north, const double east, const double tas, const double dt );
+
+  /**
+   * \return The north component of the estimated drift in m/s.
+   */
+  double north() const
+  {
+    return m_north;
+  };
+
+  /**
+   * \return The east component of the estimated drift in m/s.
+   */
+  double east() const
+  {
+    return m_east;
+  };
+
+  /**
+   * \return The standard deviation in m/s of the worst observed direction.
+   */
+  double sigma() const;
+
+ private:
+
+  /** Estimated drift of the air mass. */
+  double m_north;
+  double m_east;
+
+  /** Covariance of the estimation. */
+  double m_p11, m_p12, m_p22;
+};
+
+#endif
@@ -8,6 +8,7 @@
 **
 **   Copyright (c):  2002      by André Somers
 **                   2007-2016 by Axel Pauli
+**                   2026      by the Cumulus team
 **
 **   This file is distributed under the terms of the General Public
 **   License. See the file COPYING for more information.
@@ -22,14 +23,39 @@
 #include "windmeasurementlist.h"
 #include "altitude.h"
 #include "vector.h"
+#include "flightclock.h"
 #include "generalconfig.h"
 
 // Maximum number of wind measurements in the list.
 // No idea what a sensible value would be...
 #define MAX_MEASUREMENTS 1800
 
+// Height in meters of an altitude bucket.
+#define BUCKET_HEIGHT 100.0
+
+// relative weight for each factor in percent
+#define REL_FACTOR_QUALITY 100
+#define REL_FACTOR_ALTITUDE 100
+#define REL_FACTOR_TIME 200
+
+namespace
+{
+  /** Orders measurements by their time. */
+  bool timeLessThan( const WindMeasurement& wm, const qint64 time )
+  {
+    return wm.time < time;
+  }
+
+  int bucketOf( const double altitude )
+  {
+    return static_cast<int> (floor( altitude / BUCKET_HEIGHT ));
+  }
+}
+
 WindMeasurementList::WindMeasurementList() :
-  LimitedList<WindMeasurement>( MAX_MEASUREMENTS )
+  m_count(0),
+  m_version(0),
+  m_lastTime(0)
 {
 }
 
@@ -37,6 +63,13 @@ WindMeasurementList::~WindMeasurementList()
 {
 }
 
+void WindMeasurementList::clear()
+{
+  m_buckets.clear();
+  m_count = 0;
+  m_version++;
+}
+
 /**
  * Returns the weighted mean wind vector over the stored values, or 0
  * if no valid vector could be calculated (for instance: too little or
@@ -46,40 +79,18 @@ Vector WindMeasurementList::getWind( const Altitude& alt,
                                      const int timeWindow,
                                      const int altRange )
 {
-// relative weight for each factor in percent
-#define REL_FACTOR_QUALITY 100
-#define REL_FACTOR_ALTITUDE 100
-#define REL_FACTOR_TIME 200
-
-  // counts the number of calls to prevent endless recursion.
-  static short entry = 0;
-
-  Vector result;
-
-  if( size() == 0 )
+  if( m_count == 0 )
     {
       // Measurement list is empty.
-      return result;
+      return Vector();
     }
 
-  entry++;
-
-  QTime dauer;
-  dauer.start();
-
   GeneralConfig *conf = GeneralConfig::instance();
 
-  double usedAltRange = 0;
+  // Take the default altitude range from the configuration
+  const double defaultAltRange = static_cast<double>(conf->getWindAltitudeRange()) / 2.0;  // 1000m
 
-  if( altRange == 0 )
-    {
-      // Take the default altitude range from the configuration
-      usedAltRange  = static_cast<double>(conf->getWindAltitudeRange()) / 2.0;  // 1000m
-    }
-  else
-    {
-      usedAltRange = altRange / 2.0;
-    }
+  double usedAltRange = (altRange == 0) ? defaultAltRange : altRange / 2.0;
 
   int timeRange = timeWindow;
 
@@ -90,22 +101,70 @@ Vector WindMeasurementList::getWind( const Altitude& alt,
       timeRange = conf->getWindTimeRange(); // 600s
     }
 
+  const qint64 now = qMax( FlightClock::currentMSecsSinceEpoch(), m_lastTime );
+
+  Vector result = calcWind( alt.getMeters(), usedAltRange, timeRange, now );
+
+  if( ! result.isValid() && timeWindow < 3600 )
+    {
+      // If there is no younger wind available make a second round with a time
+      // window of one hour.
+      result = calcWind( alt.getMeters(), defaultAltRange, 3600, now );
+
+      if( ! result.isValid() )
+        {
+          // If there is no younger wind available make a second round with a time
+          // window of two hour.
+          result = calcWind( alt.getMeters(), defaultAltRange, 7200, now );
+        }
+    }
+
+  /*
+  qDebug( "Alt=%f, WindResult=%d/%f",
+          alt.getMeters(), result.getAngleDeg(), result.getSpeed().getKph() );
+  */
+
+  return result;
+}
+
+Vector WindMeasurementList::calcWind( const double altitude,
+                                      const double altRange,
+                                      const int timeRange,
+                                      const qint64 now ) const
+{
+  Vector result;
+
   int total_quality = 0;
   int quality = 0, q_quality = 0, a_quality = 0, t_quality = 0;
-  QTime now = QTime::currentTime();
 
-  double altDiff  = 0.0;
-  double timeDiff = 0.0;
+  const qint64 since = now - qint64( timeRange ) * 1000;
 
-  for( int i = 0; i < count(); i++ )
+  // Only the buckets, which overlap the altitude range, are visited.
+  QMap<int, QVector<WindMeasurement> >::const_iterator it =
+    m_buckets.lowerBound( bucketOf( altitude - altRange ) );
+
+  const int lastBucket = bucketOf( altitude + altRange );
+
+  for( ; it != m_buckets.constEnd() && it.key() <= lastBucket; ++it )
     {
-      const WindMeasurement& wm = at( i );
+      const QVector<WindMeasurement>& bucket = it.value();
 
-      altDiff = (alt - wm.altitude).getMeters() / usedAltRange;
-      timeDiff = fabs( (double) wm.time.secsTo(now) / (double) timeRange );
+      // The measurements of a bucket are ordered by time, skip the older ones.
+      QVector<WindMeasurement>::const_iterator wit =
+        std::lower_bound( bucket.constBegin(), bucket.constEnd(), since, timeLessThan );
 
-      if( (fabs(altDiff) < 1.0) && (timeDiff < 1.0) )
+      for( ; wit != bucket.constEnd(); ++wit )
         {
+          const WindMeasurement& wm = *wit;
+
+          double altDiff = (altitude - wm.altitude.getMeters()) / altRange;
+          double timeDiff = fabs( double(now - wm.time) / 1000.0 / double(timeRange) );
+
+          if( fabs(altDiff) >= 1.0 || timeDiff >= 1.0 )
+            {
+              continue;
+            }
+
           // Measurement quality range is 1...5, 5 is the best quality
           // Maximum quality is 5*100/5 = 100%
           // Minimum quality is 1*100/5 = 20%
@@ -123,58 +182,23 @@ Vector WindMeasurementList::getWind( const Altitude& alt,
 
           quality = q_quality * a_quality * t_quality;
 
-          /*
-          qDebug("i=%d alt=%f qual=%d wind=%d/%f (%d, %d, %d)",
-                  i, wm.altitude.getMeters(), quality,
-                  value(i).vector.getAngleDeg(),
-                  value(i).vector.getSpeed().getKph(),
-                  q_quality, a_quality, t_quality );
-          */
-
           if( quality == 0 )
             {
               continue;
             }
 
-          result.add( value(i).vector * quality );
-          total_quality += quality;
+          Vector vector = wm.vector;
 
-          /*
-          qDebug( "Cur result=%d/%f (tQ=%d)",
-                  result.getAngleDeg(),
-                  result.getSpeed().getKph() / total_quality,
-                  total_quality );
-          */
+          result.add( vector * quality );
+          total_quality += quality;
         }
-  }
+    }
 
   if( total_quality > 0 )
     {
       result = result / total_quality;
     }
 
-  /*
-  qDebug( "Round=%d, Alt=%f, WindResult=%d/%f",
-          entry, alt.getMeters(),
-          result.getAngleDeg(), result.getSpeed().getKph() );
-  */
-
-  if( ! result.isValid() && entry == 1 && timeWindow < 3600 )
-    {
-      // If there is no younger wind available make a second round with a time
-      // window of one hour.
-      result = getWind( alt, 3600 );
-
-      if( ! result.isValid() )
-        {
-          // If there is no younger wind available make a second round with a time
-          // window of two hour.
-          result = getWind( alt, 7200 );
-        }
-    }
-
-  entry--;
-
   return result;
 }
 
@@ -183,45 +207,74 @@ void WindMeasurementList::addMeasurement( const Vector& vector,
                                           const Altitude& alt,
                                           int quality )
 {
+  // The times inside of a bucket must be ascending, also if the system
+  // clock is set back.
+  m_lastTime = qMax( FlightClock::currentMSecsSinceEpoch(), m_lastTime );
+
   WindMeasurement wind;
   wind.vector = vector;
   wind.quality = quality;
   wind.altitude = alt;
-  wind.time = QTime::currentTime();
+  wind.time = m_lastTime;
 
-  // Add item to limited list.
-  add( wind );
+  if( m_count >= MAX_MEASUREMENTS )
+    {
+      removeLeastImportantItem();
+    }
 
-  std::sort( begin(), end(), WindMeasurement::lessThan );
+  m_buckets[ bucketOf( alt.getMeters() ) ].append( wind );
+  m_count++;
+  m_version++;
 }
 
 /**
- * getLeastImportantItem is called to identify the item that should be
- * removed if the list is too full. Reimplemented from LimitedList.
+ * Removes the least important item, if the list is too full.
  */
-int WindMeasurementList::getLeastImportantItemIndex() const
+void WindMeasurementList::removeLeastImportantItem()
 {
-  int maxscore = 0;
-  int score = 0;
-  int foundItem = LimitedList<WindMeasurement>::size() - 1;
+  qint64 maxscore = -1;
+  qint64 score = 0;
+
+  QMap<int, QVector<WindMeasurement> >::iterator foundBucket = m_buckets.end();
+  int foundItem = -1;
+
+  QMap<int, QVector<WindMeasurement> >::iterator it;
 
-  for( int i = foundItem; i >= 0; i-- )
+  for( it = m_buckets.begin(); it != m_buckets.end(); ++it )
     {
-      // Calculate the score of this item. The item with the highest score is the
-      // least important one. We may need to adjust the proportion of the quality
-      // and the elapsed time. Currently one quality-point (scale: 0 to 5) and
-      // the elapsed time are used for the core value.
-      score = 6 - LimitedList<WindMeasurement>::at( i ).quality;
-      score *= LimitedList<WindMeasurement>::at( i ).time.secsTo( QTime::currentTime() );
-
-      if( score > maxscore )
+      const QVector<WindMeasurement>& bucket = it.value();
+
+      for( int i = 0; i < bucket.size(); i++ )
         {
-          maxscore = score;
-          foundItem = i;
+          // Calculate the score of this item. The item with the highest score is the
+          // least important one. We may need to adjust the proportion of the quality
+          // and the elapsed time. Currently one quality-point (scale: 0 to 5) and
+          // the elapsed time are used for the core value.
+          score = 6 - bucket.at( i ).quality;
+          score *= (m_lastTime - bucket.at( i ).time) / 1000;
+
+          if( score > maxscore )
+            {
+              maxscore = score;
+              foundBucket = it;
+              foundItem = i;
+            }
         }
-  }
+    }
+
+  if( foundItem < 0 )
+    {
+      return;
+    }
+
+  foundBucket.value().remove( foundItem );
+
+  if( foundBucket.value().isEmpty() )
+    {
+      m_buckets.erase( foundBucket );
+    }
 
-  return foundItem;
+  m_count--;
 }
 
 bool WindMeasurement::operator < (const WindMeasurement& other) const
@@ -19,9 +19,10 @@
 #ifndef WIND_MEASUREMENT_LIST_H
 #define WIND_MEASUREMENT_LIST_H
 
-#include <QTime>
+#include <QtGlobal>
+#include <QMap>
+#include <QVector>
 
-#include "limitedlist.h"
 #include "altitude.h"
 #include "vector.h"
 
@@ -32,7 +33,7 @@
  *
  * \brief Data container for a single wind measurement.
  *
- * \date 2002-2010
+ * \date 2002-2026
  */
 class WindMeasurement
 {
@@ -41,7 +42,10 @@ public:
 
   Vector vector;
   int quality;
-  QTime time;
+
+  /** Time of the measurement in ms, monotonic increasing. */
+  qint64 time;
+
   Altitude altitude;
 
   bool operator < (const WindMeasurement& other) const;
@@ -60,14 +64,18 @@ public:
  *
  * \brief A list containing single wind measurements.
  *
- * \see LimitedList
- *
  * The WindMeasurementList is a list that contains and
  * processes wind measurements.
  *
- * \date 2002-2014
+ * The measurements are stored in altitude buckets. Inside of a bucket they
+ * are ordered by their time. A wind query visits only the buckets of its
+ * altitude range and finds the first measurement of its time window by a
+ * binary search. Therefore only measurements, which contribute to the
+ * result, are touched.
+ *
+ * \date 2002-2026
  */
-class WindMeasurementList : public LimitedList<WindMeasurement>
+class WindMeasurementList
 {
 
 public:
@@ -95,12 +103,54 @@ public:
   /** Adds the wind vector vector with quality quality to the list. */
   void addMeasurement( const Vector& vector, const Altitude& alt, int quality );
 
+  /**
+   * \return The number of stored measurements.
+   */
+  int size() const
+  {
+    return m_count;
+  };
+
+  /**
+   * \return A counter, which is incremented at every change of the stored
+   *         measurements. Can be used to detect, that a derived wind
+   *         profile must be recalculated.
+   */
+  uint version() const
+  {
+    return m_version;
+  };
+
+  /** Removes all measurements. */
+  void clear();
+
 protected:
+
   /**
-   * getLeastImportantItem is called to identify the item that should be
-   * removed if the list is too full. Reimplemented from \ref LimitedList.
+   * Calculates the weighted mean wind of the measurements in the passed
+   * altitude range and time window.
    */
-  virtual int getLeastImportantItemIndex() const;
+  Vector calcWind( const double altitude,
+                   const double altRange,
+                   const int timeRange,
+                   const qint64 now ) const;
+
+  /**
+   * Removes the least important measurement, if the list is too full.
+   */
+  void removeLeastImportantItem();
+
+  /** Measurements per altitude bucket, ordered by time. */
+  QMap<int, QVector<WindMeasurement> > m_buckets;
+
+  /** Number of stored measurements. */
+  int m_count;
+
+  /** Change counter of the stored measurements. */
+  uint m_version;
+
+  /** Time of the last measurement, to keep the times monotonic. */
+  qint64 m_lastTime;
 };
 
 #endif
@@ -25,6 +25,7 @@ CONFIG += flarm
 
 HEADERS = \
   gpsclient.h \
+  ../cumulus/fixlatency.h \
   ../cumulus/ipc.h \
   ../cumulus/protocol.h \
   ../cumulus/signalhandler.h
@@ -33,6 +33,7 @@
 #include "gpscon.h"
 #include "protocol.h"
 #include "ipc.h"
+#include "fixlatency.h"
 
 #ifdef FLARM
 #include "flarmbase.h"
@@ -76,6 +77,10 @@ GpsClient::GpsClient( const ushort portIn )
   dbsize           = 0;
   badSentences     = 0;
   activateTimeout  = false;
+  gpsFilterActive  = false;
+  forwardedSentences = 0;
+  droppedSentences   = 0;
+  droppedBytes       = 0;
 
   // establish a connection to the server
   if( ipcPort )
@@ -249,12 +254,15 @@ bool GpsClient::readGpsData()
 
   if( bytes > 0 )
     {
+      // Time stamp for the latency measurement of the read sentences.
+      const qint64 ingestTime = FixLatency::now();
+
       dbsize      += bytes;
       datapointer += bytes;
 
       databuffer[dbsize] = '\0'; // terminate buffer with a null
 
-      readSentenceFromBuffer();
+      readSentenceFromBuffer( ingestTime );
 
 #ifdef FLARM
 
@@ -488,9 +496,10 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
 /**
  * This method tries to read all lines contained in the receive buffer. A line
  * is always terminated by a newline and is taken over in the receiver queue,
- * if the checksum is valid and the GPS identifier is requested.
+ * if the checksum is valid and the GPS identifier is requested. The
+ * sentence is forwarded together with its reception time.
  */
-void GpsClient::readSentenceFromBuffer()
+void GpsClient::readSentenceFromBuffer( const qint64 ingestTime )
 {
   char *start = databuffer;
   char *end   = 0;
@@ -522,13 +531,14 @@ void GpsClient::readSentenceFromBuffer()
       if( verifyCheckSum( record ) == true )
         {
           // Forward sentence to the server, if checksum is ok and
-          // processing is desired.
-          // if( checkGpsMessageFilter( record ) == true && forwardGpsData == true )
-          // AP 2018: we forward all sentences now.
-          if( forwardGpsData == true )
+          // processing is desired. The server negotiates the filter. It
+          // is switched off, if the server wants to see all sentences.
+          if( forwardGpsData == true && checkGpsMessageFilter( record ) == true )
             {
               QByteArray ba;
-              ba.append( MSG_GPS_DATA );
+              ba.append( MSG_GPS_DATA_TS );
+              ba.append( ' ' );
+              ba.append( QByteArray::number( ingestTime ) );
               ba.append( ' ' );
               ba.append( record );
               writeForwardMsg( ba.data() );
@@ -590,34 +600,64 @@ void GpsClient::closeGps()
  */
 bool GpsClient::checkGpsMessageFilter( const char *sentence )
 {
-  QString msgKey( sentence );
-
-  int idx = msgKey.indexOf(",");
-
-  if( idx == -1 )
+  if( gpsFilterActive == false )
     {
-      return false;
+      forwardedSentences++;
+      return true;
     }
 
-  // Extract message key.
-  msgKey = msgKey.left(idx);
+  int keyLen = 0;
+
+  uint hash = hashGpsMessageKey( sentence, keyLen );
 
-  if( gpsMessageFilter.contains( msgKey ) || gpsMessageFilter.isEmpty() )
+  QHash<uint, QByteArray>::const_iterator it = gpsMessageFilter.constFind( hash );
+
+  // Verify the key, the hash value alone could be ambiguous.
+  if( it != gpsMessageFilter.constEnd() &&
+      it.value().size() == keyLen &&
+      memcmp( it.value().constData(), sentence, keyLen ) == 0 )
     {
       // message shall be processed.
+      forwardedSentences++;
       return true;
     }
 
-  if( unknownsReported.contains( msgKey ) == false )
+  droppedSentences++;
+  droppedBytes += strlen( sentence );
+
+  if( unknownsReported.contains( hash ) == false )
     {
       // Message shall be discarded. We do report that only once.
-      unknownsReported.insert( msgKey );
+      unknownsReported.insert( hash );
       qWarning() << "GPS sentence discarded!" << sentence;
     }
 
   return false;
 }
 
+/**
+ * Calculates a FNV-1a hash over the message key of a sentence.
+ */
+uint GpsClient::hashGpsMessageKey( const char *sentence, int& keyLen )
+{
+  uint hash = 2166136261U;
+
+  for( keyLen = 0; sentence[keyLen] != '\0'; keyLen++ )
+    {
+      char c = sentence[keyLen];
+
+      if( c == ',' || c == '*' || c == '\r' || c == '\n' )
+        {
+          break;
+        }
+
+      hash ^= static_cast<uchar> (c);
+      hash *= 16777619U;
+    }
+
+  return hash;
+}
+
 /**
  * Verify the checksum of the passed sentences.
  *
@@ -897,20 +937,37 @@ void GpsClient::readServerMsg()
     }
   else if( MSG_GPS_KEYS == args[0] && args.count() == 2 )
     {
-      // Well known GPS message keys are received.
+      // Well known GPS message keys are received. They are compiled into
+      // a hash table for a fast prefix match.
       QStringList keys = args[1].split( ",", QString::SkipEmptyParts );
 
       // Clear old content.
       gpsMessageFilter.clear();
+      unknownsReported.clear();
 
       for( int i = 0; i < keys.size(); i++ )
         {
-          gpsMessageFilter.insert( keys.at(i) );
+          QByteArray key = keys.at(i).toLatin1();
+          int keyLen = 0;
+
+          gpsMessageFilter.insert( hashGpsMessageKey( key.constData(), keyLen ), key );
         }
 
+      // An empty key list or the all key switches off the filter.
+      gpsFilterActive = ! ( keys.isEmpty() || keys.contains( MSG_GPS_KEYS_ALL ) );
+
       // qDebug() << "GPS-Keys:" << gpsMessageFilter;
       writeServerMsg( MSG_POS );
     }
+  else if( MSG_GPS_FILTER_STATS == args[0] )
+    {
+      // Statistics of the GPS message filter are requested.
+      QString stats = QString("%1 %2 %3").arg(forwardedSentences)
+                                         .arg(droppedSentences)
+                                         .arg(droppedBytes);
+
+      writeServerMsg( stats.toLatin1().data() );
+    }
   else if( MSG_SHD == args[0] )
     {
       // Shutdown is requested by the server. This message will not be
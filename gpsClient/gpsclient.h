@@ -47,6 +47,7 @@
 
 #include <QDateTime>
 #include <QByteArray>
+#include <QHash>
 #include <QQueue>
 #include <QSet>
 #include <QTime>
@@ -138,6 +139,16 @@ public:
    */
   bool checkGpsMessageFilter( const char *sentence );
 
+  /**
+   * Calculates a hash over the message key at the begin of a sentence. The
+   * key ends at the first comma or asterisk.
+   *
+   * \param sentence Sentence or message key to be hashed.
+   * \param keyLen Returns the length of the message key.
+   * \return The hash value of the message key.
+   */
+  static uint hashGpsMessageKey( const char *sentence, int& keyLen );
+
   /**
    * \param newState The new value for the shutdown state.
    */
@@ -174,7 +185,13 @@ public:
 
   uint getBaudrate( int rate );
 
-  void readSentenceFromBuffer();
+  /**
+   * Reads all complete sentences from the receive buffer.
+   *
+   * \param ingestTime Reception time of the read data in microseconds of
+   *        the monotonic clock.
+   */
+  void readSentenceFromBuffer( const qint64 ingestTime );
 
 #ifdef FLARM
 
@@ -266,16 +283,29 @@ public:
   int badSentences;
 
   /**
-   * Filter set with well known GPS message keys. Only GPS messages starting
-   * with such a key are processed and forwarded.
+   * Compiled filter with the well known GPS message keys sent by the server.
+   * The hash of a key is used as hash key. Only GPS messages starting with
+   * such a key are processed and forwarded.
    */
-  QSet<QString> gpsMessageFilter;
+  QHash<uint, QByteArray> gpsMessageFilter;
+
+  /** Flag to indicate, if the GPS message filter is active. */
+  bool gpsFilterActive;
 
   /**
-   * Set containing reported unknown GPS message keys to avoid an endless error
-   * reporting.
+   * Set containing the hashes of reported unknown GPS message keys to avoid
+   * an endless error reporting.
    */
-  QSet<QString> unknownsReported;
+  QSet<uint> unknownsReported;
+
+  /** Number of sentences forwarded to the server. */
+  quint64 forwardedSentences;
+
+  /** Number of sentences dropped by the filter. */
+  quint64 droppedSentences;
+
+  /** Number of bytes dropped by the filter. */
+  quint64 droppedBytes;
 
   /** activate flag for timeout after Flarm reset. */
   bool activateTimeout;
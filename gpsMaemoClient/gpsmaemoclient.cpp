@@ -1115,6 +1115,11 @@ void GpsMaemoClient::readServerMsg()
       // Well known GPS message keys are received. We do ignore that here.
       writeServerMsg( MSG_POS );
     }
+  else if( MSG_GPS_FILTER_STATS == args[0] )
+    {
+      // No GPS message filter is used here.
+      writeServerMsg( MSG_NEG );
+    }
   else if( MSG_SHD == args[0] )
     {
       // Shutdown is requested by the server. This message will not be acked!